@@ -0,0 +1,50 @@
+#include "AdjointTape.hpp"
+#include <stdexcept>
+
+void AdjointTape::reserve(std::size_t capacity)
+{
+    if (capacity >= NoNode)
+    {
+        throw std::length_error("Adjoint tape capacity exceeds the node index range.");
+    }
+    nodes_.reserve(capacity);
+    adjoints_.reserve(capacity);
+}
+
+void AdjointTape::gradient(const AdjointDouble& output)
+{
+    if (output.tape() != this)
+    {
+        throw std::invalid_argument("Adjoint output was not recorded on this tape.");
+    }
+
+    // assign() stays within the arena once it has grown to the tape's size
+    adjoints_.assign(nodes_.size(), 0.0);
+    adjoints_[output.node()] = 1.0;
+    for (std::size_t i = output.node() + 1; i-- > 0; )
+    {
+        double adjoint = adjoints_[i];
+        if (adjoint == 0.0)
+        {
+            continue;
+        }
+        const Node& node = nodes_[i];
+        for (int k = 0; k < 2; ++k)
+        {
+            if (node.operand[k] != NoNode)
+            {
+                adjoints_[node.operand[k]] += node.partial[k] * adjoint;
+            }
+        }
+    }
+}
+
+double AdjointTape::adjoint(const AdjointDouble& value) const
+{
+    // Constants and values recorded after the last sweep have no sensitivity
+    if (value.tape() != this || value.node() >= adjoints_.size())
+    {
+        return 0.0;
+    }
+    return adjoints_[value.node()];
+}
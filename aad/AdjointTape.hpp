@@ -0,0 +1,176 @@
+#ifndef ADJOINTTAPE_HPP
+#define ADJOINTTAPE_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "NormalDistribution.hpp"
+
+class AdjointDouble;
+
+/**
+ * @brief Arena-backed tape for reverse-mode algorithmic differentiation
+ *
+ * Every operation on AdjointDouble values appends one node holding the local
+ * partial derivatives with respect to its (at most two) operands. gradient()
+ * then propagates adjoints from one output back to every node in a single
+ * reverse sweep, so all input sensitivities cost a small constant multiple of
+ * the forward evaluation whatever the number of inputs.
+ *
+ * Node and adjoint storage is an arena: reset() rewinds it without releasing
+ * memory, so a tape reused for one option after another stops allocating once
+ * it has grown to the largest expression recorded. A tape is not thread-safe;
+ * use one per thread.
+ */
+class AdjointTape
+{
+public:
+
+    AdjointTape() = default;
+    explicit AdjointTape(std::size_t capacity) { reserve(capacity); };
+
+    // Register an independent input
+    AdjointDouble variable(double value);
+
+    // Rewind to an empty tape, keeping the arena's memory
+    void reset() { nodes_.clear(); };
+    void reserve(std::size_t capacity);
+
+    std::size_t size() const { return nodes_.size(); };           // Recorded nodes
+    std::size_t capacity() const { return nodes_.capacity(); };   // Nodes recordable without allocating
+
+    // Reverse sweep seeded with d output / d output = 1; afterwards adjoint(x)
+    // is d output / d x for every value x recorded on this tape
+    void gradient(const AdjointDouble& output);
+    double adjoint(const AdjointDouble& value) const;
+
+    // Record a node with partials (d0, d1) to operands (a, b); a constant operand has no node
+    std::uint32_t record(std::uint32_t a, double d0, std::uint32_t b = NoNode, double d1 = 0.0);
+
+    static constexpr std::uint32_t NoNode = UINT32_MAX;
+
+private:
+
+    struct Node
+    {
+        std::uint32_t operand[2];
+        double partial[2];
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<double> adjoints_;
+};
+
+/*
+    @brief Differentiable double recorded on an AdjointTape
+    Arithmetic, exp, log, sqrt and the normal CDF are supported, which covers
+    the closed-form pricing formulas. Values built from a plain double are
+    constants: they take no tape node and have no adjoint. Combining values of
+    two different tapes throws std::invalid_argument.
+*/
+class AdjointDouble
+{
+public:
+
+    AdjointDouble(double value = 0.0) : value_(value) {};   // Constant
+    AdjointDouble(double value, AdjointTape* tape, std::uint32_t node) : value_(value), tape_(tape), node_(node) {};
+
+    double value() const { return value_; };
+    AdjointTape* tape() const { return tape_; };
+    std::uint32_t node() const { return node_; };
+
+    AdjointDouble& operator+=(const AdjointDouble& other) { return *this = *this + other; };
+    AdjointDouble& operator-=(const AdjointDouble& other) { return *this = *this - other; };
+    AdjointDouble& operator*=(const AdjointDouble& other) { return *this = *this * other; };
+    AdjointDouble& operator/=(const AdjointDouble& other) { return *this = *this / other; };
+
+    friend AdjointDouble operator+(const AdjointDouble& a, const AdjointDouble& b)
+    {
+        return binary(a, b, a.value_ + b.value_, 1.0, 1.0);
+    }
+    friend AdjointDouble operator-(const AdjointDouble& a, const AdjointDouble& b)
+    {
+        return binary(a, b, a.value_ - b.value_, 1.0, -1.0);
+    }
+    friend AdjointDouble operator*(const AdjointDouble& a, const AdjointDouble& b)
+    {
+        return binary(a, b, a.value_ * b.value_, b.value_, a.value_);
+    }
+    friend AdjointDouble operator/(const AdjointDouble& a, const AdjointDouble& b)
+    {
+        double inverse = 1.0 / b.value_;
+        double quotient = a.value_ * inverse;
+        return binary(a, b, quotient, inverse, -quotient * inverse);
+    }
+    friend AdjointDouble operator-(const AdjointDouble& a)
+    {
+        return unary(a, -a.value_, -1.0);
+    }
+
+    friend AdjointDouble exp(const AdjointDouble& a)
+    {
+        double value = std::exp(a.value_);
+        return unary(a, value, value);
+    }
+    friend AdjointDouble log(const AdjointDouble& a)
+    {
+        return unary(a, std::log(a.value_), 1.0 / a.value_);
+    }
+    friend AdjointDouble sqrt(const AdjointDouble& a)
+    {
+        double value = std::sqrt(a.value_);
+        return unary(a, value, 0.5 / value);
+    }
+    // N(a) with the given implementation of the value; the partial is the exact density n(a)
+    friend AdjointDouble normalCdf(const AdjointDouble& a, double cdf)
+    {
+        return unary(a, cdf, normalPdf(a.value_));
+    }
+
+private:
+
+    static AdjointDouble unary(const AdjointDouble& a, double value, double partial)
+    {
+        if (!a.tape_)
+        {
+            return AdjointDouble(value);
+        }
+        return AdjointDouble(value, a.tape_, a.tape_->record(a.node_, partial));
+    }
+
+    static AdjointDouble binary(const AdjointDouble& a, const AdjointDouble& b, double value, double da, double db)
+    {
+        if (!a.tape_)
+        {
+            return unary(b, value, db);
+        }
+        if (!b.tape_)
+        {
+            return unary(a, value, da);
+        }
+        if (a.tape_ != b.tape_)
+        {
+            throw std::invalid_argument("Adjoint operands were recorded on different tapes.");
+        }
+        return AdjointDouble(value, a.tape_, a.tape_->record(a.node_, da, b.node_, db));
+    }
+
+    double value_;
+    AdjointTape* tape_ = nullptr;
+    std::uint32_t node_ = AdjointTape::NoNode;
+};
+
+inline AdjointDouble AdjointTape::variable(double value)
+{
+    return AdjointDouble(value, this, record(NoNode, 0.0));
+}
+
+inline std::uint32_t AdjointTape::record(std::uint32_t a, double d0, std::uint32_t b, double d1)
+{
+    nodes_.push_back({{a, b}, {d0, d1}});
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+}
+
+#endif // ADJOINTTAPE_HPP
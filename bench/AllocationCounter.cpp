@@ -0,0 +1,111 @@
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Heap traffic of the whole process
+    std::atomic<std::uint64_t> allocationCount{0};
+    std::atomic<std::uint64_t> allocationBytes{0};
+
+    void* countedAllocate(std::size_t size)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocationBytes.fetch_add(size, std::memory_order_relaxed);
+        if (void* p = std::malloc(size == 0 ? 1 : size))
+        {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* countedAllocate(std::size_t size, std::align_val_t alignment)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocationBytes.fetch_add(size, std::memory_order_relaxed);
+        std::size_t align = static_cast<std::size_t>(alignment);
+        // aligned_alloc wants the size to be a multiple of the alignment
+        std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+        if (void* p = std::aligned_alloc(align, rounded))
+        {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+std::uint64_t heapAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+std::uint64_t heapAllocationBytes()
+{
+    return allocationBytes.load(std::memory_order_relaxed);
+}
+
+// Allocation counting: every form of global new ends in countedAllocate
+
+void* operator new(std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return countedAllocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return countedAllocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return countedAllocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
@@ -0,0 +1,18 @@
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+#include <cstdint>
+
+/**
+ * @brief Process-wide heap allocation counter shared by the tests and the benchmarks
+ *
+ * AllocationCounter.cpp replaces every form of global operator new (plain and
+ * over-aligned) and delete, so an executable counts its heap traffic by
+ * listing that file among its sources; the pricing library itself never does.
+ * Read the counters before and after the code under test and take the
+ * difference.
+ */
+std::uint64_t heapAllocationCount();   // Allocations since process start
+std::uint64_t heapAllocationBytes();   // Bytes requested by those allocations
+
+#endif // ALLOCATIONCOUNTER_HPP
@@ -0,0 +1,372 @@
+#include "BenchmarkHarness.hpp"
+#include "AllocationCounter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    std::int64_t nowNanoseconds()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::deque<Benchmark>& registry()
+    {
+        static std::deque<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    std::vector<std::pair<std::string, std::string>>& contextEntries()
+    {
+        static std::vector<std::pair<std::string, std::string>> entries;
+        return entries;
+    }
+
+    struct RunOptions
+    {
+        std::string filter;
+        double minTime = 0.5;
+        std::string jsonPath;
+        bool list = false;
+    };
+
+    // One reported entry: a benchmark run with one argument set
+    struct RunResult
+    {
+        std::string name;
+        std::string label;
+        std::uint64_t iterations = 0;
+        double nanosecondsPerIteration = 0.0;
+        double itemsPerSecond = 0.0;
+        double allocationsPerIteration = 0.0;
+        double bytesPerIteration = 0.0;
+    };
+
+    std::string entryName(const Benchmark& benchmark, const std::vector<std::int64_t>& args)
+    {
+        std::string name = benchmark.name();
+        for (std::int64_t value : args)
+        {
+            name += "/" + std::to_string(value);
+        }
+        return name;
+    }
+
+    std::string jsonEscape(const std::string& text)
+    {
+        std::string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    bool optimisedBuild()
+    {
+#if defined(__OPTIMIZE__) && defined(NDEBUG)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /*
+        Run with growing iteration counts until the timed loop lasts at least
+        minTime, the way Google Benchmark calibrates: aim 40 % past the target
+        from the last measurement, growing at most tenfold while it is too
+        short to extrapolate from.
+    */
+    RunResult runEntry(const Benchmark& benchmark, const std::vector<std::int64_t>& args, double minTime)
+    {
+        constexpr std::uint64_t MaxIterations = 1000000000;
+
+        std::uint64_t iterations = 1;
+        for (;;)
+        {
+            BenchmarkState state(args, iterations);
+            benchmark.function()(state);
+
+            double seconds = state.elapsedSeconds();
+            if (seconds >= minTime || iterations >= MaxIterations)
+            {
+                RunResult result;
+                result.name = entryName(benchmark, args);
+                result.label = state.label();
+                result.iterations = iterations;
+                result.nanosecondsPerIteration = seconds * 1e9 / static_cast<double>(iterations);
+                result.itemsPerSecond = seconds > 0.0 ? static_cast<double>(state.itemsProcessed()) / seconds : 0.0;
+                result.allocationsPerIteration = static_cast<double>(state.allocations()) / static_cast<double>(iterations);
+                result.bytesPerIteration = static_cast<double>(state.allocatedBytes()) / static_cast<double>(iterations);
+                return result;
+            }
+
+            double multiplier = seconds > 0.1 * minTime ? 1.4 * minTime / seconds : 10.0;
+            double next = std::min(static_cast<double>(iterations) * multiplier, static_cast<double>(MaxIterations));
+            iterations = std::max(static_cast<std::uint64_t>(next), iterations + 1);
+        }
+    }
+
+    std::string formatRate(double itemsPerSecond)
+    {
+        if (itemsPerSecond <= 0.0)
+        {
+            return "";
+        }
+        const char* suffixes[] = {"", "k", "M", "G"};
+        int index = 0;
+        while (itemsPerSecond >= 1000.0 && index < 3)
+        {
+            itemsPerSecond /= 1000.0;
+            ++index;
+        }
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2) << itemsPerSecond << suffixes[index] << "/s";
+        return text.str();
+    }
+
+    void printHeader()
+    {
+        std::cout << std::left << std::setw(44) << "Benchmark" << std::right
+                  << std::setw(16) << "Time (ns)" << std::setw(14) << "Iterations"
+                  << std::setw(14) << "Items" << std::setw(12) << "Allocs"
+                  << std::setw(14) << "Bytes" << "\n"
+                  << std::string(114, '-') << std::endl;
+    }
+
+    void printResult(const RunResult& result)
+    {
+        std::cout << std::left << std::setw(44) << result.name << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(16) << result.nanosecondsPerIteration
+                  << std::setw(14) << result.iterations
+                  << std::setw(14) << formatRate(result.itemsPerSecond)
+                  << std::setprecision(2)
+                  << std::setw(12) << result.allocationsPerIteration
+                  << std::setw(14) << std::setprecision(0) << result.bytesPerIteration;
+        if (!result.label.empty())
+        {
+            std::cout << "  " << result.label;
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+
+    // Layout follows Google Benchmark's --benchmark_format=json so existing comparison scripts apply
+    void writeJson(const std::string& path, const std::vector<RunResult>& results)
+    {
+        std::ofstream file(path);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open benchmark output file: " + path);
+        }
+
+        std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        file << std::setprecision(10);
+        file << "{\n  \"context\": {\n"
+             << "    \"date\": \"" << date << "\",\n"
+             << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+             << "    \"library_build_type\": \"" << (optimisedBuild() ? "release" : "debug") << "\"";
+        for (const auto& [key, value] : contextEntries())
+        {
+            file << ",\n    \"" << jsonEscape(key) << "\": \"" << jsonEscape(value) << "\"";
+        }
+        file << "\n  },\n  \"benchmarks\": [";
+
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const RunResult& result = results[i];
+            file << (i == 0 ? "\n" : ",\n")
+                 << "    {\n"
+                 << "      \"name\": \"" << jsonEscape(result.name) << "\",\n"
+                 << "      \"iterations\": " << result.iterations << ",\n"
+                 << "      \"real_time\": " << result.nanosecondsPerIteration << ",\n"
+                 << "      \"time_unit\": \"ns\",\n"
+                 << "      \"items_per_second\": " << result.itemsPerSecond << ",\n"
+                 << "      \"allocations_per_iteration\": " << result.allocationsPerIteration << ",\n"
+                 << "      \"bytes_per_iteration\": " << result.bytesPerIteration;
+            if (!result.label.empty())
+            {
+                file << ",\n      \"label\": \"" << jsonEscape(result.label) << "\"";
+            }
+            file << "\n    }";
+        }
+        file << "\n  ]\n}\n";
+    }
+
+    RunOptions parseOptions(int argc, char** argv)
+    {
+        RunOptions options;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string argument = argv[i];
+            if (argument.rfind("--filter=", 0) == 0)
+            {
+                options.filter = argument.substr(9);
+            }
+            else if (argument.rfind("--min-time=", 0) == 0)
+            {
+                options.minTime = std::stod(argument.substr(11));
+            }
+            else if (argument.rfind("--json=", 0) == 0)
+            {
+                options.jsonPath = argument.substr(7);
+            }
+            else if (argument == "--list")
+            {
+                options.list = true;
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option: " + argument);
+            }
+        }
+        return options;
+    }
+}
+
+BenchmarkState::BenchmarkState(std::vector<std::int64_t> args, std::uint64_t iterations)
+    : args_(std::move(args)), iterations_(iterations)
+{
+}
+
+BenchmarkState::Iterator BenchmarkState::begin()
+{
+    startAllocations_ = heapAllocationCount();
+    startBytes_ = heapAllocationBytes();
+    clobberMemory();
+    startNanoseconds_ = nowNanoseconds();
+    return Iterator(this, iterations_);
+}
+
+void BenchmarkState::stopTiming()
+{
+    clobberMemory();
+    elapsedSeconds_ = static_cast<double>(nowNanoseconds() - startNanoseconds_) * 1e-9;
+    allocations_ = heapAllocationCount() - startAllocations_;
+    allocatedBytes_ = heapAllocationBytes() - startBytes_;
+}
+
+Benchmark::Benchmark(std::string name, BenchmarkFunction function)
+    : name_(std::move(name)), function_(std::move(function))
+{
+}
+
+Benchmark& Benchmark::arg(std::int64_t value)
+{
+    argumentSets_.push_back({value});
+    return *this;
+}
+
+Benchmark& Benchmark::args(std::initializer_list<std::int64_t> values)
+{
+    argumentSets_.emplace_back(values);
+    return *this;
+}
+
+Benchmark& Benchmark::range(std::int64_t start, std::int64_t limit, std::int64_t multiplier)
+{
+    if (start <= 0 || multiplier < 2)
+    {
+        throw std::invalid_argument("Benchmark range needs a positive start and a multiplier of at least 2.");
+    }
+    for (std::int64_t value = start; value <= limit; value *= multiplier)
+    {
+        argumentSets_.push_back({value});
+    }
+    return *this;
+}
+
+Benchmark& registerBenchmark(std::string name, BenchmarkFunction function)
+{
+    return registry().emplace_back(std::move(name), std::move(function));
+}
+
+void addBenchmarkContext(std::string key, std::string value)
+{
+    contextEntries().emplace_back(std::move(key), std::move(value));
+}
+
+int runBenchmarks(int argc, char** argv)
+{
+    RunOptions options;
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\nUsage: " << argv[0]
+                  << " [--filter=<substring>] [--min-time=<seconds>] [--json=<file>] [--list]" << std::endl;
+        return 2;
+    }
+
+    // Entries without arguments run once with an empty argument set
+    std::vector<std::pair<const Benchmark*, std::vector<std::int64_t>>> selected;
+    for (const Benchmark& benchmark : registry())
+    {
+        std::vector<std::vector<std::int64_t>> argumentSets = benchmark.argumentSets();
+        if (argumentSets.empty())
+        {
+            argumentSets.emplace_back();
+        }
+        for (const auto& args : argumentSets)
+        {
+            if (entryName(benchmark, args).find(options.filter) != std::string::npos)
+            {
+                selected.emplace_back(&benchmark, args);
+            }
+        }
+    }
+
+    if (options.list)
+    {
+        for (const auto& [benchmark, args] : selected)
+        {
+            std::cout << entryName(*benchmark, args) << std::endl;
+        }
+        return 0;
+    }
+
+    if (!optimisedBuild())
+    {
+        std::cout << "***WARNING*** Benchmarks built without optimisation or with assertions enabled; "
+                  << "configure with -DCMAKE_BUILD_TYPE=Release for representative timings." << std::endl;
+    }
+    for (const auto& [key, value] : contextEntries())
+    {
+        std::cout << key << ": " << value << std::endl;
+    }
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n" << std::endl;
+
+    printHeader();
+    std::vector<RunResult> results;
+    for (const auto& [benchmark, args] : selected)
+    {
+        results.push_back(runEntry(*benchmark, args, options.minTime));
+        printResult(results.back());
+    }
+
+    if (!options.jsonPath.empty())
+    {
+        writeJson(options.jsonPath, results);
+        std::cout << "\nResults written to " << options.jsonPath << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+#ifndef BENCHMARKHARNESS_HPP
+#define BENCHMARKHARNESS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Per-run state handed to a benchmark body
+ *
+ * Follows the Google Benchmark shape: everything before the range-for is setup
+ * and is not timed, the loop body runs iterations() times under the timer.
+ *
+ *     void BM_Example(BenchmarkState& state)
+ *     {
+ *         auto data = makeData(state.arg(0));
+ *         for (auto _ : state)
+ *         {
+ *             doNotOptimize(work(data));
+ *         }
+ *         state.setItemsProcessed(state.iterations() * data.size());
+ *     }
+ *
+ * Heap allocations made while the timer runs are counted through the
+ * replaced global operator new of the benchmark executable.
+ */
+class BenchmarkState
+{
+public:
+
+    // Value of the range-for loop; carries no data. The user-provided
+    // destructor keeps "for (auto _ : state)" free of unused-variable warnings.
+    struct Value
+    {
+        ~Value() {};
+    };
+
+    class Iterator
+    {
+    public:
+        Iterator(BenchmarkState* state, std::uint64_t remaining) : state_(state), remaining_(remaining) {};
+
+        Value operator * () const { return Value(); };
+        Iterator& operator ++ () { --remaining_; return *this; };
+        bool operator != (const Iterator&)
+        {
+            if (remaining_ != 0)
+            {
+                return true;
+            }
+            state_->stopTiming();
+            return false;
+        };
+
+    private:
+        BenchmarkState* state_;
+        std::uint64_t remaining_;
+    };
+
+    BenchmarkState(std::vector<std::int64_t> args, std::uint64_t iterations);
+
+    Iterator begin();
+    Iterator end() { return Iterator(this, 0); };
+
+    std::int64_t arg(std::size_t index) const { return args_.at(index); };
+    std::uint64_t iterations() const { return iterations_; };
+
+    // Items (options, paths, ...) handled over all iterations; reported as items per second
+    void setItemsProcessed(std::uint64_t items) { itemsProcessed_ = items; };
+    void setLabel(std::string label) { label_ = std::move(label); };
+
+    // Results of the finished run
+    double elapsedSeconds() const { return elapsedSeconds_; };
+    std::uint64_t allocations() const { return allocations_; };
+    std::uint64_t allocatedBytes() const { return allocatedBytes_; };
+    std::uint64_t itemsProcessed() const { return itemsProcessed_; };
+    const std::string& label() const { return label_; };
+
+private:
+
+    void stopTiming();
+
+    std::vector<std::int64_t> args_;
+    std::uint64_t iterations_;
+    std::int64_t startNanoseconds_ = 0;
+    std::uint64_t startAllocations_ = 0;
+    std::uint64_t startBytes_ = 0;
+
+    double elapsedSeconds_ = 0.0;
+    std::uint64_t allocations_ = 0;
+    std::uint64_t allocatedBytes_ = 0;
+    std::uint64_t itemsProcessed_ = 0;
+    std::string label_;
+};
+
+using BenchmarkFunction = std::function<void(BenchmarkState&)>;
+
+/**
+ * @brief A registered benchmark and the argument sets it runs with
+ *
+ * Every argument set is one reported entry, named "<name>/<arg0>/<arg1>...".
+ */
+class Benchmark
+{
+public:
+    Benchmark(std::string name, BenchmarkFunction function);
+
+    Benchmark& arg(std::int64_t value);                             // One argument set {value}
+    Benchmark& args(std::initializer_list<std::int64_t> values);    // One argument set
+    Benchmark& range(std::int64_t start, std::int64_t limit, std::int64_t multiplier = 10); // start, start*m, ... <= limit
+
+    const std::string& name() const { return name_; };
+    const BenchmarkFunction& function() const { return function_; };
+    const std::vector<std::vector<std::int64_t>>& argumentSets() const { return argumentSets_; };
+
+private:
+    std::string name_;
+    BenchmarkFunction function_;
+    std::vector<std::vector<std::int64_t>> argumentSets_;
+};
+
+// Add a benchmark to the global registry; the reference stays valid for the program's lifetime
+Benchmark& registerBenchmark(std::string name, BenchmarkFunction function);
+
+#define OPTION_PRICER_BENCHMARK(function) \
+    static Benchmark& function##_registration = registerBenchmark(#function, function)
+
+// Extra key/value pair for the "context" section of the report (e.g. the SIMD level in use)
+void addBenchmarkContext(std::string key, std::string value);
+
+/**
+ * @brief Run the registered benchmarks selected on the command line
+ *
+ * Options:
+ *   --filter=<substring>   Run entries whose name contains the substring
+ *   --min-time=<seconds>   Minimum timed duration per entry (default 0.5)
+ *   --json=<file>          Also write the results as JSON
+ *   --list                 Print the entry names and exit
+ *
+ * @return Process exit code
+ */
+int runBenchmarks(int argc, char** argv);
+
+// Keep a value alive so the computation producing it is not optimised away
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "m"(value) : "memory");
+}
+
+// Force pending stores to memory before the timer is read
+inline void clobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+#endif // BENCHMARKHARNESS_HPP
@@ -0,0 +1,725 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/math/distributions/normal.hpp>
+
+#include "BatchValidation.hpp"
+#include "BenchmarkHarness.hpp"
+#include "BlackScholesKernels.hpp"
+#include "BlackScholesPricer.hpp"
+#include "FDMPricer.hpp"
+#include "FiniteDifferenceGreeks.hpp"
+#include "Grid.hpp"
+#include "MeshUtils.hpp"
+#include "LatticePricer.hpp"
+#include "MonteCarloPricer.hpp"
+#include "NormalDistribution.hpp"
+#include "Option.hpp"
+#include "OptionBatch.hpp"
+#include "OptionBook.hpp"
+#include "OptionContext.hpp"
+#include "OptionFile.hpp"
+#include "ParameterGrid.hpp"
+#include "StaticOptionContext.hpp"
+#include "PricingCache.hpp"
+#include "PricingMetrics.hpp"
+#include "PutCallParityValidator.hpp"
+#include "ScenarioEngine.hpp"
+#include "VolSurface.hpp"
+
+/*
+    Benchmarks of the pricing library.
+
+    Micro benchmarks time one call on a rotating set of 1024 contracts so the
+    branch predictor cannot learn a single input; vector/batch/matrix entries
+    time a whole call and report options per second. Allocation columns count
+    heap allocations made inside the timed loop, so a zero there is a checked
+    property of the span/out-parameter paths.
+*/
+
+namespace
+{
+    constexpr std::size_t RotatingSetSize = 1024;
+
+    // Deterministic spread of contracts around the money: spot, strike, expiry and volatility all vary
+    std::vector<Option> makeOptions(std::size_t count)
+    {
+        std::vector<Option> options;
+        options.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double u = static_cast<double>(i % 997) / 997.0;
+            double v = static_cast<double>(i % 101) / 101.0;
+            double T = 0.1 + 2.0 * v;
+            double K = 80.0 + 40.0 * u;
+            double sig = 0.1 + 0.4 * static_cast<double>(i % 13) / 13.0;
+            options.emplace_back(T, K, sig, 0.03, 100.0, 0.01);
+        }
+        return options;
+    }
+
+    std::uint64_t itemCount(const BenchmarkState& state, std::size_t perIteration)
+    {
+        return state.iterations() * static_cast<std::uint64_t>(perIteration);
+    }
+
+    // Normal CDF: arg 0 selects Boost (0), Accurate (1) or Fast (2)
+
+    void BM_NormalCdf(BenchmarkState& state)
+    {
+        std::vector<double> x(RotatingSetSize);
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {
+            x[i] = -6.0 + 12.0 * static_cast<double>(i) / static_cast<double>(x.size());
+        }
+        boost::math::normal_distribution<> standardNormal(0.0, 1.0);
+        NormalCdfMode mode = static_cast<NormalCdfMode>(state.arg(0));
+
+        for (auto _ : state)
+        {
+            double sum = 0.0;
+            for (double value : x)
+            {
+                switch (mode)
+                {
+                    case NormalCdfMode::Boost: sum += boost::math::cdf(standardNormal, value); break;
+                    case NormalCdfMode::Accurate: sum += normalCdfAccurate(value); break;
+                    case NormalCdfMode::Fast: sum += normalCdfFast(value); break;
+                }
+            }
+            doNotOptimize(sum);
+        }
+        state.setItemsProcessed(itemCount(state, x.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_NormalCdf).arg(static_cast<std::int64_t>(NormalCdfMode::Boost))
+                                          .arg(static_cast<std::int64_t>(NormalCdfMode::Accurate))
+                                          .arg(static_cast<std::int64_t>(NormalCdfMode::Fast));
+
+    // Single option pricing through the context (virtual dispatch included)
+
+    void BM_CallPrice(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::vector<Option> options = makeOptions(RotatingSetSize);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateCallPrice(options[i]));
+            i = (i + 1) % options.size();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallPrice);
+
+    // Same call with a PricingMetrics attached: the cost of switching instrumentation on
+    void BM_CallPriceMetrics(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        context.setMetrics(std::make_shared<PricingMetrics>());
+        std::vector<Option> options = makeOptions(RotatingSetSize);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateCallPrice(options[i]));
+            i = (i + 1) % options.size();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallPriceMetrics);
+
+    // arg(0): cache capacity; below RotatingSetSize every lookup misses and evicts
+    void BM_CallPriceCached(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        context.setCache(std::make_shared<PricingCache>(static_cast<std::size_t>(state.arg(0))));
+        std::vector<Option> options = makeOptions(RotatingSetSize);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateCallPrice(options[i]));
+            i = (i + 1) % options.size();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallPriceCached).arg(64).arg(4096);
+
+    // Compile-time strategy: direct call into BlackScholesPricer, then the fully inlined template formula
+    void BM_StaticCallPrice(BenchmarkState& state)
+    {
+        StaticOptionContext<BlackScholesPricer> context;
+        std::vector<Option> options = makeOptions(RotatingSetSize);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateCallPrice(options[i]));
+            i = (i + 1) % options.size();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_StaticCallPrice);
+
+    void BM_StaticCallPriceTemplate(BenchmarkState& state)
+    {
+        StaticOptionContext<BlackScholesPricer> context;
+        std::vector<Option> options = makeOptions(RotatingSetSize);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(context.price<OptionType::Call, CarryModel::Stock>(options[i]));
+            i = (i + 1) % options.size();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_StaticCallPriceTemplate);
+
+    // d1/d2 and one N() call: the cheapest Greek, standing in for the private calculateD1D2
+    void BM_CallDelta(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::vector<Option> options = makeOptions(RotatingSetSize);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateCallDelta(options[i]));
+            i = (i + 1) % options.size();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallDelta);
+
+    void BM_Greeks(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::vector<Option> options = makeOptions(RotatingSetSize);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateGreeks(options[i]));
+            i = (i + 1) % options.size();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_Greeks);
+
+    void BM_ParityValidation(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        context.setParityValidator(std::make_unique<PutCallParityValidator>());
+        std::vector<Option> options = makeOptions(RotatingSetSize);
+        std::size_t i = 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(context.verifyParity(options[i]));
+            i = (i + 1) % options.size();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_ParityValidation);
+
+    // Vector and batch pricing: arg 0 is the number of options
+
+    void BM_CallVector(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateCallVector(options));
+        }
+        state.setItemsProcessed(itemCount(state, options.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallVector).range(1000, 10000000);
+
+    void BM_CallVectorSpan(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        std::vector<double> out(options.size());
+        for (auto _ : state)
+        {
+            context.calculateCallVector(options, out);
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, options.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallVectorSpan).range(1000, 100000);
+
+    void BM_CallBatch(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        OptionBatch batch(options);
+        std::vector<double> out(batch.size());
+        for (auto _ : state)
+        {
+            context.calculateCallBatch(batch, out);
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallBatch).range(1000, 10000000);
+
+    void BM_ValidateBatch(BenchmarkState& state)
+    {
+        OptionBatch batch(makeOptions(static_cast<std::size_t>(state.arg(0))));
+        for (auto _ : state)
+        {
+            doNotOptimize(BatchValidation(batch));
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_ValidateBatch).range(1000, 1000000);
+
+    // arg(1): 0 = unchecked, 1 = NaN mode on clean rows, 2 = NaN mode with every 1000th row invalid
+    void BM_CallBatchValidated(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        OptionBatch batch(makeOptions(static_cast<std::size_t>(state.arg(0))));
+        if (state.arg(1) != 0)
+        {
+            context.setValidationMode(ValidationMode::NaN);
+        }
+        if (state.arg(1) == 2)
+        {
+            for (std::size_t i = 0; i < batch.size(); i += 1000)
+            {
+                batch.Volatilities()[i] = -1.0;
+            }
+        }
+        std::vector<double> out(batch.size());
+        for (auto _ : state)
+        {
+            context.calculateCallBatch(batch, out);
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallBatchValidated).args({100000, 0}).args({100000, 1}).args({100000, 2});
+
+    void BM_GreeksVector(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateGreeksVector(options));
+        }
+        state.setItemsProcessed(itemCount(state, options.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_GreeksVector).range(1000, 100000);
+
+    void BM_ParityBatch(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        PutCallParityValidator validator;
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        OptionBatch batch(options);
+        std::vector<double> calls(batch.size()), puts(batch.size());
+        for (auto _ : state)
+        {
+            context.calculateCallBatch(batch, calls);
+            context.calculatePutBatch(batch, puts);
+            bool holds = true;
+            for (std::size_t i = 0; i < options.size(); ++i)
+            {
+                holds &= validator.validateParity(options[i], calls[i], puts[i]);
+            }
+            doNotOptimize(holds);
+        }
+        state.setItemsProcessed(itemCount(state, options.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_ParityBatch).range(1000, 100000);
+
+    // Parity audit of prices already computed for the book; arg 1: 0 = row by row, 1 = vectorised
+    void BM_ParityAudit(BenchmarkState& state)
+    {
+        PutCallParityValidator validator;
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        OptionBatch batch(makeOptions(static_cast<std::size_t>(state.arg(0))));
+        std::vector<double> calls = context.calculateCallBatch(batch);
+        std::vector<double> puts = context.calculatePutBatch(batch);
+        bool vectorised = state.arg(1) != 0;
+        for (auto _ : state)
+        {
+            doNotOptimize(vectorised ? validator.auditParity(batch, calls, puts)
+                                     : validator.IParityValidator::auditParity(batch, calls, puts));
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_ParityAudit).args({100000, 0}).args({100000, 1});
+
+    // Volga of a book; arg 1: 0 = three bumped call batches (sigma -h, 0, +h), 1 = analytic Greek kernel
+    void BM_VolgaBatch(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        OptionBatch batch(makeOptions(static_cast<std::size_t>(state.arg(0))));
+        bool analytic = state.arg(1) != 0;
+        const double h = 1e-4;
+        OptionBatch down = batch, up = batch;
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            down.Volatilities()[i] -= h;
+            up.Volatilities()[i] += h;
+        }
+        std::vector<double> out(batch.size()), low(batch.size()), high(batch.size());
+        for (auto _ : state)
+        {
+            if (analytic)
+            {
+                context.calculateGreekBatch(Greek::Volga, batch, out);
+            }
+            else
+            {
+                context.calculateCallBatch(down, low);
+                context.calculateCallBatch(batch, out);
+                context.calculateCallBatch(up, high);
+                for (std::size_t i = 0; i < out.size(); ++i)
+                {
+                    out[i] = (high[i] - 2.0 * out[i] + low[i]) / (h * h);
+                }
+            }
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_VolgaBatch).args({100000, 0}).args({100000, 1});
+
+    // Bumped Greeks around Black-Scholes; arg 1: 0 = one contract's variants per call, 1 = whole blocks per call
+    void BM_FiniteDifferenceGreeks(BenchmarkState& state)
+    {
+        FiniteDifferenceGreeks pricer(std::make_unique<BlackScholesPricer>());
+        OptionBatch batch(makeOptions(static_cast<std::size_t>(state.arg(0))));
+        bool batched = state.arg(1) != 0;
+        GreeksBatch greeks(batch.size());
+        for (auto _ : state)
+        {
+            if (batched)
+            {
+                pricer.calculateGreeksBatch(batch, greeks);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < batch.size(); ++i)
+                {
+                    greeks.set(i, pricer.calculateGreeks(batch.at(i)));
+                }
+            }
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_FiniteDifferenceGreeks).args({10000, 0}).args({10000, 1});
+
+    // Sensitivities to all six inputs, one contract at a time; arg 1: 0 = price only (reference),
+    // 1 = adjoint mode (one forward pass and one reverse sweep), 2 = central bumps of each input (12 prices)
+    void BM_AdjointGreeks(BenchmarkState& state)
+    {
+        BlackScholesPricer pricer;
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        std::int64_t mode = state.arg(1);
+        const double h = 1e-5;
+        std::vector<AdjointResult> out(options.size());
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < options.size(); ++i)
+            {
+                const Option& option = options[i];
+                if (mode == 0)
+                {
+                    out[i].price = pricer.calculateCallPrice(option);
+                }
+                else if (mode == 1)
+                {
+                    out[i] = pricer.calculateAdjoint(option, OptionType::Call);
+                }
+                else
+                {
+                    double inputs[6] = {option.ExerciseDate(), option.StrikePrice(), option.Volatility(),
+                                        option.RiskFreeRate(), option.AssetPrice(), option.CostOfCarry()};
+                    double partials[6];
+                    for (int k = 0; k < 6; ++k)
+                    {
+                        double up[6], down[6];
+                        std::copy(inputs, inputs + 6, up);
+                        std::copy(inputs, inputs + 6, down);
+                        up[k] += h;
+                        down[k] -= h;
+                        partials[k] = (pricer.calculateCallPrice(Option(up[0], up[1], up[2], up[3], up[4], up[5]))
+                                       - pricer.calculateCallPrice(Option(down[0], down[1], down[2], down[3], down[4], down[5])))
+                                      / (2.0 * h);
+                    }
+                    out[i] = {pricer.calculateCallPrice(option), partials[0], partials[1], partials[2],
+                              partials[3], partials[4], partials[5]};
+                }
+            }
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, options.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_AdjointGreeks).args({10000, 0}).args({10000, 1}).args({10000, 2});
+
+    // Re-price a chain after a surface refresh; arg 1: 0 = look up each vol and rebuild the Options,
+    // 1 = context surface mode on the unchanged batch
+    void BM_VolSurfaceRepricing(BenchmarkState& state)
+    {
+        Grid<double> vols(meshArray(0.1, 3.0, 0.1), meshArray(50.0, 150.0, 2.5), 0.2);
+        auto surface = std::make_shared<VolSurface>(vols, VolInterpolation::CubicSpline);
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        OptionBatch batch(options);
+        bool surfaceMode = state.arg(1) != 0;
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        if (surfaceMode)
+        {
+            context.setVolSurface(surface);
+        }
+        std::vector<double> out(options.size());
+        for (auto _ : state)
+        {
+            if (surfaceMode)
+            {
+                context.calculateCallBatch(batch, out);
+            }
+            else
+            {
+                for (Option& option : options)
+                {
+                    option.Volatility(surface->volatility(option.ExerciseDate(), option.StrikePrice()));
+                }
+                context.calculateCallVector(std::span<const Option>(options), out);
+            }
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, options.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_VolSurfaceRepricing).args({100000, 0}).args({100000, 1});
+
+    // Stress test: arg 0 contracts, arg 1 0 = rebuild through the context, 1 = factorised engine.
+    // 45 scenarios: 9 spot shocks x 5 volatility shifts; items are scenario x contract prices.
+    void BM_ScenarioEngine(BenchmarkState& state)
+    {
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        std::vector<OptionType> types(options.size());
+        for (std::size_t i = 0; i < types.size(); ++i)
+        {
+            types[i] = i % 2 == 0 ? OptionType::Call : OptionType::Put;
+        }
+        std::vector<double> quantities(options.size(), 1.0);
+        ScenarioEngine engine(options, types, quantities);
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        const double spots[] = {-0.2, -0.15, -0.1, -0.05, 0.0, 0.05, 0.1, 0.15, 0.2};
+        const double vols[] = {-0.05, -0.02, 0.0, 0.02, 0.05};
+        const double rates[] = {0.0};
+        std::vector<Scenario> scenarios = scenarioGrid(spots, vols, rates);
+        bool factorised = state.arg(1) != 0;
+        Grid<double> pnl;
+        for (auto _ : state)
+        {
+            if (factorised)
+            {
+                engine.run(scenarios, pnl);
+            }
+            else
+            {
+                pnl = engine.runWithContext(context, scenarios);
+            }
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, scenarios.size() * options.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_ScenarioEngine).args({10000, 0}).args({10000, 1});
+
+    // Matrix pricing: arg 0 is the side of a square expiry x spot grid
+
+    void BM_CallMatrix(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::size_t side = static_cast<std::size_t>(state.arg(0));
+        Grid<Option> optionGrid(side, side, Option(1.0, 100.0, 0.2, 0.03, 100.0));
+        for (std::size_t row = 0; row < side; ++row)
+        {
+            for (std::size_t col = 0; col < side; ++col)
+            {
+                optionGrid(row, col) = Option(0.1 + 0.01 * static_cast<double>(row), 100.0, 0.2, 0.03,
+                                              50.0 + 0.1 * static_cast<double>(col));
+            }
+        }
+        Grid<double> out(side, side);
+        for (auto _ : state)
+        {
+            context.calculateCallMatrix(optionGrid, out);
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, side * side));
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallMatrix).range(32, 2048, 4);
+
+    void BM_CallSweep(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::size_t side = static_cast<std::size_t>(state.arg(0));
+        ParameterGrid grid(Option(1.0, 100.0, 0.2, 0.03, 100.0));
+        std::vector<double> expiries(side), spots(side);
+        for (std::size_t i = 0; i < side; ++i)
+        {
+            expiries[i] = 0.1 + 0.01 * static_cast<double>(i);
+            spots[i] = 50.0 + 0.1 * static_cast<double>(i);
+        }
+        grid.addAxis(OptionParameter::ExerciseDate, expiries).addAxis(OptionParameter::AssetPrice, spots);
+        std::vector<double> out(side * side);
+        for (auto _ : state)
+        {
+            context.calculateCallSweep(grid, out);
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, out.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallSweep).range(32, 2048, 4);
+
+    // Thread scaling: arg 0 options, arg 1 worker threads (1 runs on the calling thread)
+
+    void BM_CallVectorThreads(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        context.setThreadCount(static_cast<std::size_t>(state.arg(1)));
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateCallVector(options));
+        }
+        state.setItemsProcessed(itemCount(state, options.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallVectorThreads).args({1000000, 1}).args({1000000, 2})
+                                                  .args({1000000, 4}).args({1000000, 8});
+
+    void BM_CallBatchThreads(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        context.setThreadCount(static_cast<std::size_t>(state.arg(1)));
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        OptionBatch batch(options);
+        std::vector<double> out(batch.size());
+        for (auto _ : state)
+        {
+            context.calculateCallBatch(batch, out);
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_CallBatchThreads).args({1000000, 1}).args({1000000, 2})
+                                                 .args({1000000, 4}).args({1000000, 8});
+
+    // Implied volatility: arg 0 quotes, inverted with the vectorised kernel
+
+    // Persistent book of arg(0) contracts on 100 underlyings (spot 100 each): one
+    // spot tick reprices the 1 % on one underlying
+    void BM_BookSpotTick(BenchmarkState& state)
+    {
+        OptionBook book;
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        for (std::size_t i = 0; i < options.size(); ++i)
+        {
+            book.addPosition("U" + std::to_string(i % 100), options[i], i % 2 == 0 ? OptionType::Call : OptionType::Put, 1.0);
+        }
+        double spot = 100.0;
+        for (auto _ : state)
+        {
+            spot = spot == 100.0 ? 100.5 : 100.0;
+            doNotOptimize(book.updateSpot("U7", spot));
+        }
+        state.setItemsProcessed(itemCount(state, options.size() / 100));
+    }
+    OPTION_PRICER_BENCHMARK(BM_BookSpotTick).arg(100000);
+
+    void BM_PriceOptionFile(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        OptionBatch batch(makeOptions(static_cast<std::size_t>(state.arg(0))));
+        boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+        boost::filesystem::create_directories(directory);
+        std::string input = (directory / "options.optbatch").string();
+        std::string output = (directory / "results.optresult").string();
+        MappedOptionFile::write(input, batch);
+        const BatchQuantity quantities[] = {BatchQuantity::CallPrice, BatchQuantity::CallDelta};
+        for (auto _ : state)
+        {
+            doNotOptimize(priceOptionFile(context, input, output, quantities));
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+        boost::filesystem::remove_all(directory);
+    }
+    OPTION_PRICER_BENCHMARK(BM_PriceOptionFile).arg(1000000);
+
+    void BM_ImpliedVolBatch(BenchmarkState& state)
+    {
+        OptionContext context(std::make_unique<BlackScholesPricer>());
+        std::vector<Option> options = makeOptions(static_cast<std::size_t>(state.arg(0)));
+        OptionBatch batch(options);
+        std::vector<double> quotes = context.calculateCallBatch(batch);
+        std::vector<ImpliedVolResult> out(batch.size());
+        for (auto _ : state)
+        {
+            context.calculateImpliedVolatilityBatch(batch, quotes, OptionType::Call, ImpliedVolSettings{}, out);
+            clobberMemory();
+        }
+        state.setItemsProcessed(itemCount(state, batch.size()));
+    }
+    OPTION_PRICER_BENCHMARK(BM_ImpliedVolBatch).range(1000, 100000);
+
+    // Macro benchmarks of the numerical strategies: one American put / European call per iteration
+
+    void BM_MonteCarloCall(BenchmarkState& state)
+    {
+        MonteCarloSettings settings;
+        settings.paths = static_cast<std::size_t>(state.arg(0));
+        OptionContext context(std::make_unique<MonteCarloPricer>(settings));
+        Option option(1.0, 100.0, 0.2, 0.03, 100.0);
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculateCallPrice(option));
+        }
+        state.setItemsProcessed(itemCount(state, settings.paths));
+        state.setLabel("items = paths");
+    }
+    OPTION_PRICER_BENCHMARK(BM_MonteCarloCall).arg(100000);
+
+    void BM_LatticeAmericanPut(BenchmarkState& state)
+    {
+        LatticeSettings settings;
+        settings.steps = static_cast<std::size_t>(state.arg(0));
+        OptionContext context(std::make_unique<LatticePricer>(settings));
+        Option option(1.0, 100.0, 0.2, 0.03, 100.0);
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculatePutPrice(option));
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_LatticeAmericanPut).arg(200).arg(1000);
+
+    void BM_FDMAmericanPut(BenchmarkState& state)
+    {
+        FDMSettings settings;
+        settings.spotSteps = static_cast<std::size_t>(state.arg(0));
+        settings.timeSteps = settings.spotSteps / 2;
+        settings.exercise = ExerciseStyle::American;
+        OptionContext context(std::make_unique<FDMPricer>(settings));
+        Option option(1.0, 100.0, 0.2, 0.03, 100.0);
+        for (auto _ : state)
+        {
+            doNotOptimize(context.calculatePutPrice(option));
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    OPTION_PRICER_BENCHMARK(BM_FDMAmericanPut).arg(400).arg(1600);
+}
+
+int main(int argc, char** argv)
+{
+    addBenchmarkContext("simd_level", simdLevelName(detectSimdLevel()));
+    return runBenchmarks(argc, argv);
+}
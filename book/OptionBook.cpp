@@ -0,0 +1,281 @@
+#include "OptionBook.hpp"
+#include "BlackScholesFormula.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    double cdf(NormalCdfMode mode, double x)
+    {
+        switch (mode)
+        {
+            case NormalCdfMode::Boost:
+                return normalCdf<NormalCdfMode::Boost>(x);
+            case NormalCdfMode::Fast:
+                return normalCdf<NormalCdfMode::Fast>(x);
+            default:
+                return normalCdf<NormalCdfMode::Accurate>(x);
+        }
+    }
+}
+
+PositionRisk& PositionRisk::operator += (const PositionRisk& other)
+{
+    value += other.value;
+    delta += other.delta;
+    gamma += other.gamma;
+    vega += other.vega;
+    return *this;
+}
+
+PositionRisk PositionRisk::operator - (const PositionRisk& other) const
+{
+    return {value - other.value, delta - other.delta, gamma - other.gamma, vega - other.vega};
+}
+
+OptionBook::OptionBook(NormalCdfMode cdfMode) : cdfMode_(cdfMode)
+{
+}
+
+std::size_t OptionBook::addPosition(const std::string& underlying, const Option& option, OptionType type, double quantity)
+{
+    if (!option.isValid())
+    {
+        throw std::invalid_argument("Invalid option parameters.");
+    }
+
+    auto found = index_.find(underlying);
+    if (found == index_.end())
+    {
+        found = index_.emplace(underlying, underlyings_.size()).first;
+        Underlying& created = underlyings_.emplace_back();
+        created.name = underlying;
+        created.spot = option.AssetPrice();
+        created.logSpot = std::log(option.AssetPrice());
+    }
+    else if (underlyings_[found->second].spot != option.AssetPrice())
+    {
+        throw std::invalid_argument("Option spot does not match the current spot of its underlying.");
+    }
+
+    Underlying& book = underlyings_[found->second];
+    std::size_t position = locations_.size();
+    std::size_t row = book.positions.size();
+    double T = option.ExerciseDate();
+    double r = option.RiskFreeRate();
+    double b = option.CostOfCarry();
+
+    book.positions.push_back(position);
+    book.isCall.push_back(type == OptionType::Call);
+    book.quantity.push_back(quantity);
+    book.T.push_back(T);
+    book.K.push_back(option.StrikePrice());
+    book.sig.push_back(option.Volatility());
+    book.r.push_back(r);
+    book.b.push_back(b);
+    book.logK.push_back(std::log(option.StrikePrice()));
+    book.sqrtT.push_back(std::sqrt(T));
+    book.sigSqrtT.push_back(0.0);
+    book.drift.push_back(0.0);
+    book.discount.push_back(std::exp(-r * T));
+    book.carry.push_back(std::exp((b - r) * T));
+    book.price.push_back(0.0);
+    book.delta.push_back(0.0);
+    book.gamma.push_back(0.0);
+    book.vega.push_back(0.0);
+    refreshVolatility(book, row, option.Volatility());
+    locations_.push_back({found->second, row});
+
+    book.total += evaluate(book, row);
+    return position;
+}
+
+BookUpdate OptionBook::updateSpot(const std::string& underlying, double spot)
+{
+    if (!(spot > 0.0))
+    {
+        throw std::invalid_argument("Spot must be positive.");
+    }
+
+    Underlying& book = findUnderlying(underlying);
+    book.spot = spot;
+    book.logSpot = std::log(spot);
+
+    BookUpdate update{underlying, {}, {}};
+    reprice(book, 0, book.positions.size(), update);
+    return update;
+}
+
+BookUpdate OptionBook::updateVolatility(const std::string& underlying, double volatility)
+{
+    if (!(volatility > 0.0))
+    {
+        throw std::invalid_argument("Volatility must be positive.");
+    }
+
+    Underlying& book = findUnderlying(underlying);
+    for (std::size_t row = 0; row < book.positions.size(); ++row)
+    {
+        refreshVolatility(book, row, volatility);
+    }
+
+    BookUpdate update{underlying, {}, {}};
+    reprice(book, 0, book.positions.size(), update);
+    return update;
+}
+
+BookUpdate OptionBook::updateVolatility(std::size_t position, double volatility)
+{
+    if (position >= locations_.size())
+    {
+        throw std::out_of_range("Unknown position.");
+    }
+    if (!(volatility > 0.0))
+    {
+        throw std::invalid_argument("Volatility must be positive.");
+    }
+
+    Location location = locations_[position];
+    Underlying& book = underlyings_[location.underlying];
+    refreshVolatility(book, location.row, volatility);
+
+    BookUpdate update{book.name, {}, {}};
+    reprice(book, location.row, location.row + 1, update);
+    return update;
+}
+
+double OptionBook::spot(const std::string& underlying) const
+{
+    return findUnderlying(underlying).spot;
+}
+
+Option OptionBook::option(std::size_t position) const
+{
+    const Location& location = locations_.at(position);
+    const Underlying& book = underlyings_[location.underlying];
+    std::size_t row = location.row;
+    return Option(book.T[row], book.K[row], book.sig[row], book.r[row], book.spot, book.b[row]);
+}
+
+OptionType OptionBook::type(std::size_t position) const
+{
+    const Location& location = locations_.at(position);
+    return underlyings_[location.underlying].isCall[location.row] ? OptionType::Call : OptionType::Put;
+}
+
+double OptionBook::quantity(std::size_t position) const
+{
+    const Location& location = locations_.at(position);
+    return underlyings_[location.underlying].quantity[location.row];
+}
+
+double OptionBook::price(std::size_t position) const
+{
+    const Location& location = locations_.at(position);
+    return underlyings_[location.underlying].price[location.row];
+}
+
+PositionRisk OptionBook::risk(std::size_t position) const
+{
+    const Location& location = locations_.at(position);
+    const Underlying& book = underlyings_[location.underlying];
+    std::size_t row = location.row;
+    double quantity = book.quantity[row];
+    return {quantity * book.price[row], quantity * book.delta[row], quantity * book.gamma[row], quantity * book.vega[row]};
+}
+
+PositionRisk OptionBook::risk(const std::string& underlying) const
+{
+    return findUnderlying(underlying).total;
+}
+
+double OptionBook::totalValue() const
+{
+    double value = 0.0;
+    for (const Underlying& book : underlyings_)
+    {
+        value += book.total.value;
+    }
+    return value;
+}
+
+OptionBook::Underlying& OptionBook::findUnderlying(const std::string& underlying)
+{
+    auto found = index_.find(underlying);
+    if (found == index_.end())
+    {
+        throw std::out_of_range("Unknown underlying: " + underlying);
+    }
+    return underlyings_[found->second];
+}
+
+const OptionBook::Underlying& OptionBook::findUnderlying(const std::string& underlying) const
+{
+    auto found = index_.find(underlying);
+    if (found == index_.end())
+    {
+        throw std::out_of_range("Unknown underlying: " + underlying);
+    }
+    return underlyings_[found->second];
+}
+
+void OptionBook::refreshVolatility(Underlying& book, std::size_t row, double volatility)
+{
+    book.sig[row] = volatility;
+    book.sigSqrtT[row] = volatility * book.sqrtT[row];
+    book.drift[row] = (book.b[row] + 0.5 * volatility * volatility) * book.T[row];
+}
+
+PositionRisk OptionBook::evaluate(Underlying& book, std::size_t row)
+{
+    double sigSqrtT = book.sigSqrtT[row];
+    double d1 = (book.logSpot - book.logK[row] + book.drift[row]) / sigSqrtT;
+    double d2 = d1 - sigSqrtT;
+    double Nd1 = cdf(cdfMode_, d1);
+
+    double carried = book.spot * book.carry[row];
+    double strike = book.K[row] * book.discount[row];
+    double pdf = normalPdf(d1);
+    if (book.isCall[row])
+    {
+        book.price[row] = carried * Nd1 - strike * cdf(cdfMode_, d2);
+        book.delta[row] = book.carry[row] * Nd1;
+    }
+    else
+    {
+        book.price[row] = strike * cdf(cdfMode_, -d2) - carried * cdf(cdfMode_, -d1);
+        book.delta[row] = book.carry[row] * (Nd1 - 1.0);
+    }
+    book.gamma[row] = book.carry[row] * pdf / (book.spot * sigSqrtT);
+    book.vega[row] = carried * pdf * book.sqrtT[row];
+
+    double quantity = book.quantity[row];
+    return {quantity * book.price[row], quantity * book.delta[row], quantity * book.gamma[row], quantity * book.vega[row]};
+}
+
+void OptionBook::reprice(Underlying& book, std::size_t begin, std::size_t end, BookUpdate& update)
+{
+    update.changes.reserve(update.changes.size() + (end - begin));
+    PositionRisk repriced;
+    for (std::size_t row = begin; row < end; ++row)
+    {
+        double quantity = book.quantity[row];
+        PositionRisk before{quantity * book.price[row], quantity * book.delta[row],
+                            quantity * book.gamma[row], quantity * book.vega[row]};
+        PositionRisk after = evaluate(book, row);
+        PositionRisk change = after - before;
+        update.changes.push_back({book.positions[row], book.price[row], change});
+        update.change += change;
+        repriced += after;
+    }
+
+    // A full revaluation resets the total, so rounding from single-contract increments cannot accumulate
+    if (begin == 0 && end == book.positions.size())
+    {
+        book.total = repriced;
+    }
+    else
+    {
+        book.total += update.change;
+    }
+}
@@ -0,0 +1,141 @@
+#ifndef OPTIONBOOK_HPP
+#define OPTIONBOOK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Option.hpp"
+#include "NormalDistribution.hpp"
+
+/**
+ * @brief Value and sensitivities of one position (quantity included) or a sum of positions
+ */
+struct PositionRisk
+{
+    double value = 0.0;
+    double delta = 0.0;
+    double gamma = 0.0;
+    double vega = 0.0;
+
+    PositionRisk& operator += (const PositionRisk& other);
+    PositionRisk operator - (const PositionRisk& other) const;
+};
+
+/**
+ * @brief Change of one position caused by a market-data update
+ */
+struct PositionChange
+{
+    std::size_t position;   // Id returned by OptionBook::addPosition
+    double price;           // New per-contract price
+    PositionRisk change;    // New minus old risk of the position
+};
+
+/**
+ * @brief Everything an update touched: the repriced positions and the net change of their underlying
+ */
+struct BookUpdate
+{
+    std::string underlying;
+    std::vector<PositionChange> changes;
+    PositionRisk change;    // Sum of changes
+};
+
+/**
+ * @brief Persistent book of European option positions, repriced incrementally on market-data ticks
+ *
+ * Positions are grouped by underlying and stored as structure-of-arrays per
+ * underlying. Everything that does not depend on spot is computed once per
+ * contract and kept: log(K), sig sqrt(T), the drift (b + sig^2/2) T and the
+ * factors e^(-rT) and e^((b-r)T). A spot tick then costs one subtraction, one
+ * division and the normal CDF/PDF per contract of that underlying only; a
+ * volatility tick refreshes the two sigma-dependent invariants first.
+ * Other underlyings are never visited, and every update returns the per
+ * position deltas of value and Greeks together with their net. Ticks on a
+ * whole underlying recompute its total from the repriced contracts; only
+ * single-contract ticks update it by their change.
+ *
+ * Prices use the generalised Black-Scholes formulas of BlackScholesPricer and
+ * agree with it to rounding. The book is not thread-safe; updates of one
+ * underlying are independent of all others.
+ */
+class OptionBook
+{
+public:
+
+    explicit OptionBook(NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+
+    // Add quantity contracts (negative for short) of the option on the underlying and price them.
+    // The first position of an underlying sets its spot; later ones must quote the same spot.
+    std::size_t addPosition(const std::string& underlying, const Option& option, OptionType type, double quantity);
+
+    // Market-data ticks: reprice only the contracts of the underlying (or the one position)
+    BookUpdate updateSpot(const std::string& underlying, double spot);
+    BookUpdate updateVolatility(const std::string& underlying, double volatility); // Flat for all its contracts
+    BookUpdate updateVolatility(std::size_t position, double volatility);
+
+    // Current state
+    std::size_t size() const { return locations_.size(); };
+    std::size_t underlyingCount() const { return underlyings_.size(); };
+    bool hasUnderlying(const std::string& underlying) const { return index_.count(underlying) != 0; };
+    double spot(const std::string& underlying) const;
+    Option option(std::size_t position) const;
+    OptionType type(std::size_t position) const;
+    double quantity(std::size_t position) const;
+    double price(std::size_t position) const;     // Per contract
+    PositionRisk risk(std::size_t position) const;   // Quantity included
+    PositionRisk risk(const std::string& underlying) const;
+    double totalValue() const;
+
+private:
+
+    // Contracts of one underlying, one column per field
+    struct Underlying
+    {
+        std::string name;
+        double spot = 0.0;
+        double logSpot = 0.0;
+        PositionRisk total;
+
+        // Contract terms
+        std::vector<std::size_t> positions;
+        std::vector<std::uint8_t> isCall;
+        std::vector<double> quantity;
+        std::vector<double> T, K, sig, r, b;
+
+        // Spot-independent invariants
+        std::vector<double> logK;
+        std::vector<double> sqrtT;
+        std::vector<double> sigSqrtT;
+        std::vector<double> drift;      // (b + sig^2 / 2) T
+        std::vector<double> discount;   // e^(-rT)
+        std::vector<double> carry;      // e^((b-r)T)
+
+        // Last results, per contract
+        std::vector<double> price;
+        std::vector<double> delta;
+        std::vector<double> gamma;
+        std::vector<double> vega;
+    };
+
+    struct Location
+    {
+        std::size_t underlying;
+        std::size_t row;
+    };
+
+    Underlying& findUnderlying(const std::string& underlying);
+    const Underlying& findUnderlying(const std::string& underlying) const;
+    void refreshVolatility(Underlying& book, std::size_t row, double volatility);
+    PositionRisk evaluate(Underlying& book, std::size_t row);  // Reprice one row from its invariants
+    void reprice(Underlying& book, std::size_t begin, std::size_t end, BookUpdate& update);
+
+    NormalCdfMode cdfMode_;
+    std::vector<Underlying> underlyings_;
+    std::unordered_map<std::string, std::size_t> index_;
+    std::vector<Location> locations_;   // Indexed by position id
+};
+
+#endif // OPTIONBOOK_HPP
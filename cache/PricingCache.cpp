@@ -0,0 +1,301 @@
+#include "PricingCache.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    std::atomic<std::uint64_t> strategyIds{1};
+
+    // splitmix64 finaliser: cheap and well mixed in every bit
+    std::uint64_t mix(std::uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    constexpr std::uint8_t GreeksBit = 1u << CachedQuantityCount;
+}
+
+struct PricingCache::Key
+{
+    std::array<std::uint64_t, 6> parameters;   // Bit patterns of T, K, sig, r, S, b
+    std::uint64_t strategyId;
+    std::uint64_t hash;
+
+    Key(std::uint64_t strategy, const Option& option)
+        : parameters{std::bit_cast<std::uint64_t>(option.ExerciseDate()), std::bit_cast<std::uint64_t>(option.StrikePrice()),
+                     std::bit_cast<std::uint64_t>(option.Volatility()), std::bit_cast<std::uint64_t>(option.RiskFreeRate()),
+                     std::bit_cast<std::uint64_t>(option.AssetPrice()), std::bit_cast<std::uint64_t>(option.CostOfCarry())},
+          strategyId(strategy)
+    {
+        std::uint64_t h = mix(strategy);
+        for (std::uint64_t parameter : parameters)
+        {
+            h = mix(h ^ parameter);
+        }
+        hash = h;
+    }
+
+    bool operator == (const Key& other) const
+    {
+        return parameters == other.parameters && strategyId == other.strategyId;
+    }
+};
+
+/*
+    One independently locked part of the cache: a fixed slot array swept by
+    the CLOCK hand, a hash index from key to slot, and a free list of slots
+    released by invalidation. Counters are plain integers guarded by the mutex.
+*/
+struct alignas(64) PricingCache::Shard
+{
+    struct Slot
+    {
+        Key key{0, Option(1.0, 1.0, 1.0, 0.0, 1.0)};
+        std::array<double, CachedQuantityCount> values{};
+        GreeksResult greeks;
+        std::uint8_t known = 0;        // Bit q: values[q] is set; GreeksBit: greeks is set
+        bool referenced = false;
+        bool occupied = false;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const { return static_cast<std::size_t>(key.hash); }
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Slot> slots;
+    std::unordered_map<Key, std::uint32_t, KeyHash> index;
+    std::vector<std::uint32_t> freeSlots;
+    std::size_t used = 0;   // Slots handed out at least once
+    std::size_t hand = 0;
+    PricingCacheStats stats;
+
+    Slot* lookup(const Key& key)
+    {
+        auto it = index.find(key);
+        return it == index.end() ? nullptr : &slots[it->second];
+    }
+
+    // Slot for a new entry: a released one, a never used one, or the CLOCK victim
+    Slot& acquire(const Key& key)
+    {
+        std::uint32_t position;
+        if (!freeSlots.empty())
+        {
+            position = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else if (used < slots.size())
+        {
+            position = static_cast<std::uint32_t>(used++);
+        }
+        else
+        {
+            // Every slot is occupied here; at most one full turn clears all reference bits
+            while (slots[hand].referenced)
+            {
+                slots[hand].referenced = false;
+                hand = (hand + 1) % slots.size();
+            }
+            position = static_cast<std::uint32_t>(hand);
+            hand = (hand + 1) % slots.size();
+            index.erase(slots[position].key);
+            ++stats.evictions;
+        }
+
+        Slot& slot = slots[position];
+        slot.key = key;
+        slot.known = 0;
+        slot.referenced = false;
+        slot.occupied = true;
+        index.emplace(key, position);
+        ++stats.insertions;
+        return slot;
+    }
+
+    Slot& findOrAcquire(const Key& key)
+    {
+        Slot* slot = lookup(key);
+        return slot ? *slot : acquire(key);
+    }
+
+    void release(std::uint32_t position)
+    {
+        Slot& slot = slots[position];
+        index.erase(slot.key);
+        slot.occupied = false;
+        slot.known = 0;
+        freeSlots.push_back(position);
+        ++stats.invalidations;
+    }
+};
+
+PricingCache::PricingCache(std::size_t capacity, std::size_t shardCount)
+    : shardCount_(shardCount), shardCapacity_(0)
+{
+    if (capacity == 0 || shardCount == 0)
+    {
+        throw std::invalid_argument("Pricing cache capacity and shard count must be positive.");
+    }
+
+    shardCapacity_ = (capacity + shardCount - 1) / shardCount;
+    shards_ = std::make_unique<Shard[]>(shardCount_);
+    for (std::size_t s = 0; s < shardCount_; ++s)
+    {
+        shards_[s].slots.resize(shardCapacity_);
+        shards_[s].index.reserve(shardCapacity_);
+    }
+}
+
+PricingCache::~PricingCache() = default;
+
+PricingCache::Shard& PricingCache::shardFor(const Key& key) const
+{
+    // High bits pick the shard; the index buckets use the low bits
+    return shards_[static_cast<std::size_t>((key.hash >> 32) % shardCount_)];
+}
+
+std::optional<double> PricingCache::find(std::uint64_t strategyId, const Option& option, CachedQuantity quantity)
+{
+    Key key(strategyId, option);
+    Shard& shard = shardFor(key);
+    std::uint8_t bit = static_cast<std::uint8_t>(1u << static_cast<unsigned>(quantity));
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Shard::Slot* slot = shard.lookup(key);
+    if (!slot || !(slot->known & bit))
+    {
+        ++shard.stats.misses;
+        return std::nullopt;
+    }
+    slot->referenced = true;
+    ++shard.stats.hits;
+    return slot->values[static_cast<std::size_t>(quantity)];
+}
+
+std::optional<GreeksResult> PricingCache::findGreeks(std::uint64_t strategyId, const Option& option)
+{
+    Key key(strategyId, option);
+    Shard& shard = shardFor(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Shard::Slot* slot = shard.lookup(key);
+    if (!slot || !(slot->known & GreeksBit))
+    {
+        ++shard.stats.misses;
+        return std::nullopt;
+    }
+    slot->referenced = true;
+    ++shard.stats.hits;
+    return slot->greeks;
+}
+
+void PricingCache::insert(std::uint64_t strategyId, const Option& option, CachedQuantity quantity, double value)
+{
+    Key key(strategyId, option);
+    Shard& shard = shardFor(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Shard::Slot& slot = shard.findOrAcquire(key);
+    slot.values[static_cast<std::size_t>(quantity)] = value;
+    slot.known |= static_cast<std::uint8_t>(1u << static_cast<unsigned>(quantity));
+}
+
+void PricingCache::insertGreeks(std::uint64_t strategyId, const Option& option, const GreeksResult& greeks)
+{
+    Key key(strategyId, option);
+    Shard& shard = shardFor(key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Shard::Slot& slot = shard.findOrAcquire(key);
+    slot.greeks = greeks;
+    slot.known |= GreeksBit;
+}
+
+void PricingCache::invalidate(std::uint64_t strategyId)
+{
+    for (std::size_t s = 0; s < shardCount_; ++s)
+    {
+        Shard& shard = shards_[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (std::size_t i = 0; i < shard.used; ++i)
+        {
+            if (shard.slots[i].occupied && shard.slots[i].key.strategyId == strategyId)
+            {
+                shard.release(static_cast<std::uint32_t>(i));
+            }
+        }
+    }
+}
+
+void PricingCache::clear()
+{
+    for (std::size_t s = 0; s < shardCount_; ++s)
+    {
+        Shard& shard = shards_[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.stats.invalidations += shard.index.size();
+        shard.index.clear();
+        shard.freeSlots.clear();
+        for (Shard::Slot& slot : shard.slots)
+        {
+            slot.occupied = false;
+            slot.known = 0;
+        }
+        shard.used = 0;
+        shard.hand = 0;
+    }
+}
+
+std::size_t PricingCache::size() const
+{
+    std::size_t entries = 0;
+    for (std::size_t s = 0; s < shardCount_; ++s)
+    {
+        std::lock_guard<std::mutex> lock(shards_[s].mutex);
+        entries += shards_[s].index.size();
+    }
+    return entries;
+}
+
+PricingCacheStats PricingCache::stats() const
+{
+    PricingCacheStats total;
+    for (std::size_t s = 0; s < shardCount_; ++s)
+    {
+        std::lock_guard<std::mutex> lock(shards_[s].mutex);
+        const PricingCacheStats& shard = shards_[s].stats;
+        total.hits += shard.hits;
+        total.misses += shard.misses;
+        total.insertions += shard.insertions;
+        total.evictions += shard.evictions;
+        total.invalidations += shard.invalidations;
+    }
+    return total;
+}
+
+void PricingCache::resetStats()
+{
+    for (std::size_t s = 0; s < shardCount_; ++s)
+    {
+        std::lock_guard<std::mutex> lock(shards_[s].mutex);
+        shards_[s].stats = PricingCacheStats();
+    }
+}
+
+std::uint64_t PricingCache::nextStrategyId()
+{
+    return strategyIds.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,99 @@
+#ifndef PRICINGCACHE_HPP
+#define PRICINGCACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "Option.hpp"
+#include "GreeksResult.hpp"
+
+/**
+ * @brief Single-option results that PricingCache can hold
+ */
+enum class CachedQuantity : std::uint8_t
+{
+    CallPrice,
+    PutPrice,
+    CallDelta,
+    PutDelta,
+    Gamma,
+    Count
+};
+
+inline constexpr std::size_t CachedQuantityCount = static_cast<std::size_t>(CachedQuantity::Count);
+
+/**
+ * @brief Cache counters, summed over all shards
+ */
+struct PricingCacheStats
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t insertions = 0;      // New entries (results added to an existing entry are not counted)
+    std::uint64_t evictions = 0;       // Entries dropped by the CLOCK hand to make room
+    std::uint64_t invalidations = 0;   // Entries dropped by invalidate() or clear()
+
+    double hitRate() const { return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses); };
+};
+
+/**
+ * @brief Bounded, thread-safe memo of single-option prices and Greeks
+ *
+ * One entry per (strategy, option) holds every quantity computed for that
+ * pair so far, so verifyParity() after calculateCallPrice() reuses the call
+ * price. Options match on the bit patterns of all six parameters; the
+ * strategy is identified by an id from nextStrategyId(), which OptionContext
+ * draws anew on every setPricingStrategy(), so entries of a replaced strategy
+ * can never be returned and one cache may be shared by several contexts.
+ *
+ * Entries are spread over independently locked shards by hash. Each shard
+ * has a fixed number of slots and evicts with the CLOCK algorithm: a hit sets
+ * the slot's reference bit, and the hand clears set bits until it finds an
+ * unreferenced slot, which approximates LRU without reordering on every hit.
+ */
+class PricingCache
+{
+public:
+    static constexpr std::size_t DefaultShardCount = 16;
+
+    // capacity is the total number of entries, rounded up to a multiple of the shard count
+    explicit PricingCache(std::size_t capacity, std::size_t shardCount = DefaultShardCount);
+    ~PricingCache();
+
+    PricingCache(const PricingCache&) = delete;
+    PricingCache& operator = (const PricingCache&) = delete;
+
+    // Lookups count as hits or misses
+    std::optional<double> find(std::uint64_t strategyId, const Option& option, CachedQuantity quantity);
+    std::optional<GreeksResult> findGreeks(std::uint64_t strategyId, const Option& option);
+
+    void insert(std::uint64_t strategyId, const Option& option, CachedQuantity quantity, double value);
+    void insertGreeks(std::uint64_t strategyId, const Option& option, const GreeksResult& greeks);
+
+    // Drop every entry of one strategy (called when a context replaces it), or all entries
+    void invalidate(std::uint64_t strategyId);
+    void clear();
+
+    std::size_t size() const;
+    std::size_t capacity() const { return shardCapacity_ * shardCount_; };
+    std::size_t shardCount() const { return shardCount_; };
+
+    PricingCacheStats stats() const;
+    void resetStats();
+
+    // Process-wide unique strategy id, never 0
+    static std::uint64_t nextStrategyId();
+
+private:
+    struct Shard;
+    struct Key;
+
+    Shard& shardFor(const Key& key) const;
+
+    std::size_t shardCount_;
+    std::size_t shardCapacity_;
+    std::unique_ptr<Shard[]> shards_;
+};
+
+#endif // PRICINGCACHE_HPP
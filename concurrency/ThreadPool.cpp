@@ -0,0 +1,205 @@
+#include "ThreadPool.hpp"
+#include <exception>
+#include <limits>
+
+namespace
+{
+
+// Identifies the pool and queue owned by the current thread (if it is a worker)
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local std::size_t currentIndex = 0;
+
+constexpr std::size_t NoHome = std::numeric_limits<std::size_t>::max();
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    queues_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    workers_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t grainSize, const RangeBody& body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (grainSize == 0)
+    {
+        grainSize = 1;
+    }
+
+    std::size_t chunks = (count + grainSize - 1) / grainSize;
+    if (chunks == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    // Completion state lives on this stack frame; tasks only touch it under its mutex
+    std::mutex doneMutex;
+    std::condition_variable done;
+    std::size_t remaining = chunks;
+    std::exception_ptr error;
+
+    for (std::size_t c = 0; c < chunks; ++c)
+    {
+        std::size_t begin = c * grainSize;
+        std::size_t end = std::min(count, begin + grainSize);
+
+        push([&, begin, end] {
+            std::exception_ptr chunkError;
+            try
+            {
+                body(begin, end);
+            }
+            catch (...)
+            {
+                chunkError = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (chunkError && !error)
+            {
+                error = chunkError;
+            }
+            if (--remaining == 0)
+            {
+                done.notify_all();
+            }
+        });
+    }
+
+    // Help with the work instead of blocking
+    std::size_t home = currentPool == this ? currentIndex : NoHome;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (remaining == 0)
+            {
+                break;
+            }
+        }
+
+        if (!tryRunTask(home))
+        {
+            std::unique_lock<std::mutex> lock(doneMutex);
+            done.wait(lock, [&] { return remaining == 0; });
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::push(Task task)
+{
+    std::size_t target;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        target = currentPool == this ? currentIndex : nextQueue_++ % queues_.size();
+        ++pending_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+
+    wake_.notify_one();
+}
+
+bool ThreadPool::tryRunTask(std::size_t home)
+{
+    Task task;
+    std::size_t n = queues_.size();
+
+    // Own queue first (newest task, still in cache), then steal the oldest from the others
+    if (home != NoHome)
+    {
+        std::lock_guard<std::mutex> lock(queues_[home]->mutex);
+        if (!queues_[home]->tasks.empty())
+        {
+            task = std::move(queues_[home]->tasks.back());
+            queues_[home]->tasks.pop_back();
+        }
+    }
+
+    std::size_t start = home == NoHome ? 0 : home + 1;
+    for (std::size_t k = 0; !task && k < n; ++k)
+    {
+        WorkQueue& victim = *queues_[(start + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!task)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        --pending_;
+    }
+
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(std::size_t index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    while (true)
+    {
+        if (tryRunTask(index))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+        if (stop_ && pending_ == 0)
+        {
+            return;
+        }
+    }
+}
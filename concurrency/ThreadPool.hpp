@@ -0,0 +1,73 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing thread pool for batch and matrix pricing
+ *
+ * Every worker owns a task deque: it pops its own work LIFO (cache-warm) and,
+ * when empty, steals FIFO from the other workers. The thread calling
+ * parallelFor() helps execute chunks instead of blocking, so nested
+ * parallelFor() calls from inside a task cannot deadlock the pool.
+ *
+ * Work is split into fixed index ranges, so results written by index are
+ * identical regardless of thread count or scheduling order.
+ */
+class ThreadPool
+{
+public:
+
+    using Task = std::function<void()>;
+    using RangeBody = std::function<void(std::size_t begin, std::size_t end)>;
+
+    explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator = (const ThreadPool&) = delete;
+
+    std::size_t threadCount() const { return workers_.size(); };
+
+    /**
+     * @brief Run body over [0, count) in chunks of at most grainSize indices
+     *
+     * Blocks until every chunk has run. The first exception thrown by a chunk
+     * is rethrown here after the remaining chunks have finished.
+     *
+     * @param count Number of indices
+     * @param grainSize Maximum chunk length (0 is treated as 1)
+     * @param body Callable receiving one [begin, end) chunk
+     */
+    void parallelFor(std::size_t count, std::size_t grainSize, const RangeBody& body);
+
+private:
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void push(Task task);
+    bool tryRunTask(std::size_t home);
+    void workerLoop(std::size_t index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_; // One deque per worker
+    std::vector<std::thread> workers_;
+
+    std::mutex sleepMutex_;                           // Guards pending_ transitions to 0 and stop_
+    std::condition_variable wake_;
+    std::size_t pending_ = 0;                         // Tasks queued but not yet taken
+    bool stop_ = false;
+    std::size_t nextQueue_ = 0;                       // Round-robin target for external submissions
+};
+
+#endif // THREADPOOL_HPP
@@ -1,18 +1,64 @@
 #include "OptionContext.hpp"
+#include <functional>
+#include <optional>
 #include <stdexcept>
+#include <string>
 
-OptionContext::OptionContext() : pricingStrategy_(nullptr), parityValidator_(nullptr)
+namespace
+{
+    // Compact the rows that passed validation into a new batch
+    OptionBatch gatherValidRows(const BatchValidation& validation, std::span<const Option> rows)
+    {
+        OptionBatch valid;
+        valid.reserve(validation.size() - validation.invalidCount());
+        for (std::size_t i = 0; i < rows.size(); ++i)
+        {
+            if (validation.isValid(i))
+            {
+                valid.push_back(rows[i]);
+            }
+        }
+        return valid;
+    }
+
+    OptionBatch gatherValidRows(const BatchValidation& validation, const OptionBatchView& rows)
+    {
+        std::vector<std::size_t> index = validation.validRows();
+        OptionBatch valid(index.size());
+        auto gather = [&index](const double* column, std::span<double> out) {
+            for (std::size_t j = 0; j < index.size(); ++j)
+            {
+                out[j] = column[index[j]];
+            }
+        };
+        gather(rows.T, valid.ExerciseDates());
+        gather(rows.K, valid.StrikePrices());
+        gather(rows.sig, valid.Volatilities());
+        gather(rows.r, valid.RiskFreeRates());
+        gather(rows.S, valid.AssetPrices());
+        gather(rows.b, valid.CostsOfCarry());
+        return valid;
+    }
+}
+
+OptionContext::OptionContext()
+    : pricingStrategy_(nullptr), parityValidator_(nullptr), threadPool_(nullptr), strategyId_(PricingCache::nextStrategyId())
 {
 }
 
 OptionContext::OptionContext(std::unique_ptr<IPricingStrategy> strategy)
-    : pricingStrategy_(std::move(strategy)), parityValidator_(nullptr)
+    : pricingStrategy_(std::move(strategy)), parityValidator_(nullptr), threadPool_(nullptr),
+      strategyId_(PricingCache::nextStrategyId())
 {
 }
 
 OptionContext::~OptionContext()
 {
-    // No explicit cleanup needed, unique_ptr will handle it
+    // Entries of this context can never be looked up again; free them in a shared cache
+    if (cache_)
+    {
+        cache_->invalidate(strategyId_);
+    }
 }
 
 void OptionContext::setPricingStrategy(std::unique_ptr<IPricingStrategy> strategy)
@@ -22,6 +68,47 @@ void OptionContext::setPricingStrategy(std::unique_ptr<IPricingStrategy> strateg
         throw std::invalid_argument("Cannot set a null pricing strategy.");
     }
     pricingStrategy_ = std::move(strategy);
+
+    // Results of the previous strategy must not be served for the new one
+    if (cache_)
+    {
+        cache_->invalidate(strategyId_);
+    }
+    strategyId_ = PricingCache::nextStrategyId();
+}
+
+void OptionContext::setThreadPool(std::shared_ptr<ThreadPool> pool)
+{
+    threadPool_ = std::move(pool);
+}
+
+void OptionContext::setThreadCount(std::size_t threadCount)
+{
+    threadPool_ = threadCount > 1 ? std::make_shared<ThreadPool>(threadCount) : nullptr;
+}
+
+std::size_t OptionContext::getThreadCount() const
+{
+    return threadPool_ ? threadPool_->threadCount() : 1;
+}
+
+void OptionContext::setParallelChunkSize(std::size_t chunkSize)
+{
+    if (chunkSize == 0)
+    {
+        throw std::invalid_argument("Parallel chunk size must be positive.");
+    }
+    parallelChunkSize_ = chunkSize;
+}
+
+void OptionContext::setMetrics(std::shared_ptr<PricingMetrics> metrics)
+{
+    metrics_ = std::move(metrics);
+}
+
+void OptionContext::setCache(std::shared_ptr<PricingCache> cache)
+{
+    cache_ = std::move(cache);
 }
 
 void OptionContext::setParityValidator(std::unique_ptr<IParityValidator> validator)
@@ -35,131 +122,619 @@ void OptionContext::setParityValidator(std::unique_ptr<IParityValidator> validat
 
 double OptionContext::calculateCallPrice(const Option& option) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallPrice, 1);
     validateStrategy();
-    if (!option.isValid())
+    if (!acceptOption(option, metrics))
     {
-        throw std::invalid_argument("Invalid option parameters.");
+        return GreeksResult::NotAvailable;
     }
 
-    return pricingStrategy_->calculateCallPrice(option);
+    return evaluateCached(option, CachedQuantity::CallPrice, &IPricingStrategy::calculateCallPrice);
 }
 
 double OptionContext::calculatePutPrice(const Option& option) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutPrice, 1);
     validateStrategy();
-    if (!option.isValid())
+    if (!acceptOption(option, metrics))
     {
-        throw std::invalid_argument("Invalid option parameters.");
+        return GreeksResult::NotAvailable;
     }
 
-    return pricingStrategy_->calculatePutPrice(option);
+    return evaluateCached(option, CachedQuantity::PutPrice, &IPricingStrategy::calculatePutPrice);
 }
 
 double OptionContext::calculateGamma(const Option& option) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::Gamma, 1);
     validateStrategy();
-    if (!option.isValid())
+    if (!acceptOption(option, metrics))
     {
-        throw std::invalid_argument("Invalid option parameters.");
+        return GreeksResult::NotAvailable;
     }
 
-    return pricingStrategy_->calculateGamma(option);
+    return evaluateCached(option, CachedQuantity::Gamma, &IPricingStrategy::calculateGamma);
 }
 
 double OptionContext::calculateCallDelta(const Option& option) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallDelta, 1);
     validateStrategy();
-    if (!option.isValid())
+    if (!acceptOption(option, metrics))
     {
-        throw std::invalid_argument("Invalid option parameters.");
+        return GreeksResult::NotAvailable;
     }
 
-    return pricingStrategy_->calculateCallDelta(option);
+    return evaluateCached(option, CachedQuantity::CallDelta, &IPricingStrategy::calculateCallDelta);
 }
 
 double OptionContext::calculatePutDelta(const Option& option) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutDelta, 1);
     validateStrategy();
-    if (!option.isValid())
+    if (!acceptOption(option, metrics))
     {
-        throw std::invalid_argument("Invalid option parameters.");
+        return GreeksResult::NotAvailable;
+    }
+
+    return evaluateCached(option, CachedQuantity::PutDelta, &IPricingStrategy::calculatePutDelta);
+}
+
+GreeksResult OptionContext::calculateGreeks(const Option& option) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::Greeks, 1);
+    validateStrategy();
+    if (!acceptOption(option, metrics))
+    {
+        return GreeksResult();
     }
 
-    return pricingStrategy_->calculatePutDelta(option);
+    if (cache_)
+    {
+        if (std::optional<GreeksResult> cached = cache_->findGreeks(strategyId_, option))
+        {
+            return *cached;
+        }
+    }
+
+    GreeksResult greeks = pricingStrategy_->calculateGreeks(option);
+    if (cache_)
+    {
+        cache_->insertGreeks(strategyId_, option, greeks);
+    }
+    return greeks;
+}
+
+std::vector<GreeksResult> OptionContext::calculateGreeksVector(const std::vector<Option>& options) const
+{
+    std::vector<GreeksResult> results(options.size());
+    calculateGreeksVector(std::span<const Option>(options), results);
+    return results;
+}
+
+void OptionContext::calculateGreeksVector(std::span<const Option> options, std::span<GreeksResult> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GreeksVector, options.size());
+    validateStrategy();
+    if (out.size() != options.size())
+    {
+        throw std::invalid_argument("Output size does not match option count.");
+    }
+    if (validationMode_ != ValidationMode::Unchecked)
+    {
+        BatchValidation validation{options};
+        if (screenRows(validation, metrics))
+        {
+            evaluateValidGreeks(validation, gatherValidRows(validation, options), out);
+            return;
+        }
+    }
+    if (!runsParallel(options.size()))
+    {
+        pricingStrategy_->calculateGreeksVector(options, out);
+        return;
+    }
+
+    evaluateGreeksChunks(options, out);
+}
+
+Grid<GreeksResult> OptionContext::calculateGreeksMatrix(const Grid<Option>& optionGrid) const
+{
+    Grid<GreeksResult> out;
+    calculateGreeksMatrix(optionGrid, out);
+    return out;
+}
+
+void OptionContext::calculateGreeksMatrix(const Grid<Option>& optionGrid, Grid<GreeksResult>& out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GreeksMatrix, optionGrid.size());
+    validateStrategy();
+    if (validationMode_ != ValidationMode::Unchecked)
+    {
+        BatchValidation validation(optionGrid.values());
+        if (screenRows(validation, metrics))
+        {
+            out.reshape(optionGrid);
+            evaluateValidGreeks(validation, gatherValidRows(validation, optionGrid.values()), out.values());
+            return;
+        }
+    }
+    if (!runsParallel(optionGrid.size()))
+    {
+        pricingStrategy_->calculateGreeksMatrix(optionGrid, out);
+        return;
+    }
+
+    out.reshape(optionGrid);
+    evaluateGreeksChunks(optionGrid.values(), out.values());
+}
+
+GreeksBatch OptionContext::calculateGreeksBatch(const OptionBatchView& input) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GreeksBatch, input.size);
+    validateStrategy();
+    SurfaceVolatilities vols;
+    OptionBatchView batch = resolveVolatilities(input, vols);
+    if (validationMode_ != ValidationMode::Unchecked)
+    {
+        BatchValidation validation(batch);
+        if (screenRows(validation, metrics))
+        {
+            GreeksBatch valid = evaluateGreeksBatch(gatherValidRows(validation, batch));
+            GreeksBatch greeks(batch.size);
+            for (std::size_t i = 0, j = 0; i < batch.size; ++i)
+            {
+                greeks.set(i, validation.isValid(i) ? valid.at(j++) : GreeksResult());
+            }
+            return greeks;
+        }
+    }
+    return evaluateGreeksBatch(batch);
+}
+
+double OptionContext::calculateGreek(Greek greek, const Option& option) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::Greek, 1);
+    validateStrategy();
+    if (!acceptOption(option, metrics))
+    {
+        return GreeksResult::NotAvailable;
+    }
+
+    // A memoised fused result already holds every Greek
+    if (cache_)
+    {
+        if (std::optional<GreeksResult> cached = cache_->findGreeks(strategyId_, option))
+        {
+            return cached->value(greek);
+        }
+    }
+    return pricingStrategy_->calculateGreek(greek, option);
+}
+
+std::vector<double> OptionContext::calculateGreekVector(Greek greek, const std::vector<Option>& options) const
+{
+    std::vector<double> results(options.size());
+    calculateGreekVector(greek, std::span<const Option>(options), results);
+    return results;
+}
+
+void OptionContext::calculateGreekVector(Greek greek, std::span<const Option> options, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GreekVector, options.size());
+    validateStrategy();
+    auto spanMethod = [greek](const IPricingStrategy& strategy, std::span<const Option> rows, std::span<double> values) {
+        strategy.calculateGreekVector(greek, rows, values);
+    };
+    auto batchMethod = [greek](const IPricingStrategy& strategy, const OptionBatchView& rows, std::span<double> values) {
+        strategy.calculateGreekBatch(greek, rows, values);
+    };
+    evaluateVector(options, out, spanMethod, batchMethod, metrics);
+}
+
+Grid<double> OptionContext::calculateGreekMatrix(Greek greek, const Grid<Option>& optionGrid) const
+{
+    Grid<double> out;
+    calculateGreekMatrix(greek, optionGrid, out);
+    return out;
+}
+
+void OptionContext::calculateGreekMatrix(Greek greek, const Grid<Option>& optionGrid, Grid<double>& out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GreekMatrix, optionGrid.size());
+    validateStrategy();
+    auto matrixMethod = [greek](const IPricingStrategy& strategy, const Grid<Option>& grid, Grid<double>& values) {
+        strategy.calculateGreekMatrix(greek, grid, values);
+    };
+    auto batchMethod = [greek](const IPricingStrategy& strategy, const OptionBatchView& rows, std::span<double> values) {
+        strategy.calculateGreekBatch(greek, rows, values);
+    };
+    evaluateMatrix(optionGrid, out, matrixMethod, batchMethod, metrics);
+}
+
+std::vector<double> OptionContext::calculateGreekBatch(Greek greek, const OptionBatchView& batch) const
+{
+    std::vector<double> results(batch.size);
+    calculateGreekBatch(greek, batch, results);
+    return results;
+}
+
+void OptionContext::calculateGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GreekBatch, batch.size);
+    validateStrategy();
+    auto batchMethod = [greek](const IPricingStrategy& strategy, const OptionBatchView& rows, std::span<double> values) {
+        strategy.calculateGreekBatch(greek, rows, values);
+    };
+    evaluateBatch(batch, out, batchMethod, metrics);
 }
 
 std::vector<double> OptionContext::calculateCallDeltaVector(const std::vector<Option>& options) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallDeltaVector, options.size());
     validateStrategy();
-    return pricingStrategy_->calculateCallDeltaVector(options);
+    return evaluateVector(options, &IPricingStrategy::calculateCallDeltaVector, &IPricingStrategy::calculateCallDeltaBatch, metrics);
 }
 
 std::vector<double> OptionContext::calculatePutDeltaVector(const std::vector<Option>& options) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutDeltaVector, options.size());
     validateStrategy();
-    return pricingStrategy_->calculatePutDeltaVector(options);
+    return evaluateVector(options, &IPricingStrategy::calculatePutDeltaVector, &IPricingStrategy::calculatePutDeltaBatch, metrics);
 }
 
 std::vector<double> OptionContext::calculateGammaVector(const std::vector<Option>& options) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::GammaVector, options.size());
     validateStrategy();
-    return pricingStrategy_->calculateGammaVector(options);
+    return evaluateVector(options, &IPricingStrategy::calculateGammaVector, &IPricingStrategy::calculateGammaBatch, metrics);
+}
+
+Grid<double> OptionContext::calculateCallDeltaMatrix(const Grid<Option>& optionGrid) const
+{
+    Grid<double> out;
+    calculateCallDeltaMatrix(optionGrid, out);
+    return out;
 }
 
-std::vector<std::vector<double>> OptionContext::calculateCallDeltaMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
+void OptionContext::calculateCallDeltaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallDeltaMatrix, optionGrid.size());
     validateStrategy();
-    return pricingStrategy_->calculateCallDeltaMatrix(optionMatrix);
+    evaluateMatrix(optionGrid, out, &IPricingStrategy::calculateCallDeltaMatrix, &IPricingStrategy::calculateCallDeltaBatch, metrics);
+}
+
+Grid<double> OptionContext::calculatePutDeltaMatrix(const Grid<Option>& optionGrid) const
+{
+    Grid<double> out;
+    calculatePutDeltaMatrix(optionGrid, out);
+    return out;
 }
 
-std::vector<std::vector<double>> OptionContext::calculatePutDeltaMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
+void OptionContext::calculatePutDeltaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutDeltaMatrix, optionGrid.size());
     validateStrategy();
-    return pricingStrategy_->calculatePutDeltaMatrix(optionMatrix);
+    evaluateMatrix(optionGrid, out, &IPricingStrategy::calculatePutDeltaMatrix, &IPricingStrategy::calculatePutDeltaBatch, metrics);
+}
+
+Grid<double> OptionContext::calculateGammaMatrix(const Grid<Option>& optionGrid) const
+{
+    Grid<double> out;
+    calculateGammaMatrix(optionGrid, out);
+    return out;
 }
 
-std::vector<std::vector<double>> OptionContext::calculateGammaMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
+void OptionContext::calculateGammaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::GammaMatrix, optionGrid.size());
     validateStrategy();
-    return pricingStrategy_->calculateGammaMatrix(optionMatrix);
+    evaluateMatrix(optionGrid, out, &IPricingStrategy::calculateGammaMatrix, &IPricingStrategy::calculateGammaBatch, metrics);
 }
 
 std::vector<double> OptionContext::calculateCallVector(const std::vector<Option>& options) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallVector, options.size());
     validateStrategy();
-    return pricingStrategy_->calculateCallVector(options);
+    return evaluateVector(options, &IPricingStrategy::calculateCallVector, &IPricingStrategy::calculateCallBatch, metrics);
 }
 
 std::vector<double> OptionContext::calculatePutVector(const std::vector<Option>& options) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutVector, options.size());
     validateStrategy();
-    return pricingStrategy_->calculatePutVector(options);
+    return evaluateVector(options, &IPricingStrategy::calculatePutVector, &IPricingStrategy::calculatePutBatch, metrics);
 }
 
-std::vector<std::vector<double>> OptionContext::calculateCallMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
+void OptionContext::calculateCallVector(std::span<const Option> options, std::span<double> out) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallVector, options.size());
     validateStrategy();
-    return pricingStrategy_->calculateCallMatrix(optionMatrix);
+    evaluateVector(options, out, &IPricingStrategy::calculateCallVector, &IPricingStrategy::calculateCallBatch, metrics);
 }
 
-std::vector<std::vector<double>> OptionContext::calculatePutMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
+void OptionContext::calculatePutVector(std::span<const Option> options, std::span<double> out) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutVector, options.size());
     validateStrategy();
-    return pricingStrategy_->calculatePutMatrix(optionMatrix);
+    evaluateVector(options, out, &IPricingStrategy::calculatePutVector, &IPricingStrategy::calculatePutBatch, metrics);
+}
+
+void OptionContext::calculateCallDeltaVector(std::span<const Option> options, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallDeltaVector, options.size());
+    validateStrategy();
+    evaluateVector(options, out, &IPricingStrategy::calculateCallDeltaVector, &IPricingStrategy::calculateCallDeltaBatch, metrics);
+}
+
+void OptionContext::calculatePutDeltaVector(std::span<const Option> options, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutDeltaVector, options.size());
+    validateStrategy();
+    evaluateVector(options, out, &IPricingStrategy::calculatePutDeltaVector, &IPricingStrategy::calculatePutDeltaBatch, metrics);
+}
+
+void OptionContext::calculateGammaVector(std::span<const Option> options, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GammaVector, options.size());
+    validateStrategy();
+    evaluateVector(options, out, &IPricingStrategy::calculateGammaVector, &IPricingStrategy::calculateGammaBatch, metrics);
+}
+
+Grid<double> OptionContext::calculateCallMatrix(const Grid<Option>& optionGrid) const
+{
+    Grid<double> out;
+    calculateCallMatrix(optionGrid, out);
+    return out;
+}
+
+void OptionContext::calculateCallMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallMatrix, optionGrid.size());
+    validateStrategy();
+    evaluateMatrix(optionGrid, out, &IPricingStrategy::calculateCallMatrix, &IPricingStrategy::calculateCallBatch, metrics);
+}
+
+Grid<double> OptionContext::calculatePutMatrix(const Grid<Option>& optionGrid) const
+{
+    Grid<double> out;
+    calculatePutMatrix(optionGrid, out);
+    return out;
+}
+
+void OptionContext::calculatePutMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutMatrix, optionGrid.size());
+    validateStrategy();
+    evaluateMatrix(optionGrid, out, &IPricingStrategy::calculatePutMatrix, &IPricingStrategy::calculatePutBatch, metrics);
+}
+
+std::vector<double> OptionContext::calculateCallBatch(const OptionBatchView& batch) const
+{
+    std::vector<double> results(batch.size);
+    calculateCallBatch(batch, results);
+    return results;
+}
+
+std::vector<double> OptionContext::calculatePutBatch(const OptionBatchView& batch) const
+{
+    std::vector<double> results(batch.size);
+    calculatePutBatch(batch, results);
+    return results;
+}
+
+std::vector<double> OptionContext::calculateCallDeltaBatch(const OptionBatchView& batch) const
+{
+    std::vector<double> results(batch.size);
+    calculateCallDeltaBatch(batch, results);
+    return results;
+}
+
+std::vector<double> OptionContext::calculatePutDeltaBatch(const OptionBatchView& batch) const
+{
+    std::vector<double> results(batch.size);
+    calculatePutDeltaBatch(batch, results);
+    return results;
+}
+
+std::vector<double> OptionContext::calculateGammaBatch(const OptionBatchView& batch) const
+{
+    std::vector<double> results(batch.size);
+    calculateGammaBatch(batch, results);
+    return results;
+}
+
+void OptionContext::calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallBatch, batch.size);
+    validateStrategy();
+    evaluateBatch(batch, out, &IPricingStrategy::calculateCallBatch, metrics);
+}
+
+void OptionContext::calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutBatch, batch.size);
+    validateStrategy();
+    evaluateBatch(batch, out, &IPricingStrategy::calculatePutBatch, metrics);
+}
+
+void OptionContext::calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallDeltaBatch, batch.size);
+    validateStrategy();
+    evaluateBatch(batch, out, &IPricingStrategy::calculateCallDeltaBatch, metrics);
+}
+
+void OptionContext::calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutDeltaBatch, batch.size);
+    validateStrategy();
+    evaluateBatch(batch, out, &IPricingStrategy::calculatePutDeltaBatch, metrics);
+}
+
+void OptionContext::calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GammaBatch, batch.size);
+    validateStrategy();
+    evaluateBatch(batch, out, &IPricingStrategy::calculateGammaBatch, metrics);
+}
+
+std::vector<double> OptionContext::calculateCallSweep(const ParameterGrid& grid) const
+{
+    std::vector<double> results(grid.size());
+    calculateCallSweep(grid, results);
+    return results;
+}
+
+std::vector<double> OptionContext::calculatePutSweep(const ParameterGrid& grid) const
+{
+    std::vector<double> results(grid.size());
+    calculatePutSweep(grid, results);
+    return results;
+}
+
+std::vector<double> OptionContext::calculateCallDeltaSweep(const ParameterGrid& grid) const
+{
+    std::vector<double> results(grid.size());
+    calculateCallDeltaSweep(grid, results);
+    return results;
+}
+
+std::vector<double> OptionContext::calculatePutDeltaSweep(const ParameterGrid& grid) const
+{
+    std::vector<double> results(grid.size());
+    calculatePutDeltaSweep(grid, results);
+    return results;
+}
+
+std::vector<double> OptionContext::calculateGammaSweep(const ParameterGrid& grid) const
+{
+    std::vector<double> results(grid.size());
+    calculateGammaSweep(grid, results);
+    return results;
+}
+
+void OptionContext::calculateCallSweep(const ParameterGrid& grid, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallSweep, grid.size());
+    validateStrategy();
+    evaluateSweep(grid, out, &IPricingStrategy::calculateCallSweep, &IPricingStrategy::calculateCallBatch, metrics);
+}
+
+void OptionContext::calculatePutSweep(const ParameterGrid& grid, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutSweep, grid.size());
+    validateStrategy();
+    evaluateSweep(grid, out, &IPricingStrategy::calculatePutSweep, &IPricingStrategy::calculatePutBatch, metrics);
+}
+
+void OptionContext::calculateCallDeltaSweep(const ParameterGrid& grid, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallDeltaSweep, grid.size());
+    validateStrategy();
+    evaluateSweep(grid, out, &IPricingStrategy::calculateCallDeltaSweep, &IPricingStrategy::calculateCallDeltaBatch, metrics);
+}
+
+void OptionContext::calculatePutDeltaSweep(const ParameterGrid& grid, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutDeltaSweep, grid.size());
+    validateStrategy();
+    evaluateSweep(grid, out, &IPricingStrategy::calculatePutDeltaSweep, &IPricingStrategy::calculatePutDeltaBatch, metrics);
+}
+
+void OptionContext::calculateGammaSweep(const ParameterGrid& grid, std::span<double> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GammaSweep, grid.size());
+    validateStrategy();
+    evaluateSweep(grid, out, &IPricingStrategy::calculateGammaSweep, &IPricingStrategy::calculateGammaBatch, metrics);
+}
+
+Grid<double> OptionContext::calculateCallMatrix(const ParameterGrid& grid) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallSweep, grid.size());
+    validateStrategy();
+    return evaluateSweepMatrix(grid, &IPricingStrategy::calculateCallSweep, &IPricingStrategy::calculateCallBatch, metrics);
+}
+
+Grid<double> OptionContext::calculatePutMatrix(const ParameterGrid& grid) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutSweep, grid.size());
+    validateStrategy();
+    return evaluateSweepMatrix(grid, &IPricingStrategy::calculatePutSweep, &IPricingStrategy::calculatePutBatch, metrics);
+}
+
+Grid<double> OptionContext::calculateCallDeltaMatrix(const ParameterGrid& grid) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::CallDeltaSweep, grid.size());
+    validateStrategy();
+    return evaluateSweepMatrix(grid, &IPricingStrategy::calculateCallDeltaSweep, &IPricingStrategy::calculateCallDeltaBatch, metrics);
+}
+
+Grid<double> OptionContext::calculatePutDeltaMatrix(const ParameterGrid& grid) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::PutDeltaSweep, grid.size());
+    validateStrategy();
+    return evaluateSweepMatrix(grid, &IPricingStrategy::calculatePutDeltaSweep, &IPricingStrategy::calculatePutDeltaBatch, metrics);
+}
+
+Grid<double> OptionContext::calculateGammaMatrix(const ParameterGrid& grid) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::GammaSweep, grid.size());
+    validateStrategy();
+    return evaluateSweepMatrix(grid, &IPricingStrategy::calculateGammaSweep, &IPricingStrategy::calculateGammaBatch, metrics);
+}
+
+ImpliedVolResult OptionContext::calculateImpliedVolatility(const Option& option, double price, OptionType type,
+                                                           const ImpliedVolSettings& settings) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::ImpliedVolatility, 1);
+    validateStrategy();
+    return pricingStrategy_->calculateImpliedVolatility(option, price, type, settings);
+}
+
+std::vector<ImpliedVolResult> OptionContext::calculateImpliedVolatilityBatch(const OptionBatchView& batch,
+                                                                             std::span<const double> prices,
+                                                                             OptionType type,
+                                                                             const ImpliedVolSettings& settings) const
+{
+    std::vector<ImpliedVolResult> results(batch.size);
+    calculateImpliedVolatilityBatch(batch, prices, type, settings, results);
+    return results;
+}
+
+void OptionContext::calculateImpliedVolatilityBatch(const OptionBatchView& batch, std::span<const double> prices,
+                                                    OptionType type, const ImpliedVolSettings& settings,
+                                                    std::span<ImpliedVolResult> out) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::ImpliedVolatilityBatch, batch.size);
+    validateStrategy();
+    if (prices.size() != batch.size || out.size() != batch.size)
+    {
+        metrics.reject(batch.size);
+        throw std::invalid_argument("Price and output sizes must match option batch size.");
+    }
+    if (!runsParallel(batch.size))
+    {
+        pricingStrategy_->calculateImpliedVolatilityBatch(batch, prices, type, settings, out);
+        return;
+    }
+
+    threadPool_->parallelFor(batch.size, parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+        std::size_t count = end - begin;
+        pricingStrategy_->calculateImpliedVolatilityBatch(batch.subview(begin, count), prices.subspan(begin, count),
+                                                          type, settings, out.subspan(begin, count));
+    });
 }
 
 bool OptionContext::verifyParity(const Option& option, double tolerance) const
 {
+    MetricsScope metrics(metrics_.get(), MetricMethod::Parity, 1);
     validateStrategy();
     validateParityValidator();
     
     if (!option.isValid())
     {
+        metrics.reject();
         throw std::invalid_argument("Invalid option parameters.");
     }
 
@@ -193,11 +768,346 @@ double OptionContext::putFromCallParity(const Option& option, double callPrice)
     return parityValidator_->putFromCall(option, callPrice);
 }
 
+ParityAudit OptionContext::auditParity(const OptionBatchView& batch, std::span<const double> callPrices,
+                                      std::span<const double> putPrices, double tolerance) const
+{
+    MetricsScope metrics(metrics_.get(), MetricMethod::ParityAudit, batch.size);
+    validateParityValidator();
+    return parityValidator_->auditParity(batch, callPrices, putPrices, tolerance);
+}
+
+ParityAudit OptionContext::auditParity(const OptionBatchView& batch, const GreeksBatch& results, double tolerance) const
+{
+    return auditParity(batch, results.callPrice, results.putPrice, tolerance);
+}
+
 std::string OptionContext::getCurrentStrategyName() const
 {
     return pricingStrategy_ ? pricingStrategy_->getName() : "No Strategy set";
 }
 
+double OptionContext::evaluateCached(const Option& option, CachedQuantity quantity, ScalarMethod scalarMethod) const
+{
+    if (!cache_)
+    {
+        return (pricingStrategy_.get()->*scalarMethod)(option);
+    }
+
+    if (std::optional<double> cached = cache_->find(strategyId_, option, quantity))
+    {
+        return *cached;
+    }
+    double value = (pricingStrategy_.get()->*scalarMethod)(option);
+    cache_->insert(strategyId_, option, quantity, value);
+    return value;
+}
+
+bool OptionContext::runsParallel(std::size_t count) const
+{
+    return threadPool_ && count > parallelChunkSize_;
+}
+
+template <typename BatchFunction>
+void OptionContext::evaluateChunks(std::span<const Option> options, std::span<double> out, const BatchFunction& batchMethod) const
+{
+    // Each chunk transposes its own rows and prices them through the batch path
+    threadPool_->parallelFor(options.size(), parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+        OptionBatch chunk(options.subspan(begin, end - begin));
+        std::invoke(batchMethod, *pricingStrategy_, chunk.view(), out.subspan(begin, end - begin));
+    });
+}
+
+void OptionContext::evaluateGreeksChunks(std::span<const Option> options, std::span<GreeksResult> out) const
+{
+    threadPool_->parallelFor(options.size(), parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+        pricingStrategy_->calculateGreeksVector(options.subspan(begin, end - begin), out.subspan(begin, end - begin));
+    });
+}
+
+std::vector<double> OptionContext::evaluateVector(const std::vector<Option>& options, VectorMethod vectorMethod,
+                                                  BatchMethod batchMethod, MetricsScope& metrics) const
+{
+    if (validationMode_ != ValidationMode::Unchecked)
+    {
+        BatchValidation validation{std::span<const Option>(options)};
+        if (screenRows(validation, metrics))
+        {
+            std::vector<double> results(options.size());
+            evaluateValidRows(validation, gatherValidRows(validation, std::span<const Option>(options)), results, batchMethod);
+            return results;
+        }
+    }
+
+    if (!runsParallel(options.size()))
+    {
+        return (pricingStrategy_.get()->*vectorMethod)(options);
+    }
+
+    std::vector<double> results(options.size());
+    evaluateChunks(options, results, batchMethod);
+    return results;
+}
+
+// The typed overloads resolve the overloaded strategy member addresses before forwarding
+void OptionContext::evaluateVector(std::span<const Option> options, std::span<double> out, SpanVectorMethod spanMethod,
+                                   BatchMethod batchMethod, MetricsScope& metrics) const
+{
+    evaluateVector<SpanVectorMethod, BatchMethod>(options, out, spanMethod, batchMethod, metrics);
+}
+
+template <typename SpanFunction, typename BatchFunction>
+void OptionContext::evaluateVector(std::span<const Option> options, std::span<double> out, const SpanFunction& spanMethod,
+                                   const BatchFunction& batchMethod, MetricsScope& metrics) const
+{
+    if (out.size() != options.size())
+    {
+        throw std::invalid_argument("Output size does not match option count.");
+    }
+
+    if (validationMode_ != ValidationMode::Unchecked)
+    {
+        BatchValidation validation{options};
+        if (screenRows(validation, metrics))
+        {
+            evaluateValidRows(validation, gatherValidRows(validation, options), out, batchMethod);
+            return;
+        }
+    }
+
+    if (!runsParallel(options.size()))
+    {
+        std::invoke(spanMethod, *pricingStrategy_, options, out);
+        return;
+    }
+
+    evaluateChunks(options, out, batchMethod);
+}
+
+void OptionContext::evaluateMatrix(const Grid<Option>& optionGrid, Grid<double>& out, MatrixMethod matrixMethod,
+                                   BatchMethod batchMethod, MetricsScope& metrics) const
+{
+    evaluateMatrix<MatrixMethod, BatchMethod>(optionGrid, out, matrixMethod, batchMethod, metrics);
+}
+
+template <typename MatrixFunction, typename BatchFunction>
+void OptionContext::evaluateMatrix(const Grid<Option>& optionGrid, Grid<double>& out, const MatrixFunction& matrixMethod,
+                                   const BatchFunction& batchMethod, MetricsScope& metrics) const
+{
+    if (validationMode_ != ValidationMode::Unchecked)
+    {
+        BatchValidation validation(optionGrid.values());
+        if (screenRows(validation, metrics))
+        {
+            out.reshape(optionGrid);
+            evaluateValidRows(validation, gatherValidRows(validation, optionGrid.values()), out.values(), batchMethod);
+            return;
+        }
+    }
+
+    if (!runsParallel(optionGrid.size()))
+    {
+        std::invoke(matrixMethod, *pricingStrategy_, optionGrid, out);
+        return;
+    }
+
+    // The grid is contiguous, so it is split like a vector regardless of row length
+    out.reshape(optionGrid);
+    evaluateChunks(optionGrid.values(), out.values(), batchMethod);
+}
+
+double* OptionContext::SurfaceVolatilities::reserve(std::size_t size)
+{
+    if (size <= StackRows)
+    {
+        return stack;
+    }
+    heap.resize(size);
+    return heap.data();
+}
+
+OptionBatchView OptionContext::resolveVolatilities(const OptionBatchView& batch, SurfaceVolatilities& vols) const
+{
+    if (!volSurface_)
+    {
+        return batch;
+    }
+    double* sig = vols.reserve(batch.size);
+    volSurface_->volatilities(std::span<const double>(batch.T, batch.size), std::span<const double>(batch.K, batch.size),
+                              std::span<double>(sig, batch.size));
+    OptionBatchView resolved = batch;
+    resolved.sig = sig;
+    return resolved;
+}
+
+template <typename BatchFunction>
+void OptionContext::evaluateBatch(const OptionBatchView& input, std::span<double> out, const BatchFunction& batchMethod,
+                                  MetricsScope& metrics) const
+{
+    SurfaceVolatilities vols;
+    OptionBatchView batch = resolveVolatilities(input, vols);
+    if (validationMode_ != ValidationMode::Unchecked)
+    {
+        if (out.size() != batch.size)
+        {
+            throw std::invalid_argument("Output size does not match option batch size.");
+        }
+
+        BatchValidation validation(batch);
+        if (screenRows(validation, metrics))
+        {
+            evaluateValidRows(validation, gatherValidRows(validation, batch), out, batchMethod);
+            return;
+        }
+    }
+
+    evaluateBatchRows(batch, out, batchMethod);
+}
+
+template <typename BatchFunction>
+void OptionContext::evaluateBatchRows(const OptionBatchView& batch, std::span<double> out, const BatchFunction& batchMethod) const
+{
+    if (!runsParallel(batch.size))
+    {
+        std::invoke(batchMethod, *pricingStrategy_, batch, out);
+        return;
+    }
+
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+
+    threadPool_->parallelFor(batch.size, parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+        std::invoke(batchMethod, *pricingStrategy_, batch.subview(begin, end - begin), out.subspan(begin, end - begin));
+    });
+}
+
+GreeksBatch OptionContext::evaluateGreeksBatch(const OptionBatchView& batch) const
+{
+    GreeksBatch greeks;
+    if (!runsParallel(batch.size))
+    {
+        pricingStrategy_->calculateGreeksBatch(batch, greeks);
+        return greeks;
+    }
+
+    greeks.resize(batch.size);
+    threadPool_->parallelFor(batch.size, parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+        GreeksBatch chunk;
+        pricingStrategy_->calculateGreeksBatch(batch.subview(begin, end - begin), chunk);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            greeks.set(i, chunk.at(i - begin));
+        }
+    });
+    return greeks;
+}
+
+void OptionContext::evaluateSweep(const ParameterGrid& grid, std::span<double> out, SweepMethod sweepMethod,
+                                  BatchMethod batchMethod, MetricsScope& metrics) const
+{
+    if (out.size() != grid.size())
+    {
+        throw std::invalid_argument("Output size does not match parameter grid size.");
+    }
+
+    // Sweeps stay lazy while every axis value is valid; only a sweep with a bad
+    // value is materialised to find out which points it affects
+    if (validationMode_ != ValidationMode::Unchecked && !isValidSweep(grid))
+    {
+        OptionBatch points;
+        grid.fill(0, grid.size(), points);
+        BatchValidation validation(points);
+        if (screenRows(validation, metrics))
+        {
+            evaluateValidRows(validation, gatherValidRows(validation, points.view()), out, batchMethod);
+            return;
+        }
+    }
+
+    if (!runsParallel(grid.size()))
+    {
+        (pricingStrategy_.get()->*sweepMethod)(grid, 0, out);
+        return;
+    }
+
+    // Chunks are plain index ranges of the sweep; each one fills its own options
+    threadPool_->parallelFor(grid.size(), parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+        (pricingStrategy_.get()->*sweepMethod)(grid, begin, out.subspan(begin, end - begin));
+    });
+}
+
+Grid<double> OptionContext::evaluateSweepMatrix(const ParameterGrid& grid, SweepMethod sweepMethod,
+                                                BatchMethod batchMethod, MetricsScope& metrics) const
+{
+    if (grid.dimensions() != 2)
+    {
+        throw std::invalid_argument("Matrix sweeps require a parameter grid with exactly two axes.");
+    }
+
+    Grid<double> out(grid.axes()[0].values, grid.axes()[1].values);
+    evaluateSweep(grid, out.values(), sweepMethod, batchMethod, metrics);
+    return out;
+}
+
+bool OptionContext::acceptOption(const Option& option, MetricsScope& metrics) const
+{
+    bool valid = validationMode_ == ValidationMode::Unchecked ? option.isValid()
+                                                              : validateOption(option) == OptionError::None;
+    if (valid)
+    {
+        return true;
+    }
+
+    metrics.reject();
+    if (validationMode_ != ValidationMode::NaN)
+    {
+        throw std::invalid_argument("Invalid option parameters.");
+    }
+    return false;
+}
+
+bool OptionContext::screenRows(const BatchValidation& validation, MetricsScope& metrics) const
+{
+    if (validation.allValid())
+    {
+        return false;
+    }
+
+    metrics.reject(validation.invalidCount());
+    if (validationMode_ == ValidationMode::Throw)
+    {
+        std::size_t row = validation.firstInvalid();
+        throw std::invalid_argument("Invalid option parameters in row " + std::to_string(row) + " ("
+                                    + describeOptionError(validation.error(row)) + "), "
+                                    + std::to_string(validation.invalidCount()) + " invalid rows in total.");
+    }
+    return true;
+}
+
+template <typename BatchFunction>
+void OptionContext::evaluateValidRows(const BatchValidation& validation, const OptionBatchView& valid,
+                                      std::span<double> out, const BatchFunction& batchMethod) const
+{
+    // Price the compacted valid rows, then scatter them back around NaN holes
+    std::vector<double> results(valid.size);
+    evaluateBatchRows(valid, results, batchMethod);
+    for (std::size_t i = 0, j = 0; i < validation.size(); ++i)
+    {
+        out[i] = validation.isValid(i) ? results[j++] : GreeksResult::NotAvailable;
+    }
+}
+
+void OptionContext::evaluateValidGreeks(const BatchValidation& validation, const OptionBatchView& valid,
+                                        std::span<GreeksResult> out) const
+{
+    GreeksBatch results = evaluateGreeksBatch(valid);
+    for (std::size_t i = 0, j = 0; i < validation.size(); ++i)
+    {
+        out[i] = validation.isValid(i) ? results.at(j++) : GreeksResult();
+    }
+}
+
 void OptionContext::validateStrategy() const
 {
     if (!pricingStrategy_)
@@ -20,7 +20,19 @@
 #include "IPricingStrategy.hpp"
 #include "IParityValidator.hpp"
 #include "Option.hpp"
+#include "OptionBatch.hpp"
+#include "BatchValidation.hpp"
+#include "Grid.hpp"
+#include "ParameterGrid.hpp"
+#include "ImpliedVolatility.hpp"
+#include "ThreadPool.hpp"
+#include "PricingMetrics.hpp"
+#include "PricingCache.hpp"
+#include "VolSurface.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 
 class OptionContext
 {
@@ -34,6 +46,41 @@ public:
     void setPricingStrategy(std::unique_ptr<IPricingStrategy> strategy);
     void setParityValidator(std::unique_ptr<IParityValidator> validator);
 
+    // Parallelism: vector, batch and matrix calls are split into chunks of
+    // parallelChunkSize options and run on the pool (single-threaded when unset).
+    // The pool can be shared between contexts; results never depend on thread count.
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
+    void setThreadCount(std::size_t threadCount); // Owned pool, 0 or 1 disables parallelism
+    std::size_t getThreadCount() const;
+    void setParallelChunkSize(std::size_t chunkSize);
+    std::size_t getParallelChunkSize() const { return parallelChunkSize_; };
+
+    // Instrumentation: call counts, latency and batch size histograms, rejected
+    // options. Off (a null test per call) until a PricingMetrics is attached;
+    // one instance may be shared by several contexts. nullptr detaches it.
+    void setMetrics(std::shared_ptr<PricingMetrics> metrics);
+    const std::shared_ptr<PricingMetrics>& getMetrics() const { return metrics_; };
+
+    // Memoization of single-option prices and Greeks, keyed on the option and the
+    // current strategy. Off until a PricingCache is attached; the cache may be
+    // shared by several contexts. Replacing the strategy drops its entries.
+    void setCache(std::shared_ptr<PricingCache> cache);
+    const std::shared_ptr<PricingCache>& getCache() const { return cache_; };
+
+    // Surface mode: when a volatility surface is attached, the batch entry points
+    // (prices, deltas, gamma, single and fused Greeks) ignore the batch's sigma
+    // column and resolve each row's volatility from the surface at (T, K) in one
+    // pass before pricing, so a chain is re-priced after a surface refresh without
+    // touching its options. Scalar, vector, matrix and sweep calls keep the
+    // options' own sigma. nullptr detaches the surface.
+    void setVolSurface(std::shared_ptr<const VolSurface> surface) { volSurface_ = std::move(surface); };
+    const std::shared_ptr<const VolSurface>& getVolSurface() const { return volSurface_; };
+
+    // Invalid input handling (see ValidationMode). Unchecked keeps bulk calls free
+    // of any scan; Throw and NaN validate each input once, up front, in one pass.
+    void setValidationMode(ValidationMode mode) { validationMode_ = mode; };
+    ValidationMode getValidationMode() const { return validationMode_; };
+
     // Single option pricing
     double calculateCallPrice(const Option& option) const;
     double calculatePutPrice(const Option& option) const;
@@ -43,34 +90,114 @@ public:
     double calculateCallDelta(const Option& option) const;
     double calculatePutDelta(const Option& option) const;
 
+    // Fused price + Greeks calculation (one pass per option)
+    GreeksResult calculateGreeks(const Option& option) const;
+    std::vector<GreeksResult> calculateGreeksVector(const std::vector<Option>& options) const;
+    void calculateGreeksVector(std::span<const Option> options, std::span<GreeksResult> out) const;
+    Grid<GreeksResult> calculateGreeksMatrix(const Grid<Option>& optionGrid) const;
+    void calculateGreeksMatrix(const Grid<Option>& optionGrid, Grid<GreeksResult>& out) const;
+    GreeksBatch calculateGreeksBatch(const OptionBatchView& batch) const;
+
+    // One sensitivity selected by Greek (vega, theta, rho, vanna, volga, speed, charm)
+    // in single, vector, matrix and batch form, with the same pool, validation and
+    // metrics handling as the quantity-specific methods
+    double calculateGreek(Greek greek, const Option& option) const;
+    std::vector<double> calculateGreekVector(Greek greek, const std::vector<Option>& options) const;
+    void calculateGreekVector(Greek greek, std::span<const Option> options, std::span<double> out) const;
+    Grid<double> calculateGreekMatrix(Greek greek, const Grid<Option>& optionGrid) const;
+    void calculateGreekMatrix(Greek greek, const Grid<Option>& optionGrid, Grid<double>& out) const;
+    std::vector<double> calculateGreekBatch(Greek greek, const OptionBatchView& batch) const;
+    void calculateGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out) const;
+
     // Vector Greeks calculation for monotonic ranges
     std::vector<double> calculateCallDeltaVector(const std::vector<Option>& options) const;
     std::vector<double> calculatePutDeltaVector(const std::vector<Option>& options) const;
     std::vector<double> calculateGammaVector(const std::vector<Option>& options) const;
 
     // Matrix Greeks calculation for parameter variations
-    std::vector<std::vector<double>> calculateCallDeltaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const;
-    std::vector<std::vector<double>> calculatePutDeltaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const;
-    std::vector<std::vector<double>> calculateGammaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const;
+    Grid<double> calculateCallDeltaMatrix(const Grid<Option>& optionGrid) const;
+    void calculateCallDeltaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const;
+    Grid<double> calculatePutDeltaMatrix(const Grid<Option>& optionGrid) const;
+    void calculatePutDeltaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const;
+    Grid<double> calculateGammaMatrix(const Grid<Option>& optionGrid) const;
+    void calculateGammaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const;
 
     // Vector pricing for monotonic ranges
     std::vector<double> calculateCallVector(const std::vector<Option>& options) const;
     std::vector<double> calculatePutVector(const std::vector<Option>& options) const;
 
-    // Matrix pricing for parameter variations
-    std::vector<std::vector<double>> calculateCallMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const;
-    std::vector<std::vector<double>> calculatePutMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const;
+    // Vector pricing and Greeks into caller-owned storage (out.size() == options.size()).
+    // Single-threaded and in Unchecked mode these never touch the heap, so a hot loop
+    // can reuse its buffers; pool chunks and validation scans still allocate.
+    void calculateCallVector(std::span<const Option> options, std::span<double> out) const;
+    void calculatePutVector(std::span<const Option> options, std::span<double> out) const;
+    void calculateCallDeltaVector(std::span<const Option> options, std::span<double> out) const;
+    void calculatePutDeltaVector(std::span<const Option> options, std::span<double> out) const;
+    void calculateGammaVector(std::span<const Option> options, std::span<double> out) const;
+
+    // Matrix pricing for parameter variations (results take the shape and labels of
+    // the option grid; the out overloads reuse the caller's storage)
+    Grid<double> calculateCallMatrix(const Grid<Option>& optionGrid) const;
+    void calculateCallMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const;
+    Grid<double> calculatePutMatrix(const Grid<Option>& optionGrid) const;
+    void calculatePutMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const;
+
+    // Batch calculation over structure-of-arrays input
+    std::vector<double> calculateCallBatch(const OptionBatchView& batch) const;
+    std::vector<double> calculatePutBatch(const OptionBatchView& batch) const;
+    std::vector<double> calculateCallDeltaBatch(const OptionBatchView& batch) const;
+    std::vector<double> calculatePutDeltaBatch(const OptionBatchView& batch) const;
+    std::vector<double> calculateGammaBatch(const OptionBatchView& batch) const;
+
+    // Batch calculation into caller-owned output (out.size() must equal batch.size)
+    void calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const;
+    void calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const;
+    void calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const;
+    void calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const;
+    void calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const;
+
+    // Parameter sweeps evaluated lazily from a base option and its axes (row-major,
+    // first axis outermost). The matrix form requires exactly two axes and labels
+    // the result with their values.
+    std::vector<double> calculateCallSweep(const ParameterGrid& grid) const;
+    std::vector<double> calculatePutSweep(const ParameterGrid& grid) const;
+    std::vector<double> calculateCallDeltaSweep(const ParameterGrid& grid) const;
+    std::vector<double> calculatePutDeltaSweep(const ParameterGrid& grid) const;
+    std::vector<double> calculateGammaSweep(const ParameterGrid& grid) const;
+    void calculateCallSweep(const ParameterGrid& grid, std::span<double> out) const;
+    void calculatePutSweep(const ParameterGrid& grid, std::span<double> out) const;
+    void calculateCallDeltaSweep(const ParameterGrid& grid, std::span<double> out) const;
+    void calculatePutDeltaSweep(const ParameterGrid& grid, std::span<double> out) const;
+    void calculateGammaSweep(const ParameterGrid& grid, std::span<double> out) const;
+    Grid<double> calculateCallMatrix(const ParameterGrid& grid) const;
+    Grid<double> calculatePutMatrix(const ParameterGrid& grid) const;
+    Grid<double> calculateCallDeltaMatrix(const ParameterGrid& grid) const;
+    Grid<double> calculatePutDeltaMatrix(const ParameterGrid& grid) const;
+    Grid<double> calculateGammaMatrix(const ParameterGrid& grid) const;
+
+    // Implied volatility from market prices (each option's own sigma is ignored).
+    // Every contract reports its convergence status; the batch form runs in chunks
+    // on the pool like the pricing batches.
+    ImpliedVolResult calculateImpliedVolatility(const Option& option, double price, OptionType type,
+                                                const ImpliedVolSettings& settings = {}) const;
+    std::vector<ImpliedVolResult> calculateImpliedVolatilityBatch(const OptionBatchView& batch,
+                                                                  std::span<const double> prices, OptionType type,
+                                                                  const ImpliedVolSettings& settings = {}) const;
+    void calculateImpliedVolatilityBatch(const OptionBatchView& batch, std::span<const double> prices,
+                                         OptionType type, const ImpliedVolSettings& settings,
+                                         std::span<ImpliedVolResult> out) const;
 
     // Put-Call Parity
     bool verifyParity(const Option& option, double tolerance = 1e-6) const;
     double callFromPutParity(const Option& option, double putPrice) const;
     double putFromCallParity(const Option& option, double callPrice) const;
 
+    // Parity audit of a whole book from prices already computed for it, in one
+    // vectorised pass; nothing is re-priced. Returns the violating rows only.
+    ParityAudit auditParity(const OptionBatchView& batch, std::span<const double> callPrices,
+                            std::span<const double> putPrices, double tolerance = 1e-6) const;
+    ParityAudit auditParity(const OptionBatchView& batch, const GreeksBatch& results, double tolerance = 1e-6) const;
+
     // Utility functions
     std::string getCurrentStrategyName() const;
 
@@ -78,6 +205,79 @@ private:
 
     std::unique_ptr<IPricingStrategy> pricingStrategy_; // Strategy for pricing options
     std::unique_ptr<IParityValidator> parityValidator_; // Validator for put-call parity
+    std::shared_ptr<ThreadPool> threadPool_; // Executor for vector/matrix workloads (optional)
+    std::size_t parallelChunkSize_ = 4096; // Options per chunk: inputs + outputs fit in L2
+    std::shared_ptr<PricingMetrics> metrics_; // Call/latency counters (optional)
+    ValidationMode validationMode_ = ValidationMode::Unchecked; // Handling of invalid rows
+    std::shared_ptr<PricingCache> cache_; // Single-option result memo (optional)
+    std::shared_ptr<const VolSurface> volSurface_; // Volatility source of the batch calls (optional)
+    std::uint64_t strategyId_; // Cache identity of the current strategy, renewed by setPricingStrategy
+
+    using ScalarMethod = double (IPricingStrategy::*)(const Option&) const;
+    using VectorMethod = std::vector<double> (IPricingStrategy::*)(const std::vector<Option>&) const;
+    using SpanVectorMethod = void (IPricingStrategy::*)(std::span<const Option>, std::span<double>) const;
+    using MatrixMethod = void (IPricingStrategy::*)(const Grid<Option>&, Grid<double>&) const;
+    using BatchMethod = void (IPricingStrategy::*)(const OptionBatchView&, std::span<double>) const;
+    using SweepMethod = void (IPricingStrategy::*)(const ParameterGrid&, std::size_t, std::span<double>) const;
+
+    // Single-option call through the cache, when one is attached
+    double evaluateCached(const Option& option, CachedQuantity quantity, ScalarMethod scalarMethod) const;
+
+    // Parallel dispatch helpers (fall back to a direct strategy call without a pool).
+    // The span, matrix and batch functions are strategy member pointers or callables
+    // taking the strategy first, both invoked through std::invoke.
+    bool runsParallel(std::size_t count) const;
+    template <typename BatchFunction>
+    void evaluateChunks(std::span<const Option> options, std::span<double> out, const BatchFunction& batchMethod) const;
+    void evaluateGreeksChunks(std::span<const Option> options, std::span<GreeksResult> out) const;
+    std::vector<double> evaluateVector(const std::vector<Option>& options, VectorMethod vectorMethod,
+                                       BatchMethod batchMethod, MetricsScope& metrics) const;
+    void evaluateVector(std::span<const Option> options, std::span<double> out, SpanVectorMethod spanMethod,
+                        BatchMethod batchMethod, MetricsScope& metrics) const;
+    template <typename SpanFunction, typename BatchFunction>
+    void evaluateVector(std::span<const Option> options, std::span<double> out, const SpanFunction& spanMethod,
+                        const BatchFunction& batchMethod, MetricsScope& metrics) const;
+    void evaluateMatrix(const Grid<Option>& optionGrid, Grid<double>& out, MatrixMethod matrixMethod,
+                        BatchMethod batchMethod, MetricsScope& metrics) const;
+    template <typename MatrixFunction, typename BatchFunction>
+    void evaluateMatrix(const Grid<Option>& optionGrid, Grid<double>& out, const MatrixFunction& matrixMethod,
+                        const BatchFunction& batchMethod, MetricsScope& metrics) const;
+    template <typename BatchFunction>
+    void evaluateBatch(const OptionBatchView& batch, std::span<double> out, const BatchFunction& batchMethod,
+                       MetricsScope& metrics) const;
+    template <typename BatchFunction>
+    void evaluateBatchRows(const OptionBatchView& batch, std::span<double> out, const BatchFunction& batchMethod) const;
+    GreeksBatch evaluateGreeksBatch(const OptionBatchView& batch) const;
+    void evaluateSweep(const ParameterGrid& grid, std::span<double> out, SweepMethod sweepMethod,
+                       BatchMethod batchMethod, MetricsScope& metrics) const;
+    Grid<double> evaluateSweepMatrix(const ParameterGrid& grid, SweepMethod sweepMethod,
+                                     BatchMethod batchMethod, MetricsScope& metrics) const;
+
+    // Surface volatilities of one call. The storage belongs to the calling frame, so chunks
+    // running on the pool (and nested calls on the same thread) never share it; batches of
+    // up to StackRows rows stay on the stack.
+    struct SurfaceVolatilities
+    {
+        static constexpr std::size_t StackRows = 256;
+
+        alignas(64) double stack[StackRows];
+        OptionBatch::Column heap;
+
+        double* reserve(std::size_t size);
+    };
+
+    // Surface mode: batch with its sigma column replaced by surface volatilities held in vols
+    OptionBatchView resolveVolatilities(const OptionBatchView& batch, SurfaceVolatilities& vols) const;
+
+    // Invalid row handling: acceptOption() is false when a single option should
+    // yield NaN, screenRows() is true when scanned rows must be masked out
+    bool acceptOption(const Option& option, MetricsScope& metrics) const;
+    bool screenRows(const BatchValidation& validation, MetricsScope& metrics) const;
+    template <typename BatchFunction>
+    void evaluateValidRows(const BatchValidation& validation, const OptionBatchView& valid,
+                           std::span<double> out, const BatchFunction& batchMethod) const;
+    void evaluateValidGreeks(const BatchValidation& validation, const OptionBatchView& valid,
+                             std::span<GreeksResult> out) const;
 
     // Validation functions
     void validateStrategy() const;
@@ -0,0 +1,540 @@
+#ifndef STATICOPTIONCONTEXT_HPP
+#define STATICOPTIONCONTEXT_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "IPricingStrategy.hpp"
+#include "Option.hpp"
+#include "OptionBatch.hpp"
+#include "Grid.hpp"
+#include "ParameterGrid.hpp"
+#include "ImpliedVolatility.hpp"
+#include "ThreadPool.hpp"
+#include "PutCallParityValidator.hpp"
+#include "BlackScholesPricer.hpp"
+#include "BlackScholesFormula.hpp"
+
+/**
+ * @brief Strategy usable by StaticOptionContext: a final IPricingStrategy
+ *
+ * Final is what lets the compiler turn every call on the held strategy into
+ * a direct (and inlinable) call instead of a virtual one.
+ */
+template <typename Strategy>
+concept StaticPricingStrategy = std::derived_from<Strategy, IPricingStrategy> && std::is_final_v<Strategy>;
+
+/**
+ * @brief OptionContext with the pricing strategy fixed at compile time
+ *
+ * Holds the strategy by value and offers the OptionContext API (pricing,
+ * Greeks, vector/matrix/batch/sweep, implied volatility, parity and the
+ * thread pool settings) without the indirection of the runtime-polymorphic
+ * context: there is no null strategy to check and no virtual call between
+ * the context and the strategy. Use OptionContext when the model has to be
+ * chosen or swapped at runtime; metrics are only recorded there.
+ *
+ * On top of that API, price/delta/gamma take the option side, the carry model
+ * and (for Black-Scholes) the normal CDF as template arguments. With
+ * BlackScholesPricer they are the header-only formulas of BlackScholesFormula,
+ * so a caller's loop over them compiles to one inlined body; other strategies
+ * are called directly on a copy of the option with the model's cost of carry.
+ *
+ *     StaticOptionContext<BlackScholesPricer> context;
+ *     double futuresCall = context.price<OptionType::Call, CarryModel::Futures>(option);
+ */
+template <StaticPricingStrategy Strategy>
+class StaticOptionContext
+{
+public:
+
+    StaticOptionContext() = default;
+    explicit StaticOptionContext(Strategy strategy) : strategy_(std::move(strategy)) {};
+
+    // Strategy access (configuration such as settings or CDF mode goes through here)
+    Strategy& strategy() { return strategy_; };
+    const Strategy& strategy() const { return strategy_; };
+
+    // Parallelism, as in OptionContext
+    void setThreadPool(std::shared_ptr<ThreadPool> pool) { threadPool_ = std::move(pool); };
+    void setThreadCount(std::size_t threadCount)
+    {
+        threadPool_ = threadCount > 1 ? std::make_shared<ThreadPool>(threadCount) : nullptr;
+    }
+    std::size_t getThreadCount() const { return threadPool_ ? threadPool_->threadCount() : 1; };
+    void setParallelChunkSize(std::size_t chunkSize)
+    {
+        if (chunkSize == 0)
+        {
+            throw std::invalid_argument("Parallel chunk size must be positive.");
+        }
+        parallelChunkSize_ = chunkSize;
+    }
+    std::size_t getParallelChunkSize() const { return parallelChunkSize_; };
+
+    // Compile-time option side, carry model and normal CDF
+    template <OptionType Type, CarryModel Carry = CarryModel::Currency, NormalCdfMode Cdf = NormalCdfMode::Accurate>
+    double price(const Option& option) const
+    {
+        validateOption(option);
+        if constexpr (std::is_same_v<Strategy, BlackScholesPricer>)
+        {
+            return blackScholesPrice<Type, Carry, Cdf>(option);
+        }
+        else if constexpr (Type == OptionType::Call)
+        {
+            return strategy_.calculateCallPrice(withCarry<Carry>(option));
+        }
+        else
+        {
+            return strategy_.calculatePutPrice(withCarry<Carry>(option));
+        }
+    }
+
+    template <OptionType Type, CarryModel Carry = CarryModel::Currency, NormalCdfMode Cdf = NormalCdfMode::Accurate>
+    double delta(const Option& option) const
+    {
+        validateOption(option);
+        if constexpr (std::is_same_v<Strategy, BlackScholesPricer>)
+        {
+            return blackScholesDelta<Type, Carry, Cdf>(option);
+        }
+        else if constexpr (Type == OptionType::Call)
+        {
+            return strategy_.calculateCallDelta(withCarry<Carry>(option));
+        }
+        else
+        {
+            return strategy_.calculatePutDelta(withCarry<Carry>(option));
+        }
+    }
+
+    template <CarryModel Carry = CarryModel::Currency>
+    double gamma(const Option& option) const
+    {
+        validateOption(option);
+        if constexpr (std::is_same_v<Strategy, BlackScholesPricer>)
+        {
+            return blackScholesGamma<Carry>(option);
+        }
+        else
+        {
+            return strategy_.calculateGamma(withCarry<Carry>(option));
+        }
+    }
+
+    // Single option pricing
+    double calculateCallPrice(const Option& option) const { validateOption(option); return strategy_.calculateCallPrice(option); };
+    double calculatePutPrice(const Option& option) const { validateOption(option); return strategy_.calculatePutPrice(option); };
+
+    // Greeks calculation
+    double calculateGamma(const Option& option) const { validateOption(option); return strategy_.calculateGamma(option); };
+    double calculateCallDelta(const Option& option) const { validateOption(option); return strategy_.calculateCallDelta(option); };
+    double calculatePutDelta(const Option& option) const { validateOption(option); return strategy_.calculatePutDelta(option); };
+
+    // Fused price + Greeks, and one Greek selected at run time
+    GreeksResult calculateGreeks(const Option& option) const { validateOption(option); return strategy_.calculateGreeks(option); };
+    double calculateGreek(Greek greek, const Option& option) const { validateOption(option); return strategy_.calculateGreek(greek, option); };
+    std::vector<GreeksResult> calculateGreeksVector(const std::vector<Option>& options) const
+    {
+        std::vector<GreeksResult> results(options.size());
+        calculateGreeksVector(std::span<const Option>(options), results);
+        return results;
+    }
+    void calculateGreeksVector(std::span<const Option> options, std::span<GreeksResult> out) const
+    {
+        if (out.size() != options.size())
+        {
+            throw std::invalid_argument("Output size does not match option count.");
+        }
+        if (!runsParallel(options.size()))
+        {
+            strategy_.calculateGreeksVector(options, out);
+            return;
+        }
+        evaluateGreeksChunks(options, out);
+    }
+    Grid<GreeksResult> calculateGreeksMatrix(const Grid<Option>& optionGrid) const
+    {
+        Grid<GreeksResult> out;
+        calculateGreeksMatrix(optionGrid, out);
+        return out;
+    }
+    void calculateGreeksMatrix(const Grid<Option>& optionGrid, Grid<GreeksResult>& out) const
+    {
+        if (!runsParallel(optionGrid.size()))
+        {
+            strategy_.calculateGreeksMatrix(optionGrid, out);
+            return;
+        }
+        out.reshape(optionGrid);
+        evaluateGreeksChunks(optionGrid.values(), out.values());
+    }
+    GreeksBatch calculateGreeksBatch(const OptionBatchView& batch) const
+    {
+        GreeksBatch greeks;
+        if (!runsParallel(batch.size))
+        {
+            strategy_.calculateGreeksBatch(batch, greeks);
+            return greeks;
+        }
+
+        greeks.resize(batch.size);
+        threadPool_->parallelFor(batch.size, parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+            GreeksBatch chunk;
+            strategy_.calculateGreeksBatch(batch.subview(begin, end - begin), chunk);
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                greeks.set(i, chunk.at(i - begin));
+            }
+        });
+        return greeks;
+    }
+
+    // Vector pricing and Greeks
+    std::vector<double> calculateCallVector(const std::vector<Option>& options) const
+    {
+        return evaluateVector<&Strategy::calculateCallVector, &Strategy::calculateCallBatch>(options);
+    }
+    std::vector<double> calculatePutVector(const std::vector<Option>& options) const
+    {
+        return evaluateVector<&Strategy::calculatePutVector, &Strategy::calculatePutBatch>(options);
+    }
+    std::vector<double> calculateCallDeltaVector(const std::vector<Option>& options) const
+    {
+        return evaluateVector<&Strategy::calculateCallDeltaVector, &Strategy::calculateCallDeltaBatch>(options);
+    }
+    std::vector<double> calculatePutDeltaVector(const std::vector<Option>& options) const
+    {
+        return evaluateVector<&Strategy::calculatePutDeltaVector, &Strategy::calculatePutDeltaBatch>(options);
+    }
+    std::vector<double> calculateGammaVector(const std::vector<Option>& options) const
+    {
+        return evaluateVector<&Strategy::calculateGammaVector, &Strategy::calculateGammaBatch>(options);
+    }
+
+    // Vector pricing and Greeks into caller-owned storage; no heap allocation when single-threaded
+    void calculateCallVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateVector<&Strategy::calculateCallBatch>(options, out, [this](std::span<const Option> in, std::span<double> results) {
+            strategy_.calculateCallVector(in, results);
+        });
+    }
+    void calculatePutVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateVector<&Strategy::calculatePutBatch>(options, out, [this](std::span<const Option> in, std::span<double> results) {
+            strategy_.calculatePutVector(in, results);
+        });
+    }
+    void calculateCallDeltaVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateVector<&Strategy::calculateCallDeltaBatch>(options, out, [this](std::span<const Option> in, std::span<double> results) {
+            strategy_.calculateCallDeltaVector(in, results);
+        });
+    }
+    void calculatePutDeltaVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateVector<&Strategy::calculatePutDeltaBatch>(options, out, [this](std::span<const Option> in, std::span<double> results) {
+            strategy_.calculatePutDeltaVector(in, results);
+        });
+    }
+    void calculateGammaVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateVector<&Strategy::calculateGammaBatch>(options, out, [this](std::span<const Option> in, std::span<double> results) {
+            strategy_.calculateGammaVector(in, results);
+        });
+    }
+
+    // Matrix pricing and Greeks
+    Grid<double> calculateCallMatrix(const Grid<Option>& optionGrid) const { return returnGrid(optionGrid, &StaticOptionContext::calculateCallMatrix); };
+    Grid<double> calculatePutMatrix(const Grid<Option>& optionGrid) const { return returnGrid(optionGrid, &StaticOptionContext::calculatePutMatrix); };
+    Grid<double> calculateCallDeltaMatrix(const Grid<Option>& optionGrid) const { return returnGrid(optionGrid, &StaticOptionContext::calculateCallDeltaMatrix); };
+    Grid<double> calculatePutDeltaMatrix(const Grid<Option>& optionGrid) const { return returnGrid(optionGrid, &StaticOptionContext::calculatePutDeltaMatrix); };
+    Grid<double> calculateGammaMatrix(const Grid<Option>& optionGrid) const { return returnGrid(optionGrid, &StaticOptionContext::calculateGammaMatrix); };
+    void calculateCallMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        if (runsParallel(optionGrid.size()))
+        {
+            evaluateGridChunks<&Strategy::calculateCallBatch>(optionGrid, out);
+            return;
+        }
+        strategy_.calculateCallMatrix(optionGrid, out);
+    }
+    void calculatePutMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        if (runsParallel(optionGrid.size()))
+        {
+            evaluateGridChunks<&Strategy::calculatePutBatch>(optionGrid, out);
+            return;
+        }
+        strategy_.calculatePutMatrix(optionGrid, out);
+    }
+    void calculateCallDeltaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        if (runsParallel(optionGrid.size()))
+        {
+            evaluateGridChunks<&Strategy::calculateCallDeltaBatch>(optionGrid, out);
+            return;
+        }
+        strategy_.calculateCallDeltaMatrix(optionGrid, out);
+    }
+    void calculatePutDeltaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        if (runsParallel(optionGrid.size()))
+        {
+            evaluateGridChunks<&Strategy::calculatePutDeltaBatch>(optionGrid, out);
+            return;
+        }
+        strategy_.calculatePutDeltaMatrix(optionGrid, out);
+    }
+    void calculateGammaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        if (runsParallel(optionGrid.size()))
+        {
+            evaluateGridChunks<&Strategy::calculateGammaBatch>(optionGrid, out);
+            return;
+        }
+        strategy_.calculateGammaMatrix(optionGrid, out);
+    }
+
+    // Batch calculation over structure-of-arrays input
+    std::vector<double> calculateCallBatch(const OptionBatchView& batch) const { return returnBatch<&Strategy::calculateCallBatch>(batch); };
+    std::vector<double> calculatePutBatch(const OptionBatchView& batch) const { return returnBatch<&Strategy::calculatePutBatch>(batch); };
+    std::vector<double> calculateCallDeltaBatch(const OptionBatchView& batch) const { return returnBatch<&Strategy::calculateCallDeltaBatch>(batch); };
+    std::vector<double> calculatePutDeltaBatch(const OptionBatchView& batch) const { return returnBatch<&Strategy::calculatePutDeltaBatch>(batch); };
+    std::vector<double> calculateGammaBatch(const OptionBatchView& batch) const { return returnBatch<&Strategy::calculateGammaBatch>(batch); };
+    void calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const { evaluateBatch<&Strategy::calculateCallBatch>(batch, out); };
+    void calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const { evaluateBatch<&Strategy::calculatePutBatch>(batch, out); };
+    void calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const { evaluateBatch<&Strategy::calculateCallDeltaBatch>(batch, out); };
+    void calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const { evaluateBatch<&Strategy::calculatePutDeltaBatch>(batch, out); };
+    void calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const { evaluateBatch<&Strategy::calculateGammaBatch>(batch, out); };
+
+    // Lazy parameter sweeps
+    std::vector<double> calculateCallSweep(const ParameterGrid& grid) const { return returnSweep<&Strategy::calculateCallSweep>(grid); };
+    std::vector<double> calculatePutSweep(const ParameterGrid& grid) const { return returnSweep<&Strategy::calculatePutSweep>(grid); };
+    std::vector<double> calculateCallDeltaSweep(const ParameterGrid& grid) const { return returnSweep<&Strategy::calculateCallDeltaSweep>(grid); };
+    std::vector<double> calculatePutDeltaSweep(const ParameterGrid& grid) const { return returnSweep<&Strategy::calculatePutDeltaSweep>(grid); };
+    std::vector<double> calculateGammaSweep(const ParameterGrid& grid) const { return returnSweep<&Strategy::calculateGammaSweep>(grid); };
+    void calculateCallSweep(const ParameterGrid& grid, std::span<double> out) const { evaluateSweep<&Strategy::calculateCallSweep>(grid, out); };
+    void calculatePutSweep(const ParameterGrid& grid, std::span<double> out) const { evaluateSweep<&Strategy::calculatePutSweep>(grid, out); };
+    void calculateCallDeltaSweep(const ParameterGrid& grid, std::span<double> out) const { evaluateSweep<&Strategy::calculateCallDeltaSweep>(grid, out); };
+    void calculatePutDeltaSweep(const ParameterGrid& grid, std::span<double> out) const { evaluateSweep<&Strategy::calculatePutDeltaSweep>(grid, out); };
+    void calculateGammaSweep(const ParameterGrid& grid, std::span<double> out) const { evaluateSweep<&Strategy::calculateGammaSweep>(grid, out); };
+    Grid<double> calculateCallMatrix(const ParameterGrid& grid) const { return evaluateSweepMatrix<&Strategy::calculateCallSweep>(grid); };
+    Grid<double> calculatePutMatrix(const ParameterGrid& grid) const { return evaluateSweepMatrix<&Strategy::calculatePutSweep>(grid); };
+    Grid<double> calculateCallDeltaMatrix(const ParameterGrid& grid) const { return evaluateSweepMatrix<&Strategy::calculateCallDeltaSweep>(grid); };
+    Grid<double> calculatePutDeltaMatrix(const ParameterGrid& grid) const { return evaluateSweepMatrix<&Strategy::calculatePutDeltaSweep>(grid); };
+    Grid<double> calculateGammaMatrix(const ParameterGrid& grid) const { return evaluateSweepMatrix<&Strategy::calculateGammaSweep>(grid); };
+
+    // Implied volatility from market prices
+    ImpliedVolResult calculateImpliedVolatility(const Option& option, double price, OptionType type,
+                                                const ImpliedVolSettings& settings = {}) const
+    {
+        return strategy_.calculateImpliedVolatility(option, price, type, settings);
+    }
+    std::vector<ImpliedVolResult> calculateImpliedVolatilityBatch(const OptionBatchView& batch,
+                                                                  std::span<const double> prices, OptionType type,
+                                                                  const ImpliedVolSettings& settings = {}) const
+    {
+        std::vector<ImpliedVolResult> results(batch.size);
+        calculateImpliedVolatilityBatch(batch, prices, type, settings, results);
+        return results;
+    }
+    void calculateImpliedVolatilityBatch(const OptionBatchView& batch, std::span<const double> prices,
+                                         OptionType type, const ImpliedVolSettings& settings,
+                                         std::span<ImpliedVolResult> out) const
+    {
+        if (prices.size() != batch.size || out.size() != batch.size)
+        {
+            throw std::invalid_argument("Price and output sizes must match option batch size.");
+        }
+        if (!runsParallel(batch.size))
+        {
+            strategy_.calculateImpliedVolatilityBatch(batch, prices, type, settings, out);
+            return;
+        }
+        threadPool_->parallelFor(batch.size, parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+            std::size_t count = end - begin;
+            strategy_.calculateImpliedVolatilityBatch(batch.subview(begin, count), prices.subspan(begin, count),
+                                                      type, settings, out.subspan(begin, count));
+        });
+    }
+
+    // Put-call parity (PutCallParityValidator)
+    bool verifyParity(const Option& option, double tolerance = 1e-6) const
+    {
+        validateOption(option);
+        return parityValidator_.validateParity(option, strategy_.calculateCallPrice(option),
+                                               strategy_.calculatePutPrice(option), tolerance);
+    }
+    double callFromPutParity(const Option& option, double putPrice) const
+    {
+        validateOption(option);
+        return parityValidator_.callFromPut(option, putPrice);
+    }
+    double putFromCallParity(const Option& option, double callPrice) const
+    {
+        validateOption(option);
+        return parityValidator_.putFromCall(option, callPrice);
+    }
+
+    // Utility functions
+    std::string getCurrentStrategyName() const { return strategy_.getName(); };
+
+private:
+
+    Strategy strategy_;
+    PutCallParityValidator parityValidator_;
+    std::shared_ptr<ThreadPool> threadPool_; // Executor for vector/matrix workloads (optional)
+    std::size_t parallelChunkSize_ = 4096; // Options per chunk: inputs + outputs fit in L2
+
+    static void validateOption(const Option& option)
+    {
+        if (!option.isValid())
+        {
+            throw std::invalid_argument("Invalid option parameters.");
+        }
+    }
+
+    // Copy of the option with the carry model's cost of carry
+    template <CarryModel Carry>
+    static Option withCarry(const Option& option)
+    {
+        return Option(option.ExerciseDate(), option.StrikePrice(), option.Volatility(), option.RiskFreeRate(),
+                      option.AssetPrice(), costOfCarry<Carry>(option));
+    }
+
+    bool runsParallel(std::size_t count) const { return threadPool_ && count > parallelChunkSize_; };
+
+    // The member pointers below are template arguments, so every call through them is direct
+
+    template <auto BatchMethod>
+    void evaluateChunks(std::span<const Option> options, std::span<double> out) const
+    {
+        threadPool_->parallelFor(options.size(), parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+            OptionBatch chunk(options.subspan(begin, end - begin));
+            (strategy_.*BatchMethod)(chunk, out.subspan(begin, end - begin));
+        });
+    }
+
+    void evaluateGreeksChunks(std::span<const Option> options, std::span<GreeksResult> out) const
+    {
+        threadPool_->parallelFor(options.size(), parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+            strategy_.calculateGreeksVector(options.subspan(begin, end - begin), out.subspan(begin, end - begin));
+        });
+    }
+
+    // Typed, so the address picks the std::vector overload among the span ones
+    using VectorFunction = std::vector<double> (Strategy::*)(const std::vector<Option>&) const;
+
+    template <VectorFunction VectorMethod, auto BatchMethod>
+    std::vector<double> evaluateVector(const std::vector<Option>& options) const
+    {
+        if (!runsParallel(options.size()))
+        {
+            return (strategy_.*VectorMethod)(options);
+        }
+        std::vector<double> results(options.size());
+        evaluateChunks<BatchMethod>(options, results);
+        return results;
+    }
+
+    template <auto BatchMethod, typename SerialMethod>
+    void evaluateVector(std::span<const Option> options, std::span<double> out, SerialMethod serialMethod) const
+    {
+        if (out.size() != options.size())
+        {
+            throw std::invalid_argument("Output size does not match option count.");
+        }
+        if (!runsParallel(options.size()))
+        {
+            serialMethod(options, out);
+            return;
+        }
+        evaluateChunks<BatchMethod>(options, out);
+    }
+
+    template <auto BatchMethod>
+    void evaluateGridChunks(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        out.reshape(optionGrid);
+        evaluateChunks<BatchMethod>(optionGrid.values(), out.values());
+    }
+
+    Grid<double> returnGrid(const Grid<Option>& optionGrid,
+                            void (StaticOptionContext::*method)(const Grid<Option>&, Grid<double>&) const) const
+    {
+        Grid<double> out;
+        (this->*method)(optionGrid, out);
+        return out;
+    }
+
+    template <auto BatchMethod>
+    void evaluateBatch(const OptionBatchView& batch, std::span<double> out) const
+    {
+        if (!runsParallel(batch.size))
+        {
+            (strategy_.*BatchMethod)(batch, out);
+            return;
+        }
+        if (out.size() != batch.size)
+        {
+            throw std::invalid_argument("Output size does not match option batch size.");
+        }
+        threadPool_->parallelFor(batch.size, parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+            (strategy_.*BatchMethod)(batch.subview(begin, end - begin), out.subspan(begin, end - begin));
+        });
+    }
+
+    template <auto BatchMethod>
+    std::vector<double> returnBatch(const OptionBatchView& batch) const
+    {
+        std::vector<double> results(batch.size);
+        evaluateBatch<BatchMethod>(batch, results);
+        return results;
+    }
+
+    template <auto SweepMethod>
+    void evaluateSweep(const ParameterGrid& grid, std::span<double> out) const
+    {
+        if (out.size() != grid.size())
+        {
+            throw std::invalid_argument("Output size does not match parameter grid size.");
+        }
+        if (!runsParallel(grid.size()))
+        {
+            (strategy_.*SweepMethod)(grid, 0, out);
+            return;
+        }
+        threadPool_->parallelFor(grid.size(), parallelChunkSize_, [&](std::size_t begin, std::size_t end) {
+            (strategy_.*SweepMethod)(grid, begin, out.subspan(begin, end - begin));
+        });
+    }
+
+    template <auto SweepMethod>
+    std::vector<double> returnSweep(const ParameterGrid& grid) const
+    {
+        std::vector<double> results(grid.size());
+        evaluateSweep<SweepMethod>(grid, results);
+        return results;
+    }
+
+    template <auto SweepMethod>
+    Grid<double> evaluateSweepMatrix(const ParameterGrid& grid) const
+    {
+        if (grid.dimensions() != 2)
+        {
+            throw std::invalid_argument("Matrix sweeps require a parameter grid with exactly two axes.");
+        }
+        Grid<double> out(grid.axes()[0].values, grid.axes()[1].values);
+        evaluateSweep<SweepMethod>(grid, out.values());
+        return out;
+    }
+};
+
+#endif // STATICOPTIONCONTEXT_HPP
@@ -0,0 +1,189 @@
+#include "BatchValidation.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+    // Error flags of one row as a double, so that a loop over whole columns keeps
+    // one element type and vectorises. Comparisons are false for NaN, so NaN
+    // inputs also raise the matching NonPositive flag, as isValid() would, and
+    // x * 0 is 0 exactly when x is finite. Distinct bits add up like an OR.
+    inline double errorFlags(double T, double K, double sig, double r, double S, double b)
+    {
+        double finite = T * 0.0 + K * 0.0 + sig * 0.0 + r * 0.0 + S * 0.0 + b * 0.0;
+        return (T > 0.0 ? 0.0 : 1.0) + (K > 0.0 ? 0.0 : 2.0) + (sig > 0.0 ? 0.0 : 4.0)
+             + (S > 0.0 ? 0.0 : 8.0) + (finite == 0.0 ? 0.0 : 16.0);
+    }
+
+    constexpr std::size_t ScanBlock = 256; // Rows per scan block, a multiple of 64
+}
+
+std::string describeOptionError(OptionError code)
+{
+    if (code == OptionError::None)
+    {
+        return "None";
+    }
+
+    static constexpr std::pair<OptionError, const char*> names[] = {
+        {OptionError::NonPositiveExpiry, "NonPositiveExpiry"},
+        {OptionError::NonPositiveStrike, "NonPositiveStrike"},
+        {OptionError::NonPositiveVolatility, "NonPositiveVolatility"},
+        {OptionError::NonPositiveAssetPrice, "NonPositiveAssetPrice"},
+        {OptionError::NonFinite, "NonFinite"}};
+
+    std::string text;
+    for (const auto& [flag, name] : names)
+    {
+        if (hasError(code, flag))
+        {
+            text += text.empty() ? name : std::string(", ") + name;
+        }
+    }
+    return text;
+}
+
+OptionError validateOption(const Option& option)
+{
+    return static_cast<OptionError>(static_cast<std::uint8_t>(errorFlags(option.ExerciseDate(), option.StrikePrice(), option.Volatility(),
+                                               option.RiskFreeRate(), option.AssetPrice(), option.CostOfCarry())));
+}
+
+bool isValidParameter(OptionParameter parameter, double value)
+{
+    bool finite = value * 0.0 == 0.0;
+    if (parameter == OptionParameter::RiskFreeRate || parameter == OptionParameter::CostOfCarry)
+    {
+        return finite;
+    }
+    return finite && value > 0.0;
+}
+
+bool isValidSweep(const ParameterGrid& grid)
+{
+    // A point is valid iff each of its six values is, so checking every axis
+    // value and every fixed base value covers all points
+    constexpr OptionParameter parameters[] = {
+        OptionParameter::ExerciseDate, OptionParameter::StrikePrice, OptionParameter::Volatility,
+        OptionParameter::RiskFreeRate, OptionParameter::AssetPrice, OptionParameter::CostOfCarry};
+
+    for (OptionParameter parameter : parameters)
+    {
+        if (!grid.varies(parameter) && !isValidParameter(parameter, grid.value(parameter, 0)))
+        {
+            return false;
+        }
+    }
+    for (const ParameterGrid::Axis& axis : grid.axes())
+    {
+        for (double value : axis.values)
+        {
+            if (!isValidParameter(axis.parameter, value))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+BatchValidation::BatchValidation(const OptionBatchView& batch) : errors_(batch.size)
+{
+    // Flags are computed block by block into a small double buffer, then
+    // narrowed to error codes; both loops are vectorised by the compiler
+    double flags[ScanBlock];
+    for (std::size_t begin = 0; begin < batch.size; begin += ScanBlock)
+    {
+        std::size_t count = std::min(ScanBlock, batch.size - begin);
+        const double* T = batch.T + begin;
+        const double* K = batch.K + begin;
+        const double* sig = batch.sig + begin;
+        const double* r = batch.r + begin;
+        const double* S = batch.S + begin;
+        const double* b = batch.b + begin;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            flags[i] = errorFlags(T[i], K[i], sig[i], r[i], S[i], b[i]);
+        }
+
+        OptionError* errors = errors_.data() + begin;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            errors[i] = static_cast<OptionError>(static_cast<std::uint8_t>(flags[i]));
+        }
+    }
+    buildMask();
+}
+
+BatchValidation::BatchValidation(std::span<const Option> options) : errors_(options.size())
+{
+    for (std::size_t i = 0; i < options.size(); ++i)
+    {
+        errors_[i] = validateOption(options[i]);
+    }
+    buildMask();
+}
+
+std::size_t BatchValidation::firstInvalid() const
+{
+    for (std::size_t word = 0; word < mask_.size(); ++word)
+    {
+        // Bits past size() are clear in the last word, so they never read as valid
+        std::uint64_t invalid = ~mask_[word];
+        if (invalid != 0)
+        {
+            std::size_t i = word * 64 + static_cast<std::size_t>(std::countr_zero(invalid));
+            return i < size() ? i : size();
+        }
+    }
+    return size();
+}
+
+std::vector<std::size_t> BatchValidation::validRows() const
+{
+    std::vector<std::size_t> rows;
+    rows.reserve(size() - invalidCount_);
+    for (std::size_t word = 0; word < mask_.size(); ++word)
+    {
+        for (std::uint64_t bits = mask_[word]; bits != 0; bits &= bits - 1)
+        {
+            rows.push_back(word * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+        }
+    }
+    return rows;
+}
+
+void BatchValidation::buildMask()
+{
+    std::size_t count = errors_.size();
+    mask_.assign((count + 63) / 64, 0);
+    std::size_t valid = 0;
+    for (std::size_t word = 0; word < mask_.size(); ++word)
+    {
+        std::size_t begin = word * 64;
+        std::size_t end = std::min(begin + 64, count);
+        std::uint64_t bits = 0;
+        std::size_t i = begin;
+
+        // Eight codes at a time: set the top bit of every non-zero byte, then
+        // gather those top bits into one byte with a multiply (a portable movemask)
+        for (; i + 8 <= end; i += 8)
+        {
+            std::uint64_t codes;
+            std::memcpy(&codes, errors_.data() + i, sizeof(codes));
+            constexpr std::uint64_t Low7 = 0x7F7F7F7F7F7F7F7Full;
+            std::uint64_t nonZero = (((codes & Low7) + Low7) | codes) & ~Low7;
+            std::uint64_t invalid = ((nonZero >> 7) * 0x0102040810204080ull) >> 56;
+            bits |= (~invalid & 0xFF) << (i - begin);
+        }
+        for (; i < end; ++i)
+        {
+            bits |= static_cast<std::uint64_t>(errors_[i] == OptionError::None) << (i - begin);
+        }
+        mask_[word] = bits;
+        valid += static_cast<std::size_t>(std::popcount(bits));
+    }
+    invalidCount_ = count - valid;
+}
@@ -0,0 +1,102 @@
+#ifndef BATCHVALIDATION_HPP
+#define BATCHVALIDATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "Option.hpp"
+#include "OptionBatch.hpp"
+#include "ParameterGrid.hpp"
+
+/*
+    @brief Reasons an option row cannot be priced, as combinable bit flags
+    The first four mirror Option::isValid(); NonFinite additionally catches
+    NaN or infinite inputs, including r and b, which isValid() does not read.
+*/
+enum class OptionError : std::uint8_t
+{
+    None = 0,
+    NonPositiveExpiry = 1 << 0,
+    NonPositiveStrike = 1 << 1,
+    NonPositiveVolatility = 1 << 2,
+    NonPositiveAssetPrice = 1 << 3,
+    NonFinite = 1 << 4
+};
+
+inline OptionError operator | (OptionError lhs, OptionError rhs)
+{
+    return static_cast<OptionError>(static_cast<std::uint8_t>(lhs) | static_cast<std::uint8_t>(rhs));
+}
+
+// True when code contains the flag
+inline bool hasError(OptionError code, OptionError flag)
+{
+    return (static_cast<std::uint8_t>(code) & static_cast<std::uint8_t>(flag)) != 0;
+}
+
+// Comma separated names of the flags in code ("None" for a valid row)
+std::string describeOptionError(OptionError code);
+
+// Error flags of a single option
+OptionError validateOption(const Option& option);
+
+// Whether a value is acceptable for the parameter (finite; positive except for r and b)
+bool isValidParameter(OptionParameter parameter, double value);
+
+// True when every point of the sweep is valid, checked in O(sum of axis lengths)
+bool isValidSweep(const ParameterGrid& grid);
+
+/*
+    @brief How OptionContext treats invalid rows
+    - Unchecked: vector, matrix and batch calls price every row as given;
+      single-option calls throw (the historical behaviour, and the default)
+    - Throw: every call scans its input first and throws std::invalid_argument
+      naming the first bad row
+    - NaN: bad rows come back as NaN (GreeksResult::NotAvailable) and are
+      counted as rejected; the valid rows are priced as usual. Nothing throws
+      for bad data, so one bad quote cannot abort a large revaluation
+*/
+enum class ValidationMode
+{
+    Unchecked,
+    Throw,
+    NaN
+};
+
+/*
+    @brief Result of one validation pass over a batch: per-row error codes plus a validity bitmask
+    The scan is a single branch-free loop over the columns that the compiler
+    vectorises; bit i % 64 of validMask()[i / 64] is set when row i is valid.
+*/
+class BatchValidation
+{
+public:
+
+    BatchValidation() = default;
+    explicit BatchValidation(const OptionBatchView& batch);
+    explicit BatchValidation(std::span<const Option> options);
+
+    std::size_t size() const { return errors_.size(); };
+    std::size_t invalidCount() const { return invalidCount_; };
+    bool allValid() const { return invalidCount_ == 0; };
+
+    bool isValid(std::size_t i) const { return (mask_[i / 64] >> (i % 64)) & 1; };
+    OptionError error(std::size_t i) const { return errors_[i]; };
+    std::size_t firstInvalid() const; // size() when every row is valid
+    std::vector<std::size_t> validRows() const; // Ascending indices of the valid rows
+
+    std::span<const OptionError> errors() const { return errors_; };
+    std::span<const std::uint64_t> validMask() const { return mask_; };
+
+private:
+
+    void buildMask();
+
+    std::vector<OptionError> errors_;
+    std::vector<std::uint64_t> mask_;
+    std::size_t invalidCount_ = 0;
+};
+
+#endif // BATCHVALIDATION_HPP
@@ -0,0 +1,177 @@
+#ifndef GREEKSRESULT_HPP
+#define GREEKSRESULT_HPP
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "AlignedAllocator.hpp"
+
+/*
+    @brief Sensitivities selectable one at a time (prices, deltas and gamma have their own methods)
+    - Vega: dV/dsig, same for calls and puts
+    - CallTheta / PutTheta: calendar decay dV/dt per year
+    - CallRho / PutRho: dV/dr with the carry spread b - r held fixed
+    - Vanna: d2V/dS dsig, same for calls and puts
+    - Volga: d2V/dsig2 (vomma), same for calls and puts
+    - Speed: d3V/dS3 = dGamma/dS, same for calls and puts
+    - CallCharm / PutCharm: calendar delta decay dDelta/dt per year
+*/
+enum class Greek
+{
+    Vega,
+    CallTheta,
+    PutTheta,
+    CallRho,
+    PutRho,
+    Vanna,
+    Volga,
+    Speed,
+    CallCharm,
+    PutCharm
+};
+
+/*
+    @brief Prices and sensitivities of one option, for both call and put
+    Produced by a single fused evaluation that shares d1/d2, the normal
+    CDF/PDF values and the discount factors. Theta and charm are calendar
+    decays d/dt per year; rho holds the carry spread b - r fixed.
+    Quantities a strategy cannot provide are left as NaN.
+*/
+struct GreeksResult
+{
+    static constexpr double NotAvailable = std::numeric_limits<double>::quiet_NaN();
+
+    double callPrice = NotAvailable;
+    double putPrice = NotAvailable;
+    double callDelta = NotAvailable;
+    double putDelta = NotAvailable;
+    double gamma = NotAvailable;     // Same for calls and puts
+    double vega = NotAvailable;      // Same for calls and puts
+    double callTheta = NotAvailable;
+    double putTheta = NotAvailable;
+    double callRho = NotAvailable;
+    double putRho = NotAvailable;
+    double vanna = NotAvailable;     // Same for calls and puts
+    double volga = NotAvailable;     // Same for calls and puts
+    double speed = NotAvailable;     // Same for calls and puts
+    double callCharm = NotAvailable;
+    double putCharm = NotAvailable;
+
+    // Field selected by greek
+    double value(Greek greek) const
+    {
+        switch (greek)
+        {
+            case Greek::Vega:      return vega;
+            case Greek::CallTheta: return callTheta;
+            case Greek::PutTheta:  return putTheta;
+            case Greek::CallRho:   return callRho;
+            case Greek::PutRho:    return putRho;
+            case Greek::Vanna:     return vanna;
+            case Greek::Volga:     return volga;
+            case Greek::Speed:     return speed;
+            case Greek::CallCharm: return callCharm;
+            case Greek::PutCharm:  return putCharm;
+        }
+        return NotAvailable;
+    };
+};
+
+/*
+    @brief Structure-of-arrays counterpart of GreeksResult for batch kernels
+    One aligned column per field of GreeksResult.
+*/
+class GreeksBatch
+{
+public:
+
+    using Column = std::vector<double, AlignedAllocator<double>>;
+
+    GreeksBatch() = default;
+    explicit GreeksBatch(std::size_t size) { resize(size); };
+
+    std::size_t size() const { return callPrice.size(); };
+
+    void resize(std::size_t size)
+    {
+        for (Column* column : columns())
+        {
+            column->resize(size);
+        }
+    };
+
+    // Scatter one AoS result into row i
+    void set(std::size_t i, const GreeksResult& result)
+    {
+        callPrice[i] = result.callPrice;
+        putPrice[i] = result.putPrice;
+        callDelta[i] = result.callDelta;
+        putDelta[i] = result.putDelta;
+        gamma[i] = result.gamma;
+        vega[i] = result.vega;
+        callTheta[i] = result.callTheta;
+        putTheta[i] = result.putTheta;
+        callRho[i] = result.callRho;
+        putRho[i] = result.putRho;
+        vanna[i] = result.vanna;
+        volga[i] = result.volga;
+        speed[i] = result.speed;
+        callCharm[i] = result.callCharm;
+        putCharm[i] = result.putCharm;
+    };
+
+    // Gather one row into the AoS result
+    GreeksResult at(std::size_t i) const
+    {
+        return {callPrice[i], putPrice[i], callDelta[i], putDelta[i], gamma[i],
+                vega[i], callTheta[i], putTheta[i], callRho[i], putRho[i],
+                vanna[i], volga[i], speed[i], callCharm[i], putCharm[i]};
+    };
+
+    Column callPrice;
+    Column putPrice;
+    Column callDelta;
+    Column putDelta;
+    Column gamma;
+    Column vega;
+    Column callTheta;
+    Column putTheta;
+    Column callRho;
+    Column putRho;
+    Column vanna;
+    Column volga;
+    Column speed;
+    Column callCharm;
+    Column putCharm;
+
+private:
+
+    std::array<Column*, 15> columns()
+    {
+        return {&callPrice, &putPrice, &callDelta, &putDelta, &gamma,
+                &vega, &callTheta, &putTheta, &callRho, &putRho,
+                &vanna, &volga, &speed, &callCharm, &putCharm};
+    };
+};
+
+/*
+    @brief Price of one option side and its sensitivity to each Option input
+    Produced by one reverse sweep (adjoint mode). Each partial holds the other
+    five inputs fixed, so dV/dr keeps b fixed: GreeksResult's rho, which keeps
+    b - r fixed, is dR + dB and its theta is -dT.
+*/
+struct AdjointResult
+{
+    static constexpr double NotAvailable = std::numeric_limits<double>::quiet_NaN();
+
+    double price = NotAvailable;
+    double dT = NotAvailable;     // d/d exercise date
+    double dK = NotAvailable;     // d/d strike
+    double dSig = NotAvailable;   // d/d volatility (vega)
+    double dR = NotAvailable;     // d/d risk-free rate
+    double dS = NotAvailable;     // d/d spot (delta)
+    double dB = NotAvailable;     // d/d cost of carry
+};
+
+#endif // GREEKSRESULT_HPP
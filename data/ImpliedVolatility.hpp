@@ -0,0 +1,117 @@
+#ifndef IMPLIEDVOLATILITY_HPP
+#define IMPLIEDVOLATILITY_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/*
+    @brief Outcome of an implied volatility inversion
+    The numeric values are part of the batch kernel interface.
+*/
+enum class ImpliedVolStatus : std::uint8_t
+{
+    Converged = 0,        // Volatility found within tolerance
+    MaxIterations = 1,    // Iteration limit reached; volatility holds the last estimate
+    BelowIntrinsic = 2,   // Price at or below the no-arbitrage lower bound
+    AboveMaximum = 3,     // Price at or above the no-arbitrage upper bound
+    InvalidInput = 4      // Non-positive T, K or S, or a NaN input
+};
+
+/*
+    @brief Convergence settings of the implied volatility solvers
+*/
+struct ImpliedVolSettings
+{
+    double tolerance = 1e-12;          // Relative change of the volatility that ends the iteration
+    std::size_t maxIterations = 32;    // Iterations per contract
+    double searchLower = 1e-4;         // Volatility bracket of the model-independent search
+    double searchUpper = 5.0;
+};
+
+/*
+    @brief Implied volatility of one contract with its convergence status
+*/
+struct ImpliedVolResult
+{
+    static constexpr double NotAvailable = std::numeric_limits<double>::quiet_NaN();
+
+    double volatility = NotAvailable;
+    std::uint32_t iterations = 0;
+    ImpliedVolStatus status = ImpliedVolStatus::InvalidInput;
+
+    bool converged() const { return status == ImpliedVolStatus::Converged; };
+};
+
+/**
+ * @brief Model-independent implied volatility search
+ *
+ * Illinois (modified regula falsi) iteration on price(sigma) - target over
+ * [searchLower, searchUpper]. Needs only a price function that increases
+ * with volatility, so it serves every strategy, including lattice and PDE
+ * pricers with early exercise.
+ *
+ * @param price Callable double(double sigma) returning the model price
+ * @param target Market price to reproduce
+ */
+template <typename PriceFunction>
+ImpliedVolResult searchImpliedVolatility(PriceFunction price, double target, const ImpliedVolSettings& settings)
+{
+    ImpliedVolResult result;
+    if (!std::isfinite(target))
+    {
+        return result;
+    }
+
+    double lower = settings.searchLower, upper = settings.searchUpper;
+    double fLower = price(lower) - target;
+    double fUpper = price(upper) - target;
+    if (fLower > 0.0)
+    {
+        result.status = ImpliedVolStatus::BelowIntrinsic;
+        return result;
+    }
+    if (fUpper < 0.0)
+    {
+        result.status = ImpliedVolStatus::AboveMaximum;
+        return result;
+    }
+
+    // The side that was kept twice in a row has its function value halved
+    int side = 0;
+    double sigma = lower;
+    result.status = ImpliedVolStatus::MaxIterations;
+    for (std::size_t iteration = 1; iteration <= settings.maxIterations; ++iteration)
+    {
+        result.iterations = static_cast<std::uint32_t>(iteration);
+        double previous = sigma;
+        sigma = (lower * fUpper - upper * fLower) / (fUpper - fLower);
+        double fSigma = price(sigma) - target;
+
+        if (fSigma == 0.0 || std::abs(sigma - previous) <= settings.tolerance * sigma)
+        {
+            result.status = ImpliedVolStatus::Converged;
+            break;
+        }
+        if (fSigma > 0.0)
+        {
+            upper = sigma;
+            fUpper = fSigma;
+            fLower = side == -1 ? 0.5 * fLower : fLower;
+            side = -1;
+        }
+        else
+        {
+            lower = sigma;
+            fLower = fSigma;
+            fUpper = side == 1 ? 0.5 * fUpper : fUpper;
+            side = 1;
+        }
+    }
+
+    result.volatility = sigma;
+    return result;
+}
+
+#endif // IMPLIEDVOLATILITY_HPP
@@ -3,6 +3,37 @@
 
 #include <string>
 
+/*
+    @brief Call or put, for APIs that price one side per call
+*/
+enum class OptionType
+{
+    Call,
+    Put
+};
+
+/*
+    @brief Exercise right of an option, for strategies that support early exercise
+*/
+enum class ExerciseStyle
+{
+    European,
+    American
+};
+
+/*
+    @brief Cost-of-carry model, for APIs that fix b at compile time
+    - Stock: b = r (Black-Scholes 1973), the option's own b is ignored
+    - Futures: b = 0 (Black 1976)
+    - Currency: b = r - rf (Garman-Kohlhagen), read from the option's b
+*/
+enum class CarryModel
+{
+    Stock,
+    Futures,
+    Currency
+};
+
 /*
     @brief Option data model
     Encapsulates parameters for option pricing
@@ -0,0 +1,108 @@
+#include "OptionBatch.hpp"
+#include <stdexcept>
+
+OptionBatchView OptionBatchView::subview(std::size_t offset, std::size_t count) const
+{
+    if (offset > size || count > size - offset)
+    {
+        throw std::out_of_range("Subview exceeds option batch bounds.");
+    }
+
+    return {T + offset, K + offset, sig + offset, r + offset, S + offset, b + offset, count};
+}
+
+OptionBatch::OptionBatch(std::size_t size)
+    : T_(size), K_(size), sig_(size), r_(size), S_(size), b_(size)
+{
+}
+
+OptionBatch::OptionBatch(std::span<const Option> options)
+    : OptionBatch(options.size())
+{
+    for (std::size_t i = 0; i < options.size(); ++i)
+    {
+        set(i, options[i]);
+    }
+}
+
+void OptionBatch::assign(std::span<const Option> options)
+{
+    resize(options.size());
+    for (std::size_t i = 0; i < options.size(); ++i)
+    {
+        set(i, options[i]);
+    }
+}
+
+void OptionBatch::reserve(std::size_t capacity)
+{
+    T_.reserve(capacity);
+    K_.reserve(capacity);
+    sig_.reserve(capacity);
+    r_.reserve(capacity);
+    S_.reserve(capacity);
+    b_.reserve(capacity);
+}
+
+void OptionBatch::resize(std::size_t size)
+{
+    T_.resize(size);
+    K_.resize(size);
+    sig_.resize(size);
+    r_.resize(size);
+    S_.resize(size);
+    b_.resize(size);
+}
+
+void OptionBatch::clear()
+{
+    resize(0);
+}
+
+void OptionBatch::push_back(const Option& option)
+{
+    T_.push_back(option.ExerciseDate());
+    K_.push_back(option.StrikePrice());
+    sig_.push_back(option.Volatility());
+    r_.push_back(option.RiskFreeRate());
+    S_.push_back(option.AssetPrice());
+    b_.push_back(option.CostOfCarry());
+}
+
+void OptionBatch::set(std::size_t i, const Option& option)
+{
+    T_[i] = option.ExerciseDate();
+    K_[i] = option.StrikePrice();
+    sig_[i] = option.Volatility();
+    r_[i] = option.RiskFreeRate();
+    S_[i] = option.AssetPrice();
+    b_[i] = option.CostOfCarry();
+}
+
+Option OptionBatch::at(std::size_t i) const
+{
+    if (i >= size())
+    {
+        throw std::out_of_range("Option batch index out of range.");
+    }
+
+    return Option(T_[i], K_[i], sig_[i], r_[i], S_[i], b_[i]);
+}
+
+std::vector<Option> OptionBatch::toOptions() const
+{
+    std::vector<Option> options;
+    options.reserve(size());
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        options.emplace_back(T_[i], K_[i], sig_[i], r_[i], S_[i], b_[i]);
+    }
+
+    return options;
+}
+
+OptionBatchView OptionBatch::view() const
+{
+    return {T_.data(), K_.data(), sig_.data(), r_.data(), S_.data(), b_.data(), size()};
+}
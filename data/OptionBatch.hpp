@@ -0,0 +1,89 @@
+#ifndef OPTIONBATCH_HPP
+#define OPTIONBATCH_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "Option.hpp"
+#include "AlignedAllocator.hpp"
+
+/*
+    @brief Non-owning, read-only structure-of-arrays view over a batch of options
+    Each pointer addresses one contiguous parameter column of length size.
+*/
+struct OptionBatchView
+{
+    const double* T = nullptr;     // Exercise dates
+    const double* K = nullptr;     // Strike prices
+    const double* sig = nullptr;   // Volatilities
+    const double* r = nullptr;     // Risk-free interest rates
+    const double* S = nullptr;     // Underlying asset prices
+    const double* b = nullptr;     // Cost-of-carry parameters
+    std::size_t size = 0;
+
+    // Rows [offset, offset + count) of this view
+    OptionBatchView subview(std::size_t offset, std::size_t count) const;
+
+    // Materialise a single row as an Option
+    Option option(std::size_t i) const { return Option(T[i], K[i], sig[i], r[i], S[i], b[i]); };
+};
+
+/*
+    @brief Structure-of-arrays option container
+    Stores T/K/sig/r/S/b as separate cache-line aligned columns so batch
+    kernels can stream each parameter with vector loads.
+*/
+class OptionBatch
+{
+public:
+
+    using Column = std::vector<double, AlignedAllocator<double>>;
+
+    OptionBatch() = default; // Empty batch
+    explicit OptionBatch(std::size_t size); // Zero-initialised batch of given size
+    explicit OptionBatch(std::span<const Option> options); // Transpose AoS into SoA
+
+    // Size management
+    std::size_t size() const { return T_.size(); };
+    bool empty() const { return T_.empty(); };
+    void reserve(std::size_t capacity);
+    void resize(std::size_t size);
+    void clear();
+    void assign(std::span<const Option> options); // Transpose AoS into SoA, reusing capacity
+
+    // Row access
+    void push_back(const Option& option);
+    void set(std::size_t i, const Option& option);
+    Option at(std::size_t i) const;
+    std::vector<Option> toOptions() const;
+
+    // Column access
+    std::span<double> ExerciseDates() { return T_; };
+    std::span<double> StrikePrices() { return K_; };
+    std::span<double> Volatilities() { return sig_; };
+    std::span<double> RiskFreeRates() { return r_; };
+    std::span<double> AssetPrices() { return S_; };
+    std::span<double> CostsOfCarry() { return b_; };
+
+    std::span<const double> ExerciseDates() const { return T_; };
+    std::span<const double> StrikePrices() const { return K_; };
+    std::span<const double> Volatilities() const { return sig_; };
+    std::span<const double> RiskFreeRates() const { return r_; };
+    std::span<const double> AssetPrices() const { return S_; };
+    std::span<const double> CostsOfCarry() const { return b_; };
+
+    // Views
+    OptionBatchView view() const;
+    operator OptionBatchView() const { return view(); };
+
+private:
+
+    Column T_;     // Exercise dates
+    Column K_;     // Strike prices
+    Column sig_;   // Volatilities
+    Column r_;     // Risk-free interest rates
+    Column S_;     // Underlying asset prices
+    Column b_;     // Cost-of-carry parameters
+};
+
+#endif // OPTIONBATCH_HPP
@@ -0,0 +1,165 @@
+#include "ParameterGrid.hpp"
+#include "MeshUtils.hpp"
+#include <stdexcept>
+#include <utility>
+
+ParameterGrid::ParameterGrid(const Option& base)
+    : base_(base)
+{
+}
+
+ParameterGrid& ParameterGrid::addAxis(OptionParameter parameter, std::vector<double> values)
+{
+    if (values.empty())
+    {
+        throw std::invalid_argument("Parameter grid axis must not be empty.");
+    }
+    if (varies(parameter))
+    {
+        throw std::invalid_argument("Parameter grid already has an axis for this parameter.");
+    }
+
+    // The new axis is innermost, every existing axis now steps over all of its values
+    for (Axis& axis : axes_)
+    {
+        axis.stride *= values.size();
+    }
+    size_ *= values.size();
+    axes_.push_back({parameter, std::move(values), 1});
+
+    return *this;
+}
+
+ParameterGrid& ParameterGrid::addAxis(OptionParameter parameter, double start, double end, double meshSize)
+{
+    return addAxis(parameter, meshArray(start, end, meshSize));
+}
+
+std::vector<std::size_t> ParameterGrid::shape() const
+{
+    std::vector<std::size_t> result;
+    result.reserve(axes_.size());
+
+    for (const Axis& axis : axes_)
+    {
+        result.push_back(axis.values.size());
+    }
+
+    return result;
+}
+
+bool ParameterGrid::varies(OptionParameter parameter) const
+{
+    return findAxis(parameter) != nullptr;
+}
+
+std::size_t ParameterGrid::spotStrikeLineLength() const
+{
+    std::size_t length = 1;
+
+    for (auto axis = axes_.rbegin(); axis != axes_.rend(); ++axis)
+    {
+        if (axis->parameter != OptionParameter::AssetPrice && axis->parameter != OptionParameter::StrikePrice)
+        {
+            break;
+        }
+        length *= axis->values.size();
+    }
+
+    return length;
+}
+
+double ParameterGrid::value(OptionParameter parameter, std::size_t index) const
+{
+    const Axis* axis = findAxis(parameter);
+    if (!axis)
+    {
+        return baseValue(parameter);
+    }
+
+    return axis->values[(index / axis->stride) % axis->values.size()];
+}
+
+Option ParameterGrid::option(std::size_t index) const
+{
+    if (index >= size_)
+    {
+        throw std::out_of_range("Parameter grid index out of range.");
+    }
+
+    return Option(value(OptionParameter::ExerciseDate, index), value(OptionParameter::StrikePrice, index),
+                  value(OptionParameter::Volatility, index), value(OptionParameter::RiskFreeRate, index),
+                  value(OptionParameter::AssetPrice, index), value(OptionParameter::CostOfCarry, index));
+}
+
+void ParameterGrid::fillColumn(OptionParameter parameter, std::size_t begin, std::size_t count, double* out) const
+{
+    if (begin > size_ || count > size_ - begin)
+    {
+        throw std::out_of_range("Range exceeds parameter grid bounds.");
+    }
+
+    const Axis* axis = findAxis(parameter);
+    if (!axis)
+    {
+        double constant = baseValue(parameter);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = constant;
+        }
+        return;
+    }
+
+    // Walk the axis position incrementally instead of dividing per point
+    std::size_t position = (begin / axis->stride) % axis->values.size();
+    std::size_t offset = begin % axis->stride;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = axis->values[position];
+        if (++offset == axis->stride)
+        {
+            offset = 0;
+            if (++position == axis->values.size())
+            {
+                position = 0;
+            }
+        }
+    }
+}
+
+void ParameterGrid::fill(std::size_t begin, std::size_t count, OptionBatch& out) const
+{
+    out.resize(count);
+    fillColumn(OptionParameter::ExerciseDate, begin, count, out.ExerciseDates().data());
+    fillColumn(OptionParameter::StrikePrice, begin, count, out.StrikePrices().data());
+    fillColumn(OptionParameter::Volatility, begin, count, out.Volatilities().data());
+    fillColumn(OptionParameter::RiskFreeRate, begin, count, out.RiskFreeRates().data());
+    fillColumn(OptionParameter::AssetPrice, begin, count, out.AssetPrices().data());
+    fillColumn(OptionParameter::CostOfCarry, begin, count, out.CostsOfCarry().data());
+}
+
+const ParameterGrid::Axis* ParameterGrid::findAxis(OptionParameter parameter) const
+{
+    for (const Axis& axis : axes_)
+    {
+        if (axis.parameter == parameter)
+        {
+            return &axis;
+        }
+    }
+    return nullptr;
+}
+
+double ParameterGrid::baseValue(OptionParameter parameter) const
+{
+    switch (parameter)
+    {
+        case OptionParameter::ExerciseDate: return base_.ExerciseDate();
+        case OptionParameter::StrikePrice:  return base_.StrikePrice();
+        case OptionParameter::Volatility:   return base_.Volatility();
+        case OptionParameter::RiskFreeRate: return base_.RiskFreeRate();
+        case OptionParameter::AssetPrice:   return base_.AssetPrice();
+        case OptionParameter::CostOfCarry:  return base_.CostOfCarry();
+    }
+    return 0.0;
+}
@@ -0,0 +1,80 @@
+#ifndef PARAMETERGRID_HPP
+#define PARAMETERGRID_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Option.hpp"
+#include "OptionBatch.hpp"
+
+/**
+ * @brief Option parameter that can be swept along a ParameterGrid axis
+ */
+enum class OptionParameter
+{
+    ExerciseDate,
+    StrikePrice,
+    Volatility,
+    RiskFreeRate,
+    AssetPrice,
+    CostOfCarry
+};
+
+/*
+    @brief Lazy description of a parameter sweep: a base option plus N varying axes
+    Points are numbered row-major: the first axis added is the outermost, the
+    last one varies fastest. No per-point Option is ever stored; parameters are
+    computed from the axis values on demand, so a sweep costs the sum of its
+    axis lengths in memory rather than six doubles per point.
+    Parameters are independent: sweeping r does not move b, even if the base
+    option was built with the stock default b = r.
+*/
+class ParameterGrid
+{
+public:
+
+    struct Axis
+    {
+        OptionParameter parameter;
+        std::vector<double> values;
+        std::size_t stride; // Points between consecutive values of this axis
+    };
+
+    explicit ParameterGrid(const Option& base);
+
+    // Append an axis as the new innermost (fastest varying) dimension
+    ParameterGrid& addAxis(OptionParameter parameter, std::vector<double> values);
+    ParameterGrid& addAxis(OptionParameter parameter, double start, double end, double meshSize); // meshArray values
+
+    // Shape
+    const Option& base() const { return base_; };
+    const std::vector<Axis>& axes() const { return axes_; };
+    std::size_t dimensions() const { return axes_.size(); };
+    std::vector<std::size_t> shape() const;
+    std::size_t size() const { return size_; };
+    bool varies(OptionParameter parameter) const;
+
+    // Number of innermost points along which only spot and strike vary (1 if the
+    // innermost axis is T, sigma, r or b). Pricers hoist everything else out of such lines.
+    std::size_t spotStrikeLineLength() const;
+
+    // Point access
+    double value(OptionParameter parameter, std::size_t index) const;
+    Option option(std::size_t index) const;
+
+    // Write one parameter of points [begin, begin + count) into out
+    void fillColumn(OptionParameter parameter, std::size_t begin, std::size_t count, double* out) const;
+
+    // Transpose points [begin, begin + count) into a batch (resized to count)
+    void fill(std::size_t begin, std::size_t count, OptionBatch& out) const;
+
+private:
+
+    const Axis* findAxis(OptionParameter parameter) const;
+    double baseValue(OptionParameter parameter) const;
+
+    Option base_;              // Values of all parameters without an axis
+    std::vector<Axis> axes_;   // Outermost first
+    std::size_t size_ = 1;     // Product of the axis lengths
+};
+
+#endif // PARAMETERGRID_HPP
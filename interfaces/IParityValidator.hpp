@@ -2,6 +2,33 @@
 #define IPARITYVALIDATOR_HPP
 
 #include "../data/Option.hpp"
+#include "../data/OptionBatch.hpp"
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief One option that failed a parity audit
+ */
+struct ParityViolation
+{
+    std::size_t index;     // Row in the audited batch
+    double difference;     // (C - P) - (S e^((b-r)T) - K e^(-rT)); NaN if it could not be evaluated
+};
+
+/**
+ * @brief Outcome of a parity audit over a batch: only the violations are kept
+ */
+struct ParityAudit
+{
+    std::size_t checked = 0;
+    double maxAbsDifference = 0.0;              // Largest |difference| that is not NaN
+    std::vector<ParityViolation> violations;    // Ascending index order
+
+    bool passed() const { return violations.empty(); };
+};
 
 /**
  * @brief Interface for Put-Call Parity validation and calculations
@@ -24,6 +51,34 @@ public:
     // Utility
     virtual double calculateParityDifference(const Option& option,
                                            double callPrice, double putPrice) const = 0;
+
+    // Batch audit: every row whose |difference| exceeds tolerance (or is NaN) is a violation.
+    // The default evaluates calculateParityDifference row by row.
+    virtual ParityAudit auditParity(const OptionBatchView& batch, std::span<const double> callPrices,
+                                    std::span<const double> putPrices, double tolerance = 1e-6) const
+    {
+        if (callPrices.size() != batch.size || putPrices.size() != batch.size)
+        {
+            throw std::invalid_argument("Price sizes must match option batch size.");
+        }
+
+        ParityAudit audit;
+        audit.checked = batch.size;
+        for (std::size_t i = 0; i < batch.size; ++i)
+        {
+            double difference = calculateParityDifference(batch.option(i), callPrices[i], putPrices[i]);
+            double magnitude = std::abs(difference);
+            if (magnitude > audit.maxAbsDifference)
+            {
+                audit.maxAbsDifference = magnitude;
+            }
+            if (!(magnitude <= tolerance))
+            {
+                audit.violations.push_back({i, difference});
+            }
+        }
+        return audit;
+    }
 };
 
 #endif // IPARITYVALIDATOR_HPP
\ No newline at end of file
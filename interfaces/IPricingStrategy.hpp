@@ -1,9 +1,18 @@
 #ifndef IPRICINGSTRATEGY_HPP
 #define IPRICINGSTRATEGY_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include "Option.hpp"
+#include "OptionBatch.hpp"
+#include "GreeksResult.hpp"
+#include "ImpliedVolatility.hpp"
+#include "Grid.hpp"
+#include "ParameterGrid.hpp"
 
 /**
  * @brief Interface for option pricing strategies
@@ -21,11 +30,44 @@ public:
     virtual std::vector<double> calculateCallVector(const std::vector<Option>& options) const = 0;
     virtual std::vector<double> calculatePutVector(const std::vector<Option>& options) const = 0;
 
-    // Matrix pricing for parameter variations
-    virtual std::vector<std::vector<double>> calculateCallMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const = 0;
-    virtual std::vector<std::vector<double>> calculatePutMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const = 0;
+    // Vector pricing into caller-owned storage (out.size() == options.size()). The
+    // defaults transpose the options block by block into stack buffers and run the
+    // batch method on each block. The transpose itself never allocates; whether the
+    // call as a whole is allocation-free depends on the batch methods, which holds
+    // for BlackScholesPricer only (the Monte Carlo, lattice and FDM batches build
+    // per-call groupings and path or grid buffers).
+    virtual void calculateCallVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateOptions(options, out, &IPricingStrategy::calculateCallBatch);
+    }
+    virtual void calculatePutVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateOptions(options, out, &IPricingStrategy::calculatePutBatch);
+    }
+
+    // Matrix pricing for parameter variations. Results are written into out,
+    // which takes the shape and axis labels of the option grid. The defaults
+    // transpose the grid once and run the batch method over all of its values.
+    virtual void calculateCallMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        evaluateGrid(optionGrid, out, &IPricingStrategy::calculateCallBatch);
+    }
+    virtual void calculatePutMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        evaluateGrid(optionGrid, out, &IPricingStrategy::calculatePutBatch);
+    }
+    Grid<double> calculateCallMatrix(const Grid<Option>& optionGrid) const
+    {
+        Grid<double> out;
+        calculateCallMatrix(optionGrid, out);
+        return out;
+    }
+    Grid<double> calculatePutMatrix(const Grid<Option>& optionGrid) const
+    {
+        Grid<double> out;
+        calculatePutMatrix(optionGrid, out);
+        return out;
+    }
 
     // Greeks calculation
     virtual double calculateGamma(const Option& option) const = 0;
@@ -37,17 +79,327 @@ public:
     virtual std::vector<double> calculatePutDeltaVector(const std::vector<Option>& options) const = 0;
     virtual std::vector<double> calculateGammaVector(const std::vector<Option>& options) const = 0;
 
+    // Vector Greeks into caller-owned storage, as the span pricing overloads
+    virtual void calculateCallDeltaVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateOptions(options, out, &IPricingStrategy::calculateCallDeltaBatch);
+    }
+    virtual void calculatePutDeltaVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateOptions(options, out, &IPricingStrategy::calculatePutDeltaBatch);
+    }
+    virtual void calculateGammaVector(std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateOptions(options, out, &IPricingStrategy::calculateGammaBatch);
+    }
+
     // Matrix Greeks calculation for parameter variations
-    virtual std::vector<std::vector<double>> calculateCallDeltaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const = 0;
-    virtual std::vector<std::vector<double>> calculatePutDeltaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const = 0;
-    virtual std::vector<std::vector<double>> calculateGammaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const = 0;
+    virtual void calculateCallDeltaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        evaluateGrid(optionGrid, out, &IPricingStrategy::calculateCallDeltaBatch);
+    }
+    virtual void calculatePutDeltaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        evaluateGrid(optionGrid, out, &IPricingStrategy::calculatePutDeltaBatch);
+    }
+    virtual void calculateGammaMatrix(const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        evaluateGrid(optionGrid, out, &IPricingStrategy::calculateGammaBatch);
+    }
+    Grid<double> calculateCallDeltaMatrix(const Grid<Option>& optionGrid) const
+    {
+        Grid<double> out;
+        calculateCallDeltaMatrix(optionGrid, out);
+        return out;
+    }
+    Grid<double> calculatePutDeltaMatrix(const Grid<Option>& optionGrid) const
+    {
+        Grid<double> out;
+        calculatePutDeltaMatrix(optionGrid, out);
+        return out;
+    }
+    Grid<double> calculateGammaMatrix(const Grid<Option>& optionGrid) const
+    {
+        Grid<double> out;
+        calculateGammaMatrix(optionGrid, out);
+        return out;
+    }
+
+    // Fused price + Greeks calculation. The defaults assemble the result from the
+    // individual methods and leave vega/theta/rho as NaN; strategies that can share
+    // intermediate results across outputs override them.
+    virtual GreeksResult calculateGreeks(const Option& option) const
+    {
+        GreeksResult result;
+        result.callPrice = calculateCallPrice(option);
+        result.putPrice = calculatePutPrice(option);
+        if (supportsGreeks())
+        {
+            result.callDelta = calculateCallDelta(option);
+            result.putDelta = calculatePutDelta(option);
+            result.gamma = calculateGamma(option);
+        }
+        return result;
+    }
+    virtual std::vector<GreeksResult> calculateGreeksVector(const std::vector<Option>& options) const
+    {
+        std::vector<GreeksResult> results;
+        results.reserve(options.size());
+        for (const auto& option : options)
+        {
+            results.push_back(calculateGreeks(option));
+        }
+        return results;
+    }
+    // Fused Greeks into caller-owned storage (out.size() == options.size()). The
+    // default transposes blocks of options on the stack like the span pricing
+    // overloads and runs calculateGreeksBatch() on each, through one GreeksBatch
+    // reused across the blocks; the matrix default runs it over the whole grid.
+    virtual void calculateGreeksVector(std::span<const Option> options, std::span<GreeksResult> out) const
+    {
+        GreeksBatch greeks;
+        evaluateOptions(options, out, [&](const OptionBatchView& block, std::span<GreeksResult> blockOut)
+        {
+            calculateGreeksBatch(block, greeks);
+            for (std::size_t i = 0; i < block.size; ++i)
+            {
+                blockOut[i] = greeks.at(i);
+            }
+        });
+    }
+    virtual void calculateGreeksMatrix(const Grid<Option>& optionGrid, Grid<GreeksResult>& out) const
+    {
+        out.reshape(optionGrid);
+        calculateGreeksVector(optionGrid.values(), out.values());
+    }
+    Grid<GreeksResult> calculateGreeksMatrix(const Grid<Option>& optionGrid) const
+    {
+        Grid<GreeksResult> out;
+        calculateGreeksMatrix(optionGrid, out);
+        return out;
+    }
+
+    // One sensitivity selected by Greek. The scalar default picks the field from
+    // calculateGreeks() (NaN where the strategy provides none) and the batch default
+    // runs it row by row; strategies with analytic kernels override the batch form.
+    // Vector and matrix forms go through the batch method block by block.
+    virtual double calculateGreek(Greek greek, const Option& option) const
+    {
+        return calculateGreeks(option).value(greek);
+    }
+    virtual void calculateGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out) const
+    {
+        if (out.size() != batch.size)
+        {
+            throw std::invalid_argument("Output size does not match option batch size.");
+        }
+        for (std::size_t i = 0; i < batch.size; ++i)
+        {
+            out[i] = calculateGreek(greek, batch.option(i));
+        }
+    }
+    void calculateGreekVector(Greek greek, std::span<const Option> options, std::span<double> out) const
+    {
+        evaluateOptions(options, out, [&](const OptionBatchView& block, std::span<double> blockOut)
+        {
+            calculateGreekBatch(greek, block, blockOut);
+        });
+    }
+    std::vector<double> calculateGreekVector(Greek greek, const std::vector<Option>& options) const
+    {
+        std::vector<double> out(options.size());
+        calculateGreekVector(greek, std::span<const Option>(options), out);
+        return out;
+    }
+    void calculateGreekMatrix(Greek greek, const Grid<Option>& optionGrid, Grid<double>& out) const
+    {
+        out.reshape(optionGrid);
+        calculateGreekVector(greek, optionGrid.values(), out.values());
+    }
+    Grid<double> calculateGreekMatrix(Greek greek, const Grid<Option>& optionGrid) const
+    {
+        Grid<double> out;
+        calculateGreekMatrix(greek, optionGrid, out);
+        return out;
+    }
+
+    // Batch calculation over structure-of-arrays input, results written to out.
+    // Defaults evaluate the single-option methods row by row; strategies with a
+    // vectorised implementation override them.
+    virtual void calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const
+    {
+        evaluateRows(batch, out, &IPricingStrategy::calculateCallPrice);
+    }
+    virtual void calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const
+    {
+        evaluateRows(batch, out, &IPricingStrategy::calculatePutPrice);
+    }
+    virtual void calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+    {
+        evaluateRows(batch, out, &IPricingStrategy::calculateCallDelta);
+    }
+    virtual void calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+    {
+        evaluateRows(batch, out, &IPricingStrategy::calculatePutDelta);
+    }
+    virtual void calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const
+    {
+        evaluateRows(batch, out, &IPricingStrategy::calculateGamma);
+    }
+    virtual void calculateGreeksBatch(const OptionBatchView& batch, GreeksBatch& out) const
+    {
+        out.resize(batch.size);
+        for (std::size_t i = 0; i < batch.size; ++i)
+        {
+            out.set(i, calculateGreeks(batch.option(i)));
+        }
+    }
+
+    // Implied volatility: the sigma that reproduces a market price (the option's own
+    // sigma is ignored). The defaults search with the strategy's own prices, so they
+    // work for any model; analytical strategies override them with faster solvers.
+    virtual ImpliedVolResult calculateImpliedVolatility(const Option& option, double price, OptionType type,
+                                                        const ImpliedVolSettings& settings) const
+    {
+        Option trial = option;
+        auto modelPrice = [&](double sigma)
+        {
+            trial.Volatility(sigma);
+            return type == OptionType::Call ? calculateCallPrice(trial) : calculatePutPrice(trial);
+        };
+
+        trial.Volatility(settings.searchUpper);
+        if (!trial.isValid())
+        {
+            return ImpliedVolResult{};
+        }
+        return searchImpliedVolatility(modelPrice, price, settings);
+    }
+    virtual void calculateImpliedVolatilityBatch(const OptionBatchView& batch, std::span<const double> prices,
+                                                 OptionType type, const ImpliedVolSettings& settings,
+                                                 std::span<ImpliedVolResult> out) const
+    {
+        if (prices.size() != batch.size || out.size() != batch.size)
+        {
+            throw std::invalid_argument("Price and output sizes must match option batch size.");
+        }
+        for (std::size_t i = 0; i < batch.size; ++i)
+        {
+            out[i] = calculateImpliedVolatility(batch.option(i), prices[i], type, settings);
+        }
+    }
+
+    // Parameter sweeps: points [offset, offset + out.size()) of the grid, evaluated
+    // without materialising the grid. The defaults fill one block of options at a
+    // time and run the batch method on it; strategies that can hoist per-line work
+    // (see ParameterGrid::spotStrikeLineLength) override them.
+    virtual void calculateCallSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+    {
+        evaluateSweep(grid, offset, out, &IPricingStrategy::calculateCallBatch);
+    }
+    virtual void calculatePutSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+    {
+        evaluateSweep(grid, offset, out, &IPricingStrategy::calculatePutBatch);
+    }
+    virtual void calculateCallDeltaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+    {
+        evaluateSweep(grid, offset, out, &IPricingStrategy::calculateCallDeltaBatch);
+    }
+    virtual void calculatePutDeltaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+    {
+        evaluateSweep(grid, offset, out, &IPricingStrategy::calculatePutDeltaBatch);
+    }
+    virtual void calculateGammaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+    {
+        evaluateSweep(grid, offset, out, &IPricingStrategy::calculateGammaBatch);
+    }
 
     // Utility functions
     virtual std::string getName() const = 0;
     virtual bool supportsGreeks() const = 0;
+
+protected:
+    // Options per block of the stack transposes: the six input columns take 12 KiB
+    static constexpr std::size_t TransposeBlockSize = 256;
+
+    // Transpose options block by block into stack columns and hand each block, with
+    // its slice of out, to evaluateBlock
+    template <typename Result, typename BlockFunction>
+    void evaluateOptions(std::span<const Option> options, std::span<Result> out, const BlockFunction& evaluateBlock) const
+    {
+        if (out.size() != options.size())
+        {
+            throw std::invalid_argument("Output size does not match option count.");
+        }
+
+        alignas(64) double columns[6][TransposeBlockSize];
+        for (std::size_t begin = 0; begin < options.size(); begin += TransposeBlockSize)
+        {
+            std::size_t count = std::min(TransposeBlockSize, options.size() - begin);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const Option& option = options[begin + i];
+                columns[0][i] = option.ExerciseDate();
+                columns[1][i] = option.StrikePrice();
+                columns[2][i] = option.Volatility();
+                columns[3][i] = option.RiskFreeRate();
+                columns[4][i] = option.AssetPrice();
+                columns[5][i] = option.CostOfCarry();
+            }
+            OptionBatchView block{columns[0], columns[1], columns[2], columns[3], columns[4], columns[5], count};
+            evaluateBlock(block, out.subspan(begin, count));
+        }
+    }
+
+private:
+    void evaluateGrid(const Grid<Option>& optionGrid, Grid<double>& out,
+                      void (IPricingStrategy::*batchMethod)(const OptionBatchView&, std::span<double>) const) const
+    {
+        out.reshape(optionGrid);
+        evaluateOptions(optionGrid.values(), out.values(), batchMethod);
+    }
+
+    void evaluateOptions(std::span<const Option> options, std::span<double> out,
+                         void (IPricingStrategy::*batchMethod)(const OptionBatchView&, std::span<double>) const) const
+    {
+        evaluateOptions(options, out, [&](const OptionBatchView& block, std::span<double> blockOut)
+        {
+            (this->*batchMethod)(block, blockOut);
+        });
+    }
+
+    void evaluateSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out,
+                       void (IPricingStrategy::*batchMethod)(const OptionBatchView&, std::span<double>) const) const
+    {
+        // Options per block: six input columns stay cache resident
+        constexpr std::size_t BlockSize = 1024;
+
+        if (offset > grid.size() || out.size() > grid.size() - offset)
+        {
+            throw std::out_of_range("Range exceeds parameter grid bounds.");
+        }
+
+        OptionBatch block;
+        for (std::size_t begin = 0; begin < out.size(); begin += BlockSize)
+        {
+            std::size_t count = std::min(BlockSize, out.size() - begin);
+            grid.fill(offset + begin, count, block);
+            (this->*batchMethod)(block, out.subspan(begin, count));
+        }
+    }
+
+    void evaluateRows(const OptionBatchView& batch, std::span<double> out,
+                      double (IPricingStrategy::*method)(const Option&) const) const
+    {
+        if (out.size() != batch.size)
+        {
+            throw std::invalid_argument("Output size does not match option batch size.");
+        }
+        for (std::size_t i = 0; i < batch.size; ++i)
+        {
+            out[i] = (this->*method)(batch.option(i));
+        }
+    }
 };
 
 #endif // IPRICINGSTRATEGY_HPP
\ No newline at end of file
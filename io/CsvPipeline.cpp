@@ -0,0 +1,406 @@
+#include "CsvPipeline.hpp"
+#include "OptionContext.hpp"
+#include "OptionBatch.hpp"
+#include "PutCallParityValidator.hpp"
+#include <charconv>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t OutputColumns = 6;
+    constexpr std::size_t MaxNumberChars = 32;   // Shortest round-trip double is at most 24 characters
+    constexpr std::size_t MaxRowChars = OutputColumns * (MaxNumberChars + 1);
+
+    // One unit of work travelling reader -> pricer -> writer and back to the free list
+    struct Chunk
+    {
+        OptionBatch options;
+        std::size_t rows = 0;
+        std::vector<double> call, put, callDelta, putDelta, gamma, parity;
+
+        explicit Chunk(std::size_t capacity)
+            : options(capacity), call(capacity), put(capacity), callDelta(capacity),
+              putDelta(capacity), gamma(capacity), parity(capacity)
+        {
+        }
+    };
+
+    /*
+        Hand-off between two stages. close() lets the consumer drain what is
+        queued; cancel() stops both sides at once after a failure. The queue
+        never holds more than the fixed number of chunks, so it stays bounded.
+    */
+    class ChunkQueue
+    {
+    public:
+
+        void push(Chunk* chunk)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (cancelled_)
+                {
+                    return;
+                }
+                chunks_.push_back(chunk);
+            }
+            ready_.notify_one();
+        }
+
+        // Next chunk, or nullptr once closed and drained or cancelled
+        Chunk* pop()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return cancelled_ || closed_ || !chunks_.empty(); });
+            if (cancelled_ || chunks_.empty())
+            {
+                return nullptr;
+            }
+            Chunk* chunk = chunks_.front();
+            chunks_.pop_front();
+            return chunk;
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed_ = true;
+            }
+            ready_.notify_all();
+        }
+
+        void cancel()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                cancelled_ = true;
+                chunks_.clear();
+            }
+            ready_.notify_all();
+        }
+
+    private:
+
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<Chunk*> chunks_;
+        bool closed_ = false;
+        bool cancelled_ = false;
+    };
+
+    /*
+        Line-oriented CSV reader over one fixed buffer. Lines are parsed where
+        they lie in the buffer; only the unfinished tail of a read is moved to
+        the front before the next read.
+    */
+    class CsvOptionReader
+    {
+    public:
+
+        CsvOptionReader(std::istream& input, std::size_t bufferBytes, char delimiter)
+            : input_(input), buffer_(bufferBytes), delimiter_(delimiter)
+        {
+        }
+
+        // Parse up to capacity option rows into the chunk; fewer only at the end of the input
+        std::size_t read(Chunk& chunk, std::size_t capacity)
+        {
+            std::size_t rows = 0;
+            const char* first;
+            const char* last;
+            while (rows < capacity && nextLine(first, last))
+            {
+                if (parseLine(first, last, chunk, rows))
+                {
+                    ++rows;
+                }
+            }
+            return rows;
+        }
+
+    private:
+
+        bool nextLine(const char*& first, const char*& last)
+        {
+            for (;;)
+            {
+                char* data = buffer_.data();
+                const void* newline = std::memchr(data + begin_, '\n', end_ - begin_);
+                if (newline)
+                {
+                    first = data + begin_;
+                    last = static_cast<const char*>(newline);
+                    begin_ = static_cast<std::size_t>(last - data) + 1;
+                    ++line_;
+                    return true;
+                }
+                if (eof_)
+                {
+                    if (begin_ == end_)
+                    {
+                        return false;
+                    }
+                    first = data + begin_;
+                    last = data + end_;
+                    begin_ = end_;
+                    ++line_;
+                    return true;
+                }
+
+                std::memmove(data, data + begin_, end_ - begin_);
+                end_ -= begin_;
+                begin_ = 0;
+                if (end_ == buffer_.size())
+                {
+                    throw std::runtime_error("CSV line " + std::to_string(line_ + 1) + " is longer than the read buffer.");
+                }
+                input_.read(data + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+                end_ += static_cast<std::size_t>(input_.gcount());
+                if (input_.bad())
+                {
+                    throw std::runtime_error("Error reading CSV input.");
+                }
+                eof_ = !input_;
+            }
+        }
+
+        static void trim(const char*& first, const char*& last)
+        {
+            while (first < last && (*first == ' ' || *first == '\t'))
+            {
+                ++first;
+            }
+            while (last > first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r'))
+            {
+                --last;
+            }
+        }
+
+        // Returns true if the line was an option row and was stored in row
+        bool parseLine(const char* first, const char* last, Chunk& chunk, std::size_t row)
+        {
+            trim(first, last);
+            if (first == last || *first == '#')
+            {
+                return false;
+            }
+
+            double fields[6];
+            std::size_t count = 0;
+            for (const char* field = first; ; )
+            {
+                const char* end = static_cast<const char*>(std::memchr(field, delimiter_, static_cast<std::size_t>(last - field)));
+                if (!end)
+                {
+                    end = last;
+                }
+                if (count == 6)
+                {
+                    throw malformed("expected 5 or 6 fields");
+                }
+
+                const char* numberFirst = field;
+                const char* numberLast = end;
+                trim(numberFirst, numberLast);
+                auto [parsed, error] = std::from_chars(numberFirst, numberLast, fields[count]);
+                if (error != std::errc() || parsed != numberLast || numberFirst == numberLast)
+                {
+                    // A header can only be the first non-blank line
+                    if (!seenRow_ && count == 0)
+                    {
+                        seenRow_ = true;
+                        return false;
+                    }
+                    throw malformed("field " + std::to_string(count + 1) + " is not a number");
+                }
+                ++count;
+
+                if (end == last)
+                {
+                    break;
+                }
+                field = end + 1;
+            }
+            if (count < 5)
+            {
+                throw malformed("expected 5 or 6 fields");
+            }
+            seenRow_ = true;
+
+            chunk.options.ExerciseDates()[row] = fields[0];
+            chunk.options.StrikePrices()[row] = fields[1];
+            chunk.options.Volatilities()[row] = fields[2];
+            chunk.options.RiskFreeRates()[row] = fields[3];
+            chunk.options.AssetPrices()[row] = fields[4];
+            chunk.options.CostsOfCarry()[row] = count == 6 ? fields[5] : fields[3];
+            return true;
+        }
+
+        std::runtime_error malformed(const std::string& reason) const
+        {
+            return std::runtime_error("Malformed option row at line " + std::to_string(line_) + ": " + reason + ".");
+        }
+
+        std::istream& input_;
+        std::vector<char> buffer_;
+        std::size_t begin_ = 0;   // Unparsed bytes are [begin_, end_)
+        std::size_t end_ = 0;
+        std::size_t line_ = 0;    // Lines handed out so far
+        bool eof_ = false;
+        bool seenRow_ = false;
+        char delimiter_;
+    };
+
+    void priceChunk(const OptionContext& context, const PutCallParityValidator& parity, Chunk& chunk)
+    {
+        std::size_t rows = chunk.rows;
+        OptionBatchView options = chunk.options.view().subview(0, rows);
+        context.calculateCallBatch(options, std::span<double>(chunk.call).first(rows));
+        context.calculatePutBatch(options, std::span<double>(chunk.put).first(rows));
+        context.calculateCallDeltaBatch(options, std::span<double>(chunk.callDelta).first(rows));
+        context.calculatePutDeltaBatch(options, std::span<double>(chunk.putDelta).first(rows));
+        context.calculateGammaBatch(options, std::span<double>(chunk.gamma).first(rows));
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            chunk.parity[i] = parity.calculateParityDifference(options.option(i), chunk.call[i], chunk.put[i]);
+        }
+    }
+
+    // Format a chunk into text, returning the end of the written characters
+    char* formatChunk(const Chunk& chunk, char* out)
+    {
+        const std::vector<double>* columns[OutputColumns] = {&chunk.call, &chunk.put, &chunk.callDelta,
+                                                             &chunk.putDelta, &chunk.gamma, &chunk.parity};
+        for (std::size_t i = 0; i < chunk.rows; ++i)
+        {
+            for (std::size_t c = 0; c < OutputColumns; ++c)
+            {
+                out = std::to_chars(out, out + MaxNumberChars, (*columns[c])[i]).ptr;
+                *out++ = c + 1 == OutputColumns ? '\n' : ',';
+            }
+        }
+        return out;
+    }
+}
+
+CsvPipelineStats priceCsvStream(const OptionContext& context, std::istream& input, std::ostream& output,
+                                const CsvPipelineSettings& settings)
+{
+    if (settings.chunkRows == 0 || settings.chunkCount == 0 || settings.readBufferBytes == 0)
+    {
+        throw std::invalid_argument("CSV pipeline chunk size, chunk count and read buffer must be positive.");
+    }
+
+    std::deque<Chunk> chunks;
+    ChunkQueue freeChunks, parsed, priced;
+    for (std::size_t c = 0; c < settings.chunkCount; ++c)
+    {
+        freeChunks.push(&chunks.emplace_back(settings.chunkRows));
+    }
+
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+    auto fail = [&](std::exception_ptr error)
+    {
+        {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure)
+            {
+                failure = error;
+            }
+        }
+        freeChunks.cancel();
+        parsed.cancel();
+        priced.cancel();
+    };
+
+    // Stage 1: parse
+    std::thread reader([&]
+    {
+        try
+        {
+            CsvOptionReader csv(input, settings.readBufferBytes, settings.delimiter);
+            while (Chunk* chunk = freeChunks.pop())
+            {
+                chunk->rows = csv.read(*chunk, settings.chunkRows);
+                if (chunk->rows == 0)
+                {
+                    break;
+                }
+                parsed.push(chunk);
+                if (chunk->rows < settings.chunkRows)
+                {
+                    break;
+                }
+            }
+            parsed.close();
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+    });
+
+    // Stage 3: format and write
+    std::thread writer([&]
+    {
+        try
+        {
+            std::vector<char> text(settings.chunkRows * MaxRowChars);
+            while (Chunk* chunk = priced.pop())
+            {
+                char* end = formatChunk(*chunk, text.data());
+                output.write(text.data(), end - text.data());
+                if (!output)
+                {
+                    throw std::runtime_error("Error writing CSV output.");
+                }
+                freeChunks.push(chunk);
+            }
+            output.flush();
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+    });
+
+    // Stage 2: price, on the calling thread (and the context's pool)
+    CsvPipelineStats stats;
+    try
+    {
+        PutCallParityValidator parity;
+        while (Chunk* chunk = parsed.pop())
+        {
+            priceChunk(context, parity, *chunk);
+            stats.rows += chunk->rows;
+            ++stats.chunks;
+            priced.push(chunk);
+        }
+        priced.close();
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+    }
+
+    reader.join();
+    writer.join();
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+    return stats;
+}
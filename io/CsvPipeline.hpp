@@ -0,0 +1,51 @@
+#ifndef CSVPIPELINE_HPP
+#define CSVPIPELINE_HPP
+
+#include <cstddef>
+#include <iosfwd>
+
+class OptionContext;
+
+/*
+    @brief Settings of the streaming CSV pricer
+    Memory use is bounded by chunkRows * chunkCount rows plus one read buffer,
+    whatever the length of the input.
+*/
+struct CsvPipelineSettings
+{
+    std::size_t chunkRows = 4096;          // Options priced per batch call
+    std::size_t chunkCount = 4;            // Chunks in flight between the three stages
+    std::size_t readBufferBytes = 1 << 20; // Longest accepted input line
+    char delimiter = ',';
+};
+
+struct CsvPipelineStats
+{
+    std::size_t rows = 0;      // Option rows priced and written
+    std::size_t chunks = 0;    // Batches priced
+};
+
+/**
+ * @brief Price a CSV stream of options into a CSV stream of results
+ *
+ * Input rows are T,K,sig,r,S[,b] (b defaults to r, as for Option); blank
+ * lines, lines starting with '#' and a non-numeric header line are skipped.
+ * Every option row yields one output row, in input order:
+ *
+ *     call,put,call_delta,put_delta,gamma,parity_diff
+ *
+ * Parsing, pricing and writing run as a three-stage pipeline over a fixed
+ * ring of chunkCount SoA chunks: a reader thread parses rows in place from a
+ * fixed buffer (std::from_chars, no per-row allocation), the calling thread
+ * prices whole chunks through the context's batch entry points (thread pool,
+ * validation mode and metrics apply; parity_diff uses PutCallParityValidator),
+ * and a writer thread formats the results with std::to_chars. A malformed row
+ * throws std::runtime_error naming its line; use ValidationMode::NaN to emit
+ * NaN for well-formed but invalid options instead.
+ *
+ * @return Rows and chunks processed
+ */
+CsvPipelineStats priceCsvStream(const OptionContext& context, std::istream& input, std::ostream& output,
+                                const CsvPipelineSettings& settings = CsvPipelineSettings());
+
+#endif // CSVPIPELINE_HPP
@@ -0,0 +1,317 @@
+#include "OptionFile.hpp"
+#include "OptionContext.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <boost/filesystem.hpp>
+
+namespace bip = boost::interprocess;
+
+namespace
+{
+    constexpr char OptionMagic[8] = {'O', 'P', 'T', 'B', 'A', 'T', 'C', 'H'};
+    constexpr char ResultMagic[8] = {'O', 'P', 'T', 'R', 'E', 'S', 'L', 'T'};
+    constexpr std::size_t OptionColumns = 6;
+    constexpr std::size_t ColumnAlignment = 64;
+    constexpr std::uint8_t LastQuantityTag = static_cast<std::uint8_t>(BatchQuantity::Gamma);
+
+    void requireLittleEndian()
+    {
+        if constexpr (std::endian::native != std::endian::little)
+        {
+            throw std::runtime_error("Column files are little-endian; big-endian hosts are not supported.");
+        }
+    }
+
+    std::size_t paddedStride(std::size_t rows)
+    {
+        std::size_t bytes = rows * sizeof(double);
+        return (bytes + ColumnAlignment - 1) / ColumnAlignment * ColumnAlignment;
+    }
+
+    ColumnFileHeader makeHeader(const char (&magic)[8], std::size_t rows, std::size_t columns)
+    {
+        ColumnFileHeader header{};
+        std::memcpy(header.magic, magic, sizeof(header.magic));
+        header.version = ColumnFileHeader::CurrentVersion;
+        header.columnCount = static_cast<std::uint32_t>(columns);
+        header.rowCount = rows;
+        header.columnStride = paddedStride(rows);
+        header.dataOffset = sizeof(ColumnFileHeader);
+        return header;
+    }
+
+    std::uint64_t fileBytes(const ColumnFileHeader& header)
+    {
+        return header.dataOffset + header.columnStride * header.columnCount;
+    }
+
+    // Size a new file, write its header and map it read-write
+    void createMapping(const std::string& path, const ColumnFileHeader& header,
+                       bip::file_mapping& file, bip::mapped_region& region)
+    {
+        requireLittleEndian();
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                throw std::runtime_error("Cannot create column file: " + path);
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        // Sparse extension: untouched column pages read back as zeros
+        boost::filesystem::resize_file(path, fileBytes(header));
+
+        file = bip::file_mapping(path.c_str(), bip::read_write);
+        region = bip::mapped_region(file, bip::read_write);
+    }
+
+    // Map an existing file and validate its header against the file size
+    ColumnFileHeader openMapping(const std::string& path, const char (&magic)[8],
+                                 bip::file_mapping& file, bip::mapped_region& region)
+    {
+        requireLittleEndian();
+        if (!boost::filesystem::exists(path))
+        {
+            throw std::runtime_error("Column file does not exist: " + path);
+        }
+        std::uint64_t size = boost::filesystem::file_size(path);
+        if (size < sizeof(ColumnFileHeader))
+        {
+            throw std::runtime_error("Column file is too short for its header: " + path);
+        }
+
+        file = bip::file_mapping(path.c_str(), bip::read_only);
+        region = bip::mapped_region(file, bip::read_only);
+        region.advise(bip::mapped_region::advice_sequential);
+
+        ColumnFileHeader header;
+        std::memcpy(&header, region.get_address(), sizeof(header));
+        if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0)
+        {
+            throw std::runtime_error("Unexpected column file type: " + path);
+        }
+        if (header.version != ColumnFileHeader::CurrentVersion)
+        {
+            throw std::runtime_error("Unsupported column file version: " + path);
+        }
+        // Every term is bounded by the file size before it is multiplied, so nothing can wrap
+        if (header.dataOffset < sizeof(ColumnFileHeader) || header.dataOffset % ColumnAlignment != 0
+            || header.dataOffset > size || header.rowCount > size / sizeof(double)
+            || header.columnStride < header.rowCount * sizeof(double) || header.columnStride % sizeof(double) != 0
+            || (header.columnCount != 0 && header.columnStride > (size - header.dataOffset) / header.columnCount))
+        {
+            throw std::runtime_error("Corrupt column file header: " + path);
+        }
+        return header;
+    }
+
+    const double* columnAt(const bip::mapped_region& region, std::size_t offset, std::size_t stride, std::size_t index)
+    {
+        const char* data = static_cast<const char*>(region.get_address()) + offset;
+        return reinterpret_cast<const double*>(data) + index * stride;
+    }
+}
+
+MappedOptionFile::MappedOptionFile(const std::string& path)
+{
+    ColumnFileHeader header = openMapping(path, OptionMagic, file_, region_);
+    if (header.columnCount != OptionColumns)
+    {
+        throw std::runtime_error("Option file must have six columns: " + path);
+    }
+    rows_ = static_cast<std::size_t>(header.rowCount);
+    stride_ = static_cast<std::size_t>(header.columnStride / sizeof(double));
+    offset_ = static_cast<std::size_t>(header.dataOffset);
+}
+
+MappedOptionFile MappedOptionFile::create(const std::string& path, std::size_t rows)
+{
+    MappedOptionFile mapped;
+    ColumnFileHeader header = makeHeader(OptionMagic, rows, OptionColumns);
+    for (std::size_t c = 0; c < OptionColumns; ++c)
+    {
+        header.columnTags[c] = static_cast<std::uint8_t>(c);
+    }
+    createMapping(path, header, mapped.file_, mapped.region_);
+    mapped.rows_ = rows;
+    mapped.stride_ = static_cast<std::size_t>(header.columnStride / sizeof(double));
+    mapped.offset_ = static_cast<std::size_t>(header.dataOffset);
+    mapped.writable_ = true;
+    return mapped;
+}
+
+void MappedOptionFile::write(const std::string& path, const OptionBatchView& batch)
+{
+    MappedOptionFile mapped = create(path, batch.size);
+    const double* columns[OptionColumns] = {batch.T, batch.K, batch.sig, batch.r, batch.S, batch.b};
+    for (std::size_t c = 0; c < OptionColumns; ++c)
+    {
+        std::copy_n(columns[c], batch.size, mapped.column(static_cast<OptionParameter>(c)).data());
+    }
+    mapped.flush();
+}
+
+OptionBatchView MappedOptionFile::view() const
+{
+    const double* T = columnAt(region_, offset_, stride_, 0);
+    return {T, T + stride_, T + 2 * stride_, T + 3 * stride_, T + 4 * stride_, T + 5 * stride_, rows_};
+}
+
+std::span<const double> MappedOptionFile::column(OptionParameter parameter) const
+{
+    return {columnAt(region_, offset_, stride_, static_cast<std::size_t>(parameter)), rows_};
+}
+
+std::span<double> MappedOptionFile::column(OptionParameter parameter)
+{
+    if (!writable_)
+    {
+        throw std::logic_error("Option file is mapped read-only.");
+    }
+    return {const_cast<double*>(columnAt(region_, offset_, stride_, static_cast<std::size_t>(parameter))), rows_};
+}
+
+void MappedOptionFile::flush()
+{
+    if (writable_)
+    {
+        region_.flush();
+    }
+}
+
+MappedResultFile::MappedResultFile(const std::string& path)
+{
+    ColumnFileHeader header = openMapping(path, ResultMagic, file_, region_);
+    if (header.columnCount > ColumnFileHeader::MaxColumns)
+    {
+        throw std::runtime_error("Corrupt column file header: " + path);
+    }
+    for (std::size_t c = 0; c < header.columnCount; ++c)
+    {
+        if (header.columnTags[c] > LastQuantityTag)
+        {
+            throw std::runtime_error("Corrupt column file header: " + path);
+        }
+        quantities_.push_back(static_cast<BatchQuantity>(header.columnTags[c]));
+    }
+    rows_ = static_cast<std::size_t>(header.rowCount);
+    stride_ = static_cast<std::size_t>(header.columnStride / sizeof(double));
+    offset_ = static_cast<std::size_t>(header.dataOffset);
+}
+
+MappedResultFile MappedResultFile::create(const std::string& path, std::size_t rows, std::span<const BatchQuantity> quantities)
+{
+    if (quantities.empty() || quantities.size() > ColumnFileHeader::MaxColumns)
+    {
+        throw std::invalid_argument("Result files hold between 1 and 16 columns.");
+    }
+
+    MappedResultFile mapped;
+    ColumnFileHeader header = makeHeader(ResultMagic, rows, quantities.size());
+    for (std::size_t c = 0; c < quantities.size(); ++c)
+    {
+        header.columnTags[c] = static_cast<std::uint8_t>(quantities[c]);
+    }
+    createMapping(path, header, mapped.file_, mapped.region_);
+    mapped.quantities_.assign(quantities.begin(), quantities.end());
+    mapped.rows_ = rows;
+    mapped.stride_ = static_cast<std::size_t>(header.columnStride / sizeof(double));
+    mapped.offset_ = static_cast<std::size_t>(header.dataOffset);
+    mapped.writable_ = true;
+    return mapped;
+}
+
+std::span<const double> MappedResultFile::column(std::size_t index) const
+{
+    if (index >= quantities_.size())
+    {
+        throw std::out_of_range("Result column index out of range.");
+    }
+    return {columnAt(region_, offset_, stride_, index), rows_};
+}
+
+std::span<double> MappedResultFile::column(std::size_t index)
+{
+    if (!writable_)
+    {
+        throw std::logic_error("Result file is mapped read-only.");
+    }
+    std::span<const double> values = std::as_const(*this).column(index);
+    return {const_cast<double*>(values.data()), values.size()};
+}
+
+std::span<const double> MappedResultFile::column(BatchQuantity quantity) const
+{
+    return column(indexOf(quantity));
+}
+
+void MappedResultFile::flush()
+{
+    if (writable_)
+    {
+        region_.flush();
+    }
+}
+
+std::size_t MappedResultFile::indexOf(BatchQuantity quantity) const
+{
+    auto found = std::find(quantities_.begin(), quantities_.end(), quantity);
+    if (found == quantities_.end())
+    {
+        throw std::out_of_range("Result file has no column for this quantity.");
+    }
+    return static_cast<std::size_t>(found - quantities_.begin());
+}
+
+std::size_t priceOptionFile(const OptionContext& context, const std::string& inputPath, const std::string& outputPath,
+                            std::span<const BatchQuantity> quantities, std::size_t chunkRows)
+{
+    if (chunkRows == 0)
+    {
+        throw std::invalid_argument("Chunk size must be positive.");
+    }
+    // Creating the output truncates it, which would pull the mapped input from under the pricer
+    if (boost::filesystem::exists(outputPath) && boost::filesystem::equivalent(inputPath, outputPath))
+    {
+        throw std::invalid_argument("Output file must not be the input file: " + outputPath);
+    }
+
+    MappedOptionFile input(inputPath);
+    MappedResultFile output = MappedResultFile::create(outputPath, input.size(), quantities);
+    OptionBatchView options = input.view();
+
+    for (std::size_t begin = 0; begin < options.size; begin += chunkRows)
+    {
+        std::size_t count = std::min(chunkRows, options.size - begin);
+        OptionBatchView chunk = options.subview(begin, count);
+        for (std::size_t c = 0; c < quantities.size(); ++c)
+        {
+            std::span<double> out = output.column(c).subspan(begin, count);
+            switch (quantities[c])
+            {
+                case BatchQuantity::CallPrice:
+                    context.calculateCallBatch(chunk, out);
+                    break;
+                case BatchQuantity::PutPrice:
+                    context.calculatePutBatch(chunk, out);
+                    break;
+                case BatchQuantity::CallDelta:
+                    context.calculateCallDeltaBatch(chunk, out);
+                    break;
+                case BatchQuantity::PutDelta:
+                    context.calculatePutDeltaBatch(chunk, out);
+                    break;
+                case BatchQuantity::Gamma:
+                    context.calculateGammaBatch(chunk, out);
+                    break;
+            }
+        }
+    }
+
+    output.flush();
+    return options.size;
+}
@@ -0,0 +1,137 @@
+#ifndef OPTIONFILE_HPP
+#define OPTIONFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "OptionBatch.hpp"
+#include "ParameterGrid.hpp"
+#include "BlackScholesKernels.hpp"
+
+class OptionContext;
+
+/*
+    @brief Header of the columnar option and result files (64 bytes, little-endian)
+    The header is followed by columnCount columns of rowCount doubles. Each
+    column starts columnStride bytes after the previous one, and the stride
+    is padded to a multiple of 64, so every column of a mapped file is
+    cache-line aligned. Option files ("OPTBATCH") hold the six columns
+    T/K/sig/r/S/b in that order; result files ("OPTRESLT") hold one column
+    per BatchQuantity listed in columnTags.
+*/
+struct ColumnFileHeader
+{
+    static constexpr std::uint32_t CurrentVersion = 1;
+    static constexpr std::size_t MaxColumns = 16;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t columnCount;
+    std::uint64_t rowCount;
+    std::uint64_t columnStride;   // Bytes between column starts
+    std::uint64_t dataOffset;     // Bytes from the file start to the first column
+    std::uint8_t columnTags[MaxColumns];
+    std::uint8_t reserved[8];
+};
+
+static_assert(sizeof(ColumnFileHeader) == 64, "Column file header must stay 64 bytes");
+
+/**
+ * @brief Read-only, zero-copy memory mapping of an option file as an OptionBatchView
+ *
+ * Opening maps the file and checks its header; no option data is read or
+ * copied, so the view can be handed to any batch entry point and pages are
+ * faulted in as the pricer streams through them. Files are written with
+ * write() or filled in place through create().
+ */
+class MappedOptionFile
+{
+public:
+
+    explicit MappedOptionFile(const std::string& path);
+
+    // New file of rows options, mapped read-write with zero columns to fill through column()
+    static MappedOptionFile create(const std::string& path, std::size_t rows);
+
+    // Write a batch as an option file
+    static void write(const std::string& path, const OptionBatchView& batch);
+
+    std::size_t size() const { return rows_; };
+    OptionBatchView view() const;
+    operator OptionBatchView() const { return view(); };
+
+    // Column of one parameter; the mutable overload needs a file from create()
+    std::span<const double> column(OptionParameter parameter) const;
+    std::span<double> column(OptionParameter parameter);
+
+    void flush(); // Write dirty pages of a created file back to disk
+
+private:
+
+    MappedOptionFile() = default;
+
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    std::size_t rows_ = 0;
+    std::size_t stride_ = 0;    // Column stride in doubles
+    std::size_t offset_ = 0;    // Bytes from the mapping start to the first column
+    bool writable_ = false;
+};
+
+/**
+ * @brief Memory-mapped result file: one column of doubles per batch quantity
+ *
+ * create() sizes and maps the file read-write so batch pricers write their
+ * output straight into the page cache; the constructor maps an existing file
+ * read-only.
+ */
+class MappedResultFile
+{
+public:
+
+    explicit MappedResultFile(const std::string& path);
+    static MappedResultFile create(const std::string& path, std::size_t rows, std::span<const BatchQuantity> quantities);
+
+    std::size_t size() const { return rows_; };
+    std::size_t columnCount() const { return quantities_.size(); };
+    const std::vector<BatchQuantity>& quantities() const { return quantities_; };
+
+    std::span<const double> column(std::size_t index) const;
+    std::span<double> column(std::size_t index);
+    std::span<const double> column(BatchQuantity quantity) const;
+
+    void flush();
+
+private:
+
+    MappedResultFile() = default;
+    std::size_t indexOf(BatchQuantity quantity) const;
+
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    std::vector<BatchQuantity> quantities_;
+    std::size_t rows_ = 0;
+    std::size_t stride_ = 0;
+    std::size_t offset_ = 0;
+    bool writable_ = false;
+};
+
+/**
+ * @brief Price a mapped option file into a new mapped result file
+ *
+ * Rows are processed in chunks of chunkRows (default: 64Ki rows, 3 MiB of
+ * input) and every requested quantity is computed for a chunk before moving
+ * on, so each input page is faulted in once and is still cache-resident for
+ * the later quantities. Each chunk goes through the context's batch entry
+ * points, so its thread pool, validation mode and metrics apply.
+ * Returns the number of rows priced; an output path naming the input file
+ * (under any spelling) is rejected with std::invalid_argument.
+ */
+std::size_t priceOptionFile(const OptionContext& context, const std::string& inputPath, const std::string& outputPath,
+                            std::span<const BatchQuantity> quantities, std::size_t chunkRows = 65536);
+
+#endif // OPTIONFILE_HPP
@@ -0,0 +1,252 @@
+#include "BlackScholesKernels.hpp"
+#include "BlackScholesSimdKernel.hpp"
+#include <stdexcept>
+
+#if defined(OPTION_PRICER_X86_SIMD)
+// Implemented in BlackScholesKernelsAVX2.cpp / BlackScholesKernelsAVX512.cpp
+void evaluateBlackScholesAVX2(BatchQuantity quantity, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out);
+void evaluateBlackScholesAVX512(BatchQuantity quantity, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out);
+void evaluateBlackScholesGreeksAVX2(NormalCdfMode cdfMode, const OptionBatchView& batch, const GreeksColumns& out);
+void evaluateBlackScholesGreeksAVX512(NormalCdfMode cdfMode, const OptionBatchView& batch, const GreeksColumns& out);
+void evaluateBlackScholesGreekAVX2(Greek greek, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out);
+void evaluateBlackScholesGreekAVX512(Greek greek, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out);
+void evaluateBlackScholesLineAVX2(BatchQuantity quantity, NormalCdfMode cdfMode, const SweepLine& line, double* out);
+void evaluateBlackScholesLineAVX512(BatchQuantity quantity, NormalCdfMode cdfMode, const SweepLine& line, double* out);
+void evaluateImpliedVolatilityAVX2(const OptionBatchView& batch, const double* prices, OptionType type,
+                                   const ImpliedVolSettings& settings, ImpliedVolResult* out);
+void evaluateImpliedVolatilityAVX512(const OptionBatchView& batch, const double* prices, OptionType type,
+                                     const ImpliedVolSettings& settings, ImpliedVolResult* out);
+void evaluateParityDifferenceAVX2(const OptionBatchView& batch, const double* calls, const double* puts, double* out);
+void evaluateParityDifferenceAVX512(const OptionBatchView& batch, const double* calls, const double* puts, double* out);
+void evaluateBlackScholesFactorisedAVX2(NormalCdfMode cdfMode, const FactorisedBatch& batch, double spotFactor, double* out);
+void evaluateBlackScholesFactorisedAVX512(NormalCdfMode cdfMode, const FactorisedBatch& batch, double spotFactor, double* out);
+#endif
+
+namespace
+{
+
+// Never run an instruction set the CPU does not have
+SimdLevel clampToAvailable(SimdLevel level)
+{
+    SimdLevel available = detectSimdLevel();
+    return level > available ? available : level;
+}
+
+} // namespace
+
+SimdLevel detectSimdLevel()
+{
+#if defined(OPTION_PRICER_X86_SIMD)
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SimdLevel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+std::string simdLevelName(SimdLevel level)
+{
+    switch (level) {
+        case SimdLevel::AVX512: return "AVX-512";
+        case SimdLevel::AVX2:   return "AVX2";
+        default:                return "Scalar";
+    }
+}
+
+void evaluateBlackScholesBatch(BatchQuantity quantity, const OptionBatchView& batch,
+                               std::span<double> out, SimdLevel level, NormalCdfMode cdfMode)
+{
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+
+    level = clampToAvailable(level);
+
+#if defined(OPTION_PRICER_X86_SIMD)
+    if (level == SimdLevel::AVX512)
+    {
+        evaluateBlackScholesAVX512(quantity, cdfMode, batch, out.data());
+        return;
+    }
+    if (level == SimdLevel::AVX2)
+    {
+        evaluateBlackScholesAVX2(quantity, cdfMode, batch, out.data());
+        return;
+    }
+#endif
+
+    runBlackScholesKernel<VecScalar>(quantity, cdfMode, batch, out.data());
+}
+
+void evaluateBlackScholesGreeksBatch(const OptionBatchView& batch, GreeksBatch& out, SimdLevel level,
+                                     NormalCdfMode cdfMode)
+{
+    out.resize(batch.size);
+    GreeksColumns columns{out.callPrice.data(), out.putPrice.data(), out.callDelta.data(), out.putDelta.data(),
+                          out.gamma.data(), out.vega.data(), out.callTheta.data(), out.putTheta.data(),
+                          out.callRho.data(), out.putRho.data(), out.vanna.data(), out.volga.data(),
+                          out.speed.data(), out.callCharm.data(), out.putCharm.data()};
+    evaluateBlackScholesGreeksBatch(batch, columns, level, cdfMode);
+}
+
+void evaluateBlackScholesGreeksBatch(const OptionBatchView& batch, const GreeksColumns& columns, SimdLevel level,
+                                     NormalCdfMode cdfMode)
+{
+    level = clampToAvailable(level);
+
+#if defined(OPTION_PRICER_X86_SIMD)
+    if (level == SimdLevel::AVX512)
+    {
+        evaluateBlackScholesGreeksAVX512(cdfMode, batch, columns);
+        return;
+    }
+    if (level == SimdLevel::AVX2)
+    {
+        evaluateBlackScholesGreeksAVX2(cdfMode, batch, columns);
+        return;
+    }
+#endif
+
+    runBlackScholesGreeksKernel<VecScalar>(cdfMode, batch, columns);
+}
+
+void evaluateBlackScholesGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out,
+                                    SimdLevel level, NormalCdfMode cdfMode)
+{
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+
+    level = clampToAvailable(level);
+
+#if defined(OPTION_PRICER_X86_SIMD)
+    if (level == SimdLevel::AVX512)
+    {
+        evaluateBlackScholesGreekAVX512(greek, cdfMode, batch, out.data());
+        return;
+    }
+    if (level == SimdLevel::AVX2)
+    {
+        evaluateBlackScholesGreekAVX2(greek, cdfMode, batch, out.data());
+        return;
+    }
+#endif
+
+    runBlackScholesGreekKernel<VecScalar>(greek, cdfMode, batch, out.data());
+}
+
+void evaluateBlackScholesLine(BatchQuantity quantity, const SweepLine& line, std::span<double> out,
+                              SimdLevel level, NormalCdfMode cdfMode)
+{
+    if (out.size() != line.size)
+    {
+        throw std::invalid_argument("Output size does not match sweep line size.");
+    }
+
+    level = clampToAvailable(level);
+
+#if defined(OPTION_PRICER_X86_SIMD)
+    if (level == SimdLevel::AVX512)
+    {
+        evaluateBlackScholesLineAVX512(quantity, cdfMode, line, out.data());
+        return;
+    }
+    if (level == SimdLevel::AVX2)
+    {
+        evaluateBlackScholesLineAVX2(quantity, cdfMode, line, out.data());
+        return;
+    }
+#endif
+
+    runBlackScholesLineKernel<VecScalar>(quantity, cdfMode, line, out.data());
+}
+
+void evaluateImpliedVolatilityBatch(const OptionBatchView& batch, std::span<const double> prices, OptionType type,
+                                    const ImpliedVolSettings& settings, std::span<ImpliedVolResult> out,
+                                    SimdLevel level)
+{
+    if (prices.size() != batch.size || out.size() != batch.size)
+    {
+        throw std::invalid_argument("Price and output sizes must match option batch size.");
+    }
+
+    level = clampToAvailable(level);
+
+#if defined(OPTION_PRICER_X86_SIMD)
+    if (level == SimdLevel::AVX512)
+    {
+        evaluateImpliedVolatilityAVX512(batch, prices.data(), type, settings, out.data());
+        return;
+    }
+    if (level == SimdLevel::AVX2)
+    {
+        evaluateImpliedVolatilityAVX2(batch, prices.data(), type, settings, out.data());
+        return;
+    }
+#endif
+
+    runImpliedVolKernel<VecScalar>(batch, prices.data(), type, settings, out.data());
+}
+
+void evaluateParityDifferenceBatch(const OptionBatchView& batch, std::span<const double> callPrices,
+                                   std::span<const double> putPrices, std::span<double> out, SimdLevel level)
+{
+    if (callPrices.size() != batch.size || putPrices.size() != batch.size || out.size() != batch.size)
+    {
+        throw std::invalid_argument("Price and output sizes must match option batch size.");
+    }
+
+    level = clampToAvailable(level);
+
+#if defined(OPTION_PRICER_X86_SIMD)
+    if (level == SimdLevel::AVX512)
+    {
+        evaluateParityDifferenceAVX512(batch, callPrices.data(), putPrices.data(), out.data());
+        return;
+    }
+    if (level == SimdLevel::AVX2)
+    {
+        evaluateParityDifferenceAVX2(batch, callPrices.data(), putPrices.data(), out.data());
+        return;
+    }
+#endif
+
+    runParityKernel<VecScalar>(batch, callPrices.data(), putPrices.data(), out.data());
+}
+
+void evaluateBlackScholesFactorised(const FactorisedBatch& batch, double spotFactor, std::span<double> out,
+                                    SimdLevel level, NormalCdfMode cdfMode)
+{
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match factorised batch size.");
+    }
+
+    level = clampToAvailable(level);
+
+#if defined(OPTION_PRICER_X86_SIMD)
+    if (level == SimdLevel::AVX512)
+    {
+        evaluateBlackScholesFactorisedAVX512(cdfMode, batch, spotFactor, out.data());
+        return;
+    }
+    if (level == SimdLevel::AVX2)
+    {
+        evaluateBlackScholesFactorisedAVX2(cdfMode, batch, spotFactor, out.data());
+        return;
+    }
+#endif
+
+    runFactorisedKernel<VecScalar>(cdfMode, batch, spotFactor, out.data());
+}
@@ -0,0 +1,211 @@
+#ifndef BLACKSCHOLESKERNELS_HPP
+#define BLACKSCHOLESKERNELS_HPP
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include "OptionBatch.hpp"
+#include "GreeksResult.hpp"
+#include "ImpliedVolatility.hpp"
+#include "NormalDistribution.hpp"
+
+/**
+ * @brief Instruction set used by the batch Black-Scholes kernels
+ *
+ * Scalar is always available; AVX2 and AVX512 are only selected when the
+ * binary was built with the x86 kernels and the running CPU supports them.
+ */
+enum class SimdLevel
+{
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Quantity evaluated by a batch kernel
+ */
+enum class BatchQuantity
+{
+    CallPrice,
+    PutPrice,
+    CallDelta,
+    PutDelta,
+    Gamma
+};
+
+/**
+ * @brief Raw output columns of the fused Greeks kernel, in GreeksResult field order
+ */
+struct GreeksColumns
+{
+    double* callPrice;
+    double* putPrice;
+    double* callDelta;
+    double* putDelta;
+    double* gamma;
+    double* vega;
+    double* callTheta;
+    double* putTheta;
+    double* callRho;
+    double* putRho;
+    double* vanna;
+    double* volga;
+    double* speed;
+    double* callCharm;
+    double* putCharm;
+};
+
+/**
+ * @brief One line of a parameter sweep: options sharing T, sigma, r and b
+ *
+ * Only spot and strike vary along the line, so the square root, both
+ * exponentials and the drift term are evaluated once for the whole line.
+ */
+struct SweepLine
+{
+    double T;
+    double sig;
+    double r;
+    double b;
+    const double* S;   // size spot prices
+    const double* K;   // size strike prices
+    std::size_t size;
+};
+
+/**
+ * @brief Contracts with everything but the spot level folded into five columns
+ *
+ * For a contract with d1 = (ln(S/K) + (b + sig^2/2) T) / (sig sqrt(T)),
+ * moneyness holds the numerator, so multiplying the spot by a factor F only
+ * adds ln F to it. Prices then cost two normal CDFs and a few products.
+ */
+struct FactorisedBatch
+{
+    const double* moneyness;          // ln(S/K) + (b + sig^2/2) T
+    const double* sigSqrtT;           // sig sqrt(T)
+    const double* carriedSpot;        // S e^((b-r)T)
+    const double* discountedStrike;   // K e^(-rT)
+    const double* sign;               // +1 call, -1 put
+    std::size_t size;
+};
+
+// Highest instruction set supported by both this build and the running CPU (detected once)
+SimdLevel detectSimdLevel();
+
+// Human-readable name of an instruction set
+std::string simdLevelName(SimdLevel level);
+
+/**
+ * @brief Evaluate one Black-Scholes quantity for every option in a batch
+ *
+ * Processes 4 (AVX2) or 8 (AVX512) options per instruction. Requests for an
+ * instruction set above detectSimdLevel() fall back to the best available one.
+ *
+ * @param quantity Quantity to evaluate
+ * @param batch Structure-of-arrays option batch
+ * @param out Output column, must hold exactly batch.size values
+ * @param level Requested instruction set
+ * @param cdfMode Normal CDF implementation (Boost is served by Accurate, it cannot be vectorised)
+ */
+void evaluateBlackScholesBatch(BatchQuantity quantity, const OptionBatchView& batch,
+                               std::span<double> out, SimdLevel level = detectSimdLevel(),
+                               NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+
+/**
+ * @brief Evaluate prices and Greeks of calls and puts in one pass
+ *
+ * d1/d2, the normal CDF/PDF values and both discount factors are computed
+ * once per option and shared by every output column.
+ *
+ * @param batch Structure-of-arrays option batch
+ * @param out Result columns, resized to batch.size
+ * @param level Requested instruction set
+ * @param cdfMode Normal CDF implementation (Boost is served by Accurate, it cannot be vectorised)
+ */
+void evaluateBlackScholesGreeksBatch(const OptionBatchView& batch, GreeksBatch& out,
+                                     SimdLevel level = detectSimdLevel(),
+                                     NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+// As above, into caller-owned columns of at least batch.size rows each (no allocation)
+void evaluateBlackScholesGreeksBatch(const OptionBatchView& batch, const GreeksColumns& out,
+                                     SimdLevel level = detectSimdLevel(),
+                                     NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+
+/**
+ * @brief Evaluate one Black-Scholes sensitivity for every option in a batch
+ *
+ * Same analytic formulas as the fused Greeks kernel, with only the normal
+ * CDF/PDF values the selected Greek needs.
+ *
+ * @param greek Sensitivity to evaluate
+ * @param batch Structure-of-arrays option batch
+ * @param out Output column, must hold exactly batch.size values
+ * @param level Requested instruction set
+ * @param cdfMode Normal CDF implementation (Boost is served by Accurate, it cannot be vectorised)
+ */
+void evaluateBlackScholesGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out,
+                                    SimdLevel level = detectSimdLevel(),
+                                    NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+
+/**
+ * @brief Evaluate one Black-Scholes quantity along a sweep line
+ *
+ * @param quantity Quantity to evaluate
+ * @param line Shared parameters plus the spot and strike columns
+ * @param out Output column, must hold exactly line.size values
+ * @param level Requested instruction set
+ * @param cdfMode Normal CDF implementation (Boost is served by Accurate, it cannot be vectorised)
+ */
+void evaluateBlackScholesLine(BatchQuantity quantity, const SweepLine& line, std::span<double> out,
+                              SimdLevel level = detectSimdLevel(),
+                              NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+
+/**
+ * @brief Invert Black-Scholes prices to implied volatilities
+ *
+ * Every contract runs Halley iterations from a rational initial guess;
+ * 4 (AVX2) or 8 (AVX512) contracts iterate in lock step and finished lanes
+ * are frozen until the slowest one converges. The sig column of the batch is
+ * ignored. Always uses the Accurate normal CDF.
+ *
+ * @param batch Structure-of-arrays contracts
+ * @param prices Market prices, one per contract
+ * @param type Call or put prices
+ * @param settings Tolerance and iteration limit
+ * @param out Results, must hold exactly batch.size values
+ * @param level Requested instruction set
+ */
+void evaluateImpliedVolatilityBatch(const OptionBatchView& batch, std::span<const double> prices, OptionType type,
+                                    const ImpliedVolSettings& settings, std::span<ImpliedVolResult> out,
+                                    SimdLevel level = detectSimdLevel());
+
+/**
+ * @brief Put-call parity residual (C - P) - (S e^((b-r)T) - K e^(-rT)) of every option
+ *
+ * Both discount factors are evaluated with the vector exponential, so a whole
+ * book is audited in one streaming pass over its columns and prices.
+ *
+ * @param batch Structure-of-arrays options (sig is not read)
+ * @param callPrices Call prices, one per option
+ * @param putPrices Put prices, one per option
+ * @param out Residuals, must hold exactly batch.size values
+ * @param level Requested instruction set
+ */
+void evaluateParityDifferenceBatch(const OptionBatchView& batch, std::span<const double> callPrices,
+                                   std::span<const double> putPrices, std::span<double> out,
+                                   SimdLevel level = detectSimdLevel());
+
+/**
+ * @brief Black-Scholes prices of factorised contracts with every spot multiplied by spotFactor
+ *
+ * @param batch Factorised contracts (see FactorisedBatch)
+ * @param spotFactor Spot multiplier, e.g. 1.05 for a +5% shock (must be positive)
+ * @param out Prices, must hold exactly batch.size values
+ * @param level Requested instruction set
+ * @param cdfMode Normal CDF implementation (Boost is served by Accurate, it cannot be vectorised)
+ */
+void evaluateBlackScholesFactorised(const FactorisedBatch& batch, double spotFactor, std::span<double> out,
+                                    SimdLevel level = detectSimdLevel(),
+                                    NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+
+#endif // BLACKSCHOLESKERNELS_HPP
@@ -0,0 +1,38 @@
+// Compiled with -mavx2 -mfma (see CMakeLists.txt); only called after runtime detection.
+#include "BlackScholesSimdKernel.hpp"
+
+void evaluateBlackScholesAVX2(BatchQuantity quantity, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out)
+{
+    runBlackScholesKernel<VecAvx2>(quantity, cdfMode, batch, out);
+}
+
+void evaluateBlackScholesGreeksAVX2(NormalCdfMode cdfMode, const OptionBatchView& batch, const GreeksColumns& out)
+{
+    runBlackScholesGreeksKernel<VecAvx2>(cdfMode, batch, out);
+}
+
+void evaluateBlackScholesGreekAVX2(Greek greek, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out)
+{
+    runBlackScholesGreekKernel<VecAvx2>(greek, cdfMode, batch, out);
+}
+
+void evaluateBlackScholesLineAVX2(BatchQuantity quantity, NormalCdfMode cdfMode, const SweepLine& line, double* out)
+{
+    runBlackScholesLineKernel<VecAvx2>(quantity, cdfMode, line, out);
+}
+
+void evaluateImpliedVolatilityAVX2(const OptionBatchView& batch, const double* prices, OptionType type,
+                                   const ImpliedVolSettings& settings, ImpliedVolResult* out)
+{
+    runImpliedVolKernel<VecAvx2>(batch, prices, type, settings, out);
+}
+
+void evaluateParityDifferenceAVX2(const OptionBatchView& batch, const double* calls, const double* puts, double* out)
+{
+    runParityKernel<VecAvx2>(batch, calls, puts, out);
+}
+
+void evaluateBlackScholesFactorisedAVX2(NormalCdfMode cdfMode, const FactorisedBatch& batch, double spotFactor, double* out)
+{
+    runFactorisedKernel<VecAvx2>(cdfMode, batch, spotFactor, out);
+}
@@ -0,0 +1,38 @@
+// Compiled with -mavx512f (see CMakeLists.txt); only called after runtime detection.
+#include "BlackScholesSimdKernel.hpp"
+
+void evaluateBlackScholesAVX512(BatchQuantity quantity, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out)
+{
+    runBlackScholesKernel<VecAvx512>(quantity, cdfMode, batch, out);
+}
+
+void evaluateBlackScholesGreeksAVX512(NormalCdfMode cdfMode, const OptionBatchView& batch, const GreeksColumns& out)
+{
+    runBlackScholesGreeksKernel<VecAvx512>(cdfMode, batch, out);
+}
+
+void evaluateBlackScholesGreekAVX512(Greek greek, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out)
+{
+    runBlackScholesGreekKernel<VecAvx512>(greek, cdfMode, batch, out);
+}
+
+void evaluateBlackScholesLineAVX512(BatchQuantity quantity, NormalCdfMode cdfMode, const SweepLine& line, double* out)
+{
+    runBlackScholesLineKernel<VecAvx512>(quantity, cdfMode, line, out);
+}
+
+void evaluateImpliedVolatilityAVX512(const OptionBatchView& batch, const double* prices, OptionType type,
+                                     const ImpliedVolSettings& settings, ImpliedVolResult* out)
+{
+    runImpliedVolKernel<VecAvx512>(batch, prices, type, settings, out);
+}
+
+void evaluateParityDifferenceAVX512(const OptionBatchView& batch, const double* calls, const double* puts, double* out)
+{
+    runParityKernel<VecAvx512>(batch, calls, puts, out);
+}
+
+void evaluateBlackScholesFactorisedAVX512(NormalCdfMode cdfMode, const FactorisedBatch& batch, double spotFactor, double* out)
+{
+    runFactorisedKernel<VecAvx512>(cdfMode, batch, spotFactor, out);
+}
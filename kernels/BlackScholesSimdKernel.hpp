@@ -0,0 +1,949 @@
+#ifndef BLACKSCHOLESSIMDKERNEL_HPP
+#define BLACKSCHOLESSIMDKERNEL_HPP
+
+/**
+ * @brief Width-generic Black-Scholes batch kernel (internal header)
+ *
+ * The kernel and its math routines are written once against a small vector
+ * wrapper interface (load/store/broadcast, arithmetic, compare/select and two
+ * exponent helpers) and instantiated per instruction set in its own
+ * translation unit, each compiled with the matching -m flags.
+ *
+ * Everything here lives in an unnamed namespace on purpose: the translation
+ * units are built with different target flags, so any shared inline symbol
+ * could be resolved by the linker to an AVX copy and then run on a CPU
+ * without AVX. For the same reason the kernels avoid calling inline library
+ * templates instantiated on non-local types (std::array<double*>,
+ * numeric_limits functions in non-constant contexts, ...).
+ */
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include "BlackScholesKernels.hpp"
+#include "NormalDistribution.hpp"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+// ---------------------------------------------------------------------------
+// Scalar lane (fallback and tail handling reference)
+// ---------------------------------------------------------------------------
+
+struct MaskScalar { bool m; };
+
+struct VecScalar
+{
+    using Mask = MaskScalar;
+    static constexpr std::size_t width = 1;
+
+    double v;
+
+    static VecScalar load(const double* p) { return {*p}; }
+    static VecScalar broadcast(double x) { return {x}; }
+    void store(double* p) const { *p = v; }
+};
+
+inline VecScalar operator + (VecScalar a, VecScalar b) { return {a.v + b.v}; }
+inline VecScalar operator - (VecScalar a, VecScalar b) { return {a.v - b.v}; }
+inline VecScalar operator * (VecScalar a, VecScalar b) { return {a.v * b.v}; }
+inline VecScalar operator / (VecScalar a, VecScalar b) { return {a.v / b.v}; }
+inline VecScalar operator - (VecScalar a) { return {-a.v}; }
+inline VecScalar fmadd(VecScalar a, VecScalar b, VecScalar c) { return {a.v * b.v + c.v}; }
+inline VecScalar sqrt(VecScalar a) { return {std::sqrt(a.v)}; }
+inline VecScalar abs(VecScalar a) { return {std::abs(a.v)}; }
+inline MaskScalar lessThan(VecScalar a, VecScalar b) { return {a.v < b.v}; }
+inline MaskScalar greaterThan(VecScalar a, VecScalar b) { return {a.v > b.v}; }
+inline MaskScalar isNan(VecScalar a) { return {std::isnan(a.v)}; }
+inline VecScalar select(MaskScalar m, VecScalar a, VecScalar b) { return m.m ? a : b; }
+
+// libm is already accurate and fast one lane at a time
+inline VecScalar vexp(VecScalar x) { return {std::exp(x.v)}; }
+inline VecScalar vlog(VecScalar x) { return {std::log(x.v)}; }
+
+// ---------------------------------------------------------------------------
+// AVX2 + FMA lane (4 doubles)
+// ---------------------------------------------------------------------------
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+struct MaskAvx2 { __m256d m; };
+
+struct VecAvx2
+{
+    using Mask = MaskAvx2;
+    static constexpr std::size_t width = 4;
+
+    __m256d v;
+
+    static VecAvx2 load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static VecAvx2 broadcast(double x) { return {_mm256_set1_pd(x)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+};
+
+inline VecAvx2 operator + (VecAvx2 a, VecAvx2 b) { return {_mm256_add_pd(a.v, b.v)}; }
+inline VecAvx2 operator - (VecAvx2 a, VecAvx2 b) { return {_mm256_sub_pd(a.v, b.v)}; }
+inline VecAvx2 operator * (VecAvx2 a, VecAvx2 b) { return {_mm256_mul_pd(a.v, b.v)}; }
+inline VecAvx2 operator / (VecAvx2 a, VecAvx2 b) { return {_mm256_div_pd(a.v, b.v)}; }
+inline VecAvx2 operator - (VecAvx2 a) { return {_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+inline VecAvx2 fmadd(VecAvx2 a, VecAvx2 b, VecAvx2 c) { return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+inline VecAvx2 sqrt(VecAvx2 a) { return {_mm256_sqrt_pd(a.v)}; }
+inline VecAvx2 abs(VecAvx2 a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+inline VecAvx2 roundNearest(VecAvx2 a) { return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+inline MaskAvx2 lessThan(VecAvx2 a, VecAvx2 b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+inline MaskAvx2 greaterThan(VecAvx2 a, VecAvx2 b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+inline MaskAvx2 isNan(VecAvx2 a) { return {_mm256_cmp_pd(a.v, a.v, _CMP_UNORD_Q)}; }
+inline VecAvx2 select(MaskAvx2 m, VecAvx2 a, VecAvx2 b) { return {_mm256_blendv_pd(b.v, a.v, m.m)}; }
+
+// 2^n for integral n in [-1022, 1023], built directly in the exponent field
+inline VecAvx2 pow2n(VecAvx2 n)
+{
+    __m256i n64 = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n.v));
+    n64 = _mm256_add_epi64(n64, _mm256_set1_epi64x(1023));
+    return {_mm256_castsi256_pd(_mm256_slli_epi64(n64, 52))};
+}
+
+// Split positive normal x into mantissa in [0.5, 1) and exponent e with x = m * 2^e
+inline VecAvx2 frexp(VecAvx2 x, VecAvx2& e)
+{
+    const __m256d magic = _mm256_set1_pd(0x1p52);
+    __m256i bits = _mm256_castpd_si256(x.v);
+    __m256i biased = _mm256_srli_epi64(bits, 52);
+    __m256d biasedD = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(biased, _mm256_castpd_si256(magic))), magic);
+    e = {_mm256_sub_pd(biasedD, _mm256_set1_pd(1022.0))};
+
+    __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+    mantissa = _mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3FE0000000000000LL));
+    return {_mm256_castsi256_pd(mantissa)};
+}
+
+#endif // __AVX2__ && __FMA__
+
+// ---------------------------------------------------------------------------
+// AVX-512F lane (8 doubles)
+// ---------------------------------------------------------------------------
+
+#if defined(__AVX512F__)
+
+struct MaskAvx512 { __mmask8 m; };
+
+struct VecAvx512
+{
+    using Mask = MaskAvx512;
+    static constexpr std::size_t width = 8;
+
+    __m512d v;
+
+    static VecAvx512 load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    static VecAvx512 broadcast(double x) { return {_mm512_set1_pd(x)}; }
+    void store(double* p) const { _mm512_storeu_pd(p, v); }
+};
+
+inline VecAvx512 operator + (VecAvx512 a, VecAvx512 b) { return {_mm512_add_pd(a.v, b.v)}; }
+inline VecAvx512 operator - (VecAvx512 a, VecAvx512 b) { return {_mm512_sub_pd(a.v, b.v)}; }
+inline VecAvx512 operator * (VecAvx512 a, VecAvx512 b) { return {_mm512_mul_pd(a.v, b.v)}; }
+inline VecAvx512 operator / (VecAvx512 a, VecAvx512 b) { return {_mm512_div_pd(a.v, b.v)}; }
+inline VecAvx512 operator - (VecAvx512 a) { return {_mm512_sub_pd(_mm512_setzero_pd(), a.v)}; }
+inline VecAvx512 fmadd(VecAvx512 a, VecAvx512 b, VecAvx512 c) { return {_mm512_fmadd_pd(a.v, b.v, c.v)}; }
+inline VecAvx512 sqrt(VecAvx512 a) { return {_mm512_sqrt_pd(a.v)}; }
+inline VecAvx512 abs(VecAvx512 a) { return {_mm512_abs_pd(a.v)}; }
+inline VecAvx512 roundNearest(VecAvx512 a) { return {_mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+inline MaskAvx512 lessThan(VecAvx512 a, VecAvx512 b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ)}; }
+inline MaskAvx512 greaterThan(VecAvx512 a, VecAvx512 b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ)}; }
+inline MaskAvx512 isNan(VecAvx512 a) { return {_mm512_cmp_pd_mask(a.v, a.v, _CMP_UNORD_Q)}; }
+inline VecAvx512 select(MaskAvx512 m, VecAvx512 a, VecAvx512 b) { return {_mm512_mask_blend_pd(m.m, b.v, a.v)}; }
+
+inline VecAvx512 pow2n(VecAvx512 n)
+{
+    return {_mm512_scalef_pd(_mm512_set1_pd(1.0), n.v)};
+}
+
+inline VecAvx512 frexp(VecAvx512 x, VecAvx512& e)
+{
+    e = {_mm512_add_pd(_mm512_getexp_pd(x.v), _mm512_set1_pd(1.0))};
+    return {_mm512_getmant_pd(x.v, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_src)};
+}
+
+#endif // __AVX512F__
+
+// ---------------------------------------------------------------------------
+// Width-generic math
+// ---------------------------------------------------------------------------
+
+// Horner evaluation of c[0]*x^n + ... + c[n]
+template <typename V, std::size_t N>
+inline V polevl(V x, const double (&c)[N])
+{
+    V result = V::broadcast(c[0]);
+    for (std::size_t i = 1; i < N; ++i) {
+        result = fmadd(result, x, V::broadcast(c[i]));
+    }
+    return result;
+}
+
+// Natural exponential (Cephes exp: Pade approximation after range reduction, ~1 ulp)
+template <typename V>
+inline V vexp(V x)
+{
+    static constexpr double P[] = {1.26177193074810590878e-4, 3.02994407707441961300e-2, 9.99999999999999999910e-1};
+    static constexpr double Q[] = {3.00198505138664455042e-6, 2.52448340349684104192e-3, 2.27265548208155028766e-1,
+                                   2.00000000000000000009e0};
+    static constexpr double inf = std::numeric_limits<double>::infinity();
+    const V minArg = V::broadcast(-708.39641853226410622);
+    const V maxArg = V::broadcast(709.43613930310391424);
+
+    V xc = select(lessThan(x, minArg), minArg, select(greaterThan(x, maxArg), maxArg, x));
+
+    // x = n*ln2 + r, |r| <= ln2/2, with ln2 split in two parts for exact reduction
+    V n = roundNearest(xc * V::broadcast(1.4426950408889634074));
+    V r = fmadd(n, V::broadcast(-6.93145751953125e-1), xc);
+    r = fmadd(n, V::broadcast(-1.42860682030941723212e-6), r);
+
+    V rr = r * r;
+    V p = r * polevl(rr, P);
+    V q = polevl(rr, Q);
+    V er = fmadd(V::broadcast(2.0), p / (q - p), V::broadcast(1.0));
+    V result = er * pow2n(n);
+
+    result = select(lessThan(x, minArg), V::broadcast(0.0), result);
+    result = select(greaterThan(x, maxArg), V::broadcast(inf), result);
+    return select(isNan(x), x, result);
+}
+
+// Natural logarithm (Cephes log: log(1+f) rational approximation, ~1 ulp for normal x)
+template <typename V>
+inline V vlog(V x)
+{
+    static constexpr double P[] = {1.01875663804580931796e-4, 4.97494994976747001425e-1, 4.70579119878881725854e0,
+                                   1.44989225341610930846e1, 1.79368678507819816313e1, 7.70838733755885391666e0};
+    static constexpr double Q[] = {1.0, 1.12873587189167450590e1, 4.52279145837532221105e1,
+                                   8.29875266912776603211e1, 7.11544750618563894466e1, 2.31251620126765340583e1};
+    static constexpr double inf = std::numeric_limits<double>::infinity();
+    static constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    static constexpr double minNormal = std::numeric_limits<double>::min();
+    static constexpr double maxFinite = std::numeric_limits<double>::max();
+    const V one = V::broadcast(1.0);
+
+    V e;
+    V m = frexp(x, e);
+
+    // Shift the mantissa to [sqrt(1/2), sqrt(2)) so that f = m - 1 stays small
+    auto small = lessThan(m, V::broadcast(0.70710678118654752440));
+    e = select(small, e - one, e);
+    V f = select(small, m + m - one, m - one);
+
+    V z = f * f;
+    V y = f * (z * polevl(f, P) / polevl(f, Q));
+    y = fmadd(e, V::broadcast(-2.121944400546905827679e-4), y);
+    y = fmadd(z, V::broadcast(-0.5), y);
+    V result = fmadd(e, V::broadcast(0.693359375), f + y);
+
+    result = select(lessThan(x, V::broadcast(0.0)), V::broadcast(nan), result);
+    result = select(lessThan(abs(x), V::broadcast(minNormal)),
+                    V::broadcast(-inf), result);
+    result = select(greaterThan(x, V::broadcast(maxFinite)), x, result);
+    return select(isNan(x), x, result);
+}
+
+// Standard normal probability density function
+template <typename V>
+inline V normalPdf(V x)
+{
+    return V::broadcast(InvSqrt2Pi) * vexp(V::broadcast(-0.5) * x * x);
+}
+
+/**
+ * Lower tail N(-a) of the standard normal distribution for a = |x| >= 0
+ *
+ * Accurate: Hart (1968) double precision algorithm (see NormalDistribution.hpp),
+ * with the rational and continued fraction branches both evaluated and blended
+ * so the routine is branch-free across lanes.
+ * Fast: Abramowitz & Stegun 26.2.17, one exp and a degree-5 polynomial.
+ * Boost is not vectorisable and is served by the Accurate variant.
+ */
+template <typename V, NormalCdfMode Mode>
+inline V normalLowerTail(V ax)
+{
+    if constexpr (Mode == NormalCdfMode::Fast) {
+        V t = V::broadcast(1.0) / fmadd(V::broadcast(AbramowitzStegunP), ax, V::broadcast(1.0));
+        return normalPdf(ax) * polevl(t, AbramowitzStegunB) * t;
+    }
+    else {
+        V expTerm = vexp(V::broadcast(-0.5) * ax * ax);
+
+        // a < HartRationalLimit
+        V rational = expTerm * polevl(ax, HartNumerator) / polevl(ax, HartDenominator);
+
+        // a >= HartRationalLimit
+        V cf = ax + V::broadcast(0.65);
+        cf = ax + V::broadcast(4.0) / cf;
+        cf = ax + V::broadcast(3.0) / cf;
+        cf = ax + V::broadcast(2.0) / cf;
+        cf = ax + V::broadcast(1.0) / cf;
+        V tail = expTerm / cf / V::broadcast(Sqrt2Pi);
+
+        V lower = select(lessThan(ax, V::broadcast(HartRationalLimit)), rational, tail);
+        return select(greaterThan(ax, V::broadcast(HartUnderflowLimit)), V::broadcast(0.0), lower);
+    }
+}
+
+// Standard normal cumulative distribution function
+template <typename V, NormalCdfMode Mode>
+inline V normalCdf(V x)
+{
+    V lower = normalLowerTail<V, Mode>(abs(x));
+    return select(greaterThan(x, V::broadcast(0.0)), V::broadcast(1.0) - lower, lower);
+}
+
+// N(x) and N(-x) from a single tail evaluation, each accurate in its own small tail
+template <typename V, NormalCdfMode Mode>
+inline void normalCdfPair(V x, V& cdf, V& cdfNeg)
+{
+    V lower = normalLowerTail<V, Mode>(abs(x));
+    V upper = V::broadcast(1.0) - lower;
+    auto positive = greaterThan(x, V::broadcast(0.0));
+    cdf = select(positive, upper, lower);
+    cdfNeg = select(positive, lower, upper);
+}
+
+// ---------------------------------------------------------------------------
+// Black-Scholes kernels (generalised cost-of-carry b)
+// ---------------------------------------------------------------------------
+
+template <typename V>
+struct D1D2
+{
+    V sqrtT;
+    V sigSqrtT;
+    V d1;
+    V d2;
+};
+
+template <typename V>
+inline D1D2<V> calculateD1D2(V T, V K, V sig, V S, V b)
+{
+    V sqrtT = sqrt(T);
+    V sigSqrtT = sig * sqrtT;
+    V d1 = (vlog(S / K) + (b + V::broadcast(0.5) * sig * sig) * T) / sigSqrtT;
+    return {sqrtT, sigSqrtT, d1, d1 - sigSqrtT};
+}
+
+// One quantity from d1/d2 and the discount factors (unused factors are optimised away)
+template <typename V, NormalCdfMode Mode, BatchQuantity Quantity>
+inline std::array<V, 1> blackScholesQuantity(V d1, V d2, V sigSqrtT, V carry, V disc, V K, V S)
+{
+    if constexpr (Quantity == BatchQuantity::CallPrice) {
+        return {S * carry * normalCdf<V, Mode>(d1) - K * disc * normalCdf<V, Mode>(d2)};
+    }
+    else if constexpr (Quantity == BatchQuantity::PutPrice) {
+        return {K * disc * normalCdf<V, Mode>(-d2) - S * carry * normalCdf<V, Mode>(-d1)};
+    }
+    else if constexpr (Quantity == BatchQuantity::CallDelta) {
+        return {carry * normalCdf<V, Mode>(d1)};
+    }
+    else if constexpr (Quantity == BatchQuantity::PutDelta) {
+        return {carry * (normalCdf<V, Mode>(d1) - V::broadcast(1.0))};
+    }
+    else {
+        return {carry * normalPdf(d1) / (S * sigSqrtT)};
+    }
+}
+
+template <typename V, NormalCdfMode Mode, BatchQuantity Quantity>
+inline std::array<V, 1> blackScholesLane(V T, V K, V sig, V r, V S, V b)
+{
+    D1D2<V> d = calculateD1D2(T, K, sig, S, b);
+    return blackScholesQuantity<V, Mode, Quantity>(d.d1, d.d2, d.sigSqrtT, vexp((b - r) * T), vexp(-r * T), K, S);
+}
+
+// Prices and Greeks of call and put, in GreeksColumns field order
+template <typename V, NormalCdfMode Mode>
+inline std::array<V, 15> blackScholesGreeksLane(V T, V K, V sig, V r, V S, V b)
+{
+    D1D2<V> d = calculateD1D2(T, K, sig, S, b);
+
+    V carry = vexp((b - r) * T);
+    V disc = vexp(-r * T);
+    V Nd1, Nmd1, Nd2, Nmd2;
+    normalCdfPair<V, Mode>(d.d1, Nd1, Nmd1);
+    normalCdfPair<V, Mode>(d.d2, Nd2, Nmd2);
+    V nd1 = normalPdf(d.d1);
+
+    V Sc = S * carry;
+    V Kd = K * disc;
+    V Scnd1 = Sc * nd1;
+    V decay = -(Scnd1 * sig) / (V::broadcast(2.0) * d.sqrtT);
+    V spread = b - r;
+    V gamma = Scnd1 / (S * S * d.sigSqrtT);
+    V vega = Scnd1 * d.sqrtT;
+    V charm = -(carry * nd1 * (b / d.sigSqrtT - d.d2 / (V::broadcast(2.0) * T)));
+
+    return {
+        Sc * Nd1 - Kd * Nd2,                          // callPrice
+        Kd * Nmd2 - Sc * Nmd1,                        // putPrice
+        carry * Nd1,                                  // callDelta
+        -(carry * Nmd1),                              // putDelta
+        gamma,                                        // gamma
+        vega,                                         // vega
+        decay - spread * Sc * Nd1 - r * Kd * Nd2,     // callTheta
+        decay + spread * Sc * Nmd1 + r * Kd * Nmd2,   // putTheta
+        T * Kd * Nd2,                                 // callRho
+        -(T * Kd * Nmd2),                             // putRho
+        -(carry * nd1 * d.d2) / sig,                  // vanna
+        vega * d.d1 * d.d2 / sig,                     // volga
+        -(gamma / S) * (V::broadcast(1.0) + d.d1 / d.sigSqrtT),   // speed
+        charm - spread * carry * Nd1,                 // callCharm
+        charm + spread * carry * Nmd1                 // putCharm
+    };
+}
+
+// One sensitivity, with only the CDF/PDF values and discount factors it needs
+template <typename V, NormalCdfMode Mode, Greek G>
+inline std::array<V, 1> blackScholesGreekLane(V T, V K, V sig, V r, V S, V b)
+{
+    D1D2<V> d = calculateD1D2(T, K, sig, S, b);
+
+    if constexpr (G == Greek::CallRho) {
+        return {T * K * vexp(-r * T) * normalCdf<V, Mode>(d.d2)};
+    }
+    else if constexpr (G == Greek::PutRho) {
+        return {-(T * K * vexp(-r * T) * normalCdf<V, Mode>(-d.d2))};
+    }
+    else {
+        V carry = vexp((b - r) * T);
+        V carrynd1 = carry * normalPdf(d.d1);
+
+        if constexpr (G == Greek::Vega) {
+            return {S * carrynd1 * d.sqrtT};
+        }
+        else if constexpr (G == Greek::CallTheta) {
+            V decay = -(S * carrynd1 * sig) / (V::broadcast(2.0) * d.sqrtT);
+            return {decay - (b - r) * S * carry * normalCdf<V, Mode>(d.d1) - r * K * vexp(-r * T) * normalCdf<V, Mode>(d.d2)};
+        }
+        else if constexpr (G == Greek::PutTheta) {
+            V decay = -(S * carrynd1 * sig) / (V::broadcast(2.0) * d.sqrtT);
+            return {decay + (b - r) * S * carry * normalCdf<V, Mode>(-d.d1) + r * K * vexp(-r * T) * normalCdf<V, Mode>(-d.d2)};
+        }
+        else if constexpr (G == Greek::Vanna) {
+            return {-(carrynd1 * d.d2) / sig};
+        }
+        else if constexpr (G == Greek::Volga) {
+            return {S * carrynd1 * d.sqrtT * d.d1 * d.d2 / sig};
+        }
+        else if constexpr (G == Greek::Speed) {
+            return {-(carrynd1 / (S * S * d.sigSqrtT)) * (V::broadcast(1.0) + d.d1 / d.sigSqrtT)};
+        }
+        else {
+            V charm = -(carrynd1 * (b / d.sigSqrtT - d.d2 / (V::broadcast(2.0) * T)));
+            if constexpr (G == Greek::CallCharm) {
+                return {charm - (b - r) * carry * normalCdf<V, Mode>(d.d1)};
+            }
+            else {
+                return {charm + (b - r) * carry * normalCdf<V, Mode>(-d.d1)};
+            }
+        }
+    }
+}
+
+// Apply a lane function returning N registers over the batch, writing N output columns
+template <typename V, std::size_t N, typename Lane>
+void batchLoop(const OptionBatchView& batch, double* const (&outs)[N], Lane lane)
+{
+    constexpr std::size_t W = V::width;
+    const std::size_t n = batch.size;
+    std::size_t i = 0;
+
+    for (; i + W <= n; i += W) {
+        std::array<V, N> res = lane(V::load(batch.T + i), V::load(batch.K + i), V::load(batch.sig + i),
+                                    V::load(batch.r + i), V::load(batch.S + i), V::load(batch.b + i));
+        for (std::size_t k = 0; k < N; ++k) {
+            res[k].store(outs[k] + i);
+        }
+    }
+
+    if (i < n) {
+        // Pad the remainder into one full register; unused lanes get a benign option
+        alignas(64) double T[W], K[W], sig[W], r[W], S[W], b[W], tmp[W];
+        for (std::size_t j = 0; j < W; ++j) {
+            bool live = i + j < n;
+            T[j] = live ? batch.T[i + j] : 1.0;
+            K[j] = live ? batch.K[i + j] : 1.0;
+            sig[j] = live ? batch.sig[i + j] : 1.0;
+            r[j] = live ? batch.r[i + j] : 0.0;
+            S[j] = live ? batch.S[i + j] : 1.0;
+            b[j] = live ? batch.b[i + j] : 0.0;
+        }
+
+        std::array<V, N> res = lane(V::load(T), V::load(K), V::load(sig), V::load(r), V::load(S), V::load(b));
+        for (std::size_t k = 0; k < N; ++k) {
+            res[k].store(tmp);
+            for (std::size_t j = 0; i + j < n; ++j) {
+                outs[k][i + j] = tmp[j];
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sweep lines: T, sigma, r and b shared by the whole line
+// ---------------------------------------------------------------------------
+
+// Everything that does not depend on spot or strike, computed once per line
+template <typename V>
+struct LineInvariants
+{
+    V sigSqrtT;
+    V drift;   // (b + sig^2 / 2) * T
+    V carry;   // e^((b - r)T)
+    V disc;    // e^(-rT)
+};
+
+template <typename V>
+inline LineInvariants<V> calculateLineInvariants(const SweepLine& line)
+{
+    V T = V::broadcast(line.T);
+    V sig = V::broadcast(line.sig);
+    V r = V::broadcast(line.r);
+    V b = V::broadcast(line.b);
+    return {sig * sqrt(T), (b + V::broadcast(0.5) * sig * sig) * T, vexp((b - r) * T), vexp(-r * T)};
+}
+
+// Per option only log(S/K), the normal CDF/PDF and a few multiplications remain
+template <typename V, NormalCdfMode Mode, BatchQuantity Quantity>
+inline std::array<V, 1> blackScholesLineLane(const LineInvariants<V>& line, V K, V S)
+{
+    V d1 = (vlog(S / K) + line.drift) / line.sigSqrtT;
+    return blackScholesQuantity<V, Mode, Quantity>(d1, d1 - line.sigSqrtT, line.sigSqrtT, line.carry, line.disc, K, S);
+}
+
+template <typename V, NormalCdfMode Mode, BatchQuantity Quantity>
+void blackScholesLineLoop(const SweepLine& line, double* out)
+{
+    constexpr std::size_t W = V::width;
+    const LineInvariants<V> invariants = calculateLineInvariants<V>(line);
+    const std::size_t n = line.size;
+    std::size_t i = 0;
+
+    for (; i + W <= n; i += W) {
+        blackScholesLineLane<V, Mode, Quantity>(invariants, V::load(line.K + i), V::load(line.S + i))[0].store(out + i);
+    }
+
+    if (i < n) {
+        alignas(64) double K[W], S[W], tmp[W];
+        for (std::size_t j = 0; j < W; ++j) {
+            bool live = i + j < n;
+            K[j] = live ? line.K[i + j] : 1.0;
+            S[j] = live ? line.S[i + j] : 1.0;
+        }
+
+        blackScholesLineLane<V, Mode, Quantity>(invariants, V::load(K), V::load(S))[0].store(tmp);
+        for (std::size_t j = 0; i + j < n; ++j) {
+            out[i + j] = tmp[j];
+        }
+    }
+}
+
+template <typename V, NormalCdfMode Mode>
+void runBlackScholesLineKernel(BatchQuantity quantity, const SweepLine& line, double* out)
+{
+    switch (quantity) {
+        case BatchQuantity::CallPrice: blackScholesLineLoop<V, Mode, BatchQuantity::CallPrice>(line, out); break;
+        case BatchQuantity::PutPrice:  blackScholesLineLoop<V, Mode, BatchQuantity::PutPrice>(line, out); break;
+        case BatchQuantity::CallDelta: blackScholesLineLoop<V, Mode, BatchQuantity::CallDelta>(line, out); break;
+        case BatchQuantity::PutDelta:  blackScholesLineLoop<V, Mode, BatchQuantity::PutDelta>(line, out); break;
+        case BatchQuantity::Gamma:     blackScholesLineLoop<V, Mode, BatchQuantity::Gamma>(line, out); break;
+    }
+}
+
+template <typename V>
+void runBlackScholesLineKernel(BatchQuantity quantity, NormalCdfMode cdfMode, const SweepLine& line, double* out)
+{
+    if (cdfMode == NormalCdfMode::Fast) {
+        runBlackScholesLineKernel<V, NormalCdfMode::Fast>(quantity, line, out);
+    }
+    else {
+        runBlackScholesLineKernel<V, NormalCdfMode::Accurate>(quantity, line, out);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Implied volatility (Halley iteration in lock step across lanes)
+// ---------------------------------------------------------------------------
+
+template <typename V>
+struct ImpliedVolLanes
+{
+    V volatility;
+    V iterations;
+    V status;   // ImpliedVolStatus values
+};
+
+/**
+ * Implied volatility of W contracts at once, in normalised Black form.
+ *
+ * With F = S e^(bT), x = ln(F/K) and the premium divided by e^(-rT) sqrt(FK),
+ * the out-of-the-money side (put-call parity removes the intrinsic value)
+ * depends only on y = -|x| and the total volatility s = sig sqrt(T):
+ * f(s) = e^(y/2) N(y/s + s/2) - e^(-y/2) N(y/s - s/2).
+ *
+ * Start: Corrado-Miller rational approximation. Iteration: Halley on the
+ * objectives of Jaeckel ("By implication", 2006), 1/ln f below the
+ * inflection point s_c = sqrt(2|y|) and ln(f_max - f) above it, which keep
+ * the iteration close to linear in both regimes. A bracket [lo, hi] is
+ * tightened from the sign of f - target every step and catches steps that
+ * leave it. Lanes freeze once converged; the loop ends when all have.
+ */
+template <typename V>
+inline ImpliedVolLanes<V> impliedVolLane(V T, V K, V r, V S, V b, V price, double sign,
+                                         double tolerance, std::size_t maxIterations)
+{
+    constexpr std::size_t W = V::width;
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    constexpr double Pi = 3.14159265358979323846;
+    const V zero = V::broadcast(0.0), one = V::broadcast(1.0), half = V::broadcast(0.5);
+
+    // Normalised out-of-the-money premium
+    V forward = S * vexp(b * T);
+    V x = vlog(forward / K);
+    V y = -abs(x);
+    V callIntrinsic = vexp(half * x) - vexp(-half * x);
+    V intrinsic = V::broadcast(sign) * callIntrinsic;
+    intrinsic = select(greaterThan(intrinsic, zero), intrinsic, zero);
+    V target = price / (vexp(-r * T) * sqrt(forward * K)) - intrinsic;
+    V fMax = vexp(half * y);
+    V fMaxInv = one / fMax;
+
+    V status = zero;
+    status = select(greaterThan(target, zero), status, V::broadcast(2.0));
+    status = select(lessThan(target, fMax), status, V::broadcast(3.0));
+    status = select(isNan(target), V::broadcast(4.0), status);
+    status = select(greaterThan(T, zero), status, V::broadcast(4.0));
+    status = select(greaterThan(K, zero), status, V::broadcast(4.0));
+    status = select(greaterThan(S, zero), status, V::broadcast(4.0));
+    V done = select(greaterThan(status, half), one, zero);
+
+    // Corrado-Miller start, inflection point s_c when it is not defined
+    V spread = fMax - fMaxInv;
+    V m = target - half * spread;
+    V radicand = m * m - spread * spread / V::broadcast(Pi);
+    V s = V::broadcast(Sqrt2Pi) / (fMax + fMaxInv) *
+          (m + sqrt(select(greaterThan(radicand, zero), radicand, zero)));
+    V sc = sqrt(V::broadcast(-2.0) * y);
+    sc = select(greaterThan(sc, V::broadcast(1e-12)), sc, V::broadcast(1e-12));
+    s = select(greaterThan(s, zero), s, sc);
+
+    V d1c = y / sc + half * sc;
+    V fc = fMax * normalCdf<V, NormalCdfMode::Accurate>(d1c) - fMaxInv * normalCdf<V, NormalCdfMode::Accurate>(d1c - sc);
+    auto lowRegion = lessThan(target, fc);
+    V invLogTarget = one / vlog(target);
+    V logGap = vlog(fMax - target);
+
+    V lo = zero, hi = V::broadcast(inf), iterations = zero;
+    alignas(64) double doneFlags[W];
+    for (std::size_t iteration = 0; iteration < maxIterations; ++iteration) {
+        V d1 = y / s + half * s;
+        V d2 = d1 - s;
+        V f = fMax * normalCdf<V, NormalCdfMode::Accurate>(d1) - fMaxInv * normalCdf<V, NormalCdfMode::Accurate>(d2);
+        V vega = fMax * normalPdf(d1);
+        V volga = vega * d1 * d2 / s;
+
+        auto above = greaterThan(f, target);
+        hi = select(above, s, hi);
+        lo = select(above, lo, s);
+
+        // Low region: g = 1/ln f - 1/ln target
+        V L = vlog(f);
+        V L1 = vega / f;
+        V L2 = volga / f - L1 * L1;
+        V lowG = one / L - invLogTarget;
+        V lowG1 = -L1 / (L * L);
+        V lowG2 = -L2 / (L * L) + V::broadcast(2.0) * L1 * L1 / (L * L * L);
+
+        // High region: g = ln(f_max - target) - ln(f_max - f)
+        V gap = fMax - f;
+        V highG = logGap - vlog(gap);
+        V highG1 = vega / gap;
+        V highG2 = volga / gap + highG1 * highG1;
+
+        V g = select(lowRegion, lowG, highG);
+        V g1 = select(lowRegion, lowG1, highG1);
+        V g2 = select(lowRegion, lowG2, highG2);
+
+        // Halley step, limited to twice the Newton step
+        V newton = -g / g1;
+        V denominator = one - half * newton * g2 / g1;
+        denominator = select(lessThan(denominator, half), half, denominator);
+        V next = s + newton / denominator;
+
+        // Bisect (or double while no upper bound is known) when the step leaves the bracket
+        V fallback = select(lessThan(hi, V::broadcast(inf)), half * (lo + hi), V::broadcast(2.0) * s);
+        next = select(lessThan(next, lo), fallback, next);
+        next = select(greaterThan(next, hi), fallback, next);
+        next = select(isNan(next), fallback, next);
+
+        auto frozen = greaterThan(done, half);
+        iterations = iterations + (one - done);
+        V converged = select(greaterThan(abs(next - s), V::broadcast(tolerance) * next), done, one);
+        s = select(frozen, s, next);
+        done = converged;
+
+        done.store(doneFlags);
+        bool allDone = true;
+        for (std::size_t j = 0; j < W; ++j) {
+            allDone = allDone && doneFlags[j] > 0.5;
+        }
+        if (allDone) {
+            break;
+        }
+    }
+
+    status = select(greaterThan(done, half), status, one);
+    V volatility = select(greaterThan(status, V::broadcast(1.5)), V::broadcast(nan), s / sqrt(T));
+    return {volatility, iterations, status};
+}
+
+template <typename V>
+void impliedVolLoop(const OptionBatchView& batch, const double* prices, double sign, double tolerance,
+                    std::size_t maxIterations, ImpliedVolResult* out)
+{
+    constexpr std::size_t W = V::width;
+    const std::size_t n = batch.size;
+    alignas(64) double volatility[W], iterations[W], status[W];
+
+    auto write = [&](std::size_t i, std::size_t count, const ImpliedVolLanes<V>& lanes) {
+        lanes.volatility.store(volatility);
+        lanes.iterations.store(iterations);
+        lanes.status.store(status);
+        for (std::size_t j = 0; j < count; ++j) {
+            out[i + j].volatility = volatility[j];
+            out[i + j].iterations = static_cast<std::uint32_t>(iterations[j]);
+            out[i + j].status = static_cast<ImpliedVolStatus>(static_cast<int>(status[j]));
+        }
+    };
+
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        write(i, W, impliedVolLane(V::load(batch.T + i), V::load(batch.K + i), V::load(batch.r + i),
+                                   V::load(batch.S + i), V::load(batch.b + i), V::load(prices + i),
+                                   sign, tolerance, maxIterations));
+    }
+
+    if (i < n) {
+        // Pad the remainder with an at-the-money contract that converges at once
+        alignas(64) double T[W], K[W], r[W], S[W], b[W], price[W];
+        for (std::size_t j = 0; j < W; ++j) {
+            bool live = i + j < n;
+            T[j] = live ? batch.T[i + j] : 1.0;
+            K[j] = live ? batch.K[i + j] : 1.0;
+            r[j] = live ? batch.r[i + j] : 0.0;
+            S[j] = live ? batch.S[i + j] : 1.0;
+            b[j] = live ? batch.b[i + j] : 0.0;
+            price[j] = live ? prices[i + j] : 0.08;
+        }
+        write(i, n - i, impliedVolLane(V::load(T), V::load(K), V::load(r), V::load(S), V::load(b), V::load(price),
+                                       sign, tolerance, maxIterations));
+    }
+}
+
+template <typename V>
+void runImpliedVolKernel(const OptionBatchView& batch, const double* prices, OptionType type,
+                         const ImpliedVolSettings& settings, ImpliedVolResult* out)
+{
+    impliedVolLoop<V>(batch, prices, type == OptionType::Call ? 1.0 : -1.0, settings.tolerance,
+                      settings.maxIterations, out);
+}
+
+// ---------------------------------------------------------------------------
+// Batch entry points
+// ---------------------------------------------------------------------------
+
+template <typename V, NormalCdfMode Mode, BatchQuantity Quantity>
+void blackScholesLoop(const OptionBatchView& batch, double* out)
+{
+    double* const outs[1] = {out};
+    batchLoop<V, 1>(batch, outs, blackScholesLane<V, Mode, Quantity>);
+}
+
+template <typename V, NormalCdfMode Mode>
+void runBlackScholesKernel(BatchQuantity quantity, const OptionBatchView& batch, double* out)
+{
+    switch (quantity) {
+        case BatchQuantity::CallPrice: blackScholesLoop<V, Mode, BatchQuantity::CallPrice>(batch, out); break;
+        case BatchQuantity::PutPrice:  blackScholesLoop<V, Mode, BatchQuantity::PutPrice>(batch, out); break;
+        case BatchQuantity::CallDelta: blackScholesLoop<V, Mode, BatchQuantity::CallDelta>(batch, out); break;
+        case BatchQuantity::PutDelta:  blackScholesLoop<V, Mode, BatchQuantity::PutDelta>(batch, out); break;
+        case BatchQuantity::Gamma:     blackScholesLoop<V, Mode, BatchQuantity::Gamma>(batch, out); break;
+    }
+}
+
+template <typename V>
+void runBlackScholesKernel(BatchQuantity quantity, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out)
+{
+    if (cdfMode == NormalCdfMode::Fast) {
+        runBlackScholesKernel<V, NormalCdfMode::Fast>(quantity, batch, out);
+    }
+    else {
+        runBlackScholesKernel<V, NormalCdfMode::Accurate>(quantity, batch, out);
+    }
+}
+
+template <typename V>
+void runBlackScholesGreeksKernel(NormalCdfMode cdfMode, const OptionBatchView& batch, const GreeksColumns& out)
+{
+    double* const outs[15] = {out.callPrice, out.putPrice, out.callDelta, out.putDelta, out.gamma,
+                              out.vega, out.callTheta, out.putTheta, out.callRho, out.putRho,
+                              out.vanna, out.volga, out.speed, out.callCharm, out.putCharm};
+    if (cdfMode == NormalCdfMode::Fast) {
+        batchLoop<V, 15>(batch, outs, blackScholesGreeksLane<V, NormalCdfMode::Fast>);
+    }
+    else {
+        batchLoop<V, 15>(batch, outs, blackScholesGreeksLane<V, NormalCdfMode::Accurate>);
+    }
+}
+
+template <typename V, NormalCdfMode Mode, Greek G>
+void blackScholesGreekLoop(const OptionBatchView& batch, double* out)
+{
+    double* const outs[1] = {out};
+    batchLoop<V, 1>(batch, outs, blackScholesGreekLane<V, Mode, G>);
+}
+
+template <typename V, NormalCdfMode Mode>
+void runBlackScholesGreekKernel(Greek greek, const OptionBatchView& batch, double* out)
+{
+    switch (greek) {
+        case Greek::Vega:      blackScholesGreekLoop<V, Mode, Greek::Vega>(batch, out); break;
+        case Greek::CallTheta: blackScholesGreekLoop<V, Mode, Greek::CallTheta>(batch, out); break;
+        case Greek::PutTheta:  blackScholesGreekLoop<V, Mode, Greek::PutTheta>(batch, out); break;
+        case Greek::CallRho:   blackScholesGreekLoop<V, Mode, Greek::CallRho>(batch, out); break;
+        case Greek::PutRho:    blackScholesGreekLoop<V, Mode, Greek::PutRho>(batch, out); break;
+        case Greek::Vanna:     blackScholesGreekLoop<V, Mode, Greek::Vanna>(batch, out); break;
+        case Greek::Volga:     blackScholesGreekLoop<V, Mode, Greek::Volga>(batch, out); break;
+        case Greek::Speed:     blackScholesGreekLoop<V, Mode, Greek::Speed>(batch, out); break;
+        case Greek::CallCharm: blackScholesGreekLoop<V, Mode, Greek::CallCharm>(batch, out); break;
+        case Greek::PutCharm:  blackScholesGreekLoop<V, Mode, Greek::PutCharm>(batch, out); break;
+    }
+}
+
+template <typename V>
+void runBlackScholesGreekKernel(Greek greek, NormalCdfMode cdfMode, const OptionBatchView& batch, double* out)
+{
+    if (cdfMode == NormalCdfMode::Fast) {
+        runBlackScholesGreekKernel<V, NormalCdfMode::Fast>(greek, batch, out);
+    }
+    else {
+        runBlackScholesGreekKernel<V, NormalCdfMode::Accurate>(greek, batch, out);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Put-call parity residual: (C - P) - (S e^((b-r)T) - K e^(-rT))
+// ---------------------------------------------------------------------------
+
+template <typename V>
+inline V parityDifferenceLane(V T, V K, V r, V S, V b, V call, V put)
+{
+    return (call - put) - (S * vexp((b - r) * T) - K * vexp(-r * T));
+}
+
+template <typename V>
+void runParityKernel(const OptionBatchView& batch, const double* calls, const double* puts, double* out)
+{
+    constexpr std::size_t W = V::width;
+    const std::size_t n = batch.size;
+    std::size_t i = 0;
+
+    for (; i + W <= n; i += W) {
+        parityDifferenceLane(V::load(batch.T + i), V::load(batch.K + i), V::load(batch.r + i), V::load(batch.S + i),
+                             V::load(batch.b + i), V::load(calls + i), V::load(puts + i)).store(out + i);
+    }
+
+    if (i < n) {
+        alignas(64) double T[W], K[W], r[W], S[W], b[W], call[W], put[W], tmp[W];
+        for (std::size_t j = 0; j < W; ++j) {
+            bool live = i + j < n;
+            T[j] = live ? batch.T[i + j] : 0.0;
+            K[j] = live ? batch.K[i + j] : 0.0;
+            r[j] = live ? batch.r[i + j] : 0.0;
+            S[j] = live ? batch.S[i + j] : 0.0;
+            b[j] = live ? batch.b[i + j] : 0.0;
+            call[j] = live ? calls[i + j] : 0.0;
+            put[j] = live ? puts[i + j] : 0.0;
+        }
+
+        parityDifferenceLane(V::load(T), V::load(K), V::load(r), V::load(S), V::load(b),
+                             V::load(call), V::load(put)).store(tmp);
+        for (std::size_t j = 0; i + j < n; ++j) {
+            out[i + j] = tmp[j];
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Factorised contracts: per-contract invariants precomputed, spot shift applied last
+// ---------------------------------------------------------------------------
+
+// sign * (F S e^((b-r)T) N(sign d1) - K e^(-rT) N(sign d2)) with d1 = (moneyness + ln F) / sig sqrt(T)
+template <typename V, NormalCdfMode Mode>
+inline V factorisedLane(V moneyness, V sigSqrtT, V carriedSpot, V discountedStrike, V sign,
+                        V logSpotFactor, V spotFactor)
+{
+    V d1 = (moneyness + logSpotFactor) / sigSqrtT;
+    V d2 = d1 - sigSqrtT;
+    return sign * (spotFactor * carriedSpot * normalCdf<V, Mode>(sign * d1) -
+                   discountedStrike * normalCdf<V, Mode>(sign * d2));
+}
+
+template <typename V, NormalCdfMode Mode>
+void factorisedLoop(const FactorisedBatch& batch, double spotFactor, double* out)
+{
+    constexpr std::size_t W = V::width;
+    const V factor = V::broadcast(spotFactor);
+    const V logFactor = vlog(factor);
+    const std::size_t n = batch.size;
+    std::size_t i = 0;
+
+    for (; i + W <= n; i += W) {
+        factorisedLane<V, Mode>(V::load(batch.moneyness + i), V::load(batch.sigSqrtT + i), V::load(batch.carriedSpot + i),
+                                V::load(batch.discountedStrike + i), V::load(batch.sign + i), logFactor, factor).store(out + i);
+    }
+
+    if (i < n) {
+        alignas(64) double moneyness[W], sigSqrtT[W], carriedSpot[W], discountedStrike[W], sign[W], tmp[W];
+        for (std::size_t j = 0; j < W; ++j) {
+            bool live = i + j < n;
+            moneyness[j] = live ? batch.moneyness[i + j] : 0.0;
+            sigSqrtT[j] = live ? batch.sigSqrtT[i + j] : 1.0;
+            carriedSpot[j] = live ? batch.carriedSpot[i + j] : 1.0;
+            discountedStrike[j] = live ? batch.discountedStrike[i + j] : 1.0;
+            sign[j] = live ? batch.sign[i + j] : 1.0;
+        }
+
+        factorisedLane<V, Mode>(V::load(moneyness), V::load(sigSqrtT), V::load(carriedSpot), V::load(discountedStrike),
+                                V::load(sign), logFactor, factor).store(tmp);
+        for (std::size_t j = 0; i + j < n; ++j) {
+            out[i + j] = tmp[j];
+        }
+    }
+}
+
+template <typename V>
+void runFactorisedKernel(NormalCdfMode cdfMode, const FactorisedBatch& batch, double spotFactor, double* out)
+{
+    if (cdfMode == NormalCdfMode::Fast) {
+        factorisedLoop<V, NormalCdfMode::Fast>(batch, spotFactor, out);
+    }
+    else {
+        factorisedLoop<V, NormalCdfMode::Accurate>(batch, spotFactor, out);
+    }
+}
+
+} // namespace
+
+#endif // BLACKSCHOLESSIMDKERNEL_HPP
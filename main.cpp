@@ -3,15 +3,48 @@
 #include <vector>
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <cstdint>
 // Boost
 #include <boost/random.hpp>
 #include <boost/math/distributions/normal.hpp>
+#include <boost/filesystem.hpp>
 
 #include "OptionContext.hpp"
+#include "StaticOptionContext.hpp"
 #include "BlackScholesPricer.hpp"
+#include "MonteCarloPricer.hpp"
+#include "LatticePricer.hpp"
+#include "FDMPricer.hpp"
+#include "FiniteDifferenceGreeks.hpp"
+#include "AdjointTape.hpp"
+#include "VolSurface.hpp"
 #include "PutCallParityValidator.hpp"
 #include "Option.hpp"
+#include "OptionBatch.hpp"
+#include "ParameterGrid.hpp"
+#include "BlackScholesKernels.hpp"
+#include "NormalDistribution.hpp"
+#include "ThreadPool.hpp"
+#include "PricingMetrics.hpp"
+#include "BatchValidation.hpp"
+#include "PricingCache.hpp"
+#include "OptionBook.hpp"
+#include "OptionFile.hpp"
+#include "CsvPipeline.hpp"
+#include "ScenarioEngine.hpp"
+#include "AllocationCounter.hpp"
 #include "utils/MeshUtils.hpp"
+#include "utils/Grid.hpp"
 #include "utils/MatrixPrintUtils.hpp"
 
 // Simple struct to hold test batch data
@@ -24,8 +57,59 @@ struct TestBatch
 };
     
 
-int main(void)
-{    
+// Command-line pricing: option_pricer --price-csv [input.csv|-] [output.csv|-]
+static int runCsvPricer(int argc, char* argv[])
+{
+    std::string inputPath = argc > 2 ? argv[2] : "-";
+    std::string outputPath = argc > 3 ? argv[3] : "-";
+
+    std::ios::sync_with_stdio(false);
+    std::ifstream inputFile;
+    std::ofstream outputFile;
+    if (inputPath != "-")
+    {
+        inputFile.open(inputPath, std::ios::binary);
+        if (!inputFile)
+        {
+            std::cerr << "Cannot open " << inputPath << std::endl;
+            return 1;
+        }
+    }
+    if (outputPath != "-")
+    {
+        outputFile.open(outputPath, std::ios::binary | std::ios::trunc);
+        if (!outputFile)
+        {
+            std::cerr << "Cannot create " << outputPath << std::endl;
+            return 1;
+        }
+    }
+
+    OptionContext context(std::make_unique<BlackScholesPricer>());
+    context.setValidationMode(ValidationMode::NaN);
+    context.setThreadCount(std::thread::hardware_concurrency());
+    try
+    {
+        std::ostream& output = outputPath == "-" ? std::cout : outputFile;
+        output << "call,put,call_delta,put_delta,gamma,parity_diff\n";
+        CsvPipelineStats stats = priceCsvStream(context, inputPath == "-" ? std::cin : inputFile, output);
+        std::cerr << "Priced " << stats.rows << " options in " << stats.chunks << " chunks" << std::endl;
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "--price-csv")
+    {
+        return runCsvPricer(argc, argv);
+    }
+
     // Create test batches
     TestBatch Batch_1 = {"BATCH 1", Option(0.25, 65.0, 0.30, 0.08, 60.0), 2.13337, 5.84628};
     TestBatch Batch_2 = {"BATCH 2", Option(1.0, 100.0, 0.2, 0.0, 100.0), 7.96557, 7.96557};
@@ -125,58 +209,31 @@ int main(void)
     auto expiryTimes = meshArray(0.1, 1.0, 0.2);  // 0.1, 0.3, 0.5, 0.7, 0.9
     auto spotPricesMatrix = meshArray(50.0, 70.0, 5.0);  // 50, 55, 60, 65, 70
     
-    std::vector<std::vector<Option>> expiryMatrix;
-    for (double T : expiryTimes) {
-        std::vector<Option> row;
-        for (double S : spotPricesMatrix) {
-            Option option = Batch_1.option;
-            option.ExerciseDate(T);
-            option.AssetPrice(S);
-            row.push_back(option);
-        }
-        expiryMatrix.push_back(row);
-    }
+    ParameterGrid expirySweep(Batch_1.option);
+    expirySweep.addAxis(OptionParameter::ExerciseDate, expiryTimes).addAxis(OptionParameter::AssetPrice, spotPricesMatrix);
     
-    auto expiryCallMatrix = context.calculateCallMatrix(expiryMatrix);
-    printMatrix(expiryTimes, spotPricesMatrix, expiryCallMatrix, "T\\S");
+    auto expiryCallMatrix = context.calculateCallMatrix(expirySweep);
+    printMatrix(expiryCallMatrix, "T\\S");
     
     // ii) Matrix pricing as function of Volatility
     std::cout << "\nii) Volatility Matrix:" << std::endl;
     auto volatilities = meshArray(0.1, 0.5, 0.1);  // 0.1, 0.2, 0.3, 0.4, 0.5
     
-    std::vector<std::vector<Option>> volMatrix;
-    for (double vol : volatilities) {
-        std::vector<Option> row;
-        for (double S : spotPricesMatrix) {
-            Option option = Batch_1.option;
-            option.Volatility(vol);
-            option.AssetPrice(S);
-            row.push_back(option);
-        }
-        volMatrix.push_back(row);
-    }
+    ParameterGrid volSweep(Batch_1.option);
+    volSweep.addAxis(OptionParameter::Volatility, volatilities).addAxis(OptionParameter::AssetPrice, spotPricesMatrix);
     
-    auto volCallMatrix = context.calculateCallMatrix(volMatrix);
-    printMatrix(volatilities, spotPricesMatrix, volCallMatrix, "Vol\\S");
+    auto volCallMatrix = context.calculateCallMatrix(volSweep);
+    printMatrix(volCallMatrix, "Vol\\S");
     
     // iii) Matrix pricing with any parameter combination (Strike vs Spot)
     std::cout << "\niii) Strike-Spot Matrix:" << std::endl;
     auto strikes = meshArray(60.0, 80.0, 5.0);  // 60, 65, 70, 75, 80
     
-    std::vector<std::vector<Option>> strikeMatrix;
-    for (double K : strikes) {
-        std::vector<Option> row;
-        for (double S : spotPricesMatrix) {
-            Option option = Batch_1.option;
-            option.StrikePrice(K);
-            option.AssetPrice(S);
-            row.push_back(option);
-        }
-        strikeMatrix.push_back(row);
-    }
+    ParameterGrid strikeSweep(Batch_1.option);
+    strikeSweep.addAxis(OptionParameter::StrikePrice, strikes).addAxis(OptionParameter::AssetPrice, spotPricesMatrix);
     
-    auto strikeCallMatrix = context.calculateCallMatrix(strikeMatrix);
-    printMatrix(strikes, spotPricesMatrix, strikeCallMatrix, "K\\S");
+    auto strikeCallMatrix = context.calculateCallMatrix(strikeSweep);
+    printMatrix(strikeCallMatrix, "K\\S");
 
     // Test Section: Gamma calculation with provided test batch
     std::cout << "\n=== GAMMA CALCULATION TEST ===" << std::endl;
@@ -260,66 +317,1719 @@ int main(void)
     auto expiryTimesGreeks = meshArray(0.1, 0.5, 0.1);  // 0.1, 0.2, 0.3, 0.4, 0.5
     auto spotPricesGreeks = meshArray(80.0, 120.0, 10.0);  // 80, 90, 100, 110, 120
     
-    std::vector<std::vector<Option>> expiryGreeksMatrix;
-    for (double T : expiryTimesGreeks)
+    Grid<Option> expiryGreeksMatrix(expiryTimesGreeks, spotPricesGreeks, gammaTestOption);
+    for (size_t i = 0; i < expiryGreeksMatrix.rows(); ++i)
     {
-        std::vector<Option> row;
-        for (double S : spotPricesGreeks)
+        for (size_t j = 0; j < expiryGreeksMatrix.cols(); ++j)
         {
-            Option option = gammaTestOption;  // Base parameters
-            option.ExerciseDate(T);
-            option.AssetPrice(S);
-            row.push_back(option);
+            expiryGreeksMatrix(i, j).ExerciseDate(expiryTimesGreeks[i]);
+            expiryGreeksMatrix(i, j).AssetPrice(spotPricesGreeks[j]);
         }
-        expiryGreeksMatrix.push_back(row);
     }
     
     auto callDeltaMatrix = context.calculateCallDeltaMatrix(expiryGreeksMatrix);
-    printMatrix(expiryTimesGreeks, spotPricesGreeks, callDeltaMatrix, "T\\S (Call Delta)");
+    printMatrix(callDeltaMatrix, "T\\S (Call Delta)");
     
     // ii) Gamma Matrix as function of Volatility vs Spot Price
     std::cout << "\nii) Gamma Matrix (Volatility vs Spot Price):" << std::endl;
     auto volatilitiesGreeks = meshArray(0.2, 0.6, 0.1);  // 0.2, 0.3, 0.4, 0.5, 0.6
     
-    std::vector<std::vector<Option>> volGreeksMatrix;
-    for (double vol : volatilitiesGreeks)
+    Grid<Option> volGreeksMatrix(volatilitiesGreeks, spotPricesGreeks, gammaTestOption);
+    for (size_t i = 0; i < volGreeksMatrix.rows(); ++i)
     {
-        std::vector<Option> row;
-        for (double S : spotPricesGreeks)
+        for (size_t j = 0; j < volGreeksMatrix.cols(); ++j)
         {
-            Option option = gammaTestOption;
-            option.Volatility(vol);
-            option.AssetPrice(S);
-            row.push_back(option);
+            volGreeksMatrix(i, j).Volatility(volatilitiesGreeks[i]);
+            volGreeksMatrix(i, j).AssetPrice(spotPricesGreeks[j]);
         }
-        volGreeksMatrix.push_back(row);
     }
     
     auto gammaMatrix = context.calculateGammaMatrix(volGreeksMatrix);
-    printMatrix(volatilitiesGreeks, spotPricesGreeks, gammaMatrix, "Vol\\S (Gamma)");
+    printMatrix(gammaMatrix, "Vol\\S (Gamma)");
     
     // iii) Put Delta Matrix as function of Strike vs Spot Price
     std::cout << "\niii) Put Delta Matrix (Strike vs Spot Price):" << std::endl;
     auto strikesGreeks = meshArray(80.0, 120.0, 10.0);  // 80, 90, 100, 110, 120
     
-    std::vector<std::vector<Option>> strikeGreeksMatrix;
-    for (double K : strikesGreeks)
+    Grid<Option> strikeGreeksMatrix(strikesGreeks, spotPricesGreeks, gammaTestOption);
+    for (size_t i = 0; i < strikeGreeksMatrix.rows(); ++i)
     {
-        std::vector<Option> row;
-        for (double S : spotPricesGreeks)
+        for (size_t j = 0; j < strikeGreeksMatrix.cols(); ++j)
         {
-            Option option = gammaTestOption;
-            option.StrikePrice(K);
-            option.AssetPrice(S);
-            row.push_back(option);
+            strikeGreeksMatrix(i, j).StrikePrice(strikesGreeks[i]);
+            strikeGreeksMatrix(i, j).AssetPrice(spotPricesGreeks[j]);
         }
-        strikeGreeksMatrix.push_back(row);
     }
     
     auto putDeltaMatrix = context.calculatePutDeltaMatrix(strikeGreeksMatrix);
-    printMatrix(strikesGreeks, spotPricesGreeks, putDeltaMatrix, "K\\S (Put Delta)");
+    printMatrix(putDeltaMatrix, "K\\S (Put Delta)");
+    
+    // Result grids carry the input labels and match single-option pricing cell by cell
+    assert(gammaMatrix.rowLabels() == volatilitiesGreeks && gammaMatrix.colLabels() == spotPricesGreeks);
+    for (size_t i = 0; i < strikeGreeksMatrix.rows(); ++i)
+    {
+        for (size_t j = 0; j < strikeGreeksMatrix.cols(); ++j)
+        {
+            assert(std::abs(putDeltaMatrix(i, j) - context.calculatePutDelta(strikeGreeksMatrix(i, j))) < 1e-12);
+        }
+    }
+    
+    // Caller-provided storage is reused when the shape does not change
+    Grid<double> reusedGrid;
+    context.calculateCallDeltaMatrix(expiryGreeksMatrix, reusedGrid);
+    const double* reusedStorage = reusedGrid.data();
+    context.calculateCallDeltaMatrix(expiryGreeksMatrix, reusedGrid);
+    assert(reusedGrid.data() == reusedStorage && reusedGrid == callDeltaMatrix);
+    
+    Grid<GreeksResult> greeksGrid = context.calculateGreeksMatrix(volGreeksMatrix);
+    assert(std::abs(greeksGrid(2, 3).gamma - gammaMatrix(2, 3)) < 1e-12);
     
     std::cout << "Matrix Greeks Test Complete" << std::endl;
     
+    std::cout << "\n=== SIMD BATCH PRICING TEST ===" << std::endl;
+    
+    // Random book of Europeans in structure-of-arrays layout
+    boost::random::mt19937 rng(42);
+    boost::random::uniform_real_distribution<double> expiryDist(0.05, 5.0);
+    boost::random::uniform_real_distribution<double> moneynessDist(0.5, 1.5);
+    boost::random::uniform_real_distribution<double> volDist(0.05, 0.8);
+    boost::random::uniform_real_distribution<double> rateDist(-0.01, 0.1);
+    
+    OptionBatch simdBatch;
+    for (int i = 0; i < 1003; ++i) // Not a multiple of the vector width to exercise the tail
+    {
+        double r = rateDist(rng);
+        simdBatch.push_back(Option(expiryDist(rng), 100.0 * moneynessDist(rng), volDist(rng), r, 100.0, r));
+    }
+    
+    // Scalar reference
+    std::vector<double> refCalls, refPuts, refCallDeltas, refPutDeltas, refGammas;
+    for (std::size_t i = 0; i < simdBatch.size(); ++i)
+    {
+        Option option = simdBatch.at(i);
+        refCalls.push_back(context.calculateCallPrice(option));
+        refPuts.push_back(context.calculatePutPrice(option));
+        refCallDeltas.push_back(context.calculateCallDelta(option));
+        refPutDeltas.push_back(context.calculatePutDelta(option));
+        refGammas.push_back(context.calculateGamma(option));
+    }
+    
+    auto maxAbsDiff = [](const std::vector<double>& a, const std::vector<double>& b)
+    {
+        double diff = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            diff = std::max(diff, std::abs(a[i] - b[i]));
+        }
+        return diff;
+    };
+    
+    std::cout << "Detected instruction set: " << simdLevelName(detectSimdLevel()) << std::endl;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512})
+    {
+        if (level > detectSimdLevel())
+        {
+            continue;
+        }
+        
+        std::vector<double> calls(simdBatch.size()), puts(simdBatch.size());
+        std::vector<double> callDeltas(simdBatch.size()), putDeltas(simdBatch.size()), gammas(simdBatch.size());
+        evaluateBlackScholesBatch(BatchQuantity::CallPrice, simdBatch, calls, level);
+        evaluateBlackScholesBatch(BatchQuantity::PutPrice, simdBatch, puts, level);
+        evaluateBlackScholesBatch(BatchQuantity::CallDelta, simdBatch, callDeltas, level);
+        evaluateBlackScholesBatch(BatchQuantity::PutDelta, simdBatch, putDeltas, level);
+        evaluateBlackScholesBatch(BatchQuantity::Gamma, simdBatch, gammas, level);
+        
+        double priceError = std::max(maxAbsDiff(calls, refCalls), maxAbsDiff(puts, refPuts));
+        double greekError = std::max({maxAbsDiff(callDeltas, refCallDeltas), maxAbsDiff(putDeltas, refPutDeltas),
+                                      maxAbsDiff(gammas, refGammas)});
+        
+        std::cout << simdLevelName(level) << ": max price error = " << priceError
+                  << ", max Greek error = " << greekError << std::endl;
+        
+        assert(priceError < 1e-10);
+        assert(greekError < 1e-12);
+    }
+    
+    // The context batch API and the AoS vector API route through the same kernels
+    assert(maxAbsDiff(context.calculateCallBatch(simdBatch), refCalls) < 1e-10);
+    assert(maxAbsDiff(context.calculatePutVector(simdBatch.toOptions()), refPuts) < 1e-10);
+    
+    std::cout << "SIMD Batch Test Complete" << std::endl;
+    
+    std::cout << "\n=== FUSED GREEKS TEST ===" << std::endl;
+    
+    for (const Option& option : {Batch_1.option, gammaTestOption})
+    {
+        GreeksResult greeks = context.calculateGreeks(option);
+        
+        std::cout << "Call=" << greeks.callPrice << ", Put=" << greeks.putPrice
+                  << ", Delta(C/P)=" << greeks.callDelta << "/" << greeks.putDelta
+                  << ", Gamma=" << greeks.gamma << ", Vega=" << greeks.vega
+                  << ", Theta(C/P)=" << greeks.callTheta << "/" << greeks.putTheta
+                  << ", Rho(C/P)=" << greeks.callRho << "/" << greeks.putRho << std::endl;
+        
+        // Fused result must agree with the individual methods
+        assert(std::abs(greeks.callPrice - context.calculateCallPrice(option)) < 1e-12);
+        assert(std::abs(greeks.putPrice - context.calculatePutPrice(option)) < 1e-12);
+        assert(std::abs(greeks.callDelta - context.calculateCallDelta(option)) < 1e-12);
+        assert(std::abs(greeks.putDelta - context.calculatePutDelta(option)) < 1e-12);
+        assert(std::abs(greeks.gamma - context.calculateGamma(option)) < 1e-12);
+        
+        // Vega, theta and rho against central differences (rho moves r and b together)
+        const double h = 1e-5;
+        auto bumped = [&](double dT, double dSig, double dR)
+        {
+            return Option(option.ExerciseDate() + dT, option.StrikePrice(), option.Volatility() + dSig,
+                          option.RiskFreeRate() + dR, option.AssetPrice(), option.CostOfCarry() + dR);
+        };
+        double fdVega = (context.calculateCallPrice(bumped(0, h, 0)) - context.calculateCallPrice(bumped(0, -h, 0))) / (2 * h);
+        double fdTheta = -(context.calculatePutPrice(bumped(h, 0, 0)) - context.calculatePutPrice(bumped(-h, 0, 0))) / (2 * h);
+        double fdRho = (context.calculateCallPrice(bumped(0, 0, h)) - context.calculateCallPrice(bumped(0, 0, -h))) / (2 * h);
+        
+        assert(std::abs(greeks.vega - fdVega) < 1e-5);
+        assert(std::abs(greeks.putTheta - fdTheta) < 1e-5);
+        assert(std::abs(greeks.callRho - fdRho) < 1e-5);
+    }
+    
+    // Vectorised fused kernel against the scalar fused evaluation
+    GreeksBatch greeksBatch = context.calculateGreeksBatch(simdBatch);
+    for (std::size_t i = 0; i < simdBatch.size(); ++i)
+    {
+        GreeksResult scalar = context.calculateGreeks(simdBatch.at(i));
+        GreeksResult batched = greeksBatch.at(i);
+        assert(std::abs(scalar.callPrice - batched.callPrice) < 1e-10);
+        assert(std::abs(scalar.putPrice - batched.putPrice) < 1e-10);
+        assert(std::abs(scalar.vega - batched.vega) < 1e-10);
+        assert(std::abs(scalar.callTheta - batched.callTheta) < 1e-10);
+        assert(std::abs(scalar.putRho - batched.putRho) < 1e-10);
+    }
+    
+    std::cout << "Fused Greeks Test Complete" << std::endl;
+    
+    std::cout << "\n=== NORMAL CDF ACCURACY TEST ===" << std::endl;
+    
+    // Sweep the whole real line where the CDF is representable and compare against Boost
+    boost::math::normal_distribution<double> boostNormal(0.0, 1.0);
+    double accurateAbsError = 0.0, accurateTailRelError = 0.0, fastAbsError = 0.0, pdfRelError = 0.0;
+    for (double x = -40.0; x <= 40.0; x += 1e-3)
+    {
+        double reference = boost::math::cdf(boostNormal, x);
+        accurateAbsError = std::max(accurateAbsError, std::abs(normalCdfAccurate(x) - reference));
+        fastAbsError = std::max(fastAbsError, std::abs(normalCdfFast(x) - reference));
+        pdfRelError = std::max(pdfRelError, std::abs(normalPdf(x) / boost::math::pdf(boostNormal, x) - 1.0));
+        
+        // Relative error of the lower tail, where absolute error says little
+        if (x < 0.0 && x > -HartUnderflowLimit)
+        {
+            accurateTailRelError = std::max(accurateTailRelError, std::abs(normalCdfAccurate(x) / reference - 1.0));
+        }
+    }
+    
+    std::cout << "Accurate: max abs error = " << accurateAbsError
+              << ", max tail rel error = " << accurateTailRelError << std::endl;
+    std::cout << "Fast: max abs error = " << fastAbsError << std::endl;
+    std::cout << "PDF: max rel error = " << pdfRelError << std::endl;
+    
+    assert(accurateAbsError < 1e-15);
+    assert(accurateTailRelError < 1e-8);
+    assert(fastAbsError < 7.5e-8);
+    assert(pdfRelError < 1e-12);
+    
+    // Pricer modes: Boost reference, Accurate (default) and Fast
+    BlackScholesPricer boostPricer(NormalCdfMode::Boost);
+    BlackScholesPricer fastPricer(NormalCdfMode::Fast);
+    for (const auto& batch : batches)
+    {
+        double boostCall = boostPricer.calculateCallPrice(batch.option);
+        assert(std::abs(context.calculateCallPrice(batch.option) - boostCall) < 1e-12);
+        // Fast mode: CDF error 7.5e-8 scaled by the two legs S and K
+        double fastTolerance = 7.5e-8 * (batch.option.AssetPrice() + batch.option.StrikePrice());
+        assert(std::abs(fastPricer.calculateCallPrice(batch.option) - boostCall) < fastTolerance);
+    }
+    
+    std::vector<double> fastCalls(simdBatch.size());
+    fastPricer.calculateCallBatch(simdBatch, fastCalls);
+    assert(maxAbsDiff(fastCalls, refCalls) < 7.5e-8 * (100.0 + 150.0));
+    
+    std::cout << "Normal CDF Accuracy Test Complete" << std::endl;
+    
+    std::cout << "\n=== PARAMETER SWEEP TEST ===" << std::endl;
+    
+    // 4-D surface (T x sigma x K x S) described by its axes only; the innermost
+    // K x S block forms lines of 1005 options with shared T, sigma, r and b
+    ParameterGrid surface(Option(1.0, 100.0, 0.2, 0.05, 100.0, 0.02));
+    surface.addAxis(OptionParameter::ExerciseDate, 0.25, 1.0, 0.25)
+           .addAxis(OptionParameter::Volatility, 0.1, 0.5, 0.1)
+           .addAxis(OptionParameter::StrikePrice, 80.0, 120.0, 10.0)
+           .addAxis(OptionParameter::AssetPrice, 50.0, 150.0, 0.5);
+    std::cout << "Surface points: " << surface.size() << ", line length: " << surface.spotStrikeLineLength() << std::endl;
+    assert(surface.size() == 4 * 5 * 5 * 201 && surface.spotStrikeLineLength() == 5 * 201);
+    assert(surface.option(1234) == Option(0.25, 90.0, 0.2, 0.05, 64.0, 0.02));
+    
+    // Reference: materialise the surface once and price it as a plain batch
+    OptionBatch surfaceBatch;
+    surface.fill(0, surface.size(), surfaceBatch);
+    auto sweepCalls = context.calculateCallSweep(surface);
+    auto sweepGammas = context.calculateGammaSweep(surface);
+    assert(maxAbsDiff(sweepCalls, context.calculateCallBatch(surfaceBatch)) < 1e-10);
+    assert(maxAbsDiff(sweepGammas, context.calculateGammaBatch(surfaceBatch)) < 1e-12);
+    
+    // Innermost axis T: no spot/strike lines, streamed through the batch path
+    ParameterGrid expiryInner(gammaTestOption);
+    expiryInner.addAxis(OptionParameter::AssetPrice, 80.0, 120.0, 1.0).addAxis(OptionParameter::ExerciseDate, 0.1, 2.0, 0.1);
+    assert(expiryInner.spotStrikeLineLength() == 1);
+    OptionBatch expiryInnerBatch;
+    expiryInner.fill(0, expiryInner.size(), expiryInnerBatch);
+    assert(maxAbsDiff(context.calculatePutSweep(expiryInner), context.calculatePutBatch(expiryInnerBatch)) < 1e-10);
+    
+    // Two-axis sweeps come back as labelled grids, matching the materialised form
+    assert(context.calculateCallMatrix(volSweep).rowLabels() == volatilities);
+    Grid<double> strikeSweepGrid = context.calculateCallMatrix(strikeSweep);
+    for (size_t i = 0; i < strikeSweep.size(); ++i)
+    {
+        assert(std::abs(strikeSweepGrid.values()[i] - context.calculateCallPrice(strikeSweep.option(i))) < 1e-12);
+    }
+    
+    std::cout << "Parameter Sweep Test Complete" << std::endl;
+    
+    std::cout << "\n=== MONTE CARLO PRICING TEST ===" << std::endl;
+    
+    MonteCarloSettings mcSettings;
+    mcSettings.paths = 1000000;
+    auto monteCarlo = std::make_shared<MonteCarloPricer>(mcSettings);
+    
+    // European prices within four standard errors of the closed form
+    for (const auto& batch : batches)
+    {
+        auto start = std::chrono::steady_clock::now();
+        MonteCarloResult mcCall = monteCarlo->simulate(batch.option, OptionType::Call);
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        MonteCarloResult mcPut = monteCarlo->simulate(batch.option, OptionType::Put);
+        
+        std::cout << batch.name << ": MC Call=" << mcCall.price << " (SE " << mcCall.standardError
+                  << "), MC Put=" << mcPut.price << " (SE " << mcPut.standardError << "), "
+                  << mcSettings.paths << " paths in " << elapsedMs << " ms" << std::endl;
+        
+        assert(std::abs(mcCall.price - context.calculateCallPrice(batch.option)) < 4.0 * mcCall.standardError + 1e-10);
+        assert(std::abs(mcPut.price - context.calculatePutPrice(batch.option)) < 4.0 * mcPut.standardError + 1e-10);
+    }
+    
+    // Pathwise delta and likelihood ratio gamma
+    MonteCarloResult mcGreeks = monteCarlo->simulate(gammaTestOption, OptionType::Put);
+    std::cout << "MC Put Delta=" << mcGreeks.delta << ", MC Gamma=" << mcGreeks.gamma << std::endl;
+    assert(std::abs(mcGreeks.delta - context.calculatePutDelta(gammaTestOption)) < 2e-3);
+    assert(std::abs(mcGreeks.gamma / context.calculateGamma(gammaTestOption) - 1.0) < 0.03);
+    
+    // A strike strip shares one set of paths, through the strategy interface
+    OptionContext mcContext(std::make_unique<MonteCarloPricer>(mcSettings));
+    std::vector<Option> strikeStrip;
+    for (double K : meshArray(80.0, 120.0, 10.0))
+    {
+        strikeStrip.push_back(Option(0.5, K, 0.25, 0.05, 100.0, 0.03));
+    }
+    std::vector<MonteCarloResult> stripResults = monteCarlo->simulate(strikeStrip, OptionType::Call);
+    std::vector<double> stripPrices = mcContext.calculateCallVector(strikeStrip);
+    for (std::size_t i = 0; i < strikeStrip.size(); ++i)
+    {
+        assert(stripPrices[i] == stripResults[i].price);
+        assert(std::abs(stripPrices[i] - context.calculateCallPrice(strikeStrip[i])) < 4.0 * stripResults[i].standardError);
+    }
+    
+    // Arithmetic Asian with the geometric Asian control variate
+    MonteCarloSettings asianSettings;
+    asianSettings.paths = 100000;
+    asianSettings.timeSteps = 52;
+    MonteCarloPricer asianPricer(asianSettings);
+    asianSettings.controlVariate = false;
+    MonteCarloPricer plainAsianPricer(asianSettings);
+    
+    Option asianOption(1.0, 100.0, 0.3, 0.05, 100.0);
+    MonteCarloResult arithmetic = asianPricer.simulate(asianOption, OptionType::Call, PayoffStyle::ArithmeticAsian);
+    MonteCarloResult arithmeticPlain = plainAsianPricer.simulate(asianOption, OptionType::Call, PayoffStyle::ArithmeticAsian);
+    MonteCarloResult geometric = asianPricer.simulate(asianOption, OptionType::Call, PayoffStyle::GeometricAsian);
+    std::cout << "Arithmetic Asian Call=" << arithmetic.price << " (SE " << arithmetic.standardError
+              << ", without control variate " << arithmeticPlain.standardError << "), Geometric Asian Call="
+              << geometric.price << std::endl;
+    
+    assert(arithmetic.standardError < arithmeticPlain.standardError / 10.0);
+    assert(std::abs(arithmetic.price - arithmeticPlain.price) < 4.0 * arithmeticPlain.standardError);
+    assert(arithmetic.price > geometric.price);   // AM-GM inequality
+    assert(std::isnan(arithmetic.delta));
+    
+    // Counter-based streams: identical estimate with any number of threads
+    MonteCarloPricer pooledMonteCarlo(mcSettings);
+    pooledMonteCarlo.setThreadPool(std::make_shared<ThreadPool>(4));
+    MonteCarloResult pooled = pooledMonteCarlo.simulate(Batch_1.option, OptionType::Call);
+    assert(pooled.price == monteCarlo->simulate(Batch_1.option, OptionType::Call).price);
+    
+    // The standard error needs two samples: three antithetic paths are one pair and a half
+    MonteCarloSettings tinySettings;
+    tinySettings.paths = 3;
+    bool rejectedPaths = false;
+    try
+    {
+        MonteCarloPricer tinyPricer(tinySettings);
+    }
+    catch (const std::invalid_argument&)
+    {
+        rejectedPaths = true;
+    }
+    assert(rejectedPaths);
+    tinySettings.paths = 4;
+    assert(std::isfinite(MonteCarloPricer(tinySettings).simulate(Batch_1.option, OptionType::Call).standardError));
+    
+    std::cout << "Monte Carlo Pricing Test Complete" << std::endl;
+    
+    std::cout << "\n=== LATTICE PRICING TEST ===" << std::endl;
+    
+    // European trees converge to the closed form, with and without Richardson extrapolation
+    for (LatticeType type : {LatticeType::Binomial, LatticeType::Trinomial})
+    {
+        for (bool richardson : {false, true})
+        {
+            LatticeSettings europeanSettings;
+            europeanSettings.type = type;
+            europeanSettings.exercise = ExerciseStyle::European;
+            europeanSettings.richardson = richardson;
+            europeanSettings.steps = 400;
+            LatticePricer europeanLattice(europeanSettings);
+            
+            for (const auto& batch : batches)
+            {
+                if (batch.option.ExerciseDate() > 5.0)
+                {
+                    continue; // 400 steps over 30 years is too coarse for this tolerance
+                }
+                assert(std::abs(europeanLattice.calculateCallPrice(batch.option) - context.calculateCallPrice(batch.option)) < 2e-2);
+                assert(std::abs(europeanLattice.calculatePutPrice(batch.option) - context.calculatePutPrice(batch.option)) < 2e-2);
+            }
+            
+            assert(std::abs(europeanLattice.calculateCallDelta(gammaTestOption) - context.calculateCallDelta(gammaTestOption)) < 5e-3);
+            assert(std::abs(europeanLattice.calculateGamma(gammaTestOption) - context.calculateGamma(gammaTestOption)) < 1e-3);
+        }
+    }
+    
+    // American exercise: the put is worth more than its European counterpart, the call on b = r is not
+    LatticePricer americanLattice;
+    Option americanPutOption(1.0, 100.0, 0.2, 0.05, 100.0);
+    double americanPut = americanLattice.calculatePutPrice(americanPutOption);
+    std::cout << americanLattice.getName() << ": American Put=" << americanPut
+              << ", European Put=" << context.calculatePutPrice(americanPutOption) << std::endl;
+    assert(std::abs(americanPut - 6.0903) < 5e-3);
+    assert(americanPut > context.calculatePutPrice(americanPutOption));
+    assert(std::abs(americanLattice.calculateCallPrice(americanPutOption) - context.calculateCallPrice(americanPutOption)) < 1e-2);
+    
+    LatticeSettings trinomialSettings;
+    trinomialSettings.type = LatticeType::Trinomial;
+    LatticePricer trinomialLattice(trinomialSettings);
+    assert(std::abs(trinomialLattice.calculatePutPrice(americanPutOption) - americanPut) < 5e-3);
+    
+    // A strike strip shares one backward sweep and matches single-option pricing
+    OptionContext latticeContext(std::make_unique<LatticePricer>());
+    std::vector<double> latticeStrip = latticeContext.calculatePutVector(strikeStrip);
+    for (std::size_t i = 0; i < strikeStrip.size(); ++i)
+    {
+        assert(std::abs(latticeStrip[i] - americanLattice.calculatePutPrice(strikeStrip[i])) < 1e-12);
+    }
+    assert(latticeContext.calculatePutVector(strikeStrip) == latticeStrip); // Reused buffers, same result
+    
+    // Fused Greeks: prices agree with the single calls, vega and rho are not available
+    GreeksResult latticeGreeks = americanLattice.calculateGreeks(americanPutOption);
+    assert(latticeGreeks.putPrice == americanPut);
+    assert(latticeGreeks.putDelta < 0.0 && latticeGreeks.gamma > 0.0 && latticeGreeks.putTheta < 0.0);
+    assert(std::isnan(latticeGreeks.vega) && std::isnan(latticeGreeks.callRho));
+    
+    std::cout << "Lattice Pricing Test Complete" << std::endl;
+    
+    std::cout << "\n=== FINITE DIFFERENCE PRICING TEST ===" << std::endl;
+    
+    // European Crank-Nicolson against the closed form (relative error on the deep in-the-money 30-year call)
+    FDMPricer europeanFdm;
+    for (const auto& batch : batches)
+    {
+        double fdmCall = europeanFdm.calculateCallPrice(batch.option);
+        double fdmPut = europeanFdm.calculatePutPrice(batch.option);
+        std::cout << batch.name << ": FDM Call=" << fdmCall << ", FDM Put=" << fdmPut << std::endl;
+        double callPrice = context.calculateCallPrice(batch.option);
+        double putPrice = context.calculatePutPrice(batch.option);
+        assert(std::abs(fdmCall - callPrice) < 1e-3 * std::max(1.0, callPrice));
+        assert(std::abs(fdmPut - putPrice) < 1e-3 * std::max(1.0, putPrice));
+    }
+    GreeksResult fdmGreeks = europeanFdm.calculateGreeks(gammaTestOption);
+    assert(std::abs(fdmGreeks.callDelta - context.calculateCallDelta(gammaTestOption)) < 1e-3);
+    assert(std::abs(fdmGreeks.gamma - context.calculateGamma(gammaTestOption)) < 1e-4);
+    assert(std::abs(fdmGreeks.putTheta - context.calculateGreeks(gammaTestOption).putTheta) < 3e-2);
+    
+    // The part (c) spot sweep is one PDE solve interpolated at every spot
+    OptionContext fdmContext(std::make_unique<FDMPricer>());
+    auto fdmStart = std::chrono::steady_clock::now();
+    std::vector<double> fdmSweep = fdmContext.calculateCallVector(optionVector);
+    double fdmSweepMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - fdmStart).count();
+    std::cout << optionVector.size() << " spots priced by one solve in " << fdmSweepMs << " ms" << std::endl;
+    assert(maxAbsDiff(fdmSweep, callPrices) < 1e-2);
+    
+    // American put: PSOR and penalty agree with each other and with the lattice
+    FDMSettings americanFdmSettings;
+    americanFdmSettings.exercise = ExerciseStyle::American;
+    FDMPricer psorFdm(americanFdmSettings);
+    americanFdmSettings.americanMethod = AmericanMethod::Penalty;
+    FDMPricer penaltyFdm(americanFdmSettings);
+    
+    double psorPut = psorFdm.calculatePutPrice(americanPutOption);
+    double penaltyPut = penaltyFdm.calculatePutPrice(americanPutOption);
+    std::cout << psorFdm.getName() << ": American Put=" << psorPut << ", "
+              << penaltyFdm.getName() << ": American Put=" << penaltyPut << std::endl;
+    assert(std::abs(psorPut - americanPut) < 1e-2);
+    assert(std::abs(penaltyPut - psorPut) < 1e-3);
+    assert(std::abs(psorFdm.calculateCallPrice(americanPutOption) - context.calculateCallPrice(americanPutOption)) < 1e-2);
+    
+    std::cout << "Finite Difference Pricing Test Complete" << std::endl;
+    
+    std::cout << "\n=== IMPLIED VOLATILITY TEST ===" << std::endl;
+    
+    // Round trip through the test batches, calls and puts
+    for (const auto& batch : batches)
+    {
+        ImpliedVolResult callVol = context.calculateImpliedVolatility(batch.option, context.calculateCallPrice(batch.option), OptionType::Call);
+        ImpliedVolResult putVol = context.calculateImpliedVolatility(batch.option, context.calculatePutPrice(batch.option), OptionType::Put);
+        std::cout << batch.name << ": Call IV=" << callVol.volatility << " (" << callVol.iterations
+                  << " iterations), Put IV=" << putVol.volatility << " (" << putVol.iterations << " iterations)" << std::endl;
+        assert(callVol.converged() && std::abs(callVol.volatility - batch.option.Volatility()) < 1e-8);
+        assert(putVol.converged() && std::abs(putVol.volatility - batch.option.Volatility()) < 1e-8);
+    }
+    
+    // A 5000-strike chain across expiries and vols, inverted in one vectorised batch
+    OptionBatch chain;
+    for (std::size_t i = 0; i < 5000; ++i)
+    {
+        double T = 0.05 + 0.1 * static_cast<double>(i % 20);
+        double sig = 0.08 + 0.07 * static_cast<double>(i % 9);
+        chain.push_back(Option(T, 50.0 + 0.03 * static_cast<double>(i), sig, 0.03, 100.0, 0.01));
+    }
+    std::vector<double> chainQuotes = context.calculateCallBatch(chain);
+    GreeksBatch chainGreeks = context.calculateGreeksBatch(chain);
+    
+    auto ivStart = std::chrono::steady_clock::now();
+    std::vector<ImpliedVolResult> chainVols = context.calculateImpliedVolatilityBatch(chain, chainQuotes, OptionType::Call);
+    double ivMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - ivStart).count();
+    
+    BlackScholesPricer scalarPricer;
+    scalarPricer.setSimdLevel(SimdLevel::Scalar);
+    std::vector<ImpliedVolResult> scalarVols(chain.size());
+    scalarPricer.calculateImpliedVolatilityBatch(chain, chainQuotes, OptionType::Call, ImpliedVolSettings{}, scalarVols);
+    
+    std::uint32_t maxIterations = 0;
+    std::size_t resolvable = 0;
+    for (std::size_t i = 0; i < chain.size(); ++i)
+    {
+        // Quotes with negligible vega carry no volatility information at double precision
+        if (chainGreeks.vega[i] < 1e-4)
+        {
+            continue;
+        }
+        ++resolvable;
+        maxIterations = std::max(maxIterations, chainVols[i].iterations);
+        assert(chainVols[i].converged());
+        assert(std::abs(chainVols[i].volatility - chain.Volatilities()[i]) < 1e-8);
+        assert(std::abs(scalarVols[i].volatility - chainVols[i].volatility) < 1e-9);
+    }
+    std::cout << resolvable << " of " << chain.size() << " contracts resolved, " << ivMicros / static_cast<double>(chain.size())
+              << " us per contract, at most " << maxIterations << " iterations" << std::endl;
+    assert(maxIterations <= 16);
+    
+    // Quotes outside the no-arbitrage bounds are reported, not iterated
+    Option ivOption(0.5, 100.0, 0.2, 0.05, 110.0);
+    assert(context.calculateImpliedVolatility(ivOption, 5.0, OptionType::Call).status == ImpliedVolStatus::BelowIntrinsic);
+    assert(context.calculateImpliedVolatility(ivOption, 111.0, OptionType::Call).status == ImpliedVolStatus::AboveMaximum);
+    assert(context.calculateImpliedVolatility(ivOption, std::nan(""), OptionType::Put).status == ImpliedVolStatus::InvalidInput);
+    assert(std::isnan(context.calculateImpliedVolatility(ivOption, 0.0, OptionType::Put).volatility));
+    
+    // Model-independent search for strategies without an analytical inverse
+    LatticeSettings europeanTreeSettings;
+    europeanTreeSettings.exercise = ExerciseStyle::European;
+    LatticePricer europeanTree(europeanTreeSettings);
+    double treeQuote = europeanTree.calculatePutPrice(ivOption);
+    ImpliedVolSettings treeSearch;
+    treeSearch.searchLower = 0.05;   // CRR branch probabilities need sig * sqrt(dt) > |b| * dt
+    ImpliedVolResult treeVol = europeanTree.calculateImpliedVolatility(ivOption, treeQuote, OptionType::Put, treeSearch);
+    std::cout << europeanTree.getName() << " Put IV=" << treeVol.volatility << " (" << treeVol.iterations << " iterations)" << std::endl;
+    assert(treeVol.converged() && std::abs(treeVol.volatility - ivOption.Volatility()) < 1e-6);
+    
+    // Chunked on a pool: same results as the serial batch
+    OptionContext pooledIvContext(std::make_unique<BlackScholesPricer>());
+    pooledIvContext.setThreadCount(4);
+    pooledIvContext.setParallelChunkSize(256);
+    std::vector<ImpliedVolResult> pooledVols = pooledIvContext.calculateImpliedVolatilityBatch(chain, chainQuotes, OptionType::Call);
+    for (std::size_t i = 0; i < chain.size(); ++i)
+    {
+        assert(pooledVols[i].status == chainVols[i].status);
+        assert(pooledVols[i].converged() ? pooledVols[i].volatility == chainVols[i].volatility : true);
+    }
+    
+    std::cout << "Implied Volatility Test Complete" << std::endl;
+    
+    std::cout << "\n=== MULTITHREADED PRICING TEST ===" << std::endl;
+    
+    // Serial results, then the same calls split into small chunks across a shared pool
+    auto serialCalls = context.calculateCallBatch(simdBatch);
+    auto serialPutDeltas = context.calculatePutDeltaVector(simdBatch.toOptions());
+    auto serialGreeks = context.calculateGreeksBatch(simdBatch);
+    auto serialMatrix = context.calculateGammaMatrix(volGreeksMatrix);
+    auto serialSweep = context.calculateCallSweep(surface);
+    
+    auto sharedPool = std::make_shared<ThreadPool>(4);
+    context.setThreadPool(sharedPool);
+    context.setParallelChunkSize(100);
+    std::cout << "Threads: " << context.getThreadCount() << ", chunk size: " << context.getParallelChunkSize() << std::endl;
+    
+    // Fixed chunk boundaries: results must be bit-identical to the serial run
+    assert(context.calculateCallBatch(simdBatch) == serialCalls);
+    assert(context.calculatePutDeltaVector(simdBatch.toOptions()) == serialPutDeltas);
+    assert(context.calculateGammaMatrix(volGreeksMatrix) == serialMatrix);
+    assert(context.calculateCallSweep(surface) == serialSweep);
+    GreeksBatch parallelGreeks = context.calculateGreeksBatch(simdBatch);
+    assert(parallelGreeks.vega == serialGreeks.vega && parallelGreeks.putRho == serialGreeks.putRho);
+    
+    // Nested parallelFor from inside a worker must not deadlock
+    std::vector<std::size_t> visits(64, 0);
+    sharedPool->parallelFor(8, 1, [&](std::size_t outerBegin, std::size_t)
+    {
+        sharedPool->parallelFor(8, 1, [&](std::size_t innerBegin, std::size_t)
+        {
+            ++visits[outerBegin * 8 + innerBegin];
+        });
+    });
+    assert(std::all_of(visits.begin(), visits.end(), [](std::size_t v) { return v == 1; }));
+    
+    context.setThreadCount(1);
+    assert(context.getThreadCount() == 1);
+    
+    std::cout << "Multithreaded Pricing Test Complete" << std::endl;
+    
+    std::cout << "\n=== METRICS TEST ===" << std::endl;
+    
+    // Bucket bounds: every value lands in a bucket whose upper bound is within 12.5 % above it
+    for (std::uint64_t value : {0ull, 1ull, 15ull, 16ull, 17ull, 100ull, 4095ull, 4096ull, 123456789ull, 1ull << 62})
+    {
+        std::uint64_t bound = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value));
+        assert(bound >= value && static_cast<double>(bound - value) <= 0.125 * static_cast<double>(value));
+    }
+    
+    if constexpr (PricingMetrics::compiledIn())
+    {
+        auto metrics = std::make_shared<PricingMetrics>();
+        context.setMetrics(metrics);
+        
+        for (int i = 0; i < 10; ++i)
+        {
+            context.calculateCallPrice(simdBatch.at(i));
+        }
+        bool rejected = false;
+        try
+        {
+            context.calculateCallPrice(Option(-1.0, 100.0, 0.2, 0.05, 100.0));
+        }
+        catch (const std::invalid_argument&)
+        {
+            rejected = true;
+        }
+        assert(rejected);
+        context.calculateCallBatch(simdBatch);
+        
+        // Per-thread shards are summed by the snapshot
+        std::vector<std::thread> recorders;
+        for (int t = 0; t < 4; ++t)
+        {
+            recorders.emplace_back([&context, &simdBatch]() {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    context.calculatePutPrice(simdBatch.at(i % simdBatch.size()));
+                }
+            });
+        }
+        for (std::thread& recorder : recorders)
+        {
+            recorder.join();
+        }
+        
+        MetricsSnapshot snapshot = metrics->snapshot();
+        const MethodMetrics& callPrice = snapshot[MetricMethod::CallPrice];
+        assert(callPrice.calls == 11 && callPrice.failures == 1 && callPrice.rejectedOptions == 1);
+        assert(callPrice.latency.count() == 11 && callPrice.batchSizes[1] == 11);
+        assert(callPrice.latency.valueAtPercentile(50.0) <= callPrice.latency.valueAtPercentile(99.0));
+        assert(callPrice.latency.valueAtPercentile(100.0) == callPrice.latency.max());
+        assert(snapshot[MetricMethod::CallBatch].options == simdBatch.size());
+        assert(snapshot[MetricMethod::PutPrice].calls == 4000);
+        assert(snapshot.toJson().find("\"name\": \"CallBatch\"") != std::string::npos);
+        std::cout << snapshot.toText();
+        
+        // Detached: nothing more is recorded; reset clears the counters
+        context.setMetrics(nullptr);
+        context.calculateCallPrice(simdBatch.at(0));
+        assert(metrics->snapshot()[MetricMethod::CallPrice].calls == 11);
+        metrics->reset();
+        assert(metrics->snapshot().totalCalls() == 0);
+    }
+    
+    std::cout << "Metrics Test Complete" << std::endl;
+    
+    std::cout << "\n=== STATIC CONTEXT TEST ===" << std::endl;
+    
+    StaticOptionContext<BlackScholesPricer> staticContext;
+    std::cout << "Strategy: " << staticContext.getCurrentStrategyName() << std::endl;
+    auto nearlyEqual = [](double a, double b) { return std::abs(a - b) <= 1e-13 * std::max(1.0, std::abs(b)); };
+    for (std::size_t i = 0; i < simdBatch.size(); i += 7)
+    {
+        Option option = simdBatch.at(i);
+        Option stock(option.ExerciseDate(), option.StrikePrice(), option.Volatility(), option.RiskFreeRate(), option.AssetPrice());
+        Option futures(option.ExerciseDate(), option.StrikePrice(), option.Volatility(), option.RiskFreeRate(), option.AssetPrice(), 0.0);
+        
+        // Same strategy, direct calls: identical results
+        assert(staticContext.calculateCallPrice(option) == context.calculateCallPrice(option));
+        assert(staticContext.calculateGreeks(option).vega == context.calculateGreeks(option).vega);
+        
+        // Compile-time side and carry: the carry model replaces the option's own b
+        assert(nearlyEqual(staticContext.price<OptionType::Call>(option), context.calculateCallPrice(option)));
+        assert(nearlyEqual(staticContext.price<OptionType::Put, CarryModel::Stock>(option), context.calculatePutPrice(stock)));
+        assert(nearlyEqual(staticContext.price<OptionType::Call, CarryModel::Futures>(option), context.calculateCallPrice(futures)));
+        assert(nearlyEqual(staticContext.delta<OptionType::Put, CarryModel::Futures>(option), context.calculatePutDelta(futures)));
+        assert(nearlyEqual(staticContext.delta<OptionType::Call, CarryModel::Stock>(option), context.calculateCallDelta(stock)));
+        assert(nearlyEqual(staticContext.gamma<CarryModel::Futures>(option), context.calculateGamma(futures)));
+        assert(std::abs(staticContext.price<OptionType::Call, CarryModel::Currency, NormalCdfMode::Fast>(option) -
+                        context.calculateCallPrice(option)) < 1e-5 * option.AssetPrice());
+    }
+    
+    // Batch, vector and sweep paths, serial and chunked on the shared pool
+    assert(staticContext.calculateCallBatch(simdBatch) == serialCalls);
+    assert(staticContext.calculatePutDeltaVector(simdBatch.toOptions()) == serialPutDeltas);
+    assert(staticContext.calculateGammaMatrix(volGreeksMatrix) == serialMatrix);
+    staticContext.setThreadPool(sharedPool);
+    staticContext.setParallelChunkSize(100);
+    assert(staticContext.calculateCallBatch(simdBatch) == serialCalls);
+    assert(staticContext.calculateCallSweep(surface) == serialSweep);
+    assert(staticContext.calculateGreeksBatch(simdBatch).putRho == serialGreeks.putRho);
+    assert(staticContext.verifyParity(simdBatch.at(0)));
+    
+    // Other strategies: price<> forwards a copy of the option carrying the model's b
+    StaticOptionContext<LatticePricer> staticLattice;
+    Option latticeOption(1.0, 100.0, 0.25, 0.05, 95.0, 0.02);
+    Option latticeFutures(1.0, 100.0, 0.25, 0.05, 95.0, 0.0);
+    double staticLatticePut = staticLattice.price<OptionType::Put, CarryModel::Futures>(latticeOption);
+    assert(staticLatticePut == LatticePricer().calculatePutPrice(latticeFutures));
+    
+    std::cout << "Static Context Test Complete" << std::endl;
+    
+    std::cout << "\n=== BATCH VALIDATION TEST ===" << std::endl;
+    
+    // Every 97th row is broken in a different way; the scan flags exactly those
+    OptionBatch dirtyBatch(simdBatch.toOptions());
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<std::size_t> badRows;
+    for (std::size_t i = 5; i < dirtyBatch.size(); i += 97)
+    {
+        Option option = dirtyBatch.at(i);
+        switch (badRows.size() % 4)
+        {
+            case 0: dirtyBatch.set(i, Option(0.0, option.StrikePrice(), option.Volatility(), option.RiskFreeRate(), option.AssetPrice())); break;
+            case 1: dirtyBatch.set(i, Option(option.ExerciseDate(), option.StrikePrice(), -0.2, option.RiskFreeRate(), option.AssetPrice())); break;
+            case 2: dirtyBatch.set(i, Option(option.ExerciseDate(), option.StrikePrice(), option.Volatility(), nan, option.AssetPrice())); break;
+            default: dirtyBatch.set(i, Option(option.ExerciseDate(), nan, option.Volatility(), option.RiskFreeRate(), option.AssetPrice())); break;
+        }
+        badRows.push_back(i);
+    }
+    
+    BatchValidation validation(dirtyBatch);
+    assert(validation.size() == dirtyBatch.size() && validation.invalidCount() == badRows.size());
+    assert(validation.firstInvalid() == badRows.front());
+    assert(validation.error(badRows[0]) == OptionError::NonPositiveExpiry);
+    assert(validation.error(badRows[1]) == OptionError::NonPositiveVolatility);
+    assert(validation.error(badRows[2]) == OptionError::NonFinite);
+    assert(validation.error(badRows[3]) == (OptionError::NonPositiveStrike | OptionError::NonFinite));
+    assert(BatchValidation(dirtyBatch.toOptions()).errors().size() == dirtyBatch.size());
+    assert(BatchValidation(simdBatch).allValid() && BatchValidation(simdBatch).firstInvalid() == simdBatch.size());
+    std::cout << "Invalid rows: " << validation.invalidCount() << " of " << validation.size()
+              << ", row " << badRows[3] << ": " << describeOptionError(validation.error(badRows[3])) << std::endl;
+    
+    // Throw: one scan up front, the message names the first bad row
+    context.setValidationMode(ValidationMode::Throw);
+    assert(context.calculateCallBatch(simdBatch) == serialCalls);
+    bool batchRejected = false;
+    try
+    {
+        context.calculateCallBatch(dirtyBatch);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        batchRejected = std::string(e.what()).find("row " + std::to_string(badRows.front())) != std::string::npos;
+    }
+    assert(batchRejected);
+    
+    // NaN: bad rows come back as NaN, all others match the clean run bit for bit,
+    // serial and chunked on the pool alike
+    context.setValidationMode(ValidationMode::NaN);
+    assert(std::isnan(context.calculateCallPrice(dirtyBatch.at(badRows[0]))));
+    assert(std::isnan(context.calculateGreeks(dirtyBatch.at(badRows[1])).vega));
+    for (int threads : {1, 4})
+    {
+        context.setThreadPool(threads > 1 ? sharedPool : nullptr);
+        auto calls = context.calculateCallBatch(dirtyBatch);
+        auto putDeltas = context.calculatePutDeltaVector(dirtyBatch.toOptions());
+        GreeksBatch greeks = context.calculateGreeksBatch(dirtyBatch);
+        for (std::size_t i = 0; i < dirtyBatch.size(); ++i)
+        {
+            if (validation.isValid(i))
+            {
+                assert(calls[i] == serialCalls[i] && putDeltas[i] == serialPutDeltas[i]);
+                assert(greeks.vega[i] == serialGreeks.vega[i]);
+            }
+            else
+            {
+                assert(std::isnan(calls[i]) && std::isnan(putDeltas[i]) && std::isnan(greeks.vega[i]));
+            }
+        }
+    }
+    context.setThreadPool(nullptr);
+    
+    // Sweeps stay lazy unless an axis holds a bad value; then only its points are masked
+    ParameterGrid dirtySweep(Option(1.0, 100.0, 0.2, 0.05, 100.0));
+    dirtySweep.addAxis(OptionParameter::Volatility, {0.2, 0.0, 0.3});
+    dirtySweep.addAxis(OptionParameter::AssetPrice, {90.0, 100.0});
+    assert(!isValidSweep(dirtySweep) && isValidSweep(surface));
+    auto maskedSweep = context.calculateCallSweep(dirtySweep);
+    assert(std::isnan(maskedSweep[2]) && std::isnan(maskedSweep[3]));
+    assert(std::abs(maskedSweep[5] - context.calculateCallPrice(Option(1.0, 100.0, 0.3, 0.05, 100.0))) < 1e-9);
+    assert(context.calculateCallSweep(surface) == serialSweep);
+    context.setValidationMode(ValidationMode::Unchecked);
+    
+    std::cout << "Batch Validation Test Complete" << std::endl;
+    
+    std::cout << "\n=== PRICING CACHE TEST ===" << std::endl;
+    
+    auto cache = std::make_shared<PricingCache>(64, 4);
+    OptionContext cachedContext(std::make_unique<BlackScholesPricer>());
+    cachedContext.setParityValidator(std::make_unique<PutCallParityValidator>());
+    cachedContext.setCache(cache);
+    Option cachedOption = simdBatch.at(0);
+    
+    // Second request for the same contract is a hit with the identical value;
+    // verifyParity reuses the call price and adds the put to the same entry
+    double cachedCall = cachedContext.calculateCallPrice(cachedOption);
+    assert(cachedContext.calculateCallPrice(cachedOption) == cachedCall && cachedCall == context.calculateCallPrice(cachedOption));
+    assert(cachedContext.verifyParity(cachedOption));
+    assert(cachedContext.calculatePutPrice(cachedOption) == context.calculatePutPrice(cachedOption));
+    GreeksResult cachedGreeks = cachedContext.calculateGreeks(cachedOption);
+    assert(cachedContext.calculateGreeks(cachedOption).vega == cachedGreeks.vega);
+    PricingCacheStats cacheStats = cache->stats();
+    assert(cacheStats.hits == 4 && cacheStats.misses == 3 && cacheStats.insertions == 1 && cache->size() == 1);
+    
+    // Bounded: streaming 1000 contracts evicts, while a contract requested between
+    // every insertion keeps its reference bit and is never evicted by the CLOCK hand
+    for (std::size_t i = 1; i < simdBatch.size(); ++i)
+    {
+        cachedContext.calculateCallDelta(simdBatch.at(i));
+        cachedContext.calculateCallPrice(cachedOption);
+    }
+    cacheStats = cache->stats();
+    assert(cache->size() <= cache->capacity() && cacheStats.evictions > 0);
+    assert(cacheStats.hits == 4 + simdBatch.size() - 1);
+    std::cout << "Entries: " << cache->size() << "/" << cache->capacity() << ", hit rate: " << cacheStats.hitRate()
+              << ", evictions: " << cacheStats.evictions << std::endl;
+    
+    // Concurrent readers and writers see the uncached values
+    std::vector<double> scalarPutDeltas;
+    for (std::size_t row = 0; row < 100; ++row)
+    {
+        scalarPutDeltas.push_back(context.calculatePutDelta(simdBatch.at(row)));
+    }
+    std::vector<std::thread> cacheUsers;
+    for (int t = 0; t < 4; ++t)
+    {
+        cacheUsers.emplace_back([&cachedContext, &simdBatch, &scalarPutDeltas]() {
+            for (std::size_t i = 0; i < 2000; ++i)
+            {
+                std::size_t row = (i * 7) % 100;
+                assert(cachedContext.calculatePutDelta(simdBatch.at(row)) == scalarPutDeltas[row]);
+            }
+        });
+    }
+    for (std::thread& user : cacheUsers)
+    {
+        user.join();
+    }
+    
+    // A new strategy drops the old entries: the next request is a miss again
+    cachedContext.setPricingStrategy(std::make_unique<LatticePricer>());
+    assert(cache->size() == 0 && cache->stats().invalidations > 0);
+    std::uint64_t missesBefore = cache->stats().misses;
+    assert(cachedContext.calculateCallPrice(cachedOption) == LatticePricer().calculateCallPrice(cachedOption));
+    assert(cache->stats().misses == missesBefore + 1);
+    cache->clear();
+    assert(cache->size() == 0);
+    
+    std::cout << "Pricing Cache Test Complete" << std::endl;
+    
+    std::cout << "\n=== OPTION BOOK TEST ===" << std::endl;
+    
+    // 300 positions on three underlyings; terms taken from the SIMD batch, spot fixed per underlying
+    OptionBook book;
+    BlackScholesPricer bookPricer;
+    const std::string bookUnderlyings[] = {"ABC", "DEF", "GHI"};
+    const double bookSpots[] = {95.0, 100.0, 120.0};
+    auto bookOption = [&](std::size_t i, double spot) {
+        Option terms = simdBatch.at(i);
+        return Option(terms.ExerciseDate(), terms.StrikePrice(), terms.Volatility(), terms.RiskFreeRate(), spot, terms.CostOfCarry());
+    };
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        OptionType type = i % 2 == 0 ? OptionType::Call : OptionType::Put;
+        double quantity = i % 5 == 0 ? -10.0 : 5.0;
+        assert(book.addPosition(bookUnderlyings[i % 3], bookOption(i, bookSpots[i % 3]), type, quantity) == i);
+    }
+    assert(book.size() == 300 && book.underlyingCount() == 3 && book.hasUnderlying("DEF"));
+    
+    auto bookMatches = [&](std::size_t position) {
+        Option option = book.option(position);
+        double expected = position % 2 == 0 ? bookPricer.calculateCallPrice(option) : bookPricer.calculatePutPrice(option);
+        return std::abs(book.price(position) - expected) <= 1e-10 * std::max(1.0, expected);
+    };
+    for (std::size_t i = 0; i < book.size(); ++i)
+    {
+        assert(bookMatches(i));
+    }
+    
+    // A spot tick reprices exactly the contracts of its underlying and reports their net change
+    PositionRisk defBefore = book.risk("DEF");
+    double ghiPrice = book.price(2);
+    BookUpdate spotTick = book.updateSpot("DEF", 101.5);
+    assert(spotTick.underlying == "DEF" && spotTick.changes.size() == 100);
+    assert(book.price(2) == ghiPrice && book.spot("DEF") == 101.5);
+    double summedChange = 0.0;
+    double repricedValue = 0.0;
+    for (const PositionChange& change : spotTick.changes)
+    {
+        assert(change.position % 3 == 1 && bookMatches(change.position));
+        assert(change.price == book.price(change.position));
+        summedChange += change.change.value;
+    }
+    for (std::size_t i = 1; i < book.size(); i += 3)
+    {
+        repricedValue += book.risk(i).value;
+    }
+    assert(std::abs(summedChange - spotTick.change.value) < 1e-9);
+    assert(book.risk("DEF").value == repricedValue);   // Recomputed, not accumulated
+    assert(std::abs(book.risk("DEF").value - defBefore.value - spotTick.change.value) < 1e-9);
+    
+    // Delta-gamma explains the spot P&L to second order
+    double dS = 1.5;
+    double explained = defBefore.delta * dS + 0.5 * defBefore.gamma * dS * dS;
+    assert(std::abs(spotTick.change.value - explained) < 0.05 * std::abs(spotTick.change.value) + 1e-6);
+    
+    // Volatility ticks: flat for an underlying, or a single contract
+    BookUpdate volTick = book.updateVolatility("ABC", 0.3);
+    assert(volTick.changes.size() == 100 && bookMatches(0) && book.option(0).Volatility() == 0.3);
+    BookUpdate contractTick = book.updateVolatility(4, 0.45);
+    assert(contractTick.changes.size() == 1 && contractTick.changes[0].position == 4 && bookMatches(4));
+    
+    // Single-contract ticks move the total by their change; the next full revaluation recomputes it
+    for (int tick = 0; tick < 1000; ++tick)
+    {
+        book.updateVolatility(1, tick % 2 == 0 ? 0.35 : 0.2);
+    }
+    book.updateSpot("DEF", 101.5);
+    double defValue = 0.0;
+    for (std::size_t i = 1; i < book.size(); i += 3)
+    {
+        defValue += book.risk(i).value;
+    }
+    assert(book.risk("DEF").value == defValue);
+    std::cout << "Positions: " << book.size() << ", DEF spot tick P&L: " << spotTick.change.value
+              << ", book value: " << book.totalValue() << std::endl;
+    
+    std::cout << "Option Book Test Complete" << std::endl;
+    
+    std::cout << "\n=== MAPPED OPTION FILE TEST ===" << std::endl;
+    
+    boost::filesystem::path fileDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::create_directories(fileDirectory);
+    std::string optionPath = (fileDirectory / "book.optbatch").string();
+    std::string resultPath = (fileDirectory / "book.optresult").string();
+    
+    // Round trip: the mapped view addresses the file's columns, aligned and bit-identical
+    MappedOptionFile::write(optionPath, simdBatch);
+    {
+        MappedOptionFile mapped(optionPath);
+        OptionBatchView mappedView = mapped.view();
+        assert(mapped.size() == simdBatch.size());
+        assert(reinterpret_cast<std::uintptr_t>(mappedView.S) % 64 == 0);
+        for (std::size_t i = 0; i < mapped.size(); ++i)
+        {
+            assert(mappedView.option(i) == simdBatch.at(i));
+        }
+        assert(context.calculateCallBatch(mapped) == serialCalls);
+    }
+    
+    // Streaming pricer: small chunks, two quantities, results written into a mapped file
+    const BatchQuantity fileQuantities[] = {BatchQuantity::CallPrice, BatchQuantity::Gamma};
+    assert(priceOptionFile(context, optionPath, resultPath, fileQuantities, 100) == simdBatch.size());
+    {
+        MappedResultFile results(resultPath);
+        auto serialGamma = context.calculateGammaBatch(simdBatch);
+        std::span<const double> fileCalls = results.column(BatchQuantity::CallPrice);
+        std::span<const double> fileGamma = results.column(BatchQuantity::Gamma);
+        assert(results.columnCount() == 2 && results.quantities()[1] == BatchQuantity::Gamma);
+        assert(std::equal(fileCalls.begin(), fileCalls.end(), serialCalls.begin()));
+        assert(std::equal(fileGamma.begin(), fileGamma.end(), serialGamma.begin()));
+    }
+    
+    // Writing the results over the input file, under any spelling of its path, is refused
+    // before the input is mapped, and the input stays intact
+    std::string aliasedPath = (boost::filesystem::path(optionPath).parent_path() / "." /
+                               boost::filesystem::path(optionPath).filename()).string();
+    for (const std::string& outputPath : {optionPath, aliasedPath})
+    {
+        bool aliasRejected = false;
+        try
+        {
+            priceOptionFile(context, optionPath, outputPath, fileQuantities, 100);
+        }
+        catch (const std::invalid_argument&)
+        {
+            aliasRejected = true;
+        }
+        assert(aliasRejected);
+    }
+    assert(MappedOptionFile(optionPath).size() == simdBatch.size());
+    
+    // Wrong file type is refused
+    bool wrongType = false;
+    try
+    {
+        MappedOptionFile misread(resultPath);
+    }
+    catch (const std::runtime_error&)
+    {
+        wrongType = true;
+    }
+    assert(wrongType);
+    
+    // Rewrite a file's bytes with header edits, and whether opening the result is refused
+    auto patchedFile = [&](const std::string& source, auto&& patch) {
+        std::ifstream in(source, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        ColumnFileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        std::string body = bytes.substr(sizeof(header));
+        patch(header, body);
+        std::string path = (fileDirectory / "patched.bin").string();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(body.data(), static_cast<std::streamsize>(body.size()));
+        return path;
+    };
+    auto refused = [](auto&& open) {
+        try
+        {
+            open();
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    };
+    
+    // Columns are found at the header's data offset, not right after the header
+    std::string relocatedPath = patchedFile(optionPath, [](ColumnFileHeader& header, std::string& body) {
+        header.dataOffset = 128;
+        body.insert(0, 64, '\0');
+    });
+    {
+        MappedOptionFile relocated(relocatedPath);
+        assert(relocated.view().option(17) == simdBatch.at(17));
+    }
+    
+    // Sizes that would wrap around 64 bits and unknown result tags are corrupt headers
+    assert(refused([&] {
+        MappedOptionFile wrapped(patchedFile(optionPath, [](ColumnFileHeader& header, std::string&) {
+            header.rowCount = (std::uint64_t(1) << 61) + 1;
+            header.columnStride = std::uint64_t(1) << 62;
+        }));
+    }));
+    assert(refused([&] {
+        MappedResultFile tagged(patchedFile(resultPath, [](ColumnFileHeader& header, std::string&) {
+            header.columnTags[1] = 200;
+        }));
+    }));
+    std::cout << "Option file: " << boost::filesystem::file_size(optionPath) << " bytes for " << simdBatch.size() << " options" << std::endl;
+    boost::filesystem::remove_all(fileDirectory);
+    
+    std::cout << "Mapped Option File Test Complete" << std::endl;
+    
+    std::cout << "\n=== CSV PIPELINE TEST ===" << std::endl;
+    
+    std::istringstream csvInput(
+        "T,K,sig,r,S,b\n"
+        "# comment and blank lines are skipped\n"
+        "\n"
+        "0.25,65,0.30,0.08,60\r\n"
+        "1.0, 100, 0.2, 0.0, 100, 0.0\n"
+        "1.0,10,0.50,0.12,5\n"
+        "30.0,100,0.30,0.08,100\n"
+        "1.0,100,-0.2,0.05,100\n"
+        "0.5,95,0.25,0.03,100,-0.01");
+    std::ostringstream csvOutput;
+    CsvPipelineSettings csvSettings;
+    csvSettings.chunkRows = 2;
+    csvSettings.chunkCount = 2;
+    csvSettings.readBufferBytes = 48;  // Forces lines to straddle buffer refills
+    
+    OptionContext csvContext(std::make_unique<BlackScholesPricer>());
+    csvContext.setValidationMode(ValidationMode::NaN);
+    CsvPipelineStats csvStats = priceCsvStream(csvContext, csvInput, csvOutput, csvSettings);
+    assert(csvStats.rows == 6 && csvStats.chunks == 3);
+    
+    std::vector<Option> csvOptions = {Batch_1.option, Option(1.0, 100.0, 0.2, 0.0, 100.0, 0.0), Batch_3.option,
+                                      Batch_4.option, Option(1.0, 100.0, -0.2, 0.05, 100.0), Option(0.5, 95.0, 0.25, 0.03, 100.0, -0.01)};
+    std::istringstream csvLines(csvOutput.str());
+    std::string csvLine;
+    for (std::size_t i = 0; i < csvOptions.size(); ++i)
+    {
+        assert(std::getline(csvLines, csvLine));
+        std::vector<double> fields;
+        std::istringstream fieldStream(csvLine);
+        for (std::string field; std::getline(fieldStream, field, ',');)
+        {
+            fields.push_back(std::stod(field));
+        }
+        assert(fields.size() == 6);
+        
+        if (i == 4)
+        {
+            // Negative volatility: NaN row, the stream carries on
+            assert(std::isnan(fields[0]) && std::isnan(fields[4]));
+            continue;
+        }
+        const Option& expected = csvOptions[i];
+        assert(std::abs(fields[0] - csvContext.calculateCallPrice(expected)) < 1e-10);
+        assert(std::abs(fields[1] - csvContext.calculatePutPrice(expected)) < 1e-10);
+        assert(std::abs(fields[2] - csvContext.calculateCallDelta(expected)) < 1e-12);
+        assert(std::abs(fields[3] - csvContext.calculatePutDelta(expected)) < 1e-12);
+        assert(std::abs(fields[4] - csvContext.calculateGamma(expected)) < 1e-12);
+        assert(std::abs(fields[5]) < 1e-9);
+    }
+    assert(!std::getline(csvLines, csvLine));
+    
+    // Malformed rows stop the pipeline with their line number
+    std::istringstream badInput("1.0,100,0.2,0.05,100\n1.0,100,0.2\n");
+    std::ostringstream badOutput;
+    bool malformedRow = false;
+    try
+    {
+        priceCsvStream(csvContext, badInput, badOutput);
+    }
+    catch (const std::runtime_error& error)
+    {
+        malformedRow = std::string(error.what()).find("line 2") != std::string::npos;
+    }
+    assert(malformedRow);
+    std::cout << "CSV rows priced: " << csvStats.rows << " in " << csvStats.chunks << " chunks" << std::endl;
+    
+    std::cout << "CSV Pipeline Test Complete" << std::endl;
+    
+    std::cout << "\n=== PARITY AUDIT TEST ===" << std::endl;
+    
+    OptionContext auditContext(std::make_unique<BlackScholesPricer>());
+    auditContext.setParityValidator(std::make_unique<PutCallParityValidator>());
+    GreeksBatch auditResults = auditContext.calculateGreeksBatch(simdBatch);
+    ParityAudit cleanAudit = auditContext.auditParity(simdBatch, auditResults, 1e-9);
+    assert(cleanAudit.passed() && cleanAudit.checked == simdBatch.size() && cleanAudit.maxAbsDifference < 1e-9);
+    
+    // Break parity on a few rows: the audit lists exactly those, in order, with their residuals
+    std::vector<double> auditCalls(auditResults.callPrice.begin(), auditResults.callPrice.end());
+    std::vector<double> auditPuts(auditResults.putPrice.begin(), auditResults.putPrice.end());
+    auditPuts[3] += 0.5;
+    auditCalls[700] -= 0.01;
+    auditPuts[simdBatch.size() - 1] = std::numeric_limits<double>::quiet_NaN();
+    ParityAudit brokenAudit = auditContext.auditParity(simdBatch, auditCalls, auditPuts, 1e-6);
+    assert(brokenAudit.violations.size() == 3);
+    assert(brokenAudit.violations[0].index == 3 && std::abs(brokenAudit.violations[0].difference + 0.5) < 1e-9);
+    assert(brokenAudit.violations[1].index == 700 && std::abs(brokenAudit.violations[1].difference + 0.01) < 1e-9);
+    assert(brokenAudit.violations[2].index == simdBatch.size() - 1 && std::isnan(brokenAudit.violations[2].difference));
+    assert(std::abs(brokenAudit.maxAbsDifference - 0.5) < 1e-9);
+    
+    // Vectorised residuals agree with the one-option formula and the generic row-by-row audit
+    PutCallParityValidator auditValidator;
+    ParityAudit rowAudit = auditValidator.IParityValidator::auditParity(simdBatch, auditCalls, auditPuts, 1e-6);
+    assert(rowAudit.violations.size() == brokenAudit.violations.size());
+    for (std::size_t i = 0; i < rowAudit.violations.size(); ++i)
+    {
+        assert(rowAudit.violations[i].index == brokenAudit.violations[i].index);
+    }
+    std::vector<double> residuals(simdBatch.size());
+    evaluateParityDifferenceBatch(simdBatch, auditResults.callPrice, auditResults.putPrice, residuals);
+    for (std::size_t i = 0; i < simdBatch.size(); ++i)
+    {
+        Option option = simdBatch.at(i);
+        double expected = auditValidator.calculateParityDifference(option, auditResults.callPrice[i], auditResults.putPrice[i]);
+        assert(std::abs(residuals[i] - expected) < 1e-12 * option.StrikePrice());
+    }
+    std::cout << "Audited " << brokenAudit.checked << " options, " << brokenAudit.violations.size()
+              << " violations, max |diff| " << brokenAudit.maxAbsDifference << std::endl;
+    
+    std::cout << "Parity Audit Test Complete" << std::endl;
+    
+    std::cout << "\n=== ALLOCATION-FREE SPAN API TEST ===" << std::endl;
+    
+    // Caller-owned output: after the buffers exist, repeated calls never touch the heap
+    OptionContext spanContext(std::make_unique<BlackScholesPricer>());
+    std::vector<Option> spanOptions = simdBatch.toOptions();
+    std::vector<double> spanCalls(spanOptions.size()), spanPuts(spanOptions.size());
+    std::vector<double> spanCallDeltas(spanOptions.size()), spanPutDeltas(spanOptions.size()), spanGammas(spanOptions.size());
+    const Grid<Option>& spanGrid = expiryGreeksMatrix;
+    Grid<double> spanGridOut;
+    spanContext.calculateCallMatrix(spanGrid, spanGridOut);
+    std::vector<GreeksResult> spanGreeks(spanOptions.size());
+    Grid<GreeksResult> spanGreeksGrid;
+    spanContext.calculateGreeksMatrix(spanGrid, spanGreeksGrid);
+    
+    std::size_t allocationsBefore = heapAllocationCount();
+    for (int repeat = 0; repeat < 10; ++repeat)
+    {
+        spanContext.calculateCallVector(spanOptions, spanCalls);
+        spanContext.calculatePutVector(spanOptions, spanPuts);
+        spanContext.calculateCallDeltaVector(spanOptions, spanCallDeltas);
+        spanContext.calculatePutDeltaVector(spanOptions, spanPutDeltas);
+        spanContext.calculateGammaVector(spanOptions, spanGammas);
+        spanContext.calculateCallMatrix(spanGrid, spanGridOut);
+        spanContext.calculateGreeksVector(spanOptions, spanGreeks);
+        spanContext.calculateGreeksMatrix(spanGrid, spanGreeksGrid);
+    }
+    std::size_t spanAllocations = heapAllocationCount() - allocationsBefore;
+    assert(spanAllocations == 0);
+    
+    // Same values as the allocating overloads, here and on a static context
+    assert(spanCalls == spanContext.calculateCallVector(spanOptions));
+    assert(spanPutDeltas == spanContext.calculatePutDeltaVector(spanOptions));
+    assert(spanGammas == spanContext.calculateGammaVector(spanOptions));
+    assert(spanGridOut == spanContext.calculateCallMatrix(spanGrid));
+    GreeksBatch spanGreeksBatch = spanContext.calculateGreeksBatch(simdBatch);
+    for (std::size_t i = 0; i < spanOptions.size(); ++i)
+    {
+        assert(std::abs(spanGreeks[i].callPrice - spanGreeksBatch.callPrice[i]) < 1e-12);
+        assert(std::abs(spanGreeks[i].gamma - spanGreeksBatch.gamma[i]) < 1e-12);
+        assert(std::abs(spanGreeks[i].putCharm - spanGreeksBatch.putCharm[i]) < 1e-12);
+    }
+    assert(std::abs(spanGreeksGrid.values()[3].vega - spanContext.calculateGreeks(spanGrid.values()[3]).vega) < 1e-10);
+    StaticOptionContext<BlackScholesPricer> spanStatic;
+    std::vector<double> staticSpanCalls(spanOptions.size());
+    allocationsBefore = heapAllocationCount();
+    spanStatic.calculateCallVector(spanOptions, staticSpanCalls);
+    spanStatic.calculateGreeksVector(spanOptions, spanGreeks);
+    assert(heapAllocationCount() == allocationsBefore && staticSpanCalls == spanCalls);
+    assert(std::abs(spanGreeks[7].callRho - spanGreeksBatch.callRho[7]) < 1e-12);
+    
+    bool spanSizeRejected = false;
+    try
+    {
+        spanContext.calculateCallVector(spanOptions, std::span<double>(spanCalls).first(10));
+    }
+    catch (const std::invalid_argument&)
+    {
+        spanSizeRejected = true;
+    }
+    assert(spanSizeRejected);
+    std::cout << "Heap allocations over 80 span/grid calls: " << spanAllocations << std::endl;
+    
+    std::cout << "Allocation-Free Span API Test Complete" << std::endl;
+    
+    std::cout << "\n=== SCENARIO ENGINE TEST ===" << std::endl;
+    
+    // 2000 contracts (terms cycled from the SIMD batch), with a dividend yield on every other one
+    std::vector<Option> stressOptions;
+    std::vector<OptionType> stressTypes;
+    std::vector<double> stressQuantities;
+    for (std::size_t i = 0; i < 2000; ++i)
+    {
+        Option terms = simdBatch.at(i % simdBatch.size());
+        double b = i % 2 == 0 ? terms.RiskFreeRate() : terms.RiskFreeRate() - 0.02;
+        stressOptions.emplace_back(terms.ExerciseDate(), terms.StrikePrice(), terms.Volatility(), terms.RiskFreeRate(), 100.0, b);
+        stressTypes.push_back(i % 3 == 0 ? OptionType::Put : OptionType::Call);
+        stressQuantities.push_back(i % 7 == 0 ? -4.0 : 2.5);
+    }
+    ScenarioEngine stressEngine(stressOptions, stressTypes, stressQuantities);
+    
+    const double stressSpots[] = {-0.2, -0.05, 0.0, 0.05, 0.2};
+    const double stressVols[] = {-0.05, 0.0, 0.1};
+    const double stressRates[] = {0.0, 0.01};
+    std::vector<Scenario> stressScenarios = scenarioGrid(stressSpots, stressVols, stressRates);
+    assert(stressScenarios.size() == 30 && stressScenarios[1].spotShift == -0.05 && stressScenarios[5].volShift == 0.0);
+    
+    // Factorised repricing matches a full rebuild through the scalar strategy, serial or pooled
+    OptionContext stressContext(std::make_unique<BlackScholesPricer>());
+    Grid<double> stressPnl = stressEngine.run(stressScenarios);
+    Grid<double> stressReference = stressEngine.runWithContext(stressContext, stressScenarios);
+    assert(stressPnl.rows() == 30 && stressPnl.cols() == 2000);
+    for (std::size_t s = 0; s < stressPnl.rows(); ++s)
+    {
+        for (std::size_t i = 0; i < stressPnl.cols(); ++i)
+        {
+            assert(std::abs(stressPnl.row(s)[i] - stressReference.row(s)[i]) < 1e-9 * std::max(1.0, std::abs(stressReference.row(s)[i])));
+        }
+    }
+    stressEngine.setThreadPool(sharedPool);
+    stressEngine.setParallelChunkSize(300);
+    Grid<double> pooledStressPnl;
+    stressEngine.run(stressScenarios, pooledStressPnl);
+    assert(pooledStressPnl == stressPnl);
+    
+    // The null scenario is exactly flat and base prices agree with the pricer
+    const Scenario nullScenario[] = {Scenario()};
+    Grid<double> flatPnl = stressEngine.run(nullScenario);
+    assert(std::all_of(flatPnl.values().begin(), flatPnl.values().end(), [](double pnl) { return pnl == 0.0; }));
+    BlackScholesPricer stressPricer;
+    for (std::size_t i = 0; i < 2000; i += 97)
+    {
+        double expected = stressTypes[i] == OptionType::Call ? stressPricer.calculateCallPrice(stressOptions[i])
+                                                             : stressPricer.calculatePutPrice(stressOptions[i]);
+        assert(std::abs(stressEngine.basePrices()[i] - expected) < 1e-10);
+    }
+    
+    // Row sums give the book P&L per scenario; the OptionBook constructor mirrors its positions
+    std::vector<double> stressTotals = ScenarioEngine::totals(stressPnl);
+    ScenarioEngine bookEngine(book);
+    assert(bookEngine.size() == book.size());
+    for (std::size_t p = 0; p < book.size(); p += 37)
+    {
+        assert(std::abs(bookEngine.basePrices()[p] - book.price(p)) < 1e-9);
+    }
+    
+    bool stressRejected = false;
+    try
+    {
+        const Scenario crash[] = {{-1.0, 0.0, 0.0}};
+        stressEngine.run(crash);
+    }
+    catch (const std::invalid_argument&)
+    {
+        stressRejected = true;
+    }
+    assert(stressRejected);
+    std::cout << "Scenarios x contracts: " << stressPnl.rows() << " x " << stressPnl.cols()
+              << ", worst book P&L " << *std::min_element(stressTotals.begin(), stressTotals.end()) << std::endl;
+    
+    std::cout << "Scenario Engine Test Complete" << std::endl;
+    
+    std::cout << "\n=== HIGHER-ORDER GREEKS TEST ===" << std::endl;
+    
+    // Analytic Greeks against central differences of the pricer's own prices, with b != r
+    BlackScholesPricer greekPricer;
+    const Option greekOptions[] = {Option(0.75, 105.0, 0.25, 0.04, 100.0, 0.01), Option(0.2, 90.0, 0.4, 0.06, 100.0, 0.06),
+                                   Option(2.0, 120.0, 0.18, 0.02, 100.0, -0.01)};
+    auto bumped = [](const Option& option, double dT, double dsig, double dr, double dS) {
+        return Option(option.ExerciseDate() + dT, option.StrikePrice(), option.Volatility() + dsig,
+                      option.RiskFreeRate() + dr, option.AssetPrice() + dS, option.CostOfCarry() + dr);
+    };
+    for (const Option& option : greekOptions)
+    {
+        GreeksResult greeks = greekPricer.calculateGreeks(option);
+        const double h = 1e-4, hS = 1e-2;
+        auto difference = [&](auto quantity, double dT, double dsig, double dr, double dS) {
+            return (quantity(bumped(option, dT, dsig, dr, dS)) - quantity(bumped(option, -dT, -dsig, -dr, -dS))) / 2.0;
+        };
+        auto call = [&](const Option& o) { return greekPricer.calculateCallPrice(o); };
+        auto put = [&](const Option& o) { return greekPricer.calculatePutPrice(o); };
+        auto callDelta = [&](const Option& o) { return greekPricer.calculateCallDelta(o); };
+        auto putDelta = [&](const Option& o) { return greekPricer.calculatePutDelta(o); };
+        auto gamma = [&](const Option& o) { return greekPricer.calculateGamma(o); };
+        auto vega = [&](const Option& o) { return greekPricer.calculateGreek(Greek::Vega, o); };
+        
+        assert(std::abs(greeks.vega - difference(call, 0, h, 0, 0) / h) < 1e-5);
+        assert(std::abs(greeks.callTheta + difference(call, h, 0, 0, 0) / h) < 1e-5);
+        assert(std::abs(greeks.putTheta + difference(put, h, 0, 0, 0) / h) < 1e-5);
+        assert(std::abs(greeks.callRho - difference(call, 0, 0, h, 0) / h) < 1e-5);
+        assert(std::abs(greeks.putRho - difference(put, 0, 0, h, 0) / h) < 1e-5);
+        assert(std::abs(greeks.vanna - difference(callDelta, 0, h, 0, 0) / h) < 1e-6);
+        assert(std::abs(greeks.volga - difference(vega, 0, h, 0, 0) / h) < 1e-4);
+        assert(std::abs(greeks.speed - difference(gamma, 0, 0, 0, hS) / hS) < 1e-7);
+        assert(std::abs(greeks.callCharm + difference(callDelta, h, 0, 0, 0) / h) < 1e-6);
+        assert(std::abs(greeks.putCharm + difference(putDelta, h, 0, 0, 0) / h) < 1e-6);
+    }
+    
+    // Single-Greek SIMD kernels agree with the fused evaluation, through every context form
+    const Greek allGreeks[] = {Greek::Vega, Greek::CallTheta, Greek::PutTheta, Greek::CallRho, Greek::PutRho,
+                               Greek::Vanna, Greek::Volga, Greek::Speed, Greek::CallCharm, Greek::PutCharm};
+    OptionContext greekContext(std::make_unique<BlackScholesPricer>());
+    GreeksBatch fusedGreeks = greekContext.calculateGreeksBatch(simdBatch);
+    std::vector<Option> greekVectorOptions = simdBatch.toOptions();
+    for (Greek greek : allGreeks)
+    {
+        std::vector<double> batchGreek = greekContext.calculateGreekBatch(greek, simdBatch);
+        std::vector<double> vectorGreek = greekContext.calculateGreekVector(greek, greekVectorOptions);
+        for (std::size_t i = 0; i < simdBatch.size(); ++i)
+        {
+            double expected = fusedGreeks.at(i).value(greek);
+            assert(std::abs(batchGreek[i] - expected) <= 1e-9 * std::max(1.0, std::abs(expected)));
+            assert(vectorGreek[i] == batchGreek[i]);
+        }
+        assert(std::abs(greekContext.calculateGreek(greek, greekVectorOptions[5]) - batchGreek[5])
+               <= 1e-9 * std::max(1.0, std::abs(batchGreek[5])));
+    }
+    Grid<double> vannaMatrix = greekContext.calculateGreekMatrix(Greek::Vanna, expiryGreeksMatrix);
+    assert(vannaMatrix.rows() == expiryGreeksMatrix.rows() && vannaMatrix.cols() == expiryGreeksMatrix.cols());
+    std::vector<double> vannaVector(expiryGreeksMatrix.size());
+    greekContext.calculateGreekVector(Greek::Vanna, expiryGreeksMatrix.values(), vannaVector);
+    assert(std::equal(vannaVector.begin(), vannaVector.end(), vannaMatrix.values().begin()));
+    StaticOptionContext<BlackScholesPricer> staticGreeks;
+    assert(staticGreeks.calculateGreek(Greek::PutCharm, greekOptions[2]) == greekPricer.calculateGreeks(greekOptions[2]).putCharm);
+    
+    // Pooled calls give the same values, NaN validation masks invalid rows, and
+    // strategies without analytic higher-order Greeks report NaN
+    std::vector<double> serialSpeed = greekContext.calculateGreekBatch(Greek::Speed, simdBatch);
+    greekContext.setThreadPool(sharedPool);
+    greekContext.setParallelChunkSize(128);
+    assert(greekContext.calculateGreekBatch(Greek::Speed, simdBatch) == serialSpeed);
+    std::vector<Option> maskedGreekOptions = {greekOptions[0], Option(1.0, 100.0, -0.2, 0.05, 100.0), greekOptions[1]};
+    greekContext.setValidationMode(ValidationMode::NaN);
+    std::vector<double> maskedVolga = greekContext.calculateGreekVector(Greek::Volga, maskedGreekOptions);
+    assert(std::isnan(maskedVolga[1]));
+    assert(std::abs(maskedVolga[2] - greekPricer.calculateGreeks(greekOptions[1]).volga) < 1e-9);
+    assert(std::isnan(FDMPricer().calculateGreek(Greek::Vanna, greekOptions[0])));
+    
+    GreeksResult shownGreeks = greekPricer.calculateGreeks(greekOptions[0]);
+    std::cout << "Vanna " << shownGreeks.vanna << ", volga " << shownGreeks.volga << ", speed " << shownGreeks.speed
+              << ", call charm " << shownGreeks.callCharm << std::endl;
+    
+    std::cout << "Higher-Order Greeks Test Complete" << std::endl;
+    
+    std::cout << "\n=== FINITE-DIFFERENCE GREEKS TEST ===" << std::endl;
+    
+    // Bump-and-reprice around the analytic pricer reproduces its Greeks
+    FiniteDifferenceGreeks bumpedPricer(std::make_unique<BlackScholesPricer>());
+    assert(bumpedPricer.getName() == "Finite-Difference Greeks (" + greekPricer.getName() + ")");
+    for (const Option& option : greekOptions)
+    {
+        GreeksResult exact = greekPricer.calculateGreeks(option);
+        GreeksResult bumpedGreeks = bumpedPricer.calculateGreeks(option);
+        assert(std::abs(bumpedGreeks.callPrice - greekPricer.calculateCallPrice(option)) < 1e-12);
+        assert(std::abs(bumpedGreeks.putPrice - greekPricer.calculatePutPrice(option)) < 1e-12);
+        assert(std::abs(bumpedGreeks.callDelta - exact.callDelta) < 1e-5);
+        assert(std::abs(bumpedGreeks.putDelta - exact.putDelta) < 1e-5);
+        assert(std::abs(bumpedGreeks.gamma - exact.gamma) < 1e-6);
+        assert(std::abs(bumpedGreeks.vega - exact.vega) < 1e-3);
+        assert(std::abs(bumpedGreeks.volga - exact.volga) < 1e-2);
+        assert(std::abs(bumpedGreeks.callTheta - exact.callTheta) < 1e-4);
+        assert(std::abs(bumpedGreeks.putTheta - exact.putTheta) < 1e-4);
+        assert(std::abs(bumpedGreeks.callRho - exact.callRho) < 1e-5);
+        assert(std::abs(bumpedGreeks.putRho - exact.putRho) < 1e-5);
+        assert(std::isnan(bumpedGreeks.vanna) && std::isnan(bumpedGreeks.speed));
+        assert(bumpedPricer.calculateCallDelta(option) == bumpedGreeks.callDelta);
+        assert(bumpedPricer.calculatePutDelta(option) == bumpedGreeks.putDelta);
+        assert(bumpedPricer.calculateGamma(option) == bumpedGreeks.gamma);
+    }
+    
+    // Batch, block-spanning and context paths agree with the single-option results
+    OptionContext bumpedContext(std::make_unique<FiniteDifferenceGreeks>(std::make_unique<BlackScholesPricer>()));
+    std::vector<double> bumpedGammas = bumpedContext.calculateGammaBatch(simdBatch);
+    GreeksBatch bumpedBatch = bumpedContext.calculateGreeksBatch(simdBatch);
+    std::vector<double> bumpedVegas = bumpedContext.calculateGreekBatch(Greek::Vega, simdBatch);
+    for (std::size_t i = 0; i < simdBatch.size(); i += 97)
+    {
+        GreeksResult single = bumpedPricer.calculateGreeks(simdBatch.at(i));
+        assert(bumpedGammas[i] == single.gamma && bumpedBatch.gamma[i] == single.gamma);
+        assert(bumpedVegas[i] == single.vega && bumpedBatch.callRho[i] == single.callRho);
+    }
+    
+    // A volatility below the bump: the step shrinks to half of it instead of going negative
+    Option lowVolOption(1.0, 100.0, 5e-4, 0.0, 100.0, 0.0);
+    GreeksResult lowVolGreeks = bumpedPricer.calculateGreeks(lowVolOption);
+    double lowVolVega = greekPricer.calculateGreeks(lowVolOption).vega;
+    assert(std::isfinite(lowVolGreeks.vega) && std::abs(lowVolGreeks.vega / lowVolVega - 1.0) < 1e-3);
+    
+    // Monte Carlo: common random numbers keep the bumped differences close to Black-Scholes
+    MonteCarloSettings fdSettings;
+    fdSettings.paths = 100000;
+    FiniteDifferenceSettings mcBumps;
+    mcBumps.spotBump = 1e-2;
+    mcBumps.volBump = 1e-2;
+    FiniteDifferenceGreeks bumpedMonteCarlo(std::make_unique<MonteCarloPricer>(fdSettings), mcBumps);
+    GreeksResult bumpedMcGreeks = bumpedMonteCarlo.calculateGreeks(greekOptions[0]);
+    GreeksResult bumpedBsGreeks = greekPricer.calculateGreeks(greekOptions[0]);
+    std::cout << "Monte Carlo bumped delta " << bumpedMcGreeks.callDelta << " (BS " << bumpedBsGreeks.callDelta << "), gamma "
+              << bumpedMcGreeks.gamma << " (BS " << bumpedBsGreeks.gamma << "), vega " << bumpedMcGreeks.vega << " (BS " << bumpedBsGreeks.vega
+              << ")" << std::endl;
+    assert(std::abs(bumpedMcGreeks.callDelta - bumpedBsGreeks.callDelta) < 1e-2);
+    assert(std::abs(bumpedMcGreeks.putDelta - bumpedBsGreeks.putDelta) < 1e-2);
+    assert(std::abs(bumpedMcGreeks.gamma - bumpedBsGreeks.gamma) < 0.1 * bumpedBsGreeks.gamma);
+    assert(std::abs(bumpedMcGreeks.vega - bumpedBsGreeks.vega) < 0.02 * bumpedBsGreeks.vega);
+    
+    bool rejectedStrategy = false;
+    try
+    {
+        FiniteDifferenceGreeks missing(nullptr);
+    }
+    catch (const std::invalid_argument&)
+    {
+        rejectedStrategy = true;
+    }
+    assert(rejectedStrategy);
+    
+    std::cout << "Finite-Difference Greeks Test Complete" << std::endl;
+    
+    std::cout << "\n=== ADJOINT GREEKS TEST ===" << std::endl;
+    
+    // Tape basics: f = x y + e^x / y, one reverse sweep gives both partials
+    AdjointTape tape;
+    AdjointDouble x = tape.variable(0.5), y = tape.variable(2.0);
+    AdjointDouble f = x * y + exp(x) / y - 3.0;
+    tape.gradient(f);
+    assert(std::abs(f.value() - (1.0 + std::exp(0.5) / 2.0 - 3.0)) < 1e-15);
+    assert(std::abs(tape.adjoint(x) - (2.0 + std::exp(0.5) / 2.0)) < 1e-15);
+    assert(std::abs(tape.adjoint(y) - (0.5 - std::exp(0.5) / 4.0)) < 1e-15);
+    assert(tape.adjoint(AdjointDouble(1.0)) == 0.0);
+    
+    // reset() rewinds without giving memory back: the same expression records without growing
+    std::size_t recorded = tape.size(), arena = tape.capacity();
+    tape.reset();
+    assert(tape.size() == 0 && tape.capacity() == arena);
+    AdjointDouble u = tape.variable(0.5), w = tape.variable(2.0);
+    tape.gradient(u * w + exp(u) / w - 3.0);
+    assert(tape.size() == recorded && tape.capacity() == arena);
+    
+    // Operands of one operation must share a tape
+    AdjointTape otherTape;
+    bool rejectedTapes = false;
+    try
+    {
+        u * otherTape.variable(1.0);
+    }
+    catch (const std::invalid_argument&)
+    {
+        rejectedTapes = true;
+    }
+    assert(rejectedTapes);
+    
+    // Black-Scholes sensitivities to all six inputs match the analytic Greeks, with b != r
+    for (const Option& option : greekOptions)
+    {
+        GreeksResult exact = greekPricer.calculateGreeks(option);
+        AdjointResult call = greekPricer.calculateAdjoint(option, OptionType::Call);
+        AdjointResult put = greekPricer.calculateAdjoint(option, OptionType::Put);
+        assert(std::abs(call.price - exact.callPrice) < 1e-12 && std::abs(put.price - exact.putPrice) < 1e-12);
+        assert(std::abs(call.dS - exact.callDelta) < 1e-12 && std::abs(put.dS - exact.putDelta) < 1e-12);
+        assert(std::abs(call.dSig - exact.vega) < 1e-10 && std::abs(put.dSig - exact.vega) < 1e-10);
+        assert(std::abs(-call.dT - exact.callTheta) < 1e-10 && std::abs(-put.dT - exact.putTheta) < 1e-10);
+        assert(std::abs(call.dR + call.dB - exact.callRho) < 1e-10 && std::abs(put.dR + put.dB - exact.putRho) < 1e-10);
+        
+        // Strike and the separate r / b partials against central differences
+        const double h = 1e-5;
+        Option strikeUp = option, strikeDown = option, rateUp = option, rateDown = option;
+        strikeUp.StrikePrice(option.StrikePrice() + h);
+        strikeDown.StrikePrice(option.StrikePrice() - h);
+        rateUp.RiskFreeRate(option.RiskFreeRate() + h);
+        rateDown.RiskFreeRate(option.RiskFreeRate() - h);
+        assert(std::abs(call.dK - (greekPricer.calculateCallPrice(strikeUp) - greekPricer.calculateCallPrice(strikeDown)) / (2.0 * h)) < 1e-7);
+        assert(std::abs(put.dR - (greekPricer.calculatePutPrice(rateUp) - greekPricer.calculatePutPrice(rateDown)) / (2.0 * h)) < 1e-5);
+    }
+    
+    // Batch form agrees with the single-option form
+    std::vector<AdjointResult> adjoints(simdBatch.size());
+    greekPricer.calculateAdjointBatch(simdBatch, OptionType::Put, adjoints);
+    for (std::size_t i = 0; i < simdBatch.size(); i += 101)
+    {
+        AdjointResult single = greekPricer.calculateAdjoint(simdBatch.at(i), OptionType::Put);
+        assert(adjoints[i].price == single.price && adjoints[i].dK == single.dK && adjoints[i].dB == single.dB);
+    }
+    
+    AdjointResult shownAdjoint = greekPricer.calculateAdjoint(greekOptions[0], OptionType::Call);
+    std::cout << "Call " << shownAdjoint.price << ": dT " << shownAdjoint.dT << ", dK " << shownAdjoint.dK << ", dSig "
+              << shownAdjoint.dSig << ", dR " << shownAdjoint.dR << ", dS " << shownAdjoint.dS << ", dB "
+              << shownAdjoint.dB << std::endl;
+    
+    std::cout << "Adjoint Greeks Test Complete" << std::endl;
+    
+    std::cout << "\n=== VOLATILITY SURFACE TEST ===" << std::endl;
+    
+    // Skewed surface on meshArray axes: vol falls with strike and rises with expiry
+    Grid<double> surfaceVols(meshArray(0.25, 2.0, 0.25), meshArray(80.0, 120.0, 5.0));
+    for (std::size_t i = 0; i < surfaceVols.rows(); ++i)
+    {
+        for (std::size_t j = 0; j < surfaceVols.cols(); ++j)
+        {
+            double moneyness = surfaceVols.colLabels()[j] / 100.0 - 1.0;
+            surfaceVols(i, j) = 0.2 - 0.3 * moneyness + 0.5 * moneyness * moneyness + 0.01 * surfaceVols.rowLabels()[i];
+        }
+    }
+    VolSurface bilinearSurface(surfaceVols);
+    VolSurface splineSurface(surfaceVols, VolInterpolation::CubicSpline);
+    for (std::size_t i = 0; i < surfaceVols.rows(); ++i)
+    {
+        for (std::size_t j = 0; j < surfaceVols.cols(); ++j)
+        {
+            double T = surfaceVols.rowLabels()[i], K = surfaceVols.colLabels()[j];
+            assert(std::abs(bilinearSurface.volatility(T, K) - surfaceVols(i, j)) < 1e-14);
+            assert(std::abs(splineSurface.volatility(T, K) - surfaceVols(i, j)) < 1e-14);
+        }
+    }
+    
+    // Between knots: linear in total variance (strike and expiry), flat beyond the grid
+    auto knotVariance = [&](std::size_t i, std::size_t j) {
+        return surfaceVols(i, j) * surfaceVols(i, j) * surfaceVols.rowLabels()[i];
+    };
+    double midVariance = 0.25 * (knotVariance(2, 3) + knotVariance(2, 4) + knotVariance(3, 3) + knotVariance(3, 4));
+    assert(std::abs(bilinearSurface.totalVariance(0.875, 97.5) - midVariance) < 1e-14);
+    assert(std::abs(splineSurface.volatility(0.875, 97.5) - bilinearSurface.volatility(0.875, 97.5)) < 1e-3);
+    assert(bilinearSurface.volatility(1.0, 40.0) == bilinearSurface.volatility(1.0, 80.0));
+    assert(splineSurface.volatility(5.0, 130.0) == splineSurface.volatility(2.0, 120.0));
+    assert(bilinearSurface.volatility(0.1, 100.0) == bilinearSurface.volatility(0.25, 100.0));
+    
+    // A variance linear in strike is reproduced exactly by the spline; uneven axes locate correctly
+    Grid<double> unevenVols(std::vector<double>{0.5, 0.6, 3.0}, std::vector<double>{50.0, 60.0, 90.0, 91.0, 130.0});
+    for (std::size_t i = 0; i < unevenVols.rows(); ++i)
+    {
+        for (std::size_t j = 0; j < unevenVols.cols(); ++j)
+        {
+            unevenVols(i, j) = std::sqrt((0.01 + 0.0005 * unevenVols.colLabels()[j]) / unevenVols.rowLabels()[i]);
+        }
+    }
+    VolSurface unevenSurface(unevenVols, VolInterpolation::CubicSpline);
+    for (double K : {51.0, 59.9, 75.0, 90.5, 91.0, 129.0})
+    {
+        assert(std::abs(unevenSurface.totalVariance(0.6, K) - (0.01 + 0.0005 * K)) < 1e-14);
+    }
+    
+    // Clustered strikes: the lookup table resolves every bucket of 1, 2, ..., 10, 1000
+    std::vector<double> clusteredStrikes = meshArray(1.0, 10.0, 1.0);
+    clusteredStrikes.push_back(1000.0);
+    Grid<double> clusteredVols(std::vector<double>{1.0}, clusteredStrikes);
+    for (std::size_t j = 0; j < clusteredStrikes.size(); ++j)
+    {
+        clusteredVols(0, j) = std::sqrt(0.01 + 0.001 * clusteredStrikes[j]);
+    }
+    VolSurface clusteredSurface(clusteredVols);
+    for (double K : {1.0, 1.5, 4.999, 5.0, 9.5, 10.0, 500.0, 999.0})
+    {
+        assert(std::abs(clusteredSurface.totalVariance(1.0, K) - (0.01 + 0.001 * K)) < 1e-14);
+    }
+    
+    // Steep wing: the spline would dip through zero variance between 60 and 70, so that
+    // interval falls back to linear while the flat intervals keep the spline
+    Grid<double> wingVols(std::vector<double>{1.0}, meshArray(50.0, 120.0, 10.0));
+    for (std::size_t j = 0; j < wingVols.cols(); ++j)
+    {
+        wingVols(0, j) = j == 0 ? 0.9 : j == 1 ? 0.25 : 0.2;
+    }
+    VolSurface wingSpline(wingVols, VolInterpolation::CubicSpline);
+    VolSurface wingLinear(wingVols);
+    for (double K = 50.0; K <= 120.0; K += 0.5)
+    {
+        double vol = wingSpline.volatility(1.0, K);
+        assert(std::isfinite(vol) && vol > 0.0);
+    }
+    assert(std::abs(wingSpline.volatility(1.0, 65.0) - wingLinear.volatility(1.0, 65.0)) < 1e-14);
+    assert(std::abs(wingSpline.volatility(1.0, 75.0) - wingLinear.volatility(1.0, 75.0)) > 1e-3);
+    
+    // SVI slices sampled on the strike axis
+    std::vector<SviSlice> sviSlices = {{0.5, 100.0, 0.01, 0.08, -0.4, 0.0, 0.15}, {1.0, 101.0, 0.02, 0.1, -0.5, 0.02, 0.2}};
+    VolSurface sviSurface(sviSlices, meshArray(60.0, 140.0, 2.5));
+    assert(std::abs(sviSurface.totalVariance(1.0, 110.0) - sviSlices[1].totalVariance(110.0)) < 1e-12);
+    assert(std::abs(sviSurface.totalVariance(0.5, 101.25) - sviSlices[0].totalVariance(101.25)) < 1e-5);
+    bool rejectedSurface = false;
+    try
+    {
+        sviSlices[0].rho = 1.5;
+        sviSurface.setSvi(sviSlices);
+    }
+    catch (const std::invalid_argument&)
+    {
+        rejectedSurface = true;
+    }
+    assert(rejectedSurface);
+    
+    // Surface mode: batch calls take sigma from the surface, ignoring the options' own
+    auto liveSurface = std::make_shared<VolSurface>(surfaceVols, VolInterpolation::CubicSpline);
+    OptionBatch surfaceChain;
+    for (double T : {0.3, 0.9, 1.7})
+    {
+        for (double K = 78.0; K <= 124.0; K += 2.0)
+        {
+            surfaceChain.push_back(Option(T, K, 0.99, 0.03, 100.0, 0.01));
+        }
+    }
+    OptionContext surfaceContext(std::make_unique<BlackScholesPricer>());
+    surfaceContext.setVolSurface(liveSurface);
+    auto expectedPrices = [&](const VolSurface& surface) {
+        std::vector<Option> options = surfaceChain.toOptions();
+        for (Option& option : options)
+        {
+            option.Volatility(surface.volatility(option.ExerciseDate(), option.StrikePrice()));
+        }
+        return BlackScholesPricer().calculateCallVector(options);
+    };
+    std::vector<double> surfacePrices = surfaceContext.calculateCallBatch(surfaceChain);
+    std::vector<double> expectedSurfacePrices = expectedPrices(*liveSurface);
+    for (std::size_t i = 0; i < surfaceChain.size(); ++i)
+    {
+        assert(std::abs(surfacePrices[i] - expectedSurfacePrices[i]) < 1e-12);
+    }
+    GreeksBatch surfaceGreeks = surfaceContext.calculateGreeksBatch(surfaceChain);
+    assert(std::abs(surfaceGreeks.callPrice[7] - expectedSurfacePrices[7]) < 1e-12);
+    
+    // Refresh: a parallel shift of the same surface re-prices the surfaceChain without rebuilding it
+    Grid<double> shiftedVols = surfaceVols;
+    for (double& vol : shiftedVols.values())
+    {
+        vol += 0.02;
+    }
+    liveSurface->setVolatilities(shiftedVols);
+    std::vector<double> refreshedPrices = surfaceContext.calculateCallBatch(surfaceChain);
+    std::vector<double> expectedRefreshedPrices = expectedPrices(*liveSurface);
+    for (std::size_t i = 0; i < surfaceChain.size(); ++i)
+    {
+        assert(refreshedPrices[i] > surfacePrices[i]);
+        assert(std::abs(refreshedPrices[i] - expectedRefreshedPrices[i]) < 1e-12);
+    }
+    // Nested surface-mode calls from tasks of the pool the context itself runs on: every
+    // call owns its resolved sigma column, so waiting threads that pick up other calls'
+    // chunks cannot overwrite it
+    auto surfacePool = std::make_shared<ThreadPool>(4);
+    surfaceContext.setThreadPool(surfacePool);
+    surfaceContext.setParallelChunkSize(8);
+    std::vector<std::vector<double>> nestedPrices(16);
+    surfacePool->parallelFor(nestedPrices.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t task = begin; task < end; ++task)
+        {
+            nestedPrices[task] = surfaceContext.calculateCallBatch(surfaceChain);
+        }
+    });
+    for (const std::vector<double>& prices : nestedPrices)
+    {
+        for (std::size_t i = 0; i < surfaceChain.size(); ++i)
+        {
+            assert(std::abs(prices[i] - expectedRefreshedPrices[i]) < 1e-12);
+        }
+    }
+    surfaceContext.setThreadPool(nullptr);
+    
+    // The scenario reference path shifts each contract's own sigma, which surface mode would discard
+    bool rejectedSurfaceScenarios = false;
+    try
+    {
+        stressEngine.runWithContext(surfaceContext, stressScenarios);
+    }
+    catch (const std::invalid_argument&)
+    {
+        rejectedSurfaceScenarios = true;
+    }
+    assert(rejectedSurfaceScenarios);
+    
+    surfaceContext.setVolSurface(nullptr);
+    assert(std::abs(surfaceContext.calculateCallBatch(surfaceChain)[0] - BlackScholesPricer().calculateCallPrice(surfaceChain.at(0))) < 1e-12);
+    
+    std::cout << "Surface vol at T=1, K=90: " << liveSurface->volatility(1.0, 90.0) << ", chain of " << surfaceChain.size()
+              << " re-priced after refresh" << std::endl;
+    
+    std::cout << "Volatility Surface Test Complete" << std::endl;
+    
     std::cout << "\n=== ALL TESTS PASSED ===" << std::endl;
 }
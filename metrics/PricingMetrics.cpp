@@ -0,0 +1,320 @@
+#include "PricingMetrics.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+/*
+    Shard of one recording thread. Only the owning thread writes, with a
+    relaxed load/store pair instead of a locked read-modify-write; readers
+    load relaxed. Shards live until their PricingMetrics is destroyed.
+*/
+struct PricingMetrics::Shard
+{
+    struct Method
+    {
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> failures{0};
+        std::atomic<std::uint64_t> rejected{0};
+        std::atomic<std::uint64_t> options{0};
+        std::atomic<std::uint64_t> latencySum{0};
+        std::atomic<std::uint64_t> latencyMax{0};
+        std::array<std::atomic<std::uint64_t>, MethodMetrics::BatchSizeBuckets> batchSizes{};
+        std::array<std::atomic<std::uint64_t>, LatencyHistogram::BucketCount> latency{};
+    };
+
+    std::array<Method, MetricMethodCount> methods;
+};
+
+namespace
+{
+    std::atomic<std::uint64_t> nextMetricsId{1};
+
+    // Per-thread cache of the shards this thread writes to, keyed by instance id.
+    // Ids are never reused, so entries of destroyed instances simply never match.
+    struct ShardCacheEntry
+    {
+        std::uint64_t owner = 0;
+        void* shard = nullptr;
+    };
+
+    constexpr std::size_t ShardCacheSize = 4;
+    thread_local std::array<ShardCacheEntry, ShardCacheSize> shardCache;
+    thread_local std::size_t shardCacheNext = 0;
+
+    void add(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    std::uint64_t load(const std::atomic<std::uint64_t>& counter)
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    constexpr const char* MethodNames[] = {
+        "CallPrice", "PutPrice", "Gamma", "CallDelta", "PutDelta", "Greeks",
+        "CallVector", "PutVector", "CallDeltaVector", "PutDeltaVector", "GammaVector", "GreeksVector",
+        "CallMatrix", "PutMatrix", "CallDeltaMatrix", "PutDeltaMatrix", "GammaMatrix", "GreeksMatrix",
+        "CallBatch", "PutBatch", "CallDeltaBatch", "PutDeltaBatch", "GammaBatch", "GreeksBatch",
+        "CallSweep", "PutSweep", "CallDeltaSweep", "PutDeltaSweep", "GammaSweep",
+        "ImpliedVolatility", "ImpliedVolatilityBatch", "Parity", "ParityAudit",
+        "Greek", "GreekVector", "GreekMatrix", "GreekBatch"};
+
+    static_assert(std::size(MethodNames) == MetricMethodCount, "Every MetricMethod needs a name");
+}
+
+std::string metricMethodName(MetricMethod method)
+{
+    std::size_t index = static_cast<std::size_t>(method);
+    return index < MetricMethodCount ? MethodNames[index] : "Unknown";
+}
+
+void LatencyHistogram::record(std::uint64_t nanoseconds)
+{
+    ++buckets_[bucketIndex(nanoseconds)];
+    ++count_;
+    sum_ += nanoseconds;
+    max_ = std::max(max_, nanoseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+}
+
+double LatencyHistogram::mean() const
+{
+    return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+}
+
+std::uint64_t LatencyHistogram::valueAtPercentile(double percentile) const
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the requested sample, 1-based, so percentile 0 is the smallest sample
+    double clamped = std::clamp(percentile, 0.0, 100.0);
+    std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(clamped / 100.0 * static_cast<double>(count_) + 0.5));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        seen += buckets_[i];
+        if (seen >= rank)
+        {
+            return std::min(bucketUpperBound(i), max_);
+        }
+    }
+    return max_;
+}
+
+std::uint64_t MetricsSnapshot::totalCalls() const
+{
+    std::uint64_t total = 0;
+    for (const MethodMetrics& method : methods)
+    {
+        total += method.calls;
+    }
+    return total;
+}
+
+std::string MetricsSnapshot::toText() const
+{
+    std::ostringstream text;
+    text << std::left << std::setw(24) << "Method" << std::right
+         << std::setw(12) << "Calls" << std::setw(10) << "Failures" << std::setw(10) << "Rejected"
+         << std::setw(14) << "Options" << std::setw(12) << "Mean (ns)" << std::setw(12) << "p50 (ns)"
+         << std::setw(12) << "p99 (ns)" << std::setw(12) << "Max (ns)" << "\n";
+
+    for (std::size_t i = 0; i < MetricMethodCount; ++i)
+    {
+        const MethodMetrics& method = methods[i];
+        if (method.calls == 0)
+        {
+            continue;
+        }
+        text << std::left << std::setw(24) << MethodNames[i] << std::right
+             << std::setw(12) << method.calls << std::setw(10) << method.failures
+             << std::setw(10) << method.rejectedOptions << std::setw(14) << method.options
+             << std::setw(12) << std::fixed << std::setprecision(1) << method.latency.mean()
+             << std::setw(12) << method.latency.valueAtPercentile(50.0)
+             << std::setw(12) << method.latency.valueAtPercentile(99.0)
+             << std::setw(12) << method.latency.max() << "\n";
+    }
+    return text.str();
+}
+
+std::string MetricsSnapshot::toJson() const
+{
+    std::ostringstream json;
+    json << "{\"methods\": [";
+    bool first = true;
+    for (std::size_t i = 0; i < MetricMethodCount; ++i)
+    {
+        const MethodMetrics& method = methods[i];
+        if (method.calls == 0)
+        {
+            continue;
+        }
+        json << (first ? "" : ", ") << "{\"name\": \"" << MethodNames[i] << "\""
+             << ", \"calls\": " << method.calls
+             << ", \"failures\": " << method.failures
+             << ", \"rejected_options\": " << method.rejectedOptions
+             << ", \"options\": " << method.options
+             << ", \"latency_ns\": {\"mean\": " << method.latency.mean()
+             << ", \"p50\": " << method.latency.valueAtPercentile(50.0)
+             << ", \"p90\": " << method.latency.valueAtPercentile(90.0)
+             << ", \"p99\": " << method.latency.valueAtPercentile(99.0)
+             << ", \"p999\": " << method.latency.valueAtPercentile(99.9)
+             << ", \"max\": " << method.latency.max() << "}"
+             << ", \"batch_sizes\": [";
+        bool firstBucket = true;
+        for (std::size_t b = 0; b < MethodMetrics::BatchSizeBuckets; ++b)
+        {
+            if (method.batchSizes[b] == 0)
+            {
+                continue;
+            }
+            std::uint64_t lower = b == 0 ? 0 : std::uint64_t(1) << (b - 1);
+            json << (firstBucket ? "" : ", ") << "{\"min\": " << lower << ", \"calls\": " << method.batchSizes[b] << "}";
+            firstBucket = false;
+        }
+        json << "]}";
+        first = false;
+    }
+    json << "]}";
+    return json.str();
+}
+
+PricingMetrics::PricingMetrics() : id_(nextMetricsId.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+PricingMetrics::~PricingMetrics() = default;
+
+PricingMetrics::Shard* PricingMetrics::localShard()
+{
+    for (const ShardCacheEntry& entry : shardCache)
+    {
+        if (entry.owner == id_)
+        {
+            return static_cast<Shard*>(entry.shard);
+        }
+    }
+
+    // First record of this thread into this instance (or evicted from the cache)
+    Shard* shard;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<Shard>& owned = shards_[std::this_thread::get_id()];
+        if (!owned)
+        {
+            owned = std::make_unique<Shard>();
+        }
+        shard = owned.get();
+    }
+    shardCache[shardCacheNext] = {id_, shard};
+    shardCacheNext = (shardCacheNext + 1) % ShardCacheSize;
+    return shard;
+}
+
+void PricingMetrics::record(MetricMethod method, std::uint64_t nanoseconds, std::size_t options,
+                            bool failed, std::size_t rejected) noexcept
+{
+    Shard* shard;
+    try
+    {
+        shard = localShard();
+    }
+    catch (...)
+    {
+        return; // No memory for a new shard: drop the sample rather than fail the pricing call
+    }
+
+    Shard::Method& counters = shard->methods[static_cast<std::size_t>(method)];
+    add(counters.calls, 1);
+    add(counters.options, options);
+    if (failed)
+    {
+        add(counters.failures, 1);
+    }
+    if (rejected != 0)
+    {
+        add(counters.rejected, rejected);
+    }
+    add(counters.batchSizes[static_cast<std::size_t>(std::bit_width(options))], 1);
+    add(counters.latency[LatencyHistogram::bucketIndex(nanoseconds)], 1);
+    add(counters.latencySum, nanoseconds);
+    if (nanoseconds > load(counters.latencyMax))
+    {
+        counters.latencyMax.store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+MetricsSnapshot PricingMetrics::snapshot() const
+{
+    MetricsSnapshot snapshot;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [thread, shard] : shards_)
+    {
+        for (std::size_t m = 0; m < MetricMethodCount; ++m)
+        {
+            const Shard::Method& counters = shard->methods[m];
+            MethodMetrics& out = snapshot.methods[m];
+            out.calls += load(counters.calls);
+            out.failures += load(counters.failures);
+            out.rejectedOptions += load(counters.rejected);
+            out.options += load(counters.options);
+            for (std::size_t b = 0; b < MethodMetrics::BatchSizeBuckets; ++b)
+            {
+                out.batchSizes[b] += load(counters.batchSizes[b]);
+            }
+
+            // Count from the buckets so percentiles stay consistent with count()
+            LatencyHistogram& latency = out.latency;
+            for (std::size_t b = 0; b < LatencyHistogram::BucketCount; ++b)
+            {
+                std::uint64_t samples = load(counters.latency[b]);
+                latency.buckets_[b] += samples;
+                latency.count_ += samples;
+            }
+            latency.sum_ += load(counters.latencySum);
+            latency.max_ = std::max(latency.max_, load(counters.latencyMax));
+        }
+    }
+    return snapshot;
+}
+
+void PricingMetrics::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [thread, shard] : shards_)
+    {
+        for (Shard::Method& counters : shard->methods)
+        {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.failures.store(0, std::memory_order_relaxed);
+            counters.rejected.store(0, std::memory_order_relaxed);
+            counters.options.store(0, std::memory_order_relaxed);
+            counters.latencySum.store(0, std::memory_order_relaxed);
+            counters.latencyMax.store(0, std::memory_order_relaxed);
+            for (auto& counter : counters.batchSizes)
+            {
+                counter.store(0, std::memory_order_relaxed);
+            }
+            for (auto& counter : counters.latency)
+            {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
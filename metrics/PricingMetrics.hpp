@@ -0,0 +1,258 @@
+#ifndef PRICINGMETRICS_HPP
+#define PRICINGMETRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief OptionContext entry points that are counted by PricingMetrics
+ *
+ * Returning and out-parameter overloads of the same method share one entry;
+ * ParameterGrid matrices count as the matching sweep.
+ */
+enum class MetricMethod : std::uint8_t
+{
+    CallPrice,
+    PutPrice,
+    Gamma,
+    CallDelta,
+    PutDelta,
+    Greeks,
+    CallVector,
+    PutVector,
+    CallDeltaVector,
+    PutDeltaVector,
+    GammaVector,
+    GreeksVector,
+    CallMatrix,
+    PutMatrix,
+    CallDeltaMatrix,
+    PutDeltaMatrix,
+    GammaMatrix,
+    GreeksMatrix,
+    CallBatch,
+    PutBatch,
+    CallDeltaBatch,
+    PutDeltaBatch,
+    GammaBatch,
+    GreeksBatch,
+    CallSweep,
+    PutSweep,
+    CallDeltaSweep,
+    PutDeltaSweep,
+    GammaSweep,
+    ImpliedVolatility,
+    ImpliedVolatilityBatch,
+    Parity,
+    ParityAudit,
+    Greek,
+    GreekVector,
+    GreekMatrix,
+    GreekBatch,
+    Count
+};
+
+inline constexpr std::size_t MetricMethodCount = static_cast<std::size_t>(MetricMethod::Count);
+
+std::string metricMethodName(MetricMethod method);
+
+/**
+ * @brief Log-linear latency histogram in nanoseconds (HdrHistogram layout)
+ *
+ * Values below 16 ns get one bucket each; above that every power of two is
+ * split into 8 equal sub-buckets, so a reported value is within 12.5 % of the
+ * recorded one over the whole 64-bit range with 496 counters.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t SubBucketBits = 3;
+    static constexpr std::size_t SubBuckets = std::size_t(1) << SubBucketBits;
+    static constexpr std::size_t LinearLimit = 2 * SubBuckets;    // 16: one bucket per nanosecond below this
+    static constexpr std::size_t BucketCount = LinearLimit + (64 - 4) * SubBuckets;
+
+    static constexpr std::size_t bucketIndex(std::uint64_t nanoseconds)
+    {
+        if (nanoseconds < LinearLimit)
+        {
+            return static_cast<std::size_t>(nanoseconds);
+        }
+        std::size_t exponent = static_cast<std::size_t>(std::bit_width(nanoseconds)) - 1;   // >= 4
+        std::size_t sub = static_cast<std::size_t>(nanoseconds >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+        return LinearLimit + (exponent - 4) * SubBuckets + sub;
+    }
+
+    // Largest value that falls into the bucket
+    static constexpr std::uint64_t bucketUpperBound(std::size_t index)
+    {
+        if (index < LinearLimit)
+        {
+            return index;
+        }
+        std::size_t exponent = (index - LinearLimit) / SubBuckets + 4;
+        std::uint64_t sub = (index - LinearLimit) % SubBuckets;
+        std::uint64_t width = std::uint64_t(1) << (exponent - SubBucketBits);
+        return (SubBuckets + sub) * width + (width - 1);
+    }
+
+    void record(std::uint64_t nanoseconds);
+    void merge(const LatencyHistogram& other);
+
+    std::uint64_t count() const { return count_; };
+    std::uint64_t max() const { return max_; };
+    double mean() const;
+    // Upper bound of the bucket holding the given percentile (0-100), capped at max(); 0 when empty
+    std::uint64_t valueAtPercentile(double percentile) const;
+
+    const std::array<std::uint64_t, BucketCount>& buckets() const { return buckets_; };
+
+private:
+    friend class PricingMetrics;
+
+    std::array<std::uint64_t, BucketCount> buckets_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t sum_ = 0;
+    std::uint64_t max_ = 0;
+};
+
+/**
+ * @brief Counters of one method, summed over all threads
+ */
+struct MethodMetrics
+{
+    // batchSizes[i] counts calls with a batch of [2^(i-1), 2^i) options (batchSizes[0]: empty batches)
+    static constexpr std::size_t BatchSizeBuckets = 65;
+
+    std::uint64_t calls = 0;
+    std::uint64_t failures = 0;            // Calls that ended with an exception
+    std::uint64_t rejectedOptions = 0;     // Options refused by isValid() or input checks
+    std::uint64_t options = 0;             // Options handled, over all calls
+    std::array<std::uint64_t, BatchSizeBuckets> batchSizes{};
+    LatencyHistogram latency;
+};
+
+/**
+ * @brief Point-in-time copy of all counters, with text and JSON rendering
+ */
+struct MetricsSnapshot
+{
+    std::array<MethodMetrics, MetricMethodCount> methods{};
+
+    const MethodMetrics& operator [] (MetricMethod method) const { return methods[static_cast<std::size_t>(method)]; };
+    std::uint64_t totalCalls() const;
+
+    std::string toText() const;   // One line per method that was called
+    std::string toJson() const;
+};
+
+/**
+ * @brief Opt-in call, latency, batch size and rejection counters of OptionContext
+ *
+ * Every recording thread owns a shard of counters and is the only writer to
+ * it, so the hot path is a thread-local lookup plus plain relaxed stores: no
+ * locks and no contended cache lines. snapshot() sums the shards; it may run
+ * concurrently with recording and then sees each counter at some recent value.
+ * A mutex is taken only the first time a thread records into this object.
+ *
+ * Attach one instance to a context with OptionContext::setMetrics(); the same
+ * instance may be shared by several contexts. Without it the context pays one
+ * null-pointer test per call. Building without OPTION_PRICER_METRICS compiles
+ * the recording out entirely.
+ */
+class PricingMetrics
+{
+public:
+    PricingMetrics();
+    ~PricingMetrics();
+
+    PricingMetrics(const PricingMetrics&) = delete;
+    PricingMetrics& operator = (const PricingMetrics&) = delete;
+
+    void record(MetricMethod method, std::uint64_t nanoseconds, std::size_t options,
+                bool failed, std::size_t rejected) noexcept;
+
+    MetricsSnapshot snapshot() const;
+    void reset();   // Samples recorded while resetting may survive it
+
+    // True when recording is compiled in (OPTION_PRICER_METRICS)
+    static constexpr bool compiledIn()
+    {
+#ifdef OPTION_PRICER_METRICS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    struct Shard;
+
+    Shard* localShard();
+
+    const std::uint64_t id_;   // Distinguishes instances in the per-thread shard cache
+    mutable std::mutex mutex_;
+    std::unordered_map<std::thread::id, std::unique_ptr<Shard>> shards_;
+};
+
+/**
+ * @brief RAII timer of one OptionContext call
+ *
+ * Inactive (and free apart from the null test) when the context has no
+ * metrics attached. A call that leaves through an exception counts as a failure.
+ */
+class MetricsScope
+{
+public:
+#ifdef OPTION_PRICER_METRICS
+    MetricsScope(PricingMetrics* metrics, MetricMethod method, std::size_t options) noexcept
+        : metrics_(metrics), method_(method), options_(options)
+    {
+        if (metrics_) [[unlikely]]
+        {
+            exceptions_ = std::uncaught_exceptions();
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~MetricsScope()
+    {
+        if (metrics_) [[unlikely]]
+        {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+            metrics_->record(method_, static_cast<std::uint64_t>(elapsed.count()), options_,
+                             std::uncaught_exceptions() > exceptions_, rejected_);
+        }
+    }
+
+    void reject(std::size_t count = 1) noexcept { rejected_ += count; };
+#else
+    MetricsScope(PricingMetrics*, MetricMethod, std::size_t) noexcept {};
+    void reject(std::size_t = 1) noexcept {};
+#endif
+
+    MetricsScope(const MetricsScope&) = delete;
+    MetricsScope& operator = (const MetricsScope&) = delete;
+
+private:
+#ifdef OPTION_PRICER_METRICS
+    PricingMetrics* metrics_;
+    MetricMethod method_;
+    std::size_t options_;
+    std::size_t rejected_ = 0;
+    int exceptions_ = 0;
+    std::chrono::steady_clock::time_point start_;
+#endif
+};
+
+#endif // PRICINGMETRICS_HPP
@@ -0,0 +1,285 @@
+#include "ScenarioEngine.hpp"
+#include "OptionBook.hpp"
+#include "OptionContext.hpp"
+#include "OptionBatch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+std::vector<Scenario> scenarioGrid(std::span<const double> spotShifts, std::span<const double> volShifts,
+                                   std::span<const double> rateShifts)
+{
+    std::vector<Scenario> scenarios;
+    scenarios.reserve(spotShifts.size() * volShifts.size() * rateShifts.size());
+    for (double rate : rateShifts)
+    {
+        for (double vol : volShifts)
+        {
+            for (double spot : spotShifts)
+            {
+                scenarios.push_back({spot, vol, rate});
+            }
+        }
+    }
+    return scenarios;
+}
+
+ScenarioEngine::ScenarioEngine(std::span<const Option> options, std::span<const OptionType> types,
+                               std::span<const double> quantities, NormalCdfMode cdfMode)
+    : cdfMode_(cdfMode)
+{
+    std::size_t n = options.size();
+    if (types.size() != n || quantities.size() != n)
+    {
+        throw std::invalid_argument("Scenario engine needs one type and one quantity per option.");
+    }
+
+    for (std::vector<double>* column : {&T_, &K_, &sig_, &r_, &S_, &b_, &quantity_, &sign_, &logMoneyness_,
+                                        &sqrtT_, &carriedSpot_, &discountedStrike_, &basePrice_})
+    {
+        column->resize(n);
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Option& option = options[i];
+        if (!option.isValid())
+        {
+            throw std::invalid_argument("Scenario engine option " + std::to_string(i) + " is invalid: " + option.toString());
+        }
+        T_[i] = option.ExerciseDate();
+        K_[i] = option.StrikePrice();
+        sig_[i] = option.Volatility();
+        r_[i] = option.RiskFreeRate();
+        S_[i] = option.AssetPrice();
+        b_[i] = option.CostOfCarry();
+        quantity_[i] = quantities[i];
+        sign_[i] = types[i] == OptionType::Call ? 1.0 : -1.0;
+
+        logMoneyness_[i] = std::log(S_[i] / K_[i]);
+        sqrtT_[i] = std::sqrt(T_[i]);
+        carriedSpot_[i] = S_[i] * std::exp((b_[i] - r_[i]) * T_[i]);
+        discountedStrike_[i] = K_[i] * std::exp(-r_[i] * T_[i]);
+    }
+
+    // Base prices go through the same kernel as the scenarios, so a null scenario gives exactly zero P&L
+    for (std::size_t begin = 0; begin < n; begin += BlockSize)
+    {
+        std::size_t count = std::min(BlockSize, n - begin);
+        double moneyness[BlockSize], sigSqrtT[BlockSize], strike[BlockSize];
+        factorise(begin, count, 0.0, 0.0, moneyness, sigSqrtT, strike);
+        FactorisedBatch batch{moneyness, sigSqrtT, carriedSpot_.data() + begin, strike, sign_.data() + begin, count};
+        evaluateBlackScholesFactorised(batch, 1.0, std::span<double>(basePrice_).subspan(begin, count), simdLevel_, cdfMode_);
+    }
+}
+
+namespace
+{
+    std::vector<Option> bookOptions(const OptionBook& book)
+    {
+        std::vector<Option> options;
+        options.reserve(book.size());
+        for (std::size_t p = 0; p < book.size(); ++p)
+        {
+            options.push_back(book.option(p));
+        }
+        return options;
+    }
+
+    std::vector<OptionType> bookTypes(const OptionBook& book)
+    {
+        std::vector<OptionType> types(book.size());
+        for (std::size_t p = 0; p < book.size(); ++p)
+        {
+            types[p] = book.type(p);
+        }
+        return types;
+    }
+
+    std::vector<double> bookQuantities(const OptionBook& book)
+    {
+        std::vector<double> quantities(book.size());
+        for (std::size_t p = 0; p < book.size(); ++p)
+        {
+            quantities[p] = book.quantity(p);
+        }
+        return quantities;
+    }
+
+    void validateScenarios(std::span<const Scenario> scenarios)
+    {
+        for (std::size_t s = 0; s < scenarios.size(); ++s)
+        {
+            const Scenario& scenario = scenarios[s];
+            if (!(scenario.spotShift > -1.0) || !std::isfinite(scenario.spotShift)
+                || !std::isfinite(scenario.volShift) || !std::isfinite(scenario.rateShift))
+            {
+                throw std::invalid_argument("Scenario " + std::to_string(s)
+                                            + " needs finite shifts and a spot shift above -100%.");
+            }
+        }
+    }
+}
+
+ScenarioEngine::ScenarioEngine(const OptionBook& book, NormalCdfMode cdfMode)
+    : ScenarioEngine(bookOptions(book), bookTypes(book), bookQuantities(book), cdfMode)
+{
+}
+
+void ScenarioEngine::setParallelChunkSize(std::size_t chunkSize)
+{
+    if (chunkSize == 0)
+    {
+        throw std::invalid_argument("Parallel chunk size must be positive.");
+    }
+    parallelChunkSize_ = chunkSize;
+}
+
+double ScenarioEngine::baseValue() const
+{
+    return std::inner_product(quantity_.begin(), quantity_.end(), basePrice_.begin(), 0.0);
+}
+
+void ScenarioEngine::factorise(std::size_t begin, std::size_t count, double volShift, double rateShift,
+                               double* moneyness, double* sigSqrtT, double* discountedStrike) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t c = begin + i;
+        double sig = sig_[c] + volShift;
+        moneyness[i] = logMoneyness_[c] + (b_[c] + rateShift + 0.5 * sig * sig) * T_[c];
+        sigSqrtT[i] = sig > 0.0 ? sig * sqrtT_[c] : std::numeric_limits<double>::quiet_NaN();
+        discountedStrike[i] = rateShift == 0.0 ? discountedStrike_[c] : discountedStrike_[c] * std::exp(-rateShift * T_[c]);
+    }
+}
+
+void ScenarioEngine::evaluateRange(std::span<const Scenario> scenarios, std::span<const ScenarioGroup> groups,
+                                   std::size_t begin, std::size_t end, Grid<double>& out) const
+{
+    double moneyness[BlockSize], sigSqrtT[BlockSize], strike[BlockSize], prices[BlockSize];
+    for (std::size_t blockBegin = begin; blockBegin < end; blockBegin += BlockSize)
+    {
+        std::size_t count = std::min(BlockSize, end - blockBegin);
+        for (const ScenarioGroup& group : groups)
+        {
+            factorise(blockBegin, count, group.volShift, group.rateShift, moneyness, sigSqrtT, strike);
+            FactorisedBatch batch{moneyness, sigSqrtT, carriedSpot_.data() + blockBegin, strike,
+                                  sign_.data() + blockBegin, count};
+            for (std::size_t s : group.scenarios)
+            {
+                evaluateBlackScholesFactorised(batch, 1.0 + scenarios[s].spotShift, std::span<double>(prices, count),
+                                               simdLevel_, cdfMode_);
+                double* pnl = out.row(s).data() + blockBegin;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    pnl[i] = quantity_[blockBegin + i] * (prices[i] - basePrice_[blockBegin + i]);
+                }
+            }
+        }
+    }
+}
+
+Grid<double> ScenarioEngine::run(std::span<const Scenario> scenarios) const
+{
+    Grid<double> pnl;
+    run(scenarios, pnl);
+    return pnl;
+}
+
+void ScenarioEngine::run(std::span<const Scenario> scenarios, Grid<double>& out) const
+{
+    validateScenarios(scenarios);
+
+    // Group by (volatility, rate) shift, keeping first-seen order
+    std::vector<ScenarioGroup> groups;
+    for (std::size_t s = 0; s < scenarios.size(); ++s)
+    {
+        auto found = std::find_if(groups.begin(), groups.end(), [&](const ScenarioGroup& group)
+        {
+            return group.volShift == scenarios[s].volShift && group.rateShift == scenarios[s].rateShift;
+        });
+        if (found == groups.end())
+        {
+            groups.push_back({scenarios[s].volShift, scenarios[s].rateShift, {}});
+            found = groups.end() - 1;
+        }
+        found->scenarios.push_back(s);
+    }
+
+    if (out.rows() != scenarios.size() || out.cols() != size())
+    {
+        out.resize(scenarios.size(), size());
+    }
+
+    if (threadPool_)
+    {
+        threadPool_->parallelFor(size(), parallelChunkSize_, [&](std::size_t begin, std::size_t end)
+        {
+            evaluateRange(scenarios, groups, begin, end, out);
+        });
+    }
+    else
+    {
+        evaluateRange(scenarios, groups, 0, size(), out);
+    }
+}
+
+Grid<double> ScenarioEngine::runWithContext(const OptionContext& context, std::span<const Scenario> scenarios) const
+{
+    validateScenarios(scenarios);
+    if (context.getVolSurface())
+    {
+        // Surface mode replaces every batch's sigma, which would drop the volatility shifts
+        throw std::invalid_argument("Scenario reference path needs a context without a volatility surface.");
+    }
+
+    std::size_t n = size();
+    OptionBatch bumped(n);
+    std::vector<double> calls(n), puts(n), base(n);
+    Grid<double> pnl(scenarios.size(), n);
+
+    auto price = [&](const Scenario& scenario, std::span<double> out)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            bumped.ExerciseDates()[i] = T_[i];
+            bumped.StrikePrices()[i] = K_[i];
+            bumped.Volatilities()[i] = sig_[i] + scenario.volShift;
+            bumped.RiskFreeRates()[i] = r_[i] + scenario.rateShift;
+            bumped.AssetPrices()[i] = S_[i] * (1.0 + scenario.spotShift);
+            bumped.CostsOfCarry()[i] = b_[i] + scenario.rateShift;
+        }
+        context.calculateCallBatch(bumped, calls);
+        context.calculatePutBatch(bumped, puts);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            out[i] = sign_[i] > 0.0 ? calls[i] : puts[i];
+        }
+    };
+
+    price(Scenario(), base);
+    for (std::size_t s = 0; s < scenarios.size(); ++s)
+    {
+        std::span<double> row = pnl.row(s);
+        price(scenarios[s], row);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            row[i] = quantity_[i] * (row[i] - base[i]);
+        }
+    }
+    return pnl;
+}
+
+std::vector<double> ScenarioEngine::totals(const Grid<double>& pnl)
+{
+    std::vector<double> sums(pnl.rows());
+    for (std::size_t s = 0; s < pnl.rows(); ++s)
+    {
+        std::span<const double> row = pnl.row(s);
+        sums[s] = std::accumulate(row.begin(), row.end(), 0.0);
+    }
+    return sums;
+}
@@ -0,0 +1,116 @@
+#ifndef SCENARIOENGINE_HPP
+#define SCENARIOENGINE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+#include "Option.hpp"
+#include "Grid.hpp"
+#include "ThreadPool.hpp"
+#include "NormalDistribution.hpp"
+#include "BlackScholesKernels.hpp"
+
+class OptionBook;
+class OptionContext;
+
+/*
+    @brief One market scenario applied to every contract of a book
+    The rate shift moves r and b together (b = r - q with the yield q held
+    fixed), so the carry factor e^((b-r)T) of a contract never changes.
+*/
+struct Scenario
+{
+    double spotShift = 0.0;   // Relative: 0.05 is spot +5%, must be above -1
+    double volShift = 0.0;    // Absolute: 0.01 is +1 vol point
+    double rateShift = 0.0;   // Absolute: 0.0025 is +25 bp
+};
+
+// Every combination of the shifts, spot varying fastest, then volatility, then rate
+std::vector<Scenario> scenarioGrid(std::span<const double> spotShifts, std::span<const double> volShifts,
+                                   std::span<const double> rateShifts);
+
+/**
+ * @brief Stress-test engine: P&L of a book of European options under many scenarios
+ *
+ * The contracts are factorised once at construction: ln(S/K), sqrt(T), the
+ * carried spot S e^((b-r)T), the discounted strike K e^(-rT) and the base
+ * price. run() groups the scenarios by their (volatility, rate) shift; per
+ * group and contract only sig sqrt(T), the d1 numerator and, for a rate
+ * shift, the discount factor are refreshed, and each spot shock of the group
+ * then just adds ln(1 + shift) to the numerator before the SIMD factorised
+ * kernel (evaluateBlackScholesFactorised) prices the contracts.
+ *
+ * Contracts are processed in blocks whose factorised columns live on the
+ * stack and are reused by every scenario; with a thread pool the blocks run
+ * in parallel. Results do not depend on the thread count. Prices follow the
+ * generalised Black-Scholes formulas of BlackScholesPricer; a scenario
+ * pushing a volatility to zero or below gives NaN for those contracts.
+ */
+class ScenarioEngine
+{
+public:
+
+    ScenarioEngine(std::span<const Option> options, std::span<const OptionType> types,
+                   std::span<const double> quantities, NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+    explicit ScenarioEngine(const OptionBook& book, NormalCdfMode cdfMode = NormalCdfMode::Accurate);
+
+    // Parallelism over contract ranges of parallelChunkSize contracts (single-threaded when unset)
+    void setThreadPool(std::shared_ptr<ThreadPool> pool) { threadPool_ = std::move(pool); };
+    void setParallelChunkSize(std::size_t chunkSize);
+
+    std::size_t size() const { return T_.size(); };
+    std::span<const double> basePrices() const { return basePrice_; };   // Per contract
+    double baseValue() const;                                            // Quantities included
+
+    // P&L (quantity included) of each contract under each scenario: one row per
+    // scenario, one column per contract. The out overload reuses the grid's storage.
+    Grid<double> run(std::span<const Scenario> scenarios) const;
+    void run(std::span<const Scenario> scenarios, Grid<double>& out) const;
+
+    // Reference path for any strategy: rebuild each scenario's options and price
+    // them through the context's batch API, without any factorisation. Contexts in
+    // surface mode are rejected: they would price every scenario at the surface vols.
+    Grid<double> runWithContext(const OptionContext& context, std::span<const Scenario> scenarios) const;
+
+    // Book P&L per scenario: the row sums of a P&L grid
+    static std::vector<double> totals(const Grid<double>& pnl);
+
+private:
+
+    // Contracts per stack block inside a parallel chunk
+    static constexpr std::size_t BlockSize = 256;
+
+    // Scenarios sharing a volatility and rate shift
+    struct ScenarioGroup
+    {
+        double volShift;
+        double rateShift;
+        std::vector<std::size_t> scenarios;
+    };
+
+    // d1 numerator, sig sqrt(T) and discounted strike of contracts [begin, begin + count) under the shifts
+    void factorise(std::size_t begin, std::size_t count, double volShift, double rateShift,
+                   double* moneyness, double* sigSqrtT, double* discountedStrike) const;
+    void evaluateRange(std::span<const Scenario> scenarios, std::span<const ScenarioGroup> groups,
+                       std::size_t begin, std::size_t end, Grid<double>& out) const;
+
+    // Contract terms
+    std::vector<double> T_, K_, sig_, r_, S_, b_;
+    std::vector<double> quantity_;
+    std::vector<double> sign_;               // +1 call, -1 put
+
+    // Scenario-independent invariants
+    std::vector<double> logMoneyness_;       // ln(S/K)
+    std::vector<double> sqrtT_;
+    std::vector<double> carriedSpot_;        // S e^((b-r)T)
+    std::vector<double> discountedStrike_;   // K e^(-rT)
+    std::vector<double> basePrice_;
+
+    NormalCdfMode cdfMode_;
+    SimdLevel simdLevel_ = detectSimdLevel();
+    std::shared_ptr<ThreadPool> threadPool_;
+    std::size_t parallelChunkSize_ = 4096;
+};
+
+#endif // SCENARIOENGINE_HPP
@@ -0,0 +1,166 @@
+#ifndef BLACKSCHOLESFORMULA_HPP
+#define BLACKSCHOLESFORMULA_HPP
+
+#include <cmath>
+#include <boost/math/distributions/normal.hpp>
+#include "Option.hpp"
+#include "NormalDistribution.hpp"
+
+/*
+    Header-only generalised Black-Scholes formulas with the option side, the
+    carry model and the normal CDF fixed at compile time. Every branch on
+    those choices folds away, so a loop over these functions inlines into one
+    straight-line body: b = r drops the carry factor e^((b-r)T) entirely and
+    b = 0 reuses the discount factor for it.
+
+    Same formulas as BlackScholesPricer: with CarryModel::Currency (the
+    option's own b) and the matching CDF the results agree to rounding.
+*/
+
+// Normal CDF of the selected implementation
+template <NormalCdfMode Cdf>
+inline double normalCdf(double x)
+{
+    if constexpr (Cdf == NormalCdfMode::Boost)
+    {
+        static const boost::math::normal_distribution<double> standardNormal(0.0, 1.0);
+        return boost::math::cdf(standardNormal, x);
+    }
+    else if constexpr (Cdf == NormalCdfMode::Fast)
+    {
+        return normalCdfFast(x);
+    }
+    else
+    {
+        return normalCdfAccurate(x);
+    }
+}
+
+// Cost of carry b of the option under the carry model
+template <CarryModel Carry>
+inline double costOfCarry(const Option& option)
+{
+    if constexpr (Carry == CarryModel::Stock)
+    {
+        return option.RiskFreeRate();
+    }
+    else if constexpr (Carry == CarryModel::Futures)
+    {
+        return 0.0;
+    }
+    else
+    {
+        return option.CostOfCarry();
+    }
+}
+
+// Carry factor e^((b-r)T) under the carry model; discount is e^(-rT), only read for futures
+template <CarryModel Carry>
+inline double carryFactor(const Option& option, double discount)
+{
+    if constexpr (Carry == CarryModel::Stock)
+    {
+        return 1.0;
+    }
+    else if constexpr (Carry == CarryModel::Futures)
+    {
+        return discount;
+    }
+    else
+    {
+        return std::exp((option.CostOfCarry() - option.RiskFreeRate()) * option.ExerciseDate());
+    }
+}
+
+/**
+ * @brief Generalised Black-Scholes price
+ *
+ * C = S e^((b-r)T) N(d1) - K e^(-rT) N(d2), P = K e^(-rT) N(-d2) - S e^((b-r)T) N(-d1)
+ */
+template <OptionType Type, CarryModel Carry = CarryModel::Currency, NormalCdfMode Cdf = NormalCdfMode::Accurate>
+inline double blackScholesPrice(const Option& option)
+{
+    double T = option.ExerciseDate();
+    double sig = option.Volatility();
+    double sigSqrtT = sig * std::sqrt(T);
+    double d1 = (std::log(option.AssetPrice() / option.StrikePrice()) + (costOfCarry<Carry>(option) + 0.5 * sig * sig) * T) / sigSqrtT;
+    double d2 = d1 - sigSqrtT;
+
+    double discount = std::exp(-option.RiskFreeRate() * T);
+    double carried = option.AssetPrice() * carryFactor<Carry>(option, discount);
+    double strike = option.StrikePrice() * discount;
+    if constexpr (Type == OptionType::Call)
+    {
+        return carried * normalCdf<Cdf>(d1) - strike * normalCdf<Cdf>(d2);
+    }
+    else
+    {
+        return strike * normalCdf<Cdf>(-d2) - carried * normalCdf<Cdf>(-d1);
+    }
+}
+
+/**
+ * @brief Generalised Black-Scholes delta: e^((b-r)T) N(d1) for calls, e^((b-r)T) (N(d1) - 1) for puts
+ */
+template <OptionType Type, CarryModel Carry = CarryModel::Currency, NormalCdfMode Cdf = NormalCdfMode::Accurate>
+inline double blackScholesDelta(const Option& option)
+{
+    double T = option.ExerciseDate();
+    double sig = option.Volatility();
+    double d1 = (std::log(option.AssetPrice() / option.StrikePrice()) + (costOfCarry<Carry>(option) + 0.5 * sig * sig) * T) / (sig * std::sqrt(T));
+
+    double carry = carryFactor<Carry>(option, Carry == CarryModel::Futures ? std::exp(-option.RiskFreeRate() * T) : 1.0);
+    if constexpr (Type == OptionType::Call)
+    {
+        return carry * normalCdf<Cdf>(d1);
+    }
+    else
+    {
+        return carry * (normalCdf<Cdf>(d1) - 1.0);
+    }
+}
+
+/**
+ * @brief Generalised Black-Scholes gamma e^((b-r)T) n(d1) / (S sig sqrt(T)), equal for calls and puts
+ */
+template <CarryModel Carry = CarryModel::Currency>
+inline double blackScholesGamma(const Option& option)
+{
+    double T = option.ExerciseDate();
+    double sig = option.Volatility();
+    double sigSqrtT = sig * std::sqrt(T);
+    double d1 = (std::log(option.AssetPrice() / option.StrikePrice()) + (costOfCarry<Carry>(option) + 0.5 * sig * sig) * T) / sigSqrtT;
+
+    double carry = carryFactor<Carry>(option, Carry == CarryModel::Futures ? std::exp(-option.RiskFreeRate() * T) : 1.0);
+    return carry * normalPdf(d1) / (option.AssetPrice() * sigSqrtT);
+}
+
+/**
+ * @brief Generalised Black-Scholes price over any arithmetic type
+ *
+ * Real needs the arithmetic operators and exp, log and sqrt found by argument
+ * lookup (double, or AdjointDouble to record the evaluation on a tape); cdf(x)
+ * returns N(x) as a Real. Same formula as blackScholesPrice with the option's own b.
+ */
+template <typename Real, typename Cdf>
+inline Real blackScholesValue(OptionType type, const Real& T, const Real& K, const Real& sig, const Real& r,
+                              const Real& S, const Real& b, const Cdf& cdf)
+{
+    using std::exp;
+    using std::log;
+    using std::sqrt;
+
+    Real sigSqrtT = sig * sqrt(T);
+    Real d1 = (log(S / K) + (b + 0.5 * sig * sig) * T) / sigSqrtT;
+    Real d2 = d1 - sigSqrtT;
+
+    Real carried = S * exp((b - r) * T);
+    Real strike = K * exp(-r * T);
+    if (type == OptionType::Call)
+    {
+        return carried * cdf(d1) - strike * cdf(d2);
+    }
+    return strike * cdf(-d2) - carried * cdf(-d1);
+}
+
+#endif // BLACKSCHOLESFORMULA_HPP
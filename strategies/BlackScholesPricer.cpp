@@ -1,16 +1,26 @@
 #include "BlackScholesPricer.hpp"
+#include "BlackScholesFormula.hpp"
+#include "AdjointTape.hpp"
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
 #include <boost/math/distributions/normal.hpp>
 
+BlackScholesPricer::BlackScholesPricer(NormalCdfMode cdfMode) : cdfMode_(cdfMode)
+{
+}
+
 double BlackScholesPricer::calculateCallPrice(const Option& option) const
 {
     // receive d1 and d2 use structure binding syntax
     auto [d1, d2] = calculateD1D2(option);
     
-    // Black-Scholes call formula: C = S*N(d1) - K*e^(-r*T)*N(d2)
-    // For stock options without dividends, no dividend adjustment needed
-    return (option.AssetPrice() * N(d1)) -
-           (option.StrikePrice() * std::exp(-option.RiskFreeRate() * option.ExerciseDate()) * N(d2));
+    // Generalised Black-Scholes call formula: C = S*e^((b-r)*T)*N(d1) - K*e^(-r*T)*N(d2)
+    // For stock options b = r, so the carry factor e^((b-r)*T) is 1
+    double b = option.CostOfCarry();
+    double T = option.ExerciseDate();
+    return (option.AssetPrice() * std::exp((b - option.RiskFreeRate()) * T) * N(d1)) -
+           (option.StrikePrice() * std::exp(-option.RiskFreeRate() * T) * N(d2));
 }
 
 double BlackScholesPricer::calculatePutPrice(const Option& option) const
@@ -18,10 +28,12 @@ double BlackScholesPricer::calculatePutPrice(const Option& option) const
     // receive d1 and d2 use structure binding syntax
     auto [d1, d2] = calculateD1D2(option);
     
-    // Black-Scholes put formula: P = K*e^(-r*T)*N(-d2) - S*e^(-q*T)*N(-d1)
-    // For stock options without dividends, q = 0, so e^(-q*T) = 1
-    return (option.StrikePrice() * std::exp(-option.RiskFreeRate() * option.ExerciseDate()) * N(-d2)) -
-           (option.AssetPrice() * N(-d1));
+    // Generalised Black-Scholes put formula: P = K*e^(-r*T)*N(-d2) - S*e^((b-r)*T)*N(-d1)
+    // For stock options b = r, so the carry factor e^((b-r)*T) is 1
+    double b = option.CostOfCarry();
+    double T = option.ExerciseDate();
+    return (option.StrikePrice() * std::exp(-option.RiskFreeRate() * T) * N(-d2)) -
+           (option.AssetPrice() * std::exp((b - option.RiskFreeRate()) * T) * N(-d1));
 }
 
 std::string BlackScholesPricer::getName() const
@@ -31,52 +43,12 @@ std::string BlackScholesPricer::getName() const
 
 std::vector<double> BlackScholesPricer::calculateCallVector(const std::vector<Option>& options) const
 {
-    std::vector<double> callPrices;
-    callPrices.reserve(options.size());
-    
-    for (const auto& option : options) {
-        callPrices.push_back(calculateCallPrice(option));
-    }
-    
-    return callPrices;
+    return evaluateVector(options, &IPricingStrategy::calculateCallVector);
 }
 
 std::vector<double> BlackScholesPricer::calculatePutVector(const std::vector<Option>& options) const
 {
-    std::vector<double> putPrices;
-    putPrices.reserve(options.size());
-    
-    for (const auto& option : options) {
-        putPrices.push_back(calculatePutPrice(option));
-    }
-    
-    return putPrices;
-}
-
-std::vector<std::vector<double>> BlackScholesPricer::calculateCallMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
-{
-    std::vector<std::vector<double>> callMatrix;
-    callMatrix.reserve(optionMatrix.size());
-    
-    for (const auto& optionRow : optionMatrix) {
-        callMatrix.push_back(calculateCallVector(optionRow));
-    }
-    
-    return callMatrix;
-}
-
-std::vector<std::vector<double>> BlackScholesPricer::calculatePutMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
-{
-    std::vector<std::vector<double>> putMatrix;
-    putMatrix.reserve(optionMatrix.size());
-    
-    for (const auto& optionRow : optionMatrix) {
-        putMatrix.push_back(calculatePutVector(optionRow));
-    }
-    
-    return putMatrix;
+    return evaluateVector(options, &IPricingStrategy::calculatePutVector);
 }
 
 bool BlackScholesPricer::supportsGreeks() const
@@ -86,13 +58,14 @@ bool BlackScholesPricer::supportsGreeks() const
 
 double BlackScholesPricer::calculateGamma(const Option& option) const
 {
-    // Gamma formula: Γ = n(d1) / (S * σ * √T)
+    // Gamma formula: Γ = e^((b-r)*T) * n(d1) / (S * σ * √T)
     // Gamma is the same for both calls and puts
     auto [d1, d2] = calculateD1D2(option);
     
+    double b = option.CostOfCarry();
     double denominator = option.AssetPrice() * option.Volatility() * std::sqrt(option.ExerciseDate());
     
-    return n(d1) / denominator;
+    return std::exp((b - option.RiskFreeRate()) * option.ExerciseDate()) * n(d1) / denominator;
 }
 
 double BlackScholesPricer::calculateCallDelta(const Option& option) const
@@ -113,85 +86,205 @@ double BlackScholesPricer::calculatePutDelta(const Option& option) const
     return std::exp((b - option.RiskFreeRate()) * option.ExerciseDate()) * (N(d1) - 1.0);
 }
 
-std::vector<double> BlackScholesPricer::calculateCallDeltaVector(const std::vector<Option>& options) const
+namespace
 {
-    std::vector<double> callDeltas;
-    callDeltas.reserve(options.size());
-    
-    for (const auto& option : options)
+    // One tape per thread, so pooled batch calls never share it; its arena is reused by every option
+    AdjointTape& adjointTape()
     {
-        callDeltas.push_back(calculateCallDelta(option));
+        thread_local AdjointTape tape(64);
+        return tape;
     }
-    
-    return callDeltas;
 }
 
-std::vector<double> BlackScholesPricer::calculatePutDeltaVector(const std::vector<Option>& options) const
+AdjointResult BlackScholesPricer::calculateAdjoint(const Option& option, OptionType type) const
 {
-    std::vector<double> putDeltas;
-    putDeltas.reserve(options.size());
-    
-    for (const auto& option : options)
+    AdjointTape& tape = adjointTape();
+    tape.reset();
+    AdjointDouble T = tape.variable(option.ExerciseDate());
+    AdjointDouble K = tape.variable(option.StrikePrice());
+    AdjointDouble sig = tape.variable(option.Volatility());
+    AdjointDouble r = tape.variable(option.RiskFreeRate());
+    AdjointDouble S = tape.variable(option.AssetPrice());
+    AdjointDouble b = tape.variable(option.CostOfCarry());
+
+    // Values from the selected CDF implementation, partials from the exact density
+    AdjointDouble price = blackScholesValue(type, T, K, sig, r, S, b, [this](const AdjointDouble& x)
     {
-        putDeltas.push_back(calculatePutDelta(option));
-    }
-    
-    return putDeltas;
+        return normalCdf(x, N(x.value()));
+    });
+    tape.gradient(price);
+
+    return {price.value(), tape.adjoint(T), tape.adjoint(K), tape.adjoint(sig),
+            tape.adjoint(r), tape.adjoint(S), tape.adjoint(b)};
 }
 
-std::vector<double> BlackScholesPricer::calculateGammaVector(const std::vector<Option>& options) const
+void BlackScholesPricer::calculateAdjointBatch(const OptionBatchView& batch, OptionType type,
+                                               std::span<AdjointResult> out) const
 {
-    std::vector<double> gammas;
-    gammas.reserve(options.size());
-    
-    for (const auto& option : options)
+    if (out.size() != batch.size)
     {
-        gammas.push_back(calculateGamma(option));
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+    for (std::size_t i = 0; i < batch.size; ++i)
+    {
+        out[i] = calculateAdjoint(batch.option(i), type);
     }
-    
-    return gammas;
 }
 
-std::vector<std::vector<double>> BlackScholesPricer::calculateCallDeltaMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
+std::vector<double> BlackScholesPricer::calculateCallDeltaVector(const std::vector<Option>& options) const
 {
-    std::vector<std::vector<double>> deltaMatrix;
-    deltaMatrix.reserve(optionMatrix.size());
-    
-    for (const auto& optionRow : optionMatrix)
-    {
-        deltaMatrix.push_back(calculateCallDeltaVector(optionRow));
-    }
-    
-    return deltaMatrix;
+    return evaluateVector(options, &IPricingStrategy::calculateCallDeltaVector);
+}
+
+std::vector<double> BlackScholesPricer::calculatePutDeltaVector(const std::vector<Option>& options) const
+{
+    return evaluateVector(options, &IPricingStrategy::calculatePutDeltaVector);
+}
+
+std::vector<double> BlackScholesPricer::calculateGammaVector(const std::vector<Option>& options) const
+{
+    return evaluateVector(options, &IPricingStrategy::calculateGammaVector);
 }
 
-std::vector<std::vector<double>> BlackScholesPricer::calculatePutDeltaMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
+GreeksResult BlackScholesPricer::calculateGreeks(const Option& option) const
 {
-    std::vector<std::vector<double>> deltaMatrix;
-    deltaMatrix.reserve(optionMatrix.size());
+    // Shared intermediates: d1/d2, the normal CDF/PDF values and both discount factors
+    auto [d1, d2] = calculateD1D2(option);
     
-    for (const auto& optionRow : optionMatrix)
-    {
-        deltaMatrix.push_back(calculatePutDeltaVector(optionRow));
-    }
+    double T = option.ExerciseDate();
+    double K = option.StrikePrice();
+    double sig = option.Volatility();
+    double r = option.RiskFreeRate();
+    double S = option.AssetPrice();
+    double b = option.CostOfCarry();
+    
+    double sqrtT = std::sqrt(T);
+    double carry = std::exp((b - r) * T);   // e^((b-r)*T)
+    double disc = std::exp(-r * T);         // e^(-r*T)
+    
+    double Nd1, Nmd1, Nd2, Nmd2;
+    NPair(d1, Nd1, Nmd1);
+    NPair(d2, Nd2, Nmd2);
+    double nd1 = n(d1);
+    
+    double Sc = S * carry;
+    double Kd = K * disc;
+    double decay = -Sc * nd1 * sig / (2.0 * sqrtT);
+    
+    GreeksResult result;
+    result.callPrice = Sc * Nd1 - Kd * Nd2;
+    result.putPrice = Kd * Nmd2 - Sc * Nmd1;
+    result.callDelta = carry * Nd1;
+    result.putDelta = -carry * Nmd1;
+    result.gamma = carry * nd1 / (S * sig * sqrtT);
+    result.vega = Sc * nd1 * sqrtT;
+    result.callTheta = decay - (b - r) * Sc * Nd1 - r * Kd * Nd2;
+    result.putTheta = decay + (b - r) * Sc * Nmd1 + r * Kd * Nmd2;
+    result.callRho = T * Kd * Nd2;
+    result.putRho = -T * Kd * Nmd2;
     
-    return deltaMatrix;
+    // Higher order: vanna and volga from vega, speed from gamma, charm = -dDelta/dT
+    double charm = -carry * nd1 * (b / (sig * sqrtT) - d2 / (2.0 * T));
+    result.vanna = -carry * nd1 * d2 / sig;
+    result.volga = result.vega * d1 * d2 / sig;
+    result.speed = -result.gamma / S * (1.0 + d1 / (sig * sqrtT));
+    result.callCharm = charm - (b - r) * carry * Nd1;
+    result.putCharm = charm + (b - r) * carry * Nmd1;
+    
+    return result;
 }
 
-std::vector<std::vector<double>> BlackScholesPricer::calculateGammaMatrix(
-    const std::vector<std::vector<Option>>& optionMatrix) const
+std::vector<GreeksResult> BlackScholesPricer::calculateGreeksVector(const std::vector<Option>& options) const
 {
-    std::vector<std::vector<double>> gammaMatrix;
-    gammaMatrix.reserve(optionMatrix.size());
+    std::vector<GreeksResult> results(options.size());
+    calculateGreeksVector(std::span<const Option>(options), results);
     
-    for (const auto& optionRow : optionMatrix)
+    return results;
+}
+
+void BlackScholesPricer::calculateGreeksVector(std::span<const Option> options, std::span<GreeksResult> out) const
+{
+    // Result columns of one transposed block: 30 KiB of stack next to the 12 KiB of inputs
+    alignas(64) double columns[15][TransposeBlockSize];
+    GreeksColumns greeks{columns[0], columns[1], columns[2], columns[3], columns[4], columns[5], columns[6],
+                         columns[7], columns[8], columns[9], columns[10], columns[11], columns[12], columns[13],
+                         columns[14]};
+    evaluateOptions(options, out, [&](const OptionBatchView& block, std::span<GreeksResult> blockOut)
     {
-        gammaMatrix.push_back(calculateGammaVector(optionRow));
-    }
+        evaluateBlackScholesGreeksBatch(block, greeks, simdLevel_, cdfMode_);
+        for (std::size_t i = 0; i < block.size; ++i)
+        {
+            blockOut[i] = {columns[0][i], columns[1][i], columns[2][i], columns[3][i], columns[4][i],
+                           columns[5][i], columns[6][i], columns[7][i], columns[8][i], columns[9][i],
+                           columns[10][i], columns[11][i], columns[12][i], columns[13][i], columns[14][i]};
+        }
+    });
+}
+
+void BlackScholesPricer::calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateBlackScholesBatch(BatchQuantity::CallPrice, batch, out, simdLevel_, cdfMode_);
+}
+
+void BlackScholesPricer::calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateBlackScholesBatch(BatchQuantity::PutPrice, batch, out, simdLevel_, cdfMode_);
+}
+
+void BlackScholesPricer::calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateBlackScholesBatch(BatchQuantity::CallDelta, batch, out, simdLevel_, cdfMode_);
+}
+
+void BlackScholesPricer::calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateBlackScholesBatch(BatchQuantity::PutDelta, batch, out, simdLevel_, cdfMode_);
+}
+
+void BlackScholesPricer::calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateBlackScholesBatch(BatchQuantity::Gamma, batch, out, simdLevel_, cdfMode_);
+}
+
+void BlackScholesPricer::calculateGreeksBatch(const OptionBatchView& batch, GreeksBatch& out) const
+{
+    evaluateBlackScholesGreeksBatch(batch, out, simdLevel_, cdfMode_);
+}
+
+void BlackScholesPricer::calculateGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateBlackScholesGreekBatch(greek, batch, out, simdLevel_, cdfMode_);
+}
+
+ImpliedVolResult BlackScholesPricer::calculateImpliedVolatility(const Option& option, double price, OptionType type,
+                                                                const ImpliedVolSettings& settings) const
+{
+    // One-row view over stack copies; a single contract gains nothing from wide registers
+    double T = option.ExerciseDate(), K = option.StrikePrice(), sig = option.Volatility();
+    double r = option.RiskFreeRate(), S = option.AssetPrice(), b = option.CostOfCarry();
+    OptionBatchView single{&T, &K, &sig, &r, &S, &b, 1};
+
+    ImpliedVolResult result;
+    evaluateImpliedVolatilityBatch(single, std::span<const double>(&price, 1), type, settings,
+                                   std::span<ImpliedVolResult>(&result, 1), SimdLevel::Scalar);
+    return result;
+}
+
+void BlackScholesPricer::calculateImpliedVolatilityBatch(const OptionBatchView& batch, std::span<const double> prices,
+                                                         OptionType type, const ImpliedVolSettings& settings,
+                                                         std::span<ImpliedVolResult> out) const
+{
+    evaluateImpliedVolatilityBatch(batch, prices, type, settings, out, simdLevel_);
+}
+
+std::vector<double> BlackScholesPricer::evaluateVector(const std::vector<Option>& options,
+                                                       void (IPricingStrategy::*spanMethod)(std::span<const Option>, std::span<double>) const) const
+{
+    // Blocks of options are transposed on the stack and evaluated with the SIMD batch kernels
+    std::vector<double> results(options.size());
+    (this->*spanMethod)(options, results);
     
-    return gammaMatrix;
+    return results;
 }
 
 std::pair<double, double> BlackScholesPricer::calculateD1D2(const Option& option) const
@@ -211,12 +304,109 @@ std::pair<double, double> BlackScholesPricer::calculateD1D2(const Option& option
 
 double BlackScholesPricer::N(double x) const
 {
-    // Use Boost's normal distribution to calculate the cumulative distribution function
-    return boost::math::cdf(NormDist_, x);
+    switch (cdfMode_)
+    {
+        case NormalCdfMode::Fast:
+            return normalCdfFast(x);
+        case NormalCdfMode::Boost:
+            // Use Boost's normal distribution to calculate the cumulative distribution function
+            return boost::math::cdf(NormDist_, x);
+        default:
+            return normalCdfAccurate(x);
+    }
 }
 
 double BlackScholesPricer::n(double x) const
 {
-    // Use Boost's normal distribution to calculate the probability density function
-    return boost::math::pdf(NormDist_, x);
+    if (cdfMode_ == NormalCdfMode::Boost)
+    {
+        // Use Boost's normal distribution to calculate the probability density function
+        return boost::math::pdf(NormDist_, x);
+    }
+    return normalPdf(x);
+}
+
+void BlackScholesPricer::NPair(double x, double& cdf, double& cdfNeg) const
+{
+    if (cdfMode_ == NormalCdfMode::Boost)
+    {
+        cdf = N(x);
+        cdfNeg = N(-x);
+        return;
+    }
+
+    double lower = cdfMode_ == NormalCdfMode::Fast ? normalLowerTailFast(std::abs(x))
+                                                   : normalLowerTailAccurate(std::abs(x));
+    cdf = x > 0.0 ? 1.0 - lower : lower;
+    cdfNeg = x > 0.0 ? lower : 1.0 - lower;
+}
+
+void BlackScholesPricer::calculateCallSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+{
+    evaluateSweep(BatchQuantity::CallPrice, grid, offset, out);
+}
+
+void BlackScholesPricer::calculatePutSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+{
+    evaluateSweep(BatchQuantity::PutPrice, grid, offset, out);
+}
+
+void BlackScholesPricer::calculateCallDeltaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+{
+    evaluateSweep(BatchQuantity::CallDelta, grid, offset, out);
+}
+
+void BlackScholesPricer::calculatePutDeltaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+{
+    evaluateSweep(BatchQuantity::PutDelta, grid, offset, out);
+}
+
+void BlackScholesPricer::calculateGammaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const
+{
+    evaluateSweep(BatchQuantity::Gamma, grid, offset, out);
+}
+
+void BlackScholesPricer::evaluateSweep(BatchQuantity quantity, const ParameterGrid& grid, std::size_t offset,
+                                       std::span<double> out) const
+{
+    // Options per segment: the spot, strike and output columns stay cache resident
+    constexpr std::size_t BlockSize = 1024;
+    // Shorter lines do not amortise the per-line exponentials
+    constexpr std::size_t MinLineLength = 8;
+
+    if (offset > grid.size() || out.size() > grid.size() - offset)
+    {
+        throw std::out_of_range("Range exceeds parameter grid bounds.");
+    }
+
+    std::size_t lineLength = grid.spotStrikeLineLength();
+    if (lineLength < MinLineLength)
+    {
+        OptionBatch block;
+        for (std::size_t begin = 0; begin < out.size(); begin += BlockSize)
+        {
+            std::size_t count = std::min(BlockSize, out.size() - begin);
+            grid.fill(offset + begin, count, block);
+            evaluateBlackScholesBatch(quantity, block, out.subspan(begin, count), simdLevel_, cdfMode_);
+        }
+        return;
+    }
+
+    OptionBatch::Column S(BlockSize), K(BlockSize);
+    std::size_t end = offset + out.size();
+    for (std::size_t begin = offset; begin < end;)
+    {
+        // Segment: the rest of the current line, at most one block
+        std::size_t lineEnd = (begin / lineLength + 1) * lineLength;
+        std::size_t count = std::min({BlockSize, lineEnd - begin, end - begin});
+
+        grid.fillColumn(OptionParameter::AssetPrice, begin, count, S.data());
+        grid.fillColumn(OptionParameter::StrikePrice, begin, count, K.data());
+        SweepLine line{grid.value(OptionParameter::ExerciseDate, begin), grid.value(OptionParameter::Volatility, begin),
+                       grid.value(OptionParameter::RiskFreeRate, begin), grid.value(OptionParameter::CostOfCarry, begin),
+                       S.data(), K.data(), count};
+        evaluateBlackScholesLine(quantity, line, out.subspan(begin - offset, count), simdLevel_, cdfMode_);
+
+        begin += count;
+    }
 }
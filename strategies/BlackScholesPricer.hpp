@@ -5,11 +5,18 @@
 #include <boost/math/distributions/normal.hpp>
 #include "IPricingStrategy.hpp"
 #include "Option.hpp"
+#include "OptionBatch.hpp"
+#include "ParameterGrid.hpp"
+#include "BlackScholesKernels.hpp"
+#include "NormalDistribution.hpp"
 
-class BlackScholesPricer : public IPricingStrategy
+class BlackScholesPricer final : public IPricingStrategy
 {
 public:
 
+    BlackScholesPricer() = default; // Accurate normal CDF, best available instruction set
+    explicit BlackScholesPricer(NormalCdfMode cdfMode); // Explicit normal CDF implementation
+
     // Single option pricing
     double calculateCallPrice(const Option& option) const override;
     double calculatePutPrice(const Option& option) const override;
@@ -17,12 +24,8 @@ public:
     // Vector pricing
     std::vector<double> calculateCallVector(const std::vector<Option>& options) const override;
     std::vector<double> calculatePutVector(const std::vector<Option>& options) const override;
-
-    // Matrix pricing
-    std::vector<std::vector<double>> calculateCallMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const override;
-    std::vector<std::vector<double>> calculatePutMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const override;
+    using IPricingStrategy::calculateCallVector;   // Span overloads
+    using IPricingStrategy::calculatePutVector;
 
     // Greeks calculation
     double calculateGamma(const Option& option) const override;
@@ -33,20 +36,70 @@ public:
     std::vector<double> calculateCallDeltaVector(const std::vector<Option>& options) const override;
     std::vector<double> calculatePutDeltaVector(const std::vector<Option>& options) const override;
     std::vector<double> calculateGammaVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallDeltaVector;
+    using IPricingStrategy::calculatePutDeltaVector;
+    using IPricingStrategy::calculateGammaVector;
+
+    // Fused price + Greeks up to speed and charm: d1/d2, N(d1), N(d2), n(d1) and discount
+    // factors computed once; single Greeks come from the same formulas (calculateGreek)
+    GreeksResult calculateGreeks(const Option& option) const override;
+    std::vector<GreeksResult> calculateGreeksVector(const std::vector<Option>& options) const override;
+    // Blocks of options and their 15 result columns stay on the stack: no heap allocation
+    void calculateGreeksVector(std::span<const Option> options, std::span<GreeksResult> out) const override;
+
+    // Batch calculation over structure-of-arrays input (SIMD kernels). Matrix
+    // pricing uses the IPricingStrategy grid defaults, which run these over the
+    // whole contiguous grid.
+    void calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateGreeksBatch(const OptionBatchView& batch, GreeksBatch& out) const override;
+    void calculateGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out) const override;
+
+    // Adjoint mode: price and its sensitivity to all six inputs from one reverse
+    // sweep over the generic formula, recorded on a per-thread arena tape that is
+    // reset, not reallocated, between options
+    AdjointResult calculateAdjoint(const Option& option, OptionType type) const;
+    void calculateAdjointBatch(const OptionBatchView& batch, OptionType type, std::span<AdjointResult> out) const;
 
-    // Matrix Greeks calculation for parameter variations
-    std::vector<std::vector<double>> calculateCallDeltaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const override;
-    std::vector<std::vector<double>> calculatePutDeltaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const override;
-    std::vector<std::vector<double>> calculateGammaMatrix(
-        const std::vector<std::vector<Option>>& optionMatrix) const override;
+    // Implied volatility: Halley iteration from a rational initial guess, the batch
+    // form iterating 4 or 8 contracts per instruction
+    ImpliedVolResult calculateImpliedVolatility(const Option& option, double price, OptionType type,
+                                                const ImpliedVolSettings& settings) const override;
+    void calculateImpliedVolatilityBatch(const OptionBatchView& batch, std::span<const double> prices,
+                                         OptionType type, const ImpliedVolSettings& settings,
+                                         std::span<ImpliedVolResult> out) const override;
+
+    // Parameter sweeps: lines where only spot and strike vary go through the line
+    // kernel, which evaluates sqrt(T), e^(-rT), e^((b-r)T) and the drift once per line
+    void calculateCallSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const override;
+    void calculatePutSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const override;
+    void calculateCallDeltaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const override;
+    void calculatePutDeltaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const override;
+    void calculateGammaSweep(const ParameterGrid& grid, std::size_t offset, std::span<double> out) const override;
 
     // Utility functions
     std::string getName() const override;
     bool supportsGreeks() const override;
 
+    // Instruction set used by the batch kernels (defaults to the best one the CPU supports)
+    SimdLevel getSimdLevel() const { return simdLevel_; };
+    void setSimdLevel(SimdLevel level) { simdLevel_ = level; };
+
+    // Normal CDF implementation used by every method (defaults to Accurate)
+    NormalCdfMode getCdfMode() const { return cdfMode_; };
+    void setCdfMode(NormalCdfMode mode) { cdfMode_ = mode; };
+
 private:
+    // Transpose AoS input once and run one batch kernel over it
+    std::vector<double> evaluateVector(const std::vector<Option>& options,
+                                       void (IPricingStrategy::*spanMethod)(std::span<const Option>, std::span<double>) const) const;
+    // Stream a sweep range through the line kernel (or the batch kernel for short lines)
+    void evaluateSweep(BatchQuantity quantity, const ParameterGrid& grid, std::size_t offset,
+                       std::span<double> out) const;
+
     // Helper functions for Black-Scholes calculations
     std::pair<double, double> calculateD1D2(const Option& option) const;
 
@@ -54,10 +107,15 @@ private:
     double N(double x) const;
     // Gaussian standard normal probability density function (PDF)
     double n(double x) const;
+    // N(x) and N(-x) together; the Hart/A&S modes get both from one tail evaluation
+    void NPair(double x, double& cdf, double& cdfNeg) const;
 
-    // Standard normal distribution by Boost
+    // Standard normal distribution by Boost (NormalCdfMode::Boost reference)
     inline static const boost::math::normal_distribution<double> NormDist_{0.0, 1.0};
 
+    SimdLevel simdLevel_ = detectSimdLevel();
+    NormalCdfMode cdfMode_ = NormalCdfMode::Accurate;
+
 };
 
 
@@ -0,0 +1,518 @@
+#include "FDMPricer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace
+{
+
+using MeshResult = FDMPricer::MeshResult;
+
+/*
+    Per-thread buffers of the finite-difference pricer. They only grow, so after
+    the first solve of a given mesh size pricing runs without heap allocation.
+*/
+struct FDMWorkspace
+{
+    OptionBatch options;              // Transposed vector input
+    std::vector<std::size_t> order;   // Batch rows sorted by (T, K, sig, r, b)
+    std::vector<double> mesh;         // Log-spot nodes x_0, x_0 + h, ..., x_0 + M h
+    std::vector<double> spots;        // e^x of every node
+    double meshStart = 0.0;           // x_0, h and M of the cached mesh
+    double meshStep = 0.0;
+    std::size_t meshIntervals = 0;
+    std::vector<double> values;       // Solution layer, M + 1 nodes
+    std::vector<double> previous;     // Layer before the last time step (theta)
+    std::vector<double> payoff;       // Exercise value of every node
+    std::vector<double> lower;        // Tridiagonal system of the interior nodes
+    std::vector<double> diag;
+    std::vector<double> upper;
+    std::vector<double> rhs;
+    std::vector<double> scratch;      // Thomas forward sweep coefficients
+    std::vector<double> penalty;      // Penalty weight, diagonal and right-hand side per interior node
+    std::vector<double> penaltyDiag;
+    std::vector<double> penaltyRhs;
+    std::vector<MeshResult> rows;     // Results by batch row
+};
+
+FDMWorkspace& workspace()
+{
+    thread_local FDMWorkspace instance;
+    return instance;
+}
+
+template <typename T>
+void ensureSize(std::vector<T>& buffer, std::size_t size)
+{
+    if (buffer.size() < size)
+    {
+        buffer.resize(size);
+    }
+}
+
+/*
+    Thomas algorithm for a tridiagonal system of n unknowns; lower[0] and
+    upper[n - 1] are ignored. Writes the solution to x, uses scratch for the
+    modified upper diagonal. The systems here are diagonally dominant, so no
+    pivoting is needed.
+*/
+void solveTridiagonal(const double* lower, const double* diag, const double* upper, const double* rhs,
+                      double* x, double* scratch, std::size_t n)
+{
+    double denominator = diag[0];
+    scratch[0] = upper[0] / denominator;
+    x[0] = rhs[0] / denominator;
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        denominator = diag[i] - lower[i] * scratch[i - 1];
+        scratch[i] = upper[i] / denominator;
+        x[i] = (rhs[i] - lower[i] * x[i - 1]) / denominator;
+    }
+    for (std::size_t i = n - 1; i-- > 0;)
+    {
+        x[i] -= scratch[i] * x[i + 1];
+    }
+}
+
+// Parameters of one PDE solve
+struct Problem
+{
+    OptionType type;
+    double T, K, sig, r, b;
+};
+
+/*
+    Dirichlet boundary value at spot S and time-to-expiry tau: the discounted
+    forward intrinsic value (never below the exercise value when American).
+*/
+double boundaryValue(const Problem& p, bool american, double S, double tau)
+{
+    const double sign = p.type == OptionType::Call ? 1.0 : -1.0;
+    double value = std::max(sign * (S * std::exp((p.b - p.r) * tau) - p.K * std::exp(-p.r * tau)), 0.0);
+    return american ? std::max(value, sign * (S - p.K)) : value;
+}
+
+/*
+    Advance the solution by one theta-scheme step of length dt in
+    time-to-expiry (theta = 1: implicit Euler, theta = 0.5: Crank-Nicolson).
+    In x = ln S the operator has constant coefficients:
+    V_tau = 0.5 sig^2 V_xx + (b - 0.5 sig^2) V_x - r V.
+*/
+void timeStep(const FDMSettings& settings, const Problem& p, double theta, double dt, double tau,
+              FDMWorkspace& ws)
+{
+    const std::size_t M = ws.meshIntervals;
+    const std::size_t n = M - 1;   // Interior unknowns, node i + 1 for row i
+    const double h = ws.meshStep;
+    const bool american = settings.exercise == ExerciseStyle::American;
+    double* v = ws.values.data();
+
+    const double alpha = 0.5 * p.sig * p.sig / (h * h);
+    const double beta = 0.5 * (p.b - 0.5 * p.sig * p.sig) / h;
+    const double a = alpha - beta;          // Coefficient of V[i - 1]
+    const double c = -2.0 * alpha - p.r;    // Coefficient of V[i]
+    const double e = alpha + beta;          // Coefficient of V[i + 1]
+
+    for (std::size_t row = 0; row < n; ++row)
+    {
+        const std::size_t i = row + 1;
+        ws.rhs[row] = v[i] + (1.0 - theta) * dt * (a * v[i - 1] + c * v[i] + e * v[i + 1]);
+        ws.lower[row] = -theta * dt * a;
+        ws.diag[row] = 1.0 - theta * dt * c;
+        ws.upper[row] = -theta * dt * e;
+    }
+
+    v[0] = boundaryValue(p, american, ws.spots[0], tau + dt);
+    v[M] = boundaryValue(p, american, ws.spots[M], tau + dt);
+    ws.rhs[0] -= ws.lower[0] * v[0];
+    ws.rhs[n - 1] -= ws.upper[n - 1] * v[M];
+
+    double* interior = v + 1;
+    if (!american)
+    {
+        solveTridiagonal(ws.lower.data(), ws.diag.data(), ws.upper.data(), ws.rhs.data(),
+                         interior, ws.scratch.data(), n);
+        return;
+    }
+
+    const double* exercise = ws.payoff.data() + 1;
+    if (settings.americanMethod == AmericanMethod::PSOR)
+    {
+        // Gauss-Seidel sweeps from the previous layer, projected onto V >= payoff
+        for (std::size_t iteration = 0; iteration < settings.maxIterations; ++iteration)
+        {
+            double change = 0.0;
+            for (std::size_t row = 0; row < n; ++row)
+            {
+                double below = row > 0 ? interior[row - 1] : 0.0;
+                double above = row + 1 < n ? interior[row + 1] : 0.0;
+                double gaussSeidel = (ws.rhs[row] - ws.lower[row] * below - ws.upper[row] * above) / ws.diag[row];
+                double updated = std::max(exercise[row], interior[row] + settings.relaxation * (gaussSeidel - interior[row]));
+                change = std::max(change, std::abs(updated - interior[row]));
+                interior[row] = updated;
+            }
+            if (change < settings.tolerance)
+            {
+                return;
+            }
+        }
+        throw std::runtime_error("PSOR did not converge; increase maxIterations or adjust the relaxation factor.");
+    }
+
+    // Penalty iteration: nodes below the payoff get a large diagonal pulling them onto it
+    const double weight = 1.0 / settings.tolerance;
+    std::fill(ws.penalty.begin(), ws.penalty.begin() + n, 0.0);
+    for (std::size_t iteration = 0; iteration < settings.maxIterations; ++iteration)
+    {
+        bool activeSetChanged = false;
+        for (std::size_t row = 0; row < n; ++row)
+        {
+            double rowWeight = interior[row] < exercise[row] ? weight : 0.0;
+            activeSetChanged |= rowWeight != ws.penalty[row];
+            ws.penalty[row] = rowWeight;
+            ws.penaltyDiag[row] = ws.diag[row] + rowWeight;
+            ws.penaltyRhs[row] = ws.rhs[row] + rowWeight * exercise[row];
+        }
+        if (!activeSetChanged && iteration > 0)
+        {
+            return;
+        }
+        solveTridiagonal(ws.lower.data(), ws.penaltyDiag.data(), ws.upper.data(), ws.penaltyRhs.data(),
+                         interior, ws.scratch.data(), n);
+    }
+    throw std::runtime_error("Penalty iteration did not converge; increase maxIterations.");
+}
+
+/*
+    Solve the PDE of one T/K/sigma/r/b group on a mesh covering all of its
+    spots. Leaves the solution at tau = T in ws.values and the layer before
+    the last step in ws.previous; returns the length of that last step.
+*/
+double solve(const FDMSettings& settings, const Problem& p, double minSpot, double maxSpot, FDMWorkspace& ws)
+{
+    // Mesh: spotRange standard deviations beyond the spots and the strike, ln K on a node
+    const double logStrike = std::log(p.K);
+    const double reach = settings.spotRange * std::max(p.sig * std::sqrt(p.T), 0.1);
+    const double lowest = std::min(std::log(minSpot), logStrike) - reach;
+    const double highest = std::max(std::log(maxSpot), logStrike) + reach;
+    const std::size_t M = settings.spotSteps;
+    const double h = (highest - lowest) / static_cast<double>(M - 1);
+    const double x0 = logStrike - std::ceil((logStrike - lowest) / h) * h;
+
+    if (ws.meshStart != x0 || ws.meshStep != h || ws.meshIntervals != M)
+    {
+        // Nodes x_0 + i h as meshArray spaces them, generated in place into the grown buffers
+        ensureSize(ws.mesh, M + 1);
+        ensureSize(ws.spots, M + 1);
+        for (std::size_t i = 0; i <= M; ++i)
+        {
+            ws.mesh[i] = x0 + static_cast<double>(i) * h;
+            ws.spots[i] = std::exp(ws.mesh[i]);
+        }
+        ws.meshStart = x0;
+        ws.meshStep = h;
+        ws.meshIntervals = M;
+    }
+
+    ensureSize(ws.values, M + 1);
+    ensureSize(ws.previous, M + 1);
+    ensureSize(ws.payoff, M + 1);
+    ensureSize(ws.lower, M);
+    ensureSize(ws.diag, M);
+    ensureSize(ws.upper, M);
+    ensureSize(ws.rhs, M);
+    ensureSize(ws.scratch, M);
+    ensureSize(ws.penalty, M);
+    ensureSize(ws.penaltyDiag, M);
+    ensureSize(ws.penaltyRhs, M);
+
+    const double sign = p.type == OptionType::Call ? 1.0 : -1.0;
+    for (std::size_t i = 0; i <= M; ++i)
+    {
+        ws.payoff[i] = std::max(sign * (ws.spots[i] - p.K), 0.0);
+        ws.values[i] = ws.payoff[i];
+    }
+
+    // Rannacher start-up: the first two steps as four implicit Euler half steps
+    const double dt = p.T / static_cast<double>(settings.timeSteps);
+    const std::size_t subSteps = settings.timeSteps + 2;
+    double tau = 0.0;
+    double lastStep = dt;
+    for (std::size_t k = 0; k < subSteps; ++k)
+    {
+        const bool startUp = k < 4;
+        const double stepLength = startUp ? 0.5 * dt : dt;
+        if (k + 1 == subSteps)
+        {
+            std::copy(ws.values.begin(), ws.values.begin() + M + 1, ws.previous.begin());
+            lastStep = stepLength;
+        }
+        timeStep(settings, p, startUp ? 1.0 : 0.5, stepLength, tau, ws);
+        tau += stepLength;
+    }
+    return lastStep;
+}
+
+/*
+    Quadratic interpolation in ln S through the three nodes nearest to the
+    spot; delta and gamma follow from the derivatives of the same parabola:
+    V_S = V_x / S, V_SS = (V_xx - V_x) / S^2.
+*/
+MeshResult interpolate(const FDMSettings& settings, const Problem& p, const FDMWorkspace& ws,
+                       double spot, double lastStep)
+{
+    const double h = ws.meshStep;
+    const double logSpot = std::log(spot);
+    const std::size_t centre = std::clamp<std::size_t>(static_cast<std::size_t>(std::round((logSpot - ws.meshStart) / h)),
+                                                       1, ws.meshIntervals - 1);
+    const double x = logSpot - ws.mesh[centre];
+
+    auto parabola = [&](const double* v, double& slope, double& curvature)
+    {
+        slope = (v[centre + 1] - v[centre - 1]) / (2.0 * h);
+        curvature = (v[centre + 1] - 2.0 * v[centre] + v[centre - 1]) / (h * h);
+        return v[centre] + x * slope + 0.5 * x * x * curvature;
+    };
+
+    double slope, curvature, previousSlope, previousCurvature;
+    MeshResult result;
+    result.price = parabola(ws.values.data(), slope, curvature);
+    double derivative = slope + x * curvature;
+    result.delta = derivative / spot;
+    result.gamma = (curvature - derivative) / (spot * spot);
+
+    if (settings.exercise == ExerciseStyle::European)
+    {
+        // Theta from the PDE itself, second order like delta and gamma
+        result.theta = p.r * result.price - p.b * spot * result.delta - 0.5 * p.sig * p.sig * spot * spot * result.gamma;
+    }
+    else
+    {
+        // The PDE does not hold where exercise is optimal; difference the last two time layers instead
+        double previousPrice = parabola(ws.previous.data(), previousSlope, previousCurvature);
+        result.theta = -(result.price - previousPrice) / lastStep;   // dV/dt = -dV/dtau
+    }
+    return result;
+}
+
+/*
+    Price every row of the batch into ws.rows. Rows are sorted by
+    (T, K, sig, r, b) so a spot sweep becomes one group and one solve.
+*/
+void priceRows(const FDMSettings& settings, const OptionBatchView& batch, OptionType type, FDMWorkspace& ws)
+{
+    const std::size_t n = batch.size;
+    ensureSize(ws.order, n);
+    ensureSize(ws.rows, n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!batch.option(i).isValid())
+        {
+            throw std::invalid_argument("Invalid option parameters.");
+        }
+    }
+
+    auto key = [&batch](std::size_t i)
+    {
+        return std::tie(batch.T[i], batch.K[i], batch.sig[i], batch.r[i], batch.b[i]);
+    };
+    std::iota(ws.order.begin(), ws.order.begin() + n, std::size_t{0});
+    std::sort(ws.order.begin(), ws.order.begin() + n,
+              [&key](std::size_t lhs, std::size_t rhs) { return key(lhs) < key(rhs); });
+
+    for (std::size_t begin = 0; begin < n;)
+    {
+        const std::size_t first = ws.order[begin];
+        std::size_t end = begin + 1;
+        double minSpot = batch.S[first], maxSpot = batch.S[first];
+        while (end < n && key(ws.order[end]) == key(first))
+        {
+            minSpot = std::min(minSpot, batch.S[ws.order[end]]);
+            maxSpot = std::max(maxSpot, batch.S[ws.order[end]]);
+            ++end;
+        }
+
+        Problem problem{type, batch.T[first], batch.K[first], batch.sig[first], batch.r[first], batch.b[first]};
+        double lastStep = solve(settings, problem, minSpot, maxSpot, ws);
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            std::size_t row = ws.order[i];
+            ws.rows[row] = interpolate(settings, problem, ws, batch.S[row], lastStep);
+        }
+
+        begin = end;
+    }
+}
+
+} // namespace
+
+FDMPricer::FDMPricer(const FDMSettings& settings)
+{
+    setSettings(settings);
+}
+
+void FDMPricer::setSettings(const FDMSettings& settings)
+{
+    if (settings.spotSteps < 8 || settings.timeSteps < 2)
+    {
+        throw std::invalid_argument("FDM mesh needs at least 8 spot steps and 2 time steps.");
+    }
+    if (settings.spotRange <= 0.0 || settings.tolerance <= 0.0 || settings.maxIterations == 0)
+    {
+        throw std::invalid_argument("FDM spot range, tolerance and iteration limit must be positive.");
+    }
+    if (settings.relaxation <= 0.0 || settings.relaxation >= 2.0)
+    {
+        throw std::invalid_argument("PSOR relaxation factor must lie in (0, 2).");
+    }
+    settings_ = settings;
+}
+
+double FDMPricer::calculateCallPrice(const Option& option) const
+{
+    return evaluate(option, OptionType::Call).price;
+}
+
+double FDMPricer::calculatePutPrice(const Option& option) const
+{
+    return evaluate(option, OptionType::Put).price;
+}
+
+std::vector<double> FDMPricer::calculateCallVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Call, &MeshResult::price);
+}
+
+std::vector<double> FDMPricer::calculatePutVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Put, &MeshResult::price);
+}
+
+double FDMPricer::calculateGamma(const Option& option) const
+{
+    return evaluate(option, OptionType::Put).gamma;
+}
+
+double FDMPricer::calculateCallDelta(const Option& option) const
+{
+    return evaluate(option, OptionType::Call).delta;
+}
+
+double FDMPricer::calculatePutDelta(const Option& option) const
+{
+    return evaluate(option, OptionType::Put).delta;
+}
+
+std::vector<double> FDMPricer::calculateCallDeltaVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Call, &MeshResult::delta);
+}
+
+std::vector<double> FDMPricer::calculatePutDeltaVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Put, &MeshResult::delta);
+}
+
+std::vector<double> FDMPricer::calculateGammaVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Put, &MeshResult::gamma);
+}
+
+GreeksResult FDMPricer::calculateGreeks(const Option& option) const
+{
+    MeshResult call = evaluate(option, OptionType::Call);
+    MeshResult put = evaluate(option, OptionType::Put);
+
+    GreeksResult result;
+    result.callPrice = call.price;
+    result.putPrice = put.price;
+    result.callDelta = call.delta;
+    result.putDelta = put.delta;
+    result.gamma = put.gamma;
+    result.callTheta = call.theta;
+    result.putTheta = put.theta;
+    return result;
+}
+
+void FDMPricer::calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Call, &MeshResult::price, out);
+}
+
+void FDMPricer::calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Put, &MeshResult::price, out);
+}
+
+void FDMPricer::calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Call, &MeshResult::delta, out);
+}
+
+void FDMPricer::calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Put, &MeshResult::delta, out);
+}
+
+void FDMPricer::calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Put, &MeshResult::gamma, out);
+}
+
+std::string FDMPricer::getName() const
+{
+    if (settings_.exercise == ExerciseStyle::European)
+    {
+        return "Finite Difference (European)";
+    }
+    return settings_.americanMethod == AmericanMethod::PSOR ? "Finite Difference (American, PSOR)"
+                                                            : "Finite Difference (American, Penalty)";
+}
+
+bool FDMPricer::supportsGreeks() const
+{
+    return true;
+}
+
+void FDMPricer::evaluate(const OptionBatchView& batch, OptionType type, ResultField field,
+                         std::span<double> out) const
+{
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+
+    FDMWorkspace& ws = workspace();
+    priceRows(settings_, batch, type, ws);
+    for (std::size_t i = 0; i < batch.size; ++i)
+    {
+        out[i] = ws.rows[i].*field;
+    }
+}
+
+std::vector<double> FDMPricer::evaluate(const std::vector<Option>& options, OptionType type,
+                                        ResultField field) const
+{
+    FDMWorkspace& ws = workspace();
+    ws.options.assign(options);
+
+    std::vector<double> values(options.size());
+    evaluate(ws.options.view(), type, field, values);
+    return values;
+}
+
+FDMPricer::MeshResult FDMPricer::evaluate(const Option& option, OptionType type) const
+{
+    // One-row view over stack copies of the parameters
+    double T = option.ExerciseDate(), K = option.StrikePrice(), sig = option.Volatility();
+    double r = option.RiskFreeRate(), S = option.AssetPrice(), b = option.CostOfCarry();
+    OptionBatchView single{&T, &K, &sig, &r, &S, &b, 1};
+
+    FDMWorkspace& ws = workspace();
+    priceRows(settings_, single, type, ws);
+    return ws.rows[0];
+}
@@ -0,0 +1,118 @@
+#ifndef FDMPRICER_HPP
+#define FDMPRICER_HPP
+
+#include <cstddef>
+#include "IPricingStrategy.hpp"
+#include "Option.hpp"
+#include "OptionBatch.hpp"
+
+/**
+ * @brief Treatment of the early exercise constraint V >= payoff
+ *
+ * - PSOR: projected successive over-relaxation on the Crank-Nicolson system
+ * - Penalty: Forsyth-Vetzal penalty iteration, each pass a tridiagonal solve
+ */
+enum class AmericanMethod
+{
+    PSOR,
+    Penalty
+};
+
+/**
+ * @brief Mesh, time stepping and exercise settings of the finite-difference pricer
+ */
+struct FDMSettings
+{
+    std::size_t spotSteps = 400;                    // Spot mesh intervals (at least 8)
+    std::size_t timeSteps = 200;                    // Crank-Nicolson steps (at least 2)
+    ExerciseStyle exercise = ExerciseStyle::European;
+    AmericanMethod americanMethod = AmericanMethod::PSOR;
+    double spotRange = 5.0;                         // Mesh reaches spotRange * sig * sqrt(T) beyond ln S and ln K
+    double relaxation = 1.2;                        // PSOR factor omega in (0, 2)
+    double tolerance = 1e-9;                        // PSOR / penalty convergence tolerance
+    std::size_t maxIterations = 1000;               // PSOR / penalty iteration limit per time step
+};
+
+/**
+ * @brief Finite-difference strategy solving the generalised Black-Scholes PDE
+ *
+ * V_t + 0.5 sig^2 S^2 V_SS + b S V_S - r V = 0 is discretised in x = ln S on
+ * a uniform mesh x_0 + i h, with ln K placed on a node, and stepped in
+ * time-to-expiry with Crank-Nicolson. The first two steps are replaced by
+ * four implicit Euler half steps (Rannacher start-up) so the payoff kink does
+ * not leave oscillations in delta and gamma. Each step is one Thomas-algorithm
+ * solve on per-thread buffers that only grow.
+ *
+ * One solve prices every spot on the mesh: options sharing T, K, sigma, r and b
+ * (a spot sweep) are served by a single solve and quadratic interpolation.
+ * calculateGamma() returns the put gamma.
+ */
+class FDMPricer final : public IPricingStrategy
+{
+public:
+
+    FDMPricer() = default; // European exercise, 400 x 200 mesh
+    explicit FDMPricer(const FDMSettings& settings);
+
+    // Single option pricing
+    double calculateCallPrice(const Option& option) const override;
+    double calculatePutPrice(const Option& option) const override;
+
+    // Vector pricing (one PDE solve per T/K/sigma/r/b group)
+    std::vector<double> calculateCallVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculatePutVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallVector;   // Span overloads
+    using IPricingStrategy::calculatePutVector;
+
+    // Greeks calculation from the solution mesh
+    double calculateGamma(const Option& option) const override;
+    double calculateCallDelta(const Option& option) const override;
+    double calculatePutDelta(const Option& option) const override;
+
+    // Vector Greeks calculation for monotonic ranges
+    std::vector<double> calculateCallDeltaVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculatePutDeltaVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculateGammaVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallDeltaVector;
+    using IPricingStrategy::calculatePutDeltaVector;
+    using IPricingStrategy::calculateGammaVector;
+
+    // Call and put prices, deltas, put gamma and thetas (vega and rho are not available)
+    GreeksResult calculateGreeks(const Option& option) const override;
+
+    // Batch calculation (grouped like the vector methods)
+    void calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+
+    // Utility functions
+    std::string getName() const override;
+    bool supportsGreeks() const override;
+
+    const FDMSettings& getSettings() const { return settings_; };
+    void setSettings(const FDMSettings& settings);
+
+    // Solution of one option, interpolated at its spot
+    struct MeshResult
+    {
+        double price;
+        double delta;
+        double gamma;
+        double theta;
+    };
+
+private:
+
+    using ResultField = double MeshResult::*;
+
+    // Price every option of the batch, writing one result field per option
+    void evaluate(const OptionBatchView& batch, OptionType type, ResultField field, std::span<double> out) const;
+    std::vector<double> evaluate(const std::vector<Option>& options, OptionType type, ResultField field) const;
+    MeshResult evaluate(const Option& option, OptionType type) const;
+
+    FDMSettings settings_;
+};
+
+#endif // FDMPRICER_HPP
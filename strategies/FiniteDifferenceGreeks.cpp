@@ -0,0 +1,271 @@
+#include "FiniteDifferenceGreeks.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+FiniteDifferenceGreeks::FiniteDifferenceGreeks(std::unique_ptr<IPricingStrategy> strategy,
+                                               const FiniteDifferenceSettings& settings)
+    : strategy_(std::move(strategy))
+{
+    if (!strategy_)
+    {
+        throw std::invalid_argument("Finite-difference Greeks need a pricing strategy.");
+    }
+    setSettings(settings);
+}
+
+void FiniteDifferenceGreeks::setSettings(const FiniteDifferenceSettings& settings)
+{
+    for (double bump : {settings.spotBump, settings.volBump, settings.timeBump, settings.rateBump})
+    {
+        if (!(bump > 0.0) || !std::isfinite(bump))
+        {
+            throw std::invalid_argument("Finite-difference bump sizes must be positive and finite.");
+        }
+    }
+    if (settings.spotBump >= 1.0)
+    {
+        throw std::invalid_argument("Relative spot bump must be below 1.");
+    }
+    settings_ = settings;
+}
+
+double FiniteDifferenceGreeks::calculateCallPrice(const Option& option) const
+{
+    return strategy_->calculateCallPrice(option);
+}
+
+double FiniteDifferenceGreeks::calculatePutPrice(const Option& option) const
+{
+    return strategy_->calculatePutPrice(option);
+}
+
+std::vector<double> FiniteDifferenceGreeks::calculateCallVector(const std::vector<Option>& options) const
+{
+    return strategy_->calculateCallVector(options);
+}
+
+std::vector<double> FiniteDifferenceGreeks::calculatePutVector(const std::vector<Option>& options) const
+{
+    return strategy_->calculatePutVector(options);
+}
+
+void FiniteDifferenceGreeks::calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    strategy_->calculateCallBatch(batch, out);
+}
+
+void FiniteDifferenceGreeks::calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    strategy_->calculatePutBatch(batch, out);
+}
+
+double FiniteDifferenceGreeks::timeStep(double T) const
+{
+    return std::min(settings_.timeBump, 0.5 * T);
+}
+
+double FiniteDifferenceGreeks::volStep(double sig) const
+{
+    return std::min(settings_.volBump, 0.5 * sig);
+}
+
+void FiniteDifferenceGreeks::fillVariants(const OptionBatchView& block, Variant first, Variant last,
+                                          OptionBatch& variants) const
+{
+    std::size_t n = block.size;
+    variants.resize((last - first) * n);
+    std::span<double> T = variants.ExerciseDates();
+    std::span<double> K = variants.StrikePrices();
+    std::span<double> sig = variants.Volatilities();
+    std::span<double> r = variants.RiskFreeRates();
+    std::span<double> S = variants.AssetPrices();
+    std::span<double> b = variants.CostsOfCarry();
+
+    for (std::size_t v = first; v < last; ++v)
+    {
+        const Bump& bump = Bumps[v];
+        std::size_t row = (v - first) * n;
+        for (std::size_t i = 0; i < n; ++i, ++row)
+        {
+            T[row] = block.T[i] + bump.time * timeStep(block.T[i]);
+            K[row] = block.K[i];
+            sig[row] = block.sig[i] + bump.vol * volStep(block.sig[i]);
+            r[row] = block.r[i] + bump.rate * settings_.rateBump;
+            S[row] = block.S[i] * (1.0 + bump.spot * settings_.spotBump);
+            b[row] = block.b[i] + bump.rate * settings_.rateBump;
+        }
+    }
+}
+
+void FiniteDifferenceGreeks::evaluateSpotGreek(SpotGreek greek, const OptionBatchView& batch, std::span<double> out) const
+{
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+
+    // Deltas need the spot pair only, gamma the base price as well
+    Variant first = greek == SpotGreek::Gamma ? Base : SpotUp;
+    OptionBatch variants;
+    std::vector<double> prices;
+    for (std::size_t begin = 0; begin < batch.size; begin += BlockSize)
+    {
+        std::size_t n = std::min(BlockSize, batch.size - begin);
+        OptionBatchView block = batch.subview(begin, n);
+        fillVariants(block, first, VolUp, variants);
+        prices.resize(variants.size());
+        if (greek == SpotGreek::PutDelta)
+        {
+            strategy_->calculatePutBatch(variants.view(), prices);
+        }
+        else
+        {
+            strategy_->calculateCallBatch(variants.view(), prices);
+        }
+
+        const double* up = prices.data() + (SpotUp - first) * n;
+        const double* down = prices.data() + (SpotDown - first) * n;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double h = block.S[i] * settings_.spotBump;
+            out[begin + i] = greek == SpotGreek::Gamma ? (up[i] - 2.0 * prices[i] + down[i]) / (h * h)
+                                                       : (up[i] - down[i]) / (2.0 * h);
+        }
+    }
+}
+
+double FiniteDifferenceGreeks::calculateGamma(const Option& option) const
+{
+    double gamma;
+    calculateGammaVector(std::span<const Option>(&option, 1), std::span<double>(&gamma, 1));
+    return gamma;
+}
+
+double FiniteDifferenceGreeks::calculateCallDelta(const Option& option) const
+{
+    double delta;
+    calculateCallDeltaVector(std::span<const Option>(&option, 1), std::span<double>(&delta, 1));
+    return delta;
+}
+
+double FiniteDifferenceGreeks::calculatePutDelta(const Option& option) const
+{
+    double delta;
+    calculatePutDeltaVector(std::span<const Option>(&option, 1), std::span<double>(&delta, 1));
+    return delta;
+}
+
+std::vector<double> FiniteDifferenceGreeks::calculateCallDeltaVector(const std::vector<Option>& options) const
+{
+    std::vector<double> deltas(options.size());
+    calculateCallDeltaVector(std::span<const Option>(options), deltas);
+    return deltas;
+}
+
+std::vector<double> FiniteDifferenceGreeks::calculatePutDeltaVector(const std::vector<Option>& options) const
+{
+    std::vector<double> deltas(options.size());
+    calculatePutDeltaVector(std::span<const Option>(options), deltas);
+    return deltas;
+}
+
+std::vector<double> FiniteDifferenceGreeks::calculateGammaVector(const std::vector<Option>& options) const
+{
+    std::vector<double> gammas(options.size());
+    calculateGammaVector(std::span<const Option>(options), gammas);
+    return gammas;
+}
+
+void FiniteDifferenceGreeks::calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateSpotGreek(SpotGreek::CallDelta, batch, out);
+}
+
+void FiniteDifferenceGreeks::calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateSpotGreek(SpotGreek::PutDelta, batch, out);
+}
+
+void FiniteDifferenceGreeks::calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluateSpotGreek(SpotGreek::Gamma, batch, out);
+}
+
+GreeksResult FiniteDifferenceGreeks::calculateGreeks(const Option& option) const
+{
+    GreeksBatch greeks;
+    calculateGreeksBatch(OptionBatch(std::span<const Option>(&option, 1)).view(), greeks);
+    return greeks.at(0);
+}
+
+void FiniteDifferenceGreeks::calculateGreeksBatch(const OptionBatchView& batch, GreeksBatch& out) const
+{
+    out.resize(batch.size);
+
+    OptionBatch variants;
+    std::vector<double> calls, puts;
+    for (std::size_t begin = 0; begin < batch.size; begin += BlockSize)
+    {
+        std::size_t n = std::min(BlockSize, batch.size - begin);
+        OptionBatchView block = batch.subview(begin, n);
+        fillVariants(block, Base, VariantCount, variants);
+        calls.resize(variants.size());
+        puts.resize(variants.size());
+        strategy_->calculateCallBatch(variants.view(), calls);
+        strategy_->calculatePutBatch(variants.view(), puts);
+
+        // Price of contract i under variant v
+        auto call = [&](Variant v, std::size_t i) { return calls[v * n + i]; };
+        auto put = [&](Variant v, std::size_t i) { return puts[v * n + i]; };
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double hS = block.S[i] * settings_.spotBump;
+            double hv = volStep(block.sig[i]);
+            double hT = timeStep(block.T[i]);
+            double hr = settings_.rateBump;
+
+            GreeksResult result;
+            result.callPrice = call(Base, i);
+            result.putPrice = put(Base, i);
+            result.callDelta = (call(SpotUp, i) - call(SpotDown, i)) / (2.0 * hS);
+            result.putDelta = (put(SpotUp, i) - put(SpotDown, i)) / (2.0 * hS);
+            result.gamma = (call(SpotUp, i) - 2.0 * call(Base, i) + call(SpotDown, i)) / (hS * hS);
+            result.vega = (call(VolUp, i) - call(VolDown, i)) / (2.0 * hv);
+            result.volga = (call(VolUp, i) - 2.0 * call(Base, i) + call(VolDown, i)) / (hv * hv);
+            // Calendar decay: time passing shortens the expiry
+            result.callTheta = -(call(TimeUp, i) - call(TimeDown, i)) / (2.0 * hT);
+            result.putTheta = -(put(TimeUp, i) - put(TimeDown, i)) / (2.0 * hT);
+            result.callRho = (call(RateUp, i) - call(RateDown, i)) / (2.0 * hr);
+            result.putRho = (put(RateUp, i) - put(RateDown, i)) / (2.0 * hr);
+            out.set(begin + i, result);
+        }
+    }
+}
+
+void FiniteDifferenceGreeks::calculateGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out) const
+{
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+
+    GreeksBatch greeks;
+    calculateGreeksBatch(batch, greeks);
+    for (std::size_t i = 0; i < batch.size; ++i)
+    {
+        out[i] = greeks.at(i).value(greek);
+    }
+}
+
+std::string FiniteDifferenceGreeks::getName() const
+{
+    return "Finite-Difference Greeks (" + strategy_->getName() + ")";
+}
+
+bool FiniteDifferenceGreeks::supportsGreeks() const
+{
+    return true;
+}
@@ -0,0 +1,120 @@
+#ifndef FINITEDIFFERENCEGREEKS_HPP
+#define FINITEDIFFERENCEGREEKS_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include "IPricingStrategy.hpp"
+#include "Option.hpp"
+#include "OptionBatch.hpp"
+
+/**
+ * @brief Bump sizes of the finite-difference Greeks engine (central differences)
+ */
+struct FiniteDifferenceSettings
+{
+    double spotBump = 1e-3;    // Relative: S (1 +- h)
+    double volBump = 1e-3;     // Absolute volatility, capped at half of each option's volatility
+    double timeBump = 1e-3;    // Absolute years, capped at half of each option's expiry
+    double rateBump = 1e-4;    // Absolute; r and b move together, as for rho
+};
+
+/**
+ * @brief Bump-and-reprice Greeks around any pricing strategy
+ *
+ * Prices are forwarded unchanged to the wrapped strategy. Greeks are central
+ * differences of its prices: for each block of contracts every bumped variant
+ * (spot, volatility, expiry and rate, up and down) is written into one SoA
+ * batch and priced with a single batch call per option side, so the wrapped
+ * strategy's own vectorised or path-sharing batch path does the work. The
+ * unbumped price is part of that batch and is reused by every second
+ * difference (gamma, volga) and returned as the fused result's price.
+ *
+ * Stochastic strategies need common random numbers across the variants, or
+ * the differences drown in simulation noise: MonteCarloPricer keys its random
+ * streams on (seed, path block), so every variant priced in one call is
+ * simulated on the same draws. Strategies that draw from a stream advancing
+ * between calls are not supported.
+ *
+ * calculateGreeks() fills price, delta, gamma, vega, theta, rho and volga;
+ * vanna, speed and charm would need cross or third-order variants and stay NaN.
+ */
+class FiniteDifferenceGreeks final : public IPricingStrategy
+{
+public:
+
+    explicit FiniteDifferenceGreeks(std::unique_ptr<IPricingStrategy> strategy,
+                                    const FiniteDifferenceSettings& settings = FiniteDifferenceSettings());
+
+    // Pricing, forwarded to the wrapped strategy
+    double calculateCallPrice(const Option& option) const override;
+    double calculatePutPrice(const Option& option) const override;
+    std::vector<double> calculateCallVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculatePutVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallVector;
+    using IPricingStrategy::calculatePutVector;
+    void calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const override;
+
+    // Greeks by central differences
+    double calculateGamma(const Option& option) const override;
+    double calculateCallDelta(const Option& option) const override;
+    double calculatePutDelta(const Option& option) const override;
+    std::vector<double> calculateCallDeltaVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculatePutDeltaVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculateGammaVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallDeltaVector;
+    using IPricingStrategy::calculatePutDeltaVector;
+    using IPricingStrategy::calculateGammaVector;
+    void calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+
+    // Fused: all variants of a contract priced together, base price shared
+    GreeksResult calculateGreeks(const Option& option) const override;
+    void calculateGreeksBatch(const OptionBatchView& batch, GreeksBatch& out) const override;
+    void calculateGreekBatch(Greek greek, const OptionBatchView& batch, std::span<double> out) const override;
+
+    // Utility functions
+    std::string getName() const override;
+    bool supportsGreeks() const override;
+
+    const IPricingStrategy& getStrategy() const { return *strategy_; };
+    const FiniteDifferenceSettings& getSettings() const { return settings_; };
+    void setSettings(const FiniteDifferenceSettings& settings);
+
+private:
+
+    // One bumped variant: each field is -1, 0 or +1 times the matching bump size
+    struct Bump
+    {
+        double spot;
+        double vol;
+        double time;
+        double rate;
+    };
+
+    // Variants of the fused evaluation, in Bumps order
+    enum Variant : std::size_t { Base, SpotUp, SpotDown, VolUp, VolDown, TimeUp, TimeDown, RateUp, RateDown, VariantCount };
+    static constexpr std::array<Bump, VariantCount> Bumps = {{
+        {0, 0, 0, 0}, {1, 0, 0, 0}, {-1, 0, 0, 0}, {0, 1, 0, 0}, {0, -1, 0, 0},
+        {0, 0, 1, 0}, {0, 0, -1, 0}, {0, 0, 0, 1}, {0, 0, 0, -1}
+    }};
+
+    // Contracts per block: the variant batch of a full block takes about 430 KiB
+    static constexpr std::size_t BlockSize = 1024;
+
+    enum class SpotGreek { CallDelta, PutDelta, Gamma };
+
+    // Every contract of block under Bumps[first, last), variant-major:
+    // row (v - first) * block.size + i is contract i under Bumps[v]
+    void fillVariants(const OptionBatchView& block, Variant first, Variant last, OptionBatch& variants) const;
+    void evaluateSpotGreek(SpotGreek greek, const OptionBatchView& batch, std::span<double> out) const;
+    double timeStep(double T) const;   // Expiry bump, at most half the expiry
+    double volStep(double sig) const;  // Volatility bump, at most half the volatility
+
+    std::unique_ptr<IPricingStrategy> strategy_;
+    FiniteDifferenceSettings settings_;
+};
+
+#endif // FINITEDIFFERENCEGREEKS_HPP
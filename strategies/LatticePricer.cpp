@@ -0,0 +1,401 @@
+#include "LatticePricer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+namespace
+{
+
+using NodeResult = LatticePricer::NodeResult;
+
+/*
+    Per-thread buffers of the lattice pricer. They only grow, so after the
+    first call of a given size pricing runs without heap allocation.
+*/
+struct LatticeWorkspace
+{
+    OptionBatch options;              // Transposed vector input
+    std::vector<std::size_t> order;   // Batch rows sorted by (T, sig, r, b)
+    std::vector<double> spots;        // S of each option in the current group
+    std::vector<double> moneyness;    // K / S of each option in the current group
+    std::vector<double> growth;       // Spot multiple of every node level
+    std::vector<double> values;       // Rolling node values, options interleaved per node
+    std::vector<double> firstNodes;   // Three nodes per option at the Greeks time
+    std::vector<NodeResult> group;    // Results of the current group (fine tree, then coarse tree)
+    std::vector<NodeResult> rows;     // Results by batch row
+};
+
+LatticeWorkspace& workspace()
+{
+    thread_local LatticeWorkspace instance;
+    return instance;
+}
+
+template <typename T>
+void ensureSize(std::vector<T>& buffer, std::size_t size)
+{
+    if (buffer.size() < size)
+    {
+        buffer.resize(size);
+    }
+}
+
+/*
+    One backward sweep over a group of m options sharing T, sig, r and b.
+    Values are kept in units of each option's spot, so node n of every option
+    sits at spot multiple growth[level(n)] and only the strike ratio differs.
+    Writes price, delta, gamma and theta (in currency units) to results[0..m).
+*/
+void sweep(LatticeType type, std::size_t steps, ExerciseStyle exercise, OptionType optionType,
+           double T, double sig, double r, double b, std::size_t m, LatticeWorkspace& ws, NodeResult* results)
+{
+    const double dt = T / static_cast<double>(steps);
+    const double sign = optionType == OptionType::Call ? 1.0 : -1.0;
+    const bool american = exercise == ExerciseStyle::American;
+    const double disc = std::exp(-r * dt);
+    const bool binomial = type == LatticeType::Binomial;
+
+    // Tree geometry: log spacing per level and discounted branch probabilities
+    double dx, pUp, pMid, pDown;
+    if (binomial)
+    {
+        dx = sig * std::sqrt(dt);
+        double u = std::exp(dx);
+        double p = (std::exp(b * dt) - 1.0 / u) / (u - 1.0 / u);
+        pUp = p;
+        pMid = 0.0;
+        pDown = 1.0 - p;
+    }
+    else
+    {
+        dx = sig * std::sqrt(3.0 * dt);
+        double nu = b - 0.5 * sig * sig;
+        double a = (sig * sig * dt + nu * nu * dt * dt) / (dx * dx);
+        pUp = 0.5 * (a + nu * dt / dx);
+        pDown = 0.5 * (a - nu * dt / dx);
+        pMid = 1.0 - a;
+    }
+    if (pUp < 0.0 || pUp > 1.0 || pDown < 0.0 || pDown > 1.0 || pMid < 0.0)
+    {
+        throw std::invalid_argument("Lattice branch probabilities out of range; increase the number of steps.");
+    }
+    pUp *= disc;
+    pMid *= disc;
+    pDown *= disc;
+
+    // Binomial nodes move two levels per step (u * d = 1), trinomial nodes one
+    const std::size_t levels = 2 * steps + 1;
+    const std::size_t levelStep = binomial ? 2 : 1;
+    const std::size_t nodes = binomial ? steps + 1 : 2 * steps + 1;
+    ensureSize(ws.growth, levels);
+    ensureSize(ws.values, nodes * m);
+    ensureSize(ws.firstNodes, 3 * m);
+    for (std::size_t level = 0; level < levels; ++level)
+    {
+        ws.growth[level] = std::exp((static_cast<double>(level) - static_cast<double>(steps)) * dx);
+    }
+
+    double* v = ws.values.data();
+    const double* g = ws.growth.data();
+    const double* mny = ws.moneyness.data();
+
+    // Terminal payoff
+    for (std::size_t j = 0; j < nodes; ++j)
+    {
+        double spot = g[j * levelStep];
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            v[j * m + i] = std::max(sign * (spot - mny[i]), 0.0);
+        }
+    }
+
+    // Backward induction in place: node j of step k only reads nodes j.. of step k + 1
+    const std::size_t greeksStep = binomial ? 2 : 1;
+    for (std::size_t k = steps; k-- > 0;)
+    {
+        const std::size_t stepNodes = binomial ? k + 1 : 2 * k + 1;
+        const std::size_t firstLevel = steps - k;   // Level of node 0 at step k
+
+        for (std::size_t j = 0; j < stepNodes; ++j)
+        {
+            double* node = v + j * m;
+            const double* next = v + (j + 1) * m;
+            double spot = g[firstLevel + j * levelStep];
+
+            if (binomial)
+            {
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    node[i] = pDown * node[i] + pUp * next[i];
+                }
+            }
+            else
+            {
+                const double* top = v + (j + 2) * m;
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    node[i] = pDown * node[i] + pMid * next[i] + pUp * top[i];
+                }
+            }
+
+            if (american)
+            {
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    node[i] = std::max(node[i], sign * (spot - mny[i]));
+                }
+            }
+        }
+
+        if (k == greeksStep)
+        {
+            std::copy(v, v + 3 * m, ws.firstNodes.begin());
+        }
+    }
+
+    // Greeks from the three nodes at t = greeksStep * dt (centre node at spot multiple 1)
+    const double gDown = g[steps - greeksStep];
+    const double gUp = g[steps + greeksStep];
+    const double tGreeks = static_cast<double>(greeksStep) * dt;
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        const double S = ws.spots[i];
+        const double v0 = ws.firstNodes[i];
+        const double v1 = ws.firstNodes[m + i];
+        const double v2 = ws.firstNodes[2 * m + i];
+
+        double upperSlope = (v2 - v1) / (gUp - 1.0);
+        double lowerSlope = (v1 - v0) / (1.0 - gDown);
+
+        results[i].price = S * v[i];
+        results[i].delta = (v2 - v0) / (gUp - gDown);
+        results[i].gamma = (upperSlope - lowerSlope) / (0.5 * (gUp - gDown)) / S;
+        results[i].theta = S * (v1 - v[i]) / tGreeks;
+    }
+}
+
+/*
+    Price every row of the batch into ws.rows. Rows are sorted by (T, sig, r, b)
+    so equal parameter sets become adjacent and share one sweep.
+*/
+void priceRows(const LatticeSettings& settings, const OptionBatchView& batch, OptionType type, LatticeWorkspace& ws)
+{
+    const std::size_t n = batch.size;
+    ensureSize(ws.order, n);
+    ensureSize(ws.spots, n);
+    ensureSize(ws.moneyness, n);
+    ensureSize(ws.group, 2 * n);
+    ensureSize(ws.rows, n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!batch.option(i).isValid())
+        {
+            throw std::invalid_argument("Invalid option parameters.");
+        }
+    }
+
+    auto key = [&batch](std::size_t i) { return std::tie(batch.T[i], batch.sig[i], batch.r[i], batch.b[i]); };
+    std::iota(ws.order.begin(), ws.order.begin() + n, std::size_t{0});
+    std::sort(ws.order.begin(), ws.order.begin() + n,
+              [&key](std::size_t lhs, std::size_t rhs) { return key(lhs) < key(rhs); });
+
+    for (std::size_t begin = 0; begin < n;)
+    {
+        const std::size_t first = ws.order[begin];
+        std::size_t end = begin + 1;
+        while (end < n && key(ws.order[end]) == key(first))
+        {
+            ++end;
+        }
+        const std::size_t m = end - begin;
+
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            std::size_t row = ws.order[begin + i];
+            ws.spots[i] = batch.S[row];
+            ws.moneyness[i] = batch.K[row] / batch.S[row];
+        }
+
+        const double T = batch.T[first], sig = batch.sig[first], r = batch.r[first], b = batch.b[first];
+        NodeResult* fine = ws.group.data();
+        sweep(settings.type, settings.steps, settings.exercise, type, T, sig, r, b, m, ws, fine);
+
+        if (settings.richardson)
+        {
+            // Cancel the leading O(1/steps) error term with the half-step tree; Greeks stay on the fine tree
+            NodeResult* coarse = ws.group.data() + m;
+            sweep(settings.type, settings.steps / 2, settings.exercise, type, T, sig, r, b, m, ws, coarse);
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                fine[i].price = 2.0 * fine[i].price - coarse[i].price;
+            }
+        }
+
+        for (std::size_t i = 0; i < m; ++i)
+        {
+            ws.rows[ws.order[begin + i]] = fine[i];
+        }
+
+        begin = end;
+    }
+}
+
+} // namespace
+
+LatticePricer::LatticePricer(const LatticeSettings& settings)
+{
+    setSettings(settings);
+}
+
+void LatticePricer::setSettings(const LatticeSettings& settings)
+{
+    if (settings.steps < 4)
+    {
+        throw std::invalid_argument("Lattice needs at least four time steps.");
+    }
+    settings_ = settings;
+}
+
+double LatticePricer::calculateCallPrice(const Option& option) const
+{
+    return evaluate(option, OptionType::Call).price;
+}
+
+double LatticePricer::calculatePutPrice(const Option& option) const
+{
+    return evaluate(option, OptionType::Put).price;
+}
+
+std::vector<double> LatticePricer::calculateCallVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Call, &NodeResult::price);
+}
+
+std::vector<double> LatticePricer::calculatePutVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Put, &NodeResult::price);
+}
+
+double LatticePricer::calculateGamma(const Option& option) const
+{
+    return evaluate(option, OptionType::Put).gamma;
+}
+
+double LatticePricer::calculateCallDelta(const Option& option) const
+{
+    return evaluate(option, OptionType::Call).delta;
+}
+
+double LatticePricer::calculatePutDelta(const Option& option) const
+{
+    return evaluate(option, OptionType::Put).delta;
+}
+
+std::vector<double> LatticePricer::calculateCallDeltaVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Call, &NodeResult::delta);
+}
+
+std::vector<double> LatticePricer::calculatePutDeltaVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Put, &NodeResult::delta);
+}
+
+std::vector<double> LatticePricer::calculateGammaVector(const std::vector<Option>& options) const
+{
+    return evaluate(options, OptionType::Put, &NodeResult::gamma);
+}
+
+GreeksResult LatticePricer::calculateGreeks(const Option& option) const
+{
+    NodeResult call = evaluate(option, OptionType::Call);
+    NodeResult put = evaluate(option, OptionType::Put);
+
+    GreeksResult result;
+    result.callPrice = call.price;
+    result.putPrice = put.price;
+    result.callDelta = call.delta;
+    result.putDelta = put.delta;
+    result.gamma = put.gamma;
+    result.callTheta = call.theta;
+    result.putTheta = put.theta;
+    return result;
+}
+
+void LatticePricer::calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Call, &NodeResult::price, out);
+}
+
+void LatticePricer::calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Put, &NodeResult::price, out);
+}
+
+void LatticePricer::calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Call, &NodeResult::delta, out);
+}
+
+void LatticePricer::calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Put, &NodeResult::delta, out);
+}
+
+void LatticePricer::calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    evaluate(batch, OptionType::Put, &NodeResult::gamma, out);
+}
+
+std::string LatticePricer::getName() const
+{
+    std::string name = settings_.type == LatticeType::Binomial ? "Binomial Lattice" : "Trinomial Lattice";
+    return settings_.exercise == ExerciseStyle::American ? name + " (American)" : name + " (European)";
+}
+
+bool LatticePricer::supportsGreeks() const
+{
+    return true;
+}
+
+void LatticePricer::evaluate(const OptionBatchView& batch, OptionType type, ResultField field,
+                             std::span<double> out) const
+{
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+
+    LatticeWorkspace& ws = workspace();
+    priceRows(settings_, batch, type, ws);
+    for (std::size_t i = 0; i < batch.size; ++i)
+    {
+        out[i] = ws.rows[i].*field;
+    }
+}
+
+std::vector<double> LatticePricer::evaluate(const std::vector<Option>& options, OptionType type,
+                                            ResultField field) const
+{
+    LatticeWorkspace& ws = workspace();
+    ws.options.assign(options);
+
+    std::vector<double> values(options.size());
+    evaluate(ws.options.view(), type, field, values);
+    return values;
+}
+
+LatticePricer::NodeResult LatticePricer::evaluate(const Option& option, OptionType type) const
+{
+    // One-row view over stack copies of the parameters
+    double T = option.ExerciseDate(), K = option.StrikePrice(), sig = option.Volatility();
+    double r = option.RiskFreeRate(), S = option.AssetPrice(), b = option.CostOfCarry();
+    OptionBatchView single{&T, &K, &sig, &r, &S, &b, 1};
+
+    LatticeWorkspace& ws = workspace();
+    priceRows(settings_, single, type, ws);
+    return ws.rows[0];
+}
@@ -0,0 +1,116 @@
+#ifndef LATTICEPRICER_HPP
+#define LATTICEPRICER_HPP
+
+#include <cstddef>
+#include "IPricingStrategy.hpp"
+#include "Option.hpp"
+#include "OptionBatch.hpp"
+
+/**
+ * @brief Tree used by the lattice pricer
+ *
+ * - Binomial: Cox-Ross-Rubinstein, u = e^(sig*sqrt(dt)), d = 1/u
+ * - Trinomial: log-space tree with spacing sig*sqrt(3*dt) and carry-adjusted probabilities
+ */
+enum class LatticeType
+{
+    Binomial,
+    Trinomial
+};
+
+/**
+ * @brief Discretisation and exercise settings of the lattice pricer
+ */
+struct LatticeSettings
+{
+    LatticeType type = LatticeType::Binomial;
+    std::size_t steps = 200;                        // Time steps (at least 4)
+    ExerciseStyle exercise = ExerciseStyle::American;
+    bool richardson = true;                         // Price = 2 * P(steps) - P(steps / 2)
+};
+
+/**
+ * @brief Binomial/trinomial lattice pricing strategy with American exercise
+ *
+ * Options sharing T, sigma, r and b are priced in one backward sweep: by
+ * homogeneity V(S, K) = S * v(K / S), so the tree geometry and the node spot
+ * multiples are shared and every node update runs over all options of the
+ * group in one contiguous inner loop.
+ *
+ * Backward induction uses a single rolling node array. Node, strike and index
+ * buffers live in a per-thread workspace that only grows, so repeated calls
+ * of the same size do not allocate and concurrent calls never share state.
+ *
+ * Delta, gamma and theta are read off the three nodes at t = 2dt (binomial)
+ * or t = dt (trinomial). calculateGamma() returns the put gamma, which is the
+ * one early exercise changes for non-negative carry spreads.
+ */
+class LatticePricer final : public IPricingStrategy
+{
+public:
+
+    LatticePricer() = default; // American CRR tree, 200 steps with Richardson extrapolation
+    explicit LatticePricer(const LatticeSettings& settings);
+
+    // Single option pricing
+    double calculateCallPrice(const Option& option) const override;
+    double calculatePutPrice(const Option& option) const override;
+
+    // Vector pricing (one backward sweep per T/sigma/r/b group)
+    std::vector<double> calculateCallVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculatePutVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallVector;   // Span overloads
+    using IPricingStrategy::calculatePutVector;
+
+    // Greeks calculation from the first lattice nodes
+    double calculateGamma(const Option& option) const override;
+    double calculateCallDelta(const Option& option) const override;
+    double calculatePutDelta(const Option& option) const override;
+
+    // Vector Greeks calculation for monotonic ranges
+    std::vector<double> calculateCallDeltaVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculatePutDeltaVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculateGammaVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallDeltaVector;
+    using IPricingStrategy::calculatePutDeltaVector;
+    using IPricingStrategy::calculateGammaVector;
+
+    // Call and put prices, deltas, put gamma and thetas (vega and rho are not available)
+    GreeksResult calculateGreeks(const Option& option) const override;
+
+    // Batch calculation (grouped like the vector methods)
+    void calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+
+    // Utility functions
+    std::string getName() const override;
+    bool supportsGreeks() const override;
+
+    const LatticeSettings& getSettings() const { return settings_; };
+    void setSettings(const LatticeSettings& settings);
+
+    // Lattice outputs of one option
+    struct NodeResult
+    {
+        double price;
+        double delta;
+        double gamma;
+        double theta;
+    };
+
+private:
+
+    using ResultField = double NodeResult::*;
+
+    // Price every option of the batch, writing one result field per option
+    void evaluate(const OptionBatchView& batch, OptionType type, ResultField field, std::span<double> out) const;
+    std::vector<double> evaluate(const std::vector<Option>& options, OptionType type, ResultField field) const;
+    NodeResult evaluate(const Option& option, OptionType type) const;
+
+    LatticeSettings settings_;
+};
+
+#endif // LATTICEPRICER_HPP
@@ -0,0 +1,450 @@
+#include "MonteCarloPricer.hpp"
+#include "PhiloxEngine.hpp"
+#include "NormalDistribution.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <boost/random/normal_distribution.hpp>
+
+namespace
+{
+
+// Samples per random stream; one sample is one path or one antithetic pair
+constexpr std::size_t BlockSamples = 4096;
+// Upper bound on partial sums kept per option (fixed, so reduction order never depends on threads)
+constexpr std::size_t MaxChunks = 64;
+
+// Running sums of one option over a range of samples
+struct Accumulator
+{
+    double y = 0.0;       // Payoff
+    double yy = 0.0;
+    double x = 0.0;       // Control variate
+    double xx = 0.0;
+    double xy = 0.0;
+    double delta = 0.0;   // Pathwise delta estimator
+    double gamma = 0.0;   // Likelihood ratio gamma estimator
+
+    void add(const Accumulator& other)
+    {
+        y += other.y;
+        yy += other.yy;
+        x += other.x;
+        xx += other.xx;
+        xy += other.xy;
+        delta += other.delta;
+        gamma += other.gamma;
+    }
+};
+
+// Per-chunk path buffers, reused by every block of the chunk and every strike of the group
+struct PathBuffers
+{
+    explicit PathBuffers(std::size_t legs)
+        : z(BlockSamples), logS(legs, std::vector<double>(BlockSamples)),
+          underlying(legs, std::vector<double>(BlockSamples)), geometric(legs, std::vector<double>(BlockSamples))
+    {
+    }
+
+    std::vector<double> z;                         // Normal draws of the current step (European: the only step)
+    std::vector<std::vector<double>> logS;         // Log spot per leg (leg 1 uses -z)
+    std::vector<std::vector<double>> underlying;   // S_T or the path average the payoff is written on
+    std::vector<std::vector<double>> geometric;    // Geometric average (arithmetic Asian control variate)
+};
+
+double payoff(OptionType type, double underlying, double strike)
+{
+    return type == OptionType::Call ? std::max(underlying - strike, 0.0) : std::max(strike - underlying, 0.0);
+}
+
+// Undiscounted expectation of the discrete geometric Asian payoff with fixings at iT/n, i = 1..n
+double geometricAsianForward(const Option& option, OptionType type, std::size_t fixings)
+{
+    double n = static_cast<double>(fixings);
+    double T = option.ExerciseDate();
+    double sig = option.Volatility();
+
+    double mean = std::log(option.AssetPrice())
+                + (option.CostOfCarry() - 0.5 * sig * sig) * T * (n + 1.0) / (2.0 * n);
+    double stdDev = sig * std::sqrt(T * (n + 1.0) * (2.0 * n + 1.0) / (6.0 * n * n));
+    double forward = std::exp(mean + 0.5 * stdDev * stdDev);
+    double K = option.StrikePrice();
+
+    double d1 = (mean - std::log(K) + stdDev * stdDev) / stdDev;
+    double d2 = d1 - stdDev;
+
+    return type == OptionType::Call ? forward * normalCdfAccurate(d1) - K * normalCdfAccurate(d2)
+                                    : K * normalCdfAccurate(-d2) - forward * normalCdfAccurate(-d1);
+}
+
+// Key of the simulated dynamics: everything except the strike
+std::tuple<double, double, double, double, double> underlyingKey(const Option& option)
+{
+    return {option.ExerciseDate(), option.Volatility(), option.RiskFreeRate(), option.AssetPrice(),
+            option.CostOfCarry()};
+}
+
+} // namespace
+
+MonteCarloPricer::MonteCarloPricer(const MonteCarloSettings& settings)
+{
+    setSettings(settings);
+}
+
+void MonteCarloPricer::setSettings(const MonteCarloSettings& settings)
+{
+    // The standard error needs two samples; an antithetic sample is a pair of paths
+    const std::size_t legs = settings.antithetic ? 2 : 1;
+    if (settings.paths < 2 * legs)
+    {
+        throw std::invalid_argument("Monte Carlo needs at least two samples (four paths when antithetic).");
+    }
+    if (settings.timeSteps == 0)
+    {
+        throw std::invalid_argument("Monte Carlo needs at least one time step.");
+    }
+    settings_ = settings;
+}
+
+double MonteCarloPricer::calculateCallPrice(const Option& option) const
+{
+    return simulate(option, OptionType::Call).price;
+}
+
+double MonteCarloPricer::calculatePutPrice(const Option& option) const
+{
+    return simulate(option, OptionType::Put).price;
+}
+
+std::vector<double> MonteCarloPricer::calculateCallVector(const std::vector<Option>& options) const
+{
+    return simulateField(options, OptionType::Call, &MonteCarloResult::price);
+}
+
+std::vector<double> MonteCarloPricer::calculatePutVector(const std::vector<Option>& options) const
+{
+    return simulateField(options, OptionType::Put, &MonteCarloResult::price);
+}
+
+double MonteCarloPricer::calculateGamma(const Option& option) const
+{
+    return simulate(option, OptionType::Call).gamma;
+}
+
+double MonteCarloPricer::calculateCallDelta(const Option& option) const
+{
+    return simulate(option, OptionType::Call).delta;
+}
+
+double MonteCarloPricer::calculatePutDelta(const Option& option) const
+{
+    return simulate(option, OptionType::Put).delta;
+}
+
+std::vector<double> MonteCarloPricer::calculateCallDeltaVector(const std::vector<Option>& options) const
+{
+    return simulateField(options, OptionType::Call, &MonteCarloResult::delta);
+}
+
+std::vector<double> MonteCarloPricer::calculatePutDeltaVector(const std::vector<Option>& options) const
+{
+    return simulateField(options, OptionType::Put, &MonteCarloResult::delta);
+}
+
+std::vector<double> MonteCarloPricer::calculateGammaVector(const std::vector<Option>& options) const
+{
+    return simulateField(options, OptionType::Call, &MonteCarloResult::gamma);
+}
+
+void MonteCarloPricer::calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    simulateBatch(batch, out, OptionType::Call, &MonteCarloResult::price);
+}
+
+void MonteCarloPricer::calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    simulateBatch(batch, out, OptionType::Put, &MonteCarloResult::price);
+}
+
+void MonteCarloPricer::calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    simulateBatch(batch, out, OptionType::Call, &MonteCarloResult::delta);
+}
+
+void MonteCarloPricer::calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    simulateBatch(batch, out, OptionType::Put, &MonteCarloResult::delta);
+}
+
+void MonteCarloPricer::calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const
+{
+    simulateBatch(batch, out, OptionType::Call, &MonteCarloResult::gamma);
+}
+
+MonteCarloResult MonteCarloPricer::simulate(const Option& option, OptionType type, PayoffStyle style) const
+{
+    return simulate(std::vector<Option>{option}, type, style).front();
+}
+
+std::vector<MonteCarloResult> MonteCarloPricer::simulate(const std::vector<Option>& options, OptionType type,
+                                                         PayoffStyle style) const
+{
+    // Group by underlying dynamics; std::map keeps the group order deterministic
+    std::map<std::tuple<double, double, double, double, double>, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < options.size(); ++i)
+    {
+        if (!options[i].isValid())
+        {
+            throw std::invalid_argument("Invalid option parameters.");
+        }
+        groups[underlyingKey(options[i])].push_back(i);
+    }
+
+    std::vector<MonteCarloResult> results(options.size());
+    for (const auto& [key, group] : groups)
+    {
+        simulateGroup(options, group, type, style, results);
+    }
+
+    return results;
+}
+
+std::string MonteCarloPricer::getName() const
+{
+    return "Monte Carlo";
+}
+
+bool MonteCarloPricer::supportsGreeks() const
+{
+    return true;
+}
+
+void MonteCarloPricer::simulateGroup(const std::vector<Option>& options, const std::vector<std::size_t>& group,
+                                     OptionType type, PayoffStyle style,
+                                     std::vector<MonteCarloResult>& results) const
+{
+    const Option& underlying = options[group.front()];
+    const double T = underlying.ExerciseDate();
+    const double sig = underlying.Volatility();
+    const double r = underlying.RiskFreeRate();
+    const double S = underlying.AssetPrice();
+    const double b = underlying.CostOfCarry();
+
+    const bool european = style == PayoffStyle::European;
+    const std::size_t steps = european ? 1 : settings_.timeSteps;
+    const std::size_t legs = settings_.antithetic ? 2 : 1;
+    const double dt = T / static_cast<double>(steps);
+    const double drift = (b - 0.5 * sig * sig) * dt;
+    const double vol = sig * std::sqrt(dt);
+    const double logS0 = std::log(S);
+    const double legWeight = 1.0 / static_cast<double>(legs);
+
+    const std::size_t samples = (settings_.paths + legs - 1) / legs;
+    const std::size_t blocks = (samples + BlockSamples - 1) / BlockSamples;
+    const std::size_t grain = (blocks + MaxChunks - 1) / MaxChunks;
+    const std::size_t chunks = (blocks + grain - 1) / grain;
+    const std::size_t count = group.size();
+
+    std::vector<Accumulator> sums(chunks * count);
+
+    auto runBlocks = [&](std::size_t firstBlock, std::size_t lastBlock) {
+        Accumulator* acc = &sums[(firstBlock / grain) * count];
+        PathBuffers buffers(legs);
+        boost::random::normal_distribution<double> normal(0.0, 1.0);
+
+        for (std::size_t block = firstBlock; block < lastBlock; ++block)
+        {
+            const std::size_t n = std::min(BlockSamples, samples - block * BlockSamples);
+            PhiloxEngine engine(settings_.seed, block);
+
+            // Generate the block's paths once for the whole group
+            for (std::size_t leg = 0; leg < legs; ++leg)
+            {
+                std::fill_n(buffers.logS[leg].begin(), n, logS0);
+                std::fill_n(buffers.underlying[leg].begin(), n, 0.0);
+                std::fill_n(buffers.geometric[leg].begin(), n, 0.0);
+            }
+
+            for (std::size_t step = 0; step < steps; ++step)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    buffers.z[i] = normal(engine);
+                }
+                for (std::size_t leg = 0; leg < legs; ++leg)
+                {
+                    double shock = leg == 0 ? vol : -vol;
+                    double* logS = buffers.logS[leg].data();
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        logS[i] += drift + shock * buffers.z[i];
+                    }
+                    if (!european)
+                    {
+                        double* sum = buffers.underlying[leg].data();
+                        double* logSum = buffers.geometric[leg].data();
+                        for (std::size_t i = 0; i < n; ++i)
+                        {
+                            sum[i] += std::exp(logS[i]);
+                            logSum[i] += logS[i];
+                        }
+                    }
+                }
+            }
+
+            // Value the payoff is written on, plus the control variate's underlying
+            for (std::size_t leg = 0; leg < legs; ++leg)
+            {
+                double* value = buffers.underlying[leg].data();
+                double* geometric = buffers.geometric[leg].data();
+                const double* logS = buffers.logS[leg].data();
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    if (european)
+                    {
+                        value[i] = std::exp(logS[i]);
+                        geometric[i] = value[i];
+                    }
+                    else
+                    {
+                        double geometricAverage = std::exp(geometric[i] / static_cast<double>(steps));
+                        value[i] = style == PayoffStyle::GeometricAsian ? geometricAverage
+                                                                        : value[i] / static_cast<double>(steps);
+                        geometric[i] = style == PayoffStyle::ArithmeticAsian ? geometricAverage
+                                                                             : std::exp(logS[i]);
+                    }
+                }
+            }
+
+            // Evaluate every strike of the group on the same paths
+            const double gammaScale = 1.0 / (S * sig * std::sqrt(T));
+            for (std::size_t j = 0; j < count; ++j)
+            {
+                const double K = options[group[j]].StrikePrice();
+                Accumulator& a = acc[j];
+
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    double y = 0.0, x = 0.0, delta = 0.0, gamma = 0.0;
+                    for (std::size_t leg = 0; leg < legs; ++leg)
+                    {
+                        double value = buffers.underlying[leg][i];
+                        y += payoff(type, value, K);
+
+                        // Arithmetic Asian: geometric Asian payoff as control; otherwise S_T
+                        double control = buffers.geometric[leg][i];
+                        x += style == PayoffStyle::ArithmeticAsian ? payoff(type, control, K) : control;
+
+                        if (european)
+                        {
+                            double z = leg == 0 ? buffers.z[i] : -buffers.z[i];
+                            bool inTheMoney = value > K;
+                            delta += type == OptionType::Call ? (inTheMoney ? value / S : 0.0)
+                                                              : (inTheMoney ? 0.0 : -value / S);
+                            gamma += inTheMoney ? K / S * z * gammaScale : 0.0;
+                        }
+                    }
+                    y *= legWeight;
+                    x *= legWeight;
+
+                    a.y += y;
+                    a.yy += y * y;
+                    a.x += x;
+                    a.xx += x * x;
+                    a.xy += x * y;
+                    a.delta += delta * legWeight;
+                    a.gamma += gamma * legWeight;
+                }
+            }
+        }
+    };
+
+    // Fixed chunk boundaries: the serial and the pooled run produce identical sums
+    if (threadPool_ && chunks > 1)
+    {
+        threadPool_->parallelFor(blocks, grain, runBlocks);
+    }
+    else
+    {
+        for (std::size_t first = 0; first < blocks; first += grain)
+        {
+            runBlocks(first, std::min(blocks, first + grain));
+        }
+    }
+
+    const double N = static_cast<double>(samples);
+    const double discount = std::exp(-r * T);
+
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        Accumulator total;
+        for (std::size_t c = 0; c < chunks; ++c)
+        {
+            total.add(sums[c * count + j]);
+        }
+
+        const Option& option = options[group[j]];
+        double meanY = total.y / N;
+        double meanX = total.x / N;
+        double varY = std::max(0.0, (total.yy - N * meanY * meanY) / (N - 1.0));
+        double varX = std::max(0.0, (total.xx - N * meanX * meanX) / (N - 1.0));
+        double covXY = (total.xy - N * meanX * meanY) / (N - 1.0);
+
+        double estimate = meanY;
+        double variance = varY;
+        if (settings_.controlVariate && varX > 0.0)
+        {
+            // Known mean of the control: E[S_T] or the undiscounted geometric Asian price
+            double expectedX = style == PayoffStyle::ArithmeticAsian ? geometricAsianForward(option, type, steps)
+                                                                     : S * std::exp(b * T);
+            double beta = covXY / varX;
+            estimate = meanY - beta * (meanX - expectedX);
+            variance = std::max(0.0, varY - covXY * covXY / varX);
+        }
+
+        MonteCarloResult& result = results[group[j]];
+        result.price = discount * estimate;
+        result.standardError = discount * std::sqrt(variance / N);
+        if (european)
+        {
+            result.delta = discount * total.delta / N;
+            result.gamma = discount * total.gamma / N;
+        }
+    }
+}
+
+std::vector<double> MonteCarloPricer::simulateField(const std::vector<Option>& options, OptionType type,
+                                                    ResultField field) const
+{
+    std::vector<MonteCarloResult> results = simulate(options, type);
+
+    std::vector<double> values;
+    values.reserve(results.size());
+    for (const MonteCarloResult& result : results)
+    {
+        values.push_back(result.*field);
+    }
+
+    return values;
+}
+
+void MonteCarloPricer::simulateBatch(const OptionBatchView& batch, std::span<double> out, OptionType type,
+                                     ResultField field) const
+{
+    if (out.size() != batch.size)
+    {
+        throw std::invalid_argument("Output size does not match option batch size.");
+    }
+
+    std::vector<Option> options;
+    options.reserve(batch.size);
+    for (std::size_t i = 0; i < batch.size; ++i)
+    {
+        options.push_back(batch.option(i));
+    }
+
+    std::vector<double> values = simulateField(options, type, field);
+    std::copy(values.begin(), values.end(), out.begin());
+}
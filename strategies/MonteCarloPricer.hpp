@@ -0,0 +1,132 @@
+#ifndef MONTECARLOPRICER_HPP
+#define MONTECARLOPRICER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include "IPricingStrategy.hpp"
+#include "Option.hpp"
+#include "OptionBatch.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @brief Payoff evaluated on the simulated paths
+ *
+ * - European: max(S_T - K, 0) / max(K - S_T, 0), simulated exactly in one step
+ * - ArithmeticAsian: fixed strike on the arithmetic mean of timeSteps equally spaced fixings
+ * - GeometricAsian: fixed strike on the geometric mean of the same fixings
+ */
+enum class PayoffStyle
+{
+    European,
+    ArithmeticAsian,
+    GeometricAsian
+};
+
+/**
+ * @brief Simulation parameters of the Monte Carlo pricer
+ */
+struct MonteCarloSettings
+{
+    std::size_t paths = 200000;       // Simulated paths (an antithetic pair counts as two), at least two samples
+    std::size_t timeSteps = 64;       // Fixings of path-dependent payoffs
+    bool antithetic = true;           // Pair every normal draw Z with -Z
+    bool controlVariate = true;       // S_T (European) or the geometric Asian payoff (arithmetic Asian)
+    std::uint64_t seed = 20240517;    // Philox key; equal seeds give equal results for any thread count
+};
+
+/**
+ * @brief Monte Carlo estimate with its standard error
+ *
+ * Delta (pathwise) and gamma (likelihood ratio on the pathwise delta) are only
+ * estimated for European payoffs and are NaN otherwise.
+ */
+struct MonteCarloResult
+{
+    static constexpr double NotAvailable = std::numeric_limits<double>::quiet_NaN();
+
+    double price = NotAvailable;
+    double standardError = NotAvailable;
+    double delta = NotAvailable;
+    double gamma = NotAvailable;
+};
+
+/**
+ * @brief Monte Carlo pricing strategy under geometric Brownian motion with cost of carry b
+ *
+ * Paths are simulated in blocks of 4096 samples; every block draws from its own
+ * Philox stream keyed by (seed, block index), so the estimate does not depend
+ * on the number of threads or on which thread ran which block. Options that
+ * share T, sigma, r, S and b are priced on one set of paths: the path buffers
+ * of a block are filled once and evaluated for every strike of the group.
+ */
+class MonteCarloPricer final : public IPricingStrategy
+{
+public:
+
+    MonteCarloPricer() = default; // Default settings, single-threaded
+    explicit MonteCarloPricer(const MonteCarloSettings& settings);
+
+    // Single option pricing
+    double calculateCallPrice(const Option& option) const override;
+    double calculatePutPrice(const Option& option) const override;
+
+    // Vector pricing (options sharing an underlying reuse the same paths)
+    std::vector<double> calculateCallVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculatePutVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallVector;   // Span overloads
+    using IPricingStrategy::calculatePutVector;
+
+    // Greeks calculation (pathwise delta, likelihood ratio gamma)
+    double calculateGamma(const Option& option) const override;
+    double calculateCallDelta(const Option& option) const override;
+    double calculatePutDelta(const Option& option) const override;
+
+    // Vector Greeks calculation for monotonic ranges
+    std::vector<double> calculateCallDeltaVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculatePutDeltaVector(const std::vector<Option>& options) const override;
+    std::vector<double> calculateGammaVector(const std::vector<Option>& options) const override;
+    using IPricingStrategy::calculateCallDeltaVector;
+    using IPricingStrategy::calculatePutDeltaVector;
+    using IPricingStrategy::calculateGammaVector;
+
+    // Batch calculation (grouped like the vector methods instead of one simulation per row)
+    void calculateCallBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateCallDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculatePutDeltaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+    void calculateGammaBatch(const OptionBatchView& batch, std::span<double> out) const override;
+
+    // Full simulation results, including standard errors and path-dependent payoffs
+    MonteCarloResult simulate(const Option& option, OptionType type,
+                              PayoffStyle style = PayoffStyle::European) const;
+    std::vector<MonteCarloResult> simulate(const std::vector<Option>& options, OptionType type,
+                                           PayoffStyle style = PayoffStyle::European) const;
+
+    // Utility functions
+    std::string getName() const override;
+    bool supportsGreeks() const override;
+
+    const MonteCarloSettings& getSettings() const { return settings_; };
+    void setSettings(const MonteCarloSettings& settings);
+
+    // Blocks of paths run on the pool when set (may be shared with an OptionContext)
+    void setThreadPool(std::shared_ptr<ThreadPool> pool) { threadPool_ = std::move(pool); };
+
+private:
+
+    using ResultField = double MonteCarloResult::*;
+
+    // Simulate one group of options sharing an underlying; results written by option index
+    void simulateGroup(const std::vector<Option>& options, const std::vector<std::size_t>& group,
+                       OptionType type, PayoffStyle style, std::vector<MonteCarloResult>& results) const;
+
+    std::vector<double> simulateField(const std::vector<Option>& options, OptionType type, ResultField field) const;
+    void simulateBatch(const OptionBatchView& batch, std::span<double> out, OptionType type, ResultField field) const;
+
+    MonteCarloSettings settings_;
+    std::shared_ptr<ThreadPool> threadPool_;
+};
+
+#endif // MONTECARLOPRICER_HPP
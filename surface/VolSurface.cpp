@@ -0,0 +1,324 @@
+#include "VolSurface.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+double SviSlice::totalVariance(double strike) const
+{
+    double d = std::log(strike / forward) - m;
+    return a + b * (rho * d + std::sqrt(d * d + sigma * sigma));
+}
+
+bool SviSlice::isValid() const
+{
+    for (double value : {expiry, forward, a, b, rho, m, sigma})
+    {
+        if (!std::isfinite(value))
+        {
+            return false;
+        }
+    }
+    // The minimum of w over k is a + b sigma sqrt(1 - rho^2)
+    return expiry > 0.0 && forward > 0.0 && b >= 0.0 && std::abs(rho) < 1.0 && sigma > 0.0
+           && a + b * sigma * std::sqrt(1.0 - rho * rho) >= 0.0;
+}
+
+void VolSurface::Axis::build(std::vector<double> values, std::size_t minimumSize, const char* name)
+{
+    if (values.size() < minimumSize)
+    {
+        throw std::invalid_argument(std::string("Volatility surface needs at least ") + std::to_string(minimumSize)
+                                    + " " + name + ".");
+    }
+    for (std::size_t j = 0; j < values.size(); ++j)
+    {
+        if (!(values[j] > 0.0) || !std::isfinite(values[j]) || (j > 0 && !(values[j] > values[j - 1])))
+        {
+            throw std::invalid_argument(std::string("Volatility surface ") + name
+                                        + " must be positive, finite and strictly increasing.");
+        }
+    }
+    knots = std::move(values);
+
+    // Cells no wider than the smallest gap hold at most one knot each
+    std::size_t buckets = knots.size() - 1;
+    std::size_t cells = 1;
+    cellScale = 0.0;
+    if (buckets > 0)
+    {
+        double range = knots.back() - knots.front();
+        double smallestGap = range;
+        for (std::size_t j = 1; j < knots.size(); ++j)
+        {
+            smallestGap = std::min(smallestGap, knots[j] - knots[j - 1]);
+        }
+        double needed = std::ceil(range / smallestGap);
+        cells = std::max(buckets, needed < MaxCells ? static_cast<std::size_t>(needed) : MaxCells);
+        cellScale = cells / range;
+    }
+    cellBucket.assign(cells, 0);
+    std::size_t j = 0;
+    for (std::size_t c = 0; c < cells; ++c)
+    {
+        double edge = knots.front() + c / cellScale;
+        while (j + 2 < knots.size() && knots[j + 1] <= edge)
+        {
+            ++j;
+        }
+        cellBucket[c] = static_cast<std::uint32_t>(j);
+    }
+}
+
+std::size_t VolSurface::Axis::bucket(double x) const
+{
+    std::size_t last = knots.size() - 1;
+    if (last == 0 || !(x > knots.front()))
+    {
+        return 0;
+    }
+    if (x >= knots.back())
+    {
+        return last - 1;
+    }
+    std::size_t cell = std::min(static_cast<std::size_t>((x - knots.front()) * cellScale), cellBucket.size() - 1);
+    std::size_t j = cellBucket[cell];
+    while (j + 1 < last && knots[j + 1] <= x)
+    {
+        ++j;
+    }
+    return j;
+}
+
+VolSurface::VolSurface(const Grid<double>& vols, VolInterpolation interpolation)
+    : interpolation_(interpolation)
+{
+    if (vols.rowLabels().size() != vols.rows() || vols.colLabels().size() != vols.cols())
+    {
+        throw std::invalid_argument("Volatility grid needs expiry row labels and strike column labels.");
+    }
+    expiries_.build(vols.rowLabels(), 1, "expiries");
+    strikes_.build(vols.colLabels(), 2, "strikes");
+    setVolatilities(vols);
+}
+
+VolSurface::VolSurface(std::span<const SviSlice> slices, std::vector<double> strikes, VolInterpolation interpolation)
+    : interpolation_(interpolation)
+{
+    std::vector<double> expiries;
+    expiries.reserve(slices.size());
+    for (const SviSlice& slice : slices)
+    {
+        expiries.push_back(slice.expiry);
+    }
+    expiries_.build(std::move(expiries), 1, "expiries");
+    strikes_.build(std::move(strikes), 2, "strikes");
+    setSvi(slices);
+}
+
+void VolSurface::setVolatilities(const Grid<double>& vols)
+{
+    if (vols.rows() != expiries_.knots.size() || vols.cols() != strikes_.knots.size())
+    {
+        throw std::invalid_argument("Volatility grid does not match the surface's expiries and strikes.");
+    }
+
+    std::vector<double> variance(vols.size());
+    for (std::size_t i = 0; i < vols.rows(); ++i)
+    {
+        for (std::size_t j = 0; j < vols.cols(); ++j)
+        {
+            double vol = vols(i, j);
+            if (!(vol > 0.0) || !std::isfinite(vol))
+            {
+                throw std::invalid_argument("Surface volatilities must be positive and finite.");
+            }
+            variance[i * vols.cols() + j] = vol * vol * expiries_.knots[i];
+        }
+    }
+    setVariance(std::move(variance));
+}
+
+void VolSurface::setSvi(std::span<const SviSlice> slices)
+{
+    const std::vector<double>& expiries = expiries_.knots;
+    const std::vector<double>& strikes = strikes_.knots;
+    if (slices.size() != expiries.size())
+    {
+        throw std::invalid_argument("SVI slices do not match the surface's expiries.");
+    }
+
+    std::vector<double> variance(expiries.size() * strikes.size());
+    for (std::size_t i = 0; i < slices.size(); ++i)
+    {
+        if (!slices[i].isValid() || slices[i].expiry != expiries[i])
+        {
+            throw std::invalid_argument("SVI slice " + std::to_string(i)
+                                        + " is invalid or does not match the surface's expiry.");
+        }
+        for (std::size_t j = 0; j < strikes.size(); ++j)
+        {
+            variance[i * strikes.size() + j] = slices[i].totalVariance(strikes[j]);
+        }
+    }
+    setVariance(std::move(variance));
+}
+
+namespace
+{
+    // Smallest value on t in [0, 1] of the spline piece
+    // w(t) = s w0 + t w1 + c ((s^3 - s) M0 + (t^3 - t) M1), s = 1 - t, c = h^2 / 6
+    double splineMinimum(double w0, double w1, double M0, double M1, double c)
+    {
+        auto piece = [&](double t) {
+            double s = 1.0 - t;
+            return s * w0 + t * w1 + c * ((s * s * s - s) * M0 + (t * t * t - t) * M1);
+        };
+        double minimum = std::min(w0, w1);
+
+        // Interior extrema at the roots of w'(t) = A t^2 + B t + C
+        double A = 3.0 * c * (M1 - M0);
+        double B = 6.0 * c * M0;
+        double C = w1 - w0 - c * (2.0 * M0 + M1);
+        double roots[2];
+        std::size_t rootCount = 0;
+        if (std::abs(A) > 1e-14 * (std::abs(B) + std::abs(C)))
+        {
+            double discriminant = B * B - 4.0 * A * C;
+            if (discriminant >= 0.0)
+            {
+                double root = std::sqrt(discriminant);
+                roots[rootCount++] = (-B - root) / (2.0 * A);
+                roots[rootCount++] = (-B + root) / (2.0 * A);
+            }
+        }
+        else if (B != 0.0)
+        {
+            roots[rootCount++] = -C / B;
+        }
+        for (std::size_t k = 0; k < rootCount; ++k)
+        {
+            if (roots[k] > 0.0 && roots[k] < 1.0)
+            {
+                minimum = std::min(minimum, piece(roots[k]));
+            }
+        }
+        return minimum;
+    }
+}
+
+void VolSurface::setVariance(std::vector<double> variance)
+{
+    variance_ = std::move(variance);
+    curvature_.assign(variance_.size(), 0.0);
+    splineWeight_.assign(variance_.size(), 0.0);
+    if (interpolation_ != VolInterpolation::CubicSpline)
+    {
+        return;
+    }
+
+    // Natural spline per expiry row: tridiagonal system for the second derivatives, solved by the Thomas algorithm
+    const std::vector<double>& K = strikes_.knots;
+    std::size_t n = K.size();
+    std::vector<double> diagonal(n), rhs(n);
+    for (std::size_t i = 0; i < expiries_.knots.size(); ++i)
+    {
+        const double* w = variance_.data() + i * n;
+        double* M = curvature_.data() + i * n;
+        for (std::size_t j = 1; j + 1 < n; ++j)
+        {
+            double h0 = K[j] - K[j - 1];
+            double h1 = K[j + 1] - K[j];
+            diagonal[j] = 2.0 * (h0 + h1);
+            rhs[j] = 6.0 * ((w[j + 1] - w[j]) / h1 - (w[j] - w[j - 1]) / h0);
+            if (j > 1)
+            {
+                double factor = h0 / diagonal[j - 1];
+                diagonal[j] -= factor * h0;
+                rhs[j] -= factor * rhs[j - 1];
+            }
+        }
+        for (std::size_t j = n - 1; j-- > 1; )
+        {
+            M[j] = (rhs[j] - (K[j + 1] - K[j]) * M[j + 1]) / diagonal[j];
+        }
+
+        // Steep wings can pull the spline through zero variance: such intervals fall back to linear
+        double* weight = splineWeight_.data() + i * n;
+        for (std::size_t j = 0; j + 1 < n; ++j)
+        {
+            double h = K[j + 1] - K[j];
+            weight[j] = splineMinimum(w[j], w[j + 1], M[j], M[j + 1], h * h / 6.0) > 0.0 ? 1.0 : 0.0;
+        }
+    }
+}
+
+double VolSurface::totalVariance(double T, double K) const
+{
+    double vol = volatility(T, K);
+    return vol * vol * T;
+}
+
+double VolSurface::volatility(double T, double K) const
+{
+    double vol;
+    volatilities(std::span<const double>(&T, 1), std::span<const double>(&K, 1), std::span<double>(&vol, 1));
+    return vol;
+}
+
+void VolSurface::volatilities(std::span<const double> T, std::span<const double> K, std::span<double> out) const
+{
+    if (T.size() != out.size() || K.size() != out.size())
+    {
+        throw std::invalid_argument("Expiry, strike and output sizes must match.");
+    }
+
+    const std::vector<double>& expiries = expiries_.knots;
+    const std::vector<double>& strikes = strikes_.knots;
+    std::size_t columns = strikes.size();
+    const double* w = variance_.data();
+    const double* M = curvature_.data();
+    const double* spline = splineWeight_.data();
+
+    // Per row of a block: grid offsets of the two expiry rows' buckets, strike and expiry
+    // weights, the spline scale h^2 / 6 and the clamped expiry
+    std::size_t lower[BlockSize], upper[BlockSize];
+    double strikeWeight[BlockSize], expiryWeight[BlockSize], splineScale[BlockSize], expiry[BlockSize];
+    for (std::size_t begin = 0; begin < out.size(); begin += BlockSize)
+    {
+        std::size_t count = std::min(BlockSize, out.size() - begin);
+
+        // Gather: bucket searches and weights; flat extrapolation by clamping
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double clampedK = std::clamp(K[begin + i], strikes.front(), strikes.back());
+            double clampedT = std::clamp(T[begin + i], expiries.front(), expiries.back());
+            std::size_t j = strikes_.bucket(clampedK);
+            std::size_t e = expiries_.bucket(clampedT);
+            std::size_t next = std::min(e + 1, expiries.size() - 1);
+            double h = strikes[j + 1] - strikes[j];
+
+            lower[i] = e * columns + j;
+            upper[i] = next * columns + j;
+            strikeWeight[i] = (clampedK - strikes[j]) / h;
+            expiryWeight[i] = next == e ? 0.0 : (clampedT - expiries[e]) / (expiries[next] - expiries[e]);
+            splineScale[i] = h * h / 6.0;
+            expiry[i] = clampedT;
+        }
+
+        // Interpolate: branch-free over the gathered columns; linear intervals (every interval
+        // of a bilinear surface) carry a zero spline weight
+        double* result = out.data() + begin;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double t = strikeWeight[i];
+            double s = 1.0 - t;
+            double cs = (s * s * s - s) * splineScale[i];
+            double ct = (t * t * t - t) * splineScale[i];
+            std::size_t a = lower[i], b = upper[i];
+            double w0 = s * w[a] + t * w[a + 1] + spline[a] * (cs * M[a] + ct * M[a + 1]);
+            double w1 = s * w[b] + t * w[b + 1] + spline[b] * (cs * M[b] + ct * M[b + 1]);
+            result[i] = std::sqrt((w0 + expiryWeight[i] * (w1 - w0)) / expiry[i]);
+        }
+    }
+}
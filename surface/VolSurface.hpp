@@ -0,0 +1,114 @@
+#ifndef VOLSURFACE_HPP
+#define VOLSURFACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Grid.hpp"
+
+/*
+    @brief Interpolation across strikes within one expiry, in total variance
+    - Bilinear: linear in strike (and linear in expiry, like every mode)
+    - CubicSpline: natural cubic spline in strike; an interval where the spline
+      would reach zero variance (a steep wing) is interpolated linearly instead
+*/
+enum class VolInterpolation
+{
+    Bilinear,
+    CubicSpline
+};
+
+/*
+    @brief One expiry of a raw SVI parameterisation
+    Total variance w(k) = a + b (rho (k - m) + sqrt((k - m)^2 + sigma^2)) in
+    log-moneyness k = ln(K / forward).
+*/
+struct SviSlice
+{
+    double expiry = 1.0;
+    double forward = 100.0;
+    double a = 0.04;
+    double b = 0.1;
+    double rho = -0.5;
+    double m = 0.0;
+    double sigma = 0.1;
+
+    double totalVariance(double strike) const;
+    bool isValid() const;   // b >= 0, |rho| < 1, sigma > 0 and a variance that never goes negative
+};
+
+/**
+ * @brief Implied volatility surface on a strike / expiry grid
+ *
+ * Volatilities are held as total variance w = sig^2 T, interpolated across
+ * strikes per expiry row (VolInterpolation) and linearly in expiry, which
+ * keeps calendar interpolation free of arbitrage between grid expiries.
+ * Outside the grid the volatility is extrapolated flat: strikes are clamped
+ * to the strike range and expiries to the expiry range.
+ *
+ * Lookups are O(1): each axis keeps a table of uniform cells, no wider than
+ * its smallest knot gap, recording the knot bucket each cell starts in. A
+ * cell then holds at most one knot, so locating a strike or expiry is one
+ * multiplication, one table read and at most one step along the knots. The
+ * table is capped at MaxCells; only axes whose largest and smallest gaps
+ * differ by more than that ratio step further. The tables and spline
+ * coefficients are built once; setVolatilities() and setSvi() refresh the
+ * values of the same axes without touching the lookup tables.
+ */
+class VolSurface
+{
+public:
+
+    // vols: one row per expiry (row labels) and one column per strike (column
+    // labels), as built with Grid(meshArray(...), meshArray(...))
+    explicit VolSurface(const Grid<double>& vols, VolInterpolation interpolation = VolInterpolation::Bilinear);
+    // SVI slices sampled at the given strikes, one row per slice in expiry order
+    VolSurface(std::span<const SviSlice> slices, std::vector<double> strikes,
+               VolInterpolation interpolation = VolInterpolation::CubicSpline);
+
+    double volatility(double T, double K) const;
+    double totalVariance(double T, double K) const;
+
+    // Volatility of every (T[i], K[i]), block by block: a gather pass locates the
+    // buckets and weights, then a branch-free pass interpolates the whole block
+    void volatilities(std::span<const double> T, std::span<const double> K, std::span<double> out) const;
+
+    // Surface refresh: new values on the same strikes and expiries
+    void setVolatilities(const Grid<double>& vols);
+    void setSvi(std::span<const SviSlice> slices);
+
+    const std::vector<double>& expiries() const { return expiries_.knots; };
+    const std::vector<double>& strikes() const { return strikes_.knots; };
+    VolInterpolation interpolation() const { return interpolation_; };
+
+private:
+
+    // Knots with their O(1) bucket table
+    struct Axis
+    {
+        static constexpr std::size_t MaxCells = std::size_t(1) << 16;   // 256 KiB of table per axis
+
+        std::vector<double> knots;
+        std::vector<std::uint32_t> cellBucket;   // Bucket of each cell's lower edge
+        double cellScale = 0.0;                  // Cells per unit of the axis
+
+        void build(std::vector<double> values, std::size_t minimumSize, const char* name);
+        std::size_t bucket(double x) const;      // j with knots[j] <= x < knots[j + 1], clamped to the grid
+    };
+
+    // Rows per block of the batch pass: the gathered buckets and weights stay on the stack
+    static constexpr std::size_t BlockSize = 256;
+
+    // Install expiries x strikes total variances, then the spline coefficients
+    void setVariance(std::vector<double> variance);
+
+    Axis expiries_;
+    Axis strikes_;
+    VolInterpolation interpolation_;
+    std::vector<double> variance_;     // expiries x strikes, row-major
+    std::vector<double> curvature_;    // Spline second derivatives d2w/dK2 at the knots
+    std::vector<double> splineWeight_; // 1 where interval [K_j, K_j+1] uses the spline, 0 where linear
+};
+
+#endif // VOLSURFACE_HPP
@@ -0,0 +1,123 @@
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "AlignedAllocator.hpp"
+
+/**
+ * @brief Row-major contiguous 2-D grid with numeric row/column axis labels
+ *
+ * Replaces nested vectors for matrix pricing: one allocation for the whole
+ * grid, rows are adjacent in memory, and the flat value range can be handed
+ * directly to batch kernels. Labels describe the swept parameters (e.g. expiry
+ * times down the rows, spot prices across the columns) and travel with the
+ * values from input to result grid.
+ *
+ * resize() and reshape() keep existing capacity, so a result grid passed back
+ * into the same call does not allocate again.
+ *
+ * @tparam T Element type (Option, double, GreeksResult, ...)
+ */
+template <typename T>
+class Grid
+{
+public:
+
+    using Storage = std::vector<T, AlignedAllocator<T>>;
+
+    Grid() = default; // Empty 0 x 0 grid
+
+    Grid(std::size_t rows, std::size_t cols, const T& value = T())
+        : rows_(rows), cols_(cols), values_(rows * cols, value)
+    {
+    }
+
+    // Shape taken from the axis labels
+    Grid(std::vector<double> rowLabels, std::vector<double> colLabels, const T& value = T())
+        : rows_(rowLabels.size()), cols_(colLabels.size()), values_(rows_ * cols_, value),
+          rowLabels_(std::move(rowLabels)), colLabels_(std::move(colLabels))
+    {
+    }
+
+    // Shape
+    std::size_t rows() const { return rows_; };
+    std::size_t cols() const { return cols_; };
+    std::size_t size() const { return values_.size(); };
+    bool empty() const { return values_.empty(); };
+
+    // Element and row access
+    T& operator () (std::size_t row, std::size_t col) { return values_[row * cols_ + col]; };
+    const T& operator () (std::size_t row, std::size_t col) const { return values_[row * cols_ + col]; };
+    T& at(std::size_t row, std::size_t col)
+    {
+        checkIndex(row, col);
+        return values_[row * cols_ + col];
+    };
+    const T& at(std::size_t row, std::size_t col) const
+    {
+        checkIndex(row, col);
+        return values_[row * cols_ + col];
+    };
+    std::span<T> row(std::size_t row) { return std::span<T>(values_).subspan(row * cols_, cols_); };
+    std::span<const T> row(std::size_t row) const { return std::span<const T>(values_).subspan(row * cols_, cols_); };
+
+    // All values in row-major order
+    std::span<T> values() { return values_; };
+    std::span<const T> values() const { return values_; };
+    T* data() { return values_.data(); };
+    const T* data() const { return values_.data(); };
+
+    // Axis labels (may be empty when the axes carry no parameter values)
+    const std::vector<double>& rowLabels() const { return rowLabels_; };
+    const std::vector<double>& colLabels() const { return colLabels_; };
+    void setRowLabels(std::vector<double> labels) { rowLabels_ = std::move(labels); };
+    void setColLabels(std::vector<double> labels) { colLabels_ = std::move(labels); };
+
+    // Change the shape; existing values are not preserved in position
+    void resize(std::size_t rows, std::size_t cols, const T& value = T())
+    {
+        rows_ = rows;
+        cols_ = cols;
+        values_.assign(rows * cols, value);
+    };
+
+    // Take the shape and labels of another grid (e.g. the input of a matrix calculation)
+    template <typename U>
+    void reshape(const Grid<U>& other)
+    {
+        if (rows_ != other.rows() || cols_ != other.cols())
+        {
+            resize(other.rows(), other.cols());
+        }
+        rowLabels_ = other.rowLabels();
+        colLabels_ = other.colLabels();
+    }
+
+    bool operator == (const Grid& other) const
+    {
+        return rows_ == other.rows_ && cols_ == other.cols_ && values_ == other.values_
+            && rowLabels_ == other.rowLabels_ && colLabels_ == other.colLabels_;
+    };
+
+private:
+
+    void checkIndex(std::size_t row, std::size_t col) const
+    {
+        if (row >= rows_ || col >= cols_)
+        {
+            throw std::out_of_range("Grid index out of range.");
+        }
+    };
+
+    std::size_t rows_ = 0;
+    std::size_t cols_ = 0;
+    Storage values_;                // Row-major values
+    std::vector<double> rowLabels_; // Parameter value of each row
+    std::vector<double> colLabels_; // Parameter value of each column
+};
+
+#endif // GRID_HPP
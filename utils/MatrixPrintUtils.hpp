@@ -4,24 +4,25 @@
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include <string>
+#include "Grid.hpp"
 
 /**
- * @brief Utility function to print a matrix with row and column labels
+ * @brief Utility function to print a grid with its row and column labels
  *
- * This function prints a matrix in a formatted table with:
+ * This function prints a grid in a formatted table with:
  * - Row labels on the left
  * - Column labels on the top
  * - Tab-separated values for alignment
  *
- * @param rowLabels Vector of numeric labels for rows (e.g., expiry times, volatilities, strikes)
- * @param colLabels Vector of numeric labels for columns (e.g., spot prices)
- * @param matrix 2D vector containing the matrix values to print
+ * Axes without labels are numbered by index instead.
+ *
+ * @param grid Grid of values with row labels (e.g., expiry times, volatilities, strikes)
+ *             and column labels (e.g., spot prices)
  * @param rowHeader Header text for the row label column (e.g., "T\\S", "Vol\\S", "K\\S")
  * @param precision Number of decimal places for all values (default: 6)
  */
-inline void printMatrix(const std::vector<double>& rowLabels,
-                       const std::vector<double>& colLabels,
-                       const std::vector<std::vector<double>>& matrix,
+inline void printMatrix(const Grid<double>& grid,
                        const std::string& rowHeader,
                        int precision = 6)
 {
@@ -30,16 +31,24 @@ inline void printMatrix(const std::vector<double>& rowLabels,
     
     // Print header row
     std::cout << rowHeader << "\t\t";
-    for (const auto& colLabel : colLabels) {
-        std::cout << colLabel << "\t";
+    for (size_t j = 0; j < grid.cols(); ++j) {
+        if (j < grid.colLabels().size()) {
+            std::cout << grid.colLabels()[j] << "\t";
+        } else {
+            std::cout << j << "\t";
+        }
     }
     std::cout << std::endl;
     
-    // Print matrix rows with row labels
-    for (size_t i = 0; i < rowLabels.size() && i < matrix.size(); ++i) {
-        std::cout << rowLabels[i] << "\t";
-        for (size_t j = 0; j < colLabels.size() && j < matrix[i].size(); ++j) {
-            std::cout << matrix[i][j] << "\t";
+    // Print grid rows with row labels
+    for (size_t i = 0; i < grid.rows(); ++i) {
+        if (i < grid.rowLabels().size()) {
+            std::cout << grid.rowLabels()[i] << "\t";
+        } else {
+            std::cout << i << "\t";
+        }
+        for (double value : grid.row(i)) {
+            std::cout << value << "\t";
         }
         std::cout << std::endl;
     }
@@ -0,0 +1,84 @@
+#ifndef PHILOX_ENGINE_HPP
+#define PHILOX_ENGINE_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Philox4x32-10 counter-based random number engine
+ *
+ * Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC11). Every
+ * output block is a pure function of (key, counter), so independent streams
+ * need no shared state: a simulation gives each block of paths its own stream
+ * id and gets identical numbers for any thread count or scheduling order.
+ *
+ * Satisfies UniformRandomBitGenerator and can drive Boost.Random distributions.
+ */
+class PhiloxEngine
+{
+public:
+
+    using result_type = std::uint32_t;
+
+    /**
+     * @param seed Key shared by all streams of one simulation
+     * @param stream Stream id; distinct ids give non-overlapping sequences of 2^64 blocks
+     */
+    explicit PhiloxEngine(std::uint64_t seed = 0, std::uint64_t stream = 0)
+        : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+          counter_{0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)}
+    {
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator () ()
+    {
+        if (index_ == 4)
+        {
+            generateBlock();
+        }
+        return output_[index_++];
+    }
+
+private:
+
+    static constexpr std::uint32_t Multiplier0 = 0xD2511F53;
+    static constexpr std::uint32_t Multiplier1 = 0xCD9E8D57;
+    static constexpr std::uint32_t Weyl0 = 0x9E3779B9;
+    static constexpr std::uint32_t Weyl1 = 0xBB67AE85;
+
+    void generateBlock()
+    {
+        std::array<std::uint32_t, 4> x = counter_;
+        std::array<std::uint32_t, 2> k = key_;
+
+        for (int round = 0; round < 10; ++round)
+        {
+            std::uint64_t p0 = static_cast<std::uint64_t>(Multiplier0) * x[0];
+            std::uint64_t p1 = static_cast<std::uint64_t>(Multiplier1) * x[2];
+            x = {static_cast<std::uint32_t>(p1 >> 32) ^ x[1] ^ k[0], static_cast<std::uint32_t>(p1),
+                 static_cast<std::uint32_t>(p0 >> 32) ^ x[3] ^ k[1], static_cast<std::uint32_t>(p0)};
+            k[0] += Weyl0;
+            k[1] += Weyl1;
+        }
+
+        output_ = x;
+        index_ = 0;
+
+        // 64-bit block counter in the low words; the high words hold the stream id
+        if (++counter_[0] == 0)
+        {
+            ++counter_[1];
+        }
+    }
+
+    std::array<std::uint32_t, 2> key_;
+    std::array<std::uint32_t, 4> counter_;
+    std::array<std::uint32_t, 4> output_{};
+    int index_ = 4; // Output words consumed from the current block
+};
+
+#endif // PHILOX_ENGINE_HPP
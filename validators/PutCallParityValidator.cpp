@@ -1,4 +1,6 @@
 #include "PutCallParityValidator.hpp"
+#include "BlackScholesKernels.hpp"
+#include <algorithm>
 #include <cmath>
 
 bool PutCallParityValidator::validateParity(const Option& option, double callPrice, 
@@ -10,33 +12,74 @@ bool PutCallParityValidator::validateParity(const Option& option, double callPri
 
 double PutCallParityValidator::callFromPut(const Option& option, double putPrice) const
 {
-    // Put-Call Parity: C - P = S - K * e^(-r*T)
-    // Therefore: C = P + S - K * e^(-r*T)
+    // Put-Call Parity: C - P = S * e^((b-r)*T) - K * e^(-r*T)
+    // Therefore: C = P + S * e^((b-r)*T) - K * e^(-r*T)
     double presentValueOfStrike = calculatePresentValueOfStrike(option);
-    return putPrice + option.AssetPrice() - presentValueOfStrike;
+    return putPrice + calculateCarriedAssetPrice(option) - presentValueOfStrike;
 }
 
 double PutCallParityValidator::putFromCall(const Option& option, double callPrice) const
 {
-    // Put-Call Parity: C - P = S - K * e^(-r*T)
-    // Therefore: P = C - S + K * e^(-r*T)
+    // Put-Call Parity: C - P = S * e^((b-r)*T) - K * e^(-r*T)
+    // Therefore: P = C - S * e^((b-r)*T) + K * e^(-r*T)
     double presentValueOfStrike = calculatePresentValueOfStrike(option);
-    return callPrice - option.AssetPrice() + presentValueOfStrike;
+    return callPrice - calculateCarriedAssetPrice(option) + presentValueOfStrike;
 }
 
 double PutCallParityValidator::calculateParityDifference(const Option& option, 
                                                        double callPrice, double putPrice) const
 {
-    // Put-Call Parity: C - P = S - K * e^(-r*T)
-    // Difference = (C - P) - (S - K * e^(-r*T))
+    // Put-Call Parity: C - P = S * e^((b-r)*T) - K * e^(-r*T)
+    // Difference = (C - P) - (S * e^((b-r)*T) - K * e^(-r*T))
     double leftSide = callPrice - putPrice;
-    double rightSide = option.AssetPrice() - calculatePresentValueOfStrike(option);
+    double rightSide = calculateCarriedAssetPrice(option) - calculatePresentValueOfStrike(option);
     
     return leftSide - rightSide;
 }
 
+ParityAudit PutCallParityValidator::auditParity(const OptionBatchView& batch, std::span<const double> callPrices,
+                                               std::span<const double> putPrices, double tolerance) const
+{
+    if (callPrices.size() != batch.size || putPrices.size() != batch.size)
+    {
+        throw std::invalid_argument("Price sizes must match option batch size.");
+    }
+
+    constexpr std::size_t Block = 1024;
+    alignas(64) double differences[Block];
+
+    ParityAudit audit;
+    audit.checked = batch.size;
+    for (std::size_t begin = 0; begin < batch.size; begin += Block)
+    {
+        std::size_t count = std::min(Block, batch.size - begin);
+        evaluateParityDifferenceBatch(batch.subview(begin, count), callPrices.subspan(begin, count),
+                                      putPrices.subspan(begin, count), std::span<double>(differences, count));
+
+        double blockMax = audit.maxAbsDifference;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double magnitude = std::abs(differences[i]);
+            blockMax = magnitude > blockMax ? magnitude : blockMax;
+            if (!(magnitude <= tolerance))
+            {
+                audit.violations.push_back({begin + i, differences[i]});
+            }
+        }
+        audit.maxAbsDifference = blockMax;
+    }
+    return audit;
+}
+
 double PutCallParityValidator::calculatePresentValueOfStrike(const Option& option) const
 {
     // Present value of strike: K * e^(-r*T)
     return option.StrikePrice() * std::exp(-option.RiskFreeRate() * option.ExerciseDate());
 }
+
+double PutCallParityValidator::calculateCarriedAssetPrice(const Option& option) const
+{
+    // Asset price adjusted for cost-of-carry: S * e^((b-r)*T)
+    // For stock options b = r, so this is just S
+    return option.AssetPrice() * std::exp((option.CostOfCarry() - option.RiskFreeRate()) * option.ExerciseDate());
+}
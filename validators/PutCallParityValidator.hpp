@@ -7,9 +7,11 @@
 /**
  * @brief Concrete implementation of Put-Call Parity validator
  * 
- * Implements the Put-Call Parity relationship: C - P = S - K * e^(-r*T)
+ * Implements the Put-Call Parity relationship with cost-of-carry b:
+ * C - P = S * e^((b-r)*T) - K * e^(-r*T), which reduces to C - P = S - K * e^(-r*T)
+ * for stock options (b = r)
  */
-class PutCallParityValidator : public IParityValidator
+class PutCallParityValidator final : public IParityValidator
 {
 public:
     // IParityValidator implementation
@@ -22,9 +24,16 @@ public:
     double calculateParityDifference(const Option& option, 
                                    double callPrice, double putPrice) const override;
 
+    // Vectorised audit: residuals come from evaluateParityDifferenceBatch in
+    // cache-sized blocks and only the violating rows are collected
+    ParityAudit auditParity(const OptionBatchView& batch, std::span<const double> callPrices,
+                            std::span<const double> putPrices, double tolerance = 1e-6) const override;
+
 private:
     // Helper function to calculate present value of strike price
     double calculatePresentValueOfStrike(const Option& option) const;
+    // Helper function to calculate the carry-adjusted asset price S * e^((b-r)*T)
+    double calculateCarriedAssetPrice(const Option& option) const;
 };
 
 #endif // PUTCALLPARITYVALIDATOR_HPP
\ No newline at end of file